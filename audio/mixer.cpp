@@ -141,9 +141,29 @@ public:
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
 	/**
-	 * Queries how long the channel has been playing.
+	 * Queries the number of samples consumed up to the last mix.
 	 */
-	Timestamp getElapsedTime();
+	uint32 getSamplesConsumed() const { return _samplesConsumed; }
+
+	/**
+	 * Queries the time of the last mix, in milliseconds.
+	 */
+	uint32 getMixerTimeStamp() const { return _mixerTimeStamp; }
+
+	/**
+	 * Queries when the channel was paused, in milliseconds.
+	 */
+	uint32 getPauseStartTime() const { return _pauseStartTime; }
+
+	/**
+	 * Queries how long the channel was paused since the last mix.
+	 */
+	uint32 getPauseTime() const { return _pauseTime; }
+
+	/**
+	 * Queries the native sample rate of the channel's stream.
+	 */
+	uint32 getStreamRate() const { return _stream->getRate(); }
 
 	/**
 	 * Replaces the channel's stream with a version that loops indefinitely.
@@ -201,8 +221,11 @@ MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
 
 	assert(sampleRate > 0);
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	for (int i = 0; i != NUM_CHANNELS; i++) {
 		_channels[i] = nullptr;
+		_channelStates[i].handle.store(kInvalidHandle);
+		_channelStates[i].rateHandle.store(kInvalidHandle);
+	}
 }
 
 MixerImpl::~MixerImpl() {
@@ -213,7 +236,7 @@ MixerImpl::~MixerImpl() {
 void MixerImpl::setReady(bool ready) {
 	Common::StackLock lock(_mutex);
 
-	_mixerReady = ready;
+	_mixerReady.store(ready);
 }
 
 uint MixerImpl::getOutputRate() const {
@@ -251,6 +274,152 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	_handleSeed++;
 	if (handle)
 		*handle = chanHandle;
+
+	publishChannel(index);
+}
+
+void MixerImpl::publishChannel(int index) {
+	Channel *chan = _channels[index];
+	ChannelState &state = _channelStates[index];
+	const uint32 handle = chan->getHandle()._val;
+
+	state.id.store(chan->getId());
+	state.type.store(chan->getType());
+	state.settings.store(packSettings(handle, chan->getVolume(), chan->getBalance()));
+	publishRate(state, handle, chan->getRate(), false);
+	state.streamRate.store(chan->getStreamRate());
+	publishPosition(index);
+
+	// Publish the handle last, so that the queries only match it once
+	// everything else is in place
+	state.handle.store(handle);
+}
+
+void MixerImpl::publishPosition(int index) {
+	Channel *chan = _channels[index];
+	ChannelState &state = _channelStates[index];
+
+	state.sequence.fetchAdd(1);
+	state.samplesConsumed.store(chan->getSamplesConsumed());
+	state.mixerTimeStamp.store(chan->getMixerTimeStamp());
+	state.pauseStartTime.store(chan->getPauseStartTime());
+	state.pauseTime.store(chan->getPauseTime());
+	state.paused.store(chan->isPaused());
+	state.sequence.fetchAdd(1);
+}
+
+void MixerImpl::publishRate(ChannelState &state, uint32 handle, uint32 rate, bool onlyIfCurrent) {
+	uint32 current = state.rateHandle.load();
+	for (;;) {
+		if (onlyIfCurrent && current != handle)
+			return;
+		if (current != kUpdatingRate && state.rateHandle.compareExchange(current, kUpdatingRate))
+			break;
+		current = state.rateHandle.load();
+	}
+
+	state.rate.store(rate);
+	state.rateHandle.store(handle);
+}
+
+void MixerImpl::removeChannel(int index) {
+	_channelStates[index].handle.store(kInvalidHandle);
+
+	delete _channels[index];
+	_channels[index] = nullptr;
+}
+
+void MixerImpl::queueCommand(Command::Type type, uint32 target, int32 value) {
+	_commandMutex.lock();
+
+	while (_commandHead.loadRelaxed() - _commandTail.load() == COMMAND_QUEUE_SIZE) {
+		// The mixer callback is not running, or not keeping up, so apply
+		// the queued commands here. Engines may call us with _mutex held,
+		// so never wait for it while holding _commandMutex.
+		_commandMutex.unlock();
+		{
+			Common::StackLock lock(_mutex);
+			processCommands();
+		}
+		_commandMutex.lock();
+	}
+
+	const uint32 head = _commandHead.loadRelaxed();
+	Command &command = _commands[head % COMMAND_QUEUE_SIZE];
+	command.type = type;
+	command.target = target;
+	command.value = value;
+	_commandHead.store(head + 1);
+
+	_commandMutex.unlock();
+}
+
+void MixerImpl::processCommands() {
+	// Must be called with _mutex held, which makes us the only consumer
+	uint32 tail = _commandTail.loadRelaxed();
+	const uint32 head = _commandHead.load();
+
+	for (; tail != head; tail++)
+		applyCommand(_commands[tail % COMMAND_QUEUE_SIZE]);
+
+	_commandTail.store(tail);
+}
+
+void MixerImpl::applyCommand(const Command &command) {
+	if (command.type == Command::kPauseAll) {
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != nullptr) {
+				_channels[i]->pause(command.value != 0);
+				publishPosition(i);
+			}
+		}
+		return;
+	}
+
+	if (command.type == Command::kPauseID) {
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != nullptr && _channels[i]->getId() == (int)command.target) {
+				_channels[i]->pause(command.value != 0);
+				publishPosition(i);
+				return;
+			}
+		}
+		return;
+	}
+
+	if (command.type == Command::kUpdateVolumes) {
+		for (int i = 0; i != NUM_CHANNELS; ++i) {
+			if (_channels[i] && _channels[i]->getType() == (SoundType)command.target)
+				_channels[i]->notifyGlobalVolChange();
+		}
+		return;
+	}
+
+	// Simply ignore requests for handles of sounds that already terminated
+	const int index = command.target % NUM_CHANNELS;
+	if (!_channels[index] || _channels[index]->getHandle()._val != command.target)
+		return;
+
+	switch (command.type) {
+	case Command::kSetVolume:
+		_channels[index]->setVolume(command.value);
+		break;
+	case Command::kSetBalance:
+		_channels[index]->setBalance(command.value);
+		break;
+	case Command::kSetRate:
+		_channels[index]->setRate(command.value);
+		break;
+	case Command::kResetRate:
+		_channels[index]->resetRate();
+		break;
+	case Command::kPauseHandle:
+		_channels[index]->pause(command.value != 0);
+		publishPosition(index);
+		break;
+	default:
+		break;
+	}
 }
 
 void MixerImpl::playStream(
@@ -269,7 +438,10 @@ void MixerImpl::playStream(
 	}
 
 
-	assert(_mixerReady);
+	assert(_mixerReady.load());
+
+	// Apply pending settings first, in case they refer to the sound ID
+	processCommands();
 
 	// Prevent duplicate sounds
 	if (id != -1) {
@@ -306,7 +478,10 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	int16 *buf = (int16 *)samples;
 
 	// Since the mixer callback has been called, the mixer must be ready...
-	_mixerReady = true;
+	_mixerReady.store(true);
+
+	// Apply the settings the engine changed since the last mix
+	processCommands();
 
 	//  zero the buf
 	memset(buf, 0, len);
@@ -325,10 +500,10 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = nullptr;
+				removeChannel(i);
 			} else if (!_channels[i]->isPaused()) {
 				tmp = _channels[i]->mix(buf, len);
+				publishPosition(i);
 
 				if (tmp > res)
 					res = tmp;
@@ -340,113 +515,119 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
+	processCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = nullptr;
+			removeChannel(i);
 		}
 	}
 }
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
+	processCommands();
 	for (int i = 0; i != NUM_CHANNELS; i++) {
 		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = nullptr;
+			removeChannel(i);
 		}
 	}
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	processCommands();
 
 	// Simply ignore stop requests for handles of sounds that already terminated
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
 		return;
 
-	delete _channels[index];
-	_channels[index] = nullptr;
+	removeChannel(index);
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	_soundTypeSettings[type].mute = mute;
+	_soundTypeSettings[type].mute.store(mute);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	queueCommand(Command::kUpdateVolumes, type);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	return _soundTypeSettings[type].mute;
+	return _soundTypeSettings[type].mute.load();
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
+	ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	// Update the published settings right away, so that getChannelVolume()
+	// returns the new value even before the command has been applied
+	uint32 settings = state.settings.load();
+	while ((settings >> 16) == (handle._val & 0xFFFF) &&
+	       !state.settings.compareExchange(settings, (settings & ~0xFF) | volume))
+		;
 
-	_channels[index]->setVolume(volume);
+	queueCommand(Command::kSetVolume, handle._val, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	const uint32 settings = state.settings.load();
+	if (state.handle.load() != handle._val || (settings >> 16) != (handle._val & 0xFFFF))
 		return 0;
 
-	return _channels[index]->getVolume();
+	return settings & 0xFF;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
+	ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	uint32 settings = state.settings.load();
+	while ((settings >> 16) == (handle._val & 0xFFFF) &&
+	       !state.settings.compareExchange(settings, (settings & ~0xFF00) | ((byte)balance << 8)))
+		;
 
-	_channels[index]->setBalance(balance);
+	queueCommand(Command::kSetBalance, handle._val, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	const uint32 settings = state.settings.load();
+	if (state.handle.load() != handle._val || (settings >> 16) != (handle._val & 0xFFFF))
 		return 0;
 
-	return _channels[index]->getBalance();
+	return (int8)(settings >> 8);
 }
 
 void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
-	Common::StackLock lock(_mutex);
+	ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
+	publishRate(state, handle._val, rate, true);
 
-	_channels[index]->setRate(rate);
+	queueCommand(Command::kSetRate, handle._val, rate);
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	if (state.handle.load() != handle._val)
 		return 0;
-	
-	return _channels[index]->getRate();
+
+	// Retry if the rate changed while reading it
+	uint32 rateHandle, rate;
+	do {
+		rateHandle = state.rateHandle.load();
+		rate = state.rate.load();
+	} while (rateHandle == kUpdatingRate || state.rateHandle.load() != rateHandle);
+
+	return rateHandle == handle._val ? rate : 0;
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-	
-	_channels[index]->resetRate();
+	publishRate(state, handle._val, state.streamRate.load(), true);
+
+	queueCommand(Command::kResetRate, handle._val);
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -454,17 +635,53 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	uint32 samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime;
+	bool paused;
+
+	// Take a consistent snapshot of the position, retrying if the mixer
+	// thread updated it meanwhile
+	uint32 sequence;
+	do {
+		sequence = state.sequence.load();
+		samplesConsumed = state.samplesConsumed.load();
+		mixerTimeStamp = state.mixerTimeStamp.load();
+		pauseStartTime = state.pauseStartTime.load();
+		pauseTime = state.pauseTime.load();
+		paused = state.paused.load();
+	} while ((sequence & 1) || state.sequence.load() != sequence);
+
+	Audio::Timestamp ts(0, _sampleRate);
+
+	if (state.handle.load() != handle._val)
+		return ts;
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return Timestamp(0, _sampleRate);
+	if (mixerTimeStamp == 0)
+		return ts;
 
-	return _channels[index]->getElapsedTime();
+	uint32 delta = 0;
+	if (paused)
+		delta = pauseStartTime - mixerTimeStamp;
+	else
+		delta = g_system->getMillis(true) - mixerTimeStamp - pauseTime;
+
+	// Convert the number of samples into a time duration.
+
+	ts = ts.addFrames(samplesConsumed);
+	ts = ts.addMsecs(delta);
+
+	// In theory it would seem like a good idea to limit the approximation
+	// so that it never exceeds the theoretical upper bound set by
+	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
+	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
+	// isn't invoked at the regular intervals that I first imagined.
+
+	return ts;
 }
 
 void MixerImpl::loopChannel(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	processCommands();
 
 	const int index = handle._val % NUM_CHANNELS;
 	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
@@ -474,71 +691,47 @@ void MixerImpl::loopChannel(SoundHandle handle) {
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr) {
-			_channels[i]->pause(paused);
-		}
-	}
+	queueCommand(Command::kPauseAll, 0, paused);
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
-			return;
-		}
-	}
+	queueCommand(Command::kPauseID, id, paused);
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
-
-	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->pause(paused);
+	queueCommand(Command::kPauseHandle, handle._val, paused);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (_channelStates[i].handle.load() != kInvalidHandle && _channelStates[i].id.load() == id)
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	const int id = state.id.load();
+	if (state.handle.load() == handle._val)
+		return id;
 	return 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return _channelStates[handle._val % NUM_CHANNELS].handle.load() == handle._val;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (_channelStates[i].handle.load() != kInvalidHandle && _channelStates[i].type.load() == type)
 			return true;
 	return false;
 }
@@ -552,19 +745,15 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
-	_soundTypeSettings[type].volume = volume;
+	_soundTypeSettings[type].volume.store(volume);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	queueCommand(Command::kUpdateVolumes, type);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 
-	return _soundTypeSettings[type].volume;
+	return _soundTypeSettings[type].volume.load();
 }
 
 
@@ -670,34 +859,6 @@ void Channel::pause(bool paused) {
 	}
 }
 
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
-	uint32 delta = 0;
-
-	Audio::Timestamp ts(0, rate);
-
-	if (_mixerTimeStamp == 0)
-		return ts;
-
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
-
-	// Convert the number of samples into a time duration.
-
-	ts = ts.addFrames(_samplesConsumed);
-	ts = ts.addMsecs(delta);
-
-	// In theory it would seem like a good idea to limit the approximation
-	// so that it never exceeds the theoretical upper bound set by
-	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
-	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
-	// isn't invoked at the regular intervals that I first imagined.
-
-	return ts;
-}
-
 void Channel::loop() {
 	assert(_stream);
 
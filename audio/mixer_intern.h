@@ -23,6 +23,7 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/atomic.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
@@ -58,34 +59,127 @@ namespace Audio {
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		COMMAND_QUEUE_SIZE = 256
 	};
 
+	/**
+	 * Held by mixCallback() for the whole mix, and by everything which
+	 * creates or destroys channels.
+	 */
 	Common::Mutex _mutex;
 
 	const uint _sampleRate;
 	const bool _stereo;
 	const uint _outBufSize;
-	bool _mixerReady;
+	Common::Atomic<bool> _mixerReady;
 	uint32 _handleSeed;
 
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
 
-		bool mute;
-		int volume;
+		Common::Atomic<bool> mute;
+		Common::Atomic<int> volume;
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * A channel setting change, queued by the engine and applied by the
+	 * mixer thread at the start of the next mixCallback(). Pausing also
+	 * takes effect from then, since the channel keeps playing until then.
+	 */
+	struct Command {
+		enum Type {
+			kSetVolume,
+			kSetBalance,
+			kSetRate,
+			kResetRate,
+			kPauseHandle,
+			kPauseID,
+			kPauseAll,
+			kUpdateVolumes
+		};
+
+		Type type;
+		/** Channel handle, sound ID or sound type, depending on the type */
+		uint32 target;
+		int32 value;
+	};
+
+	/**
+	 * Single-producer/single-consumer ring of queued commands. Engine
+	 * threads serialize on _commandMutex to form the single producer. The
+	 * consumer is whoever holds _mutex, usually mixCallback(), which
+	 * therefore never has to wait for the engine to change a setting.
+	 */
+	Command _commands[COMMAND_QUEUE_SIZE];
+	Common::Atomic<uint32> _commandHead;
+	Common::Atomic<uint32> _commandTail;
+	Common::Mutex _commandMutex;
+
+	/**
+	 * Per-slot channel state published for the queries, so they never
+	 * have to lock _mutex and wait for a mix to finish.
+	 */
+	struct ChannelState {
+		/** Handle of the channel in the slot, or kInvalidHandle */
+		Common::Atomic<uint32> handle;
+		Common::Atomic<int> id;
+		Common::Atomic<int> type;
+		/** Volume, balance and handle check bits, see packSettings() */
+		Common::Atomic<uint32> settings;
+		/** Input rate, see publishRate() */
+		Common::Atomic<uint32> rate;
+		/** Handle of the channel the rate belongs to, or kUpdatingRate */
+		Common::Atomic<uint32> rateHandle;
+		/** Native rate of the channel's stream */
+		Common::Atomic<uint32> streamRate;
+
+		/**
+		 * Playback position snapshot, written by the mixer thread. The
+		 * sequence counter is odd while an update is in progress.
+		 */
+		Common::Atomic<uint32> sequence;
+		Common::Atomic<uint32> samplesConsumed;
+		Common::Atomic<uint32> mixerTimeStamp;
+		Common::Atomic<uint32> pauseStartTime;
+		Common::Atomic<uint32> pauseTime;
+		Common::Atomic<bool> paused;
+	};
+
+	static const uint32 kInvalidHandle = 0xFFFFFFFF;
+	/** Set in rateHandle while a thread changes the rate */
+	static const uint32 kUpdatingRate = 0xFFFFFFFE;
+
+	ChannelState _channelStates[NUM_CHANNELS];
+
+	static uint32 packSettings(uint32 handle, byte volume, int8 balance) { return (handle << 16) | ((byte)balance << 8) | volume; }
+
+	/**
+	 * Publish the rate of a channel. Rates need all 32 bits, so unlike the
+	 * settings they are not packed with handle check bits, rateHandle is
+	 * held as a tiny lock instead.
+	 *
+	 * @param onlyIfCurrent Only change the rate if it belongs to @p handle.
+	 */
+	static void publishRate(ChannelState &state, uint32 handle, uint32 rate, bool onlyIfCurrent);
+
+	void queueCommand(Command::Type type, uint32 target, int32 value = 0);
+	void processCommands();
+	void applyCommand(const Command &command);
+
+	void publishChannel(int index);
+	void publishPosition(int index);
+	void removeChannel(int index);
 
 public:
 
 	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0);
 	~MixerImpl();
 
-	virtual bool isReady() const { Common::StackLock lock(_mutex); return _mixerReady; }
+	virtual bool isReady() const { return _mixerReady.load(); }
 
 	virtual Common::Mutex &mutex() { return _mutex; }
 
@@ -29,7 +29,9 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/mixer.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -45,6 +47,25 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+template<bool inStereo, bool outStereo, bool reverseStereo>
+static RateMixFunc getRateMixFunc() {
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		return mixFramesAVX2<inStereo, outStereo, reverseStereo>;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return mixFramesSSE2<inStereo, outStereo, reverseStereo>;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return mixFramesNEON<inStereo, outStereo, reverseStereo>;
+#endif
+#endif
+	return mixFrames<inStereo, outStereo, reverseStereo>;
+}
+
 template<bool inStereo, bool outStereo, bool reverseStereo>
 class RateConverter_Impl : public RateConverter {
 private:
@@ -64,6 +85,13 @@ private:
 	/** Size of data currently loaded into the buffer */
 	int _bufferSize;
 
+	/**
+	 * Resampled input frames waiting to be mixed into the output. The
+	 * resampling loops fill this, so the volume and clamping can be applied
+	 * to a whole run of frames at once.
+	 */
+	st_sample_t _resampled[512];
+
 	/** How far output is ahead of input when doing simple conversion */
 	frac_t _outPos;
 
@@ -76,6 +104,9 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
+	/** Kernel applying the volume and mixing frames into the output */
+	RateMixFunc _mix;
+
     int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
     int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
     int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
@@ -110,30 +141,13 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
-		// Mix the data into the output buffer
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-		_bufferSize -= (inStereo ? 2 : 1);
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+		// Mix as many frames as both the buffer and the output allow
+		const uint numFrames = MIN<uint>(_bufferSize / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		_mix(outBuffer, _bufferPos, numFrames, volL, volR);
 
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
-		}
+		_bufferPos += numFrames * (inStereo ? 2 : 1);
+		_bufferSize -= numFrames * (inStereo ? 2 : 1);
+		outBuffer += numFrames * (outStereo ? 2 : 1);
 	}
 
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
@@ -149,6 +163,9 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
+	st_sample_t *resampled = _resampled;
+	const st_sample_t *resampledEnd = _resampled + ARRAYSIZE(_resampled);
+
 	while (outBuffer < outEnd) {
 		// Read enough input samples so that _outPos >= 0
 		do {
@@ -157,8 +174,12 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 				_bufferPos = _buffer;
 				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
 
-				if (_bufferSize <= 0)
+				if (_bufferSize <= 0) {
+					const uint numFrames = (resampled - _resampled) / (inStereo ? 2 : 1);
+					_mix(outBuffer, _resampled, numFrames, volL, volR);
+					outBuffer += numFrames * (outStereo ? 2 : 1);
 					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+				}
 			}
 
 			_bufferSize -= (inStereo ? 2 : 1);
@@ -169,30 +190,20 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 			}
 		} while (_outPos >= 0);
 
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
+		*resampled++ = *_bufferPos++;
+		if (inStereo)
+			*resampled++ = *_bufferPos++;
 
 		// Increment output position
 		_outPos += outPos_inc;
 
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-			outBuffer += 1;
+		// Flush the resampled frames once we have a full run, or the output
+		// buffer is going to be full
+		const uint numFrames = (resampled - _resampled) / (inStereo ? 2 : 1);
+		if (resampled == resampledEnd || outBuffer + numFrames * (outStereo ? 2 : 1) >= outEnd) {
+			_mix(outBuffer, _resampled, numFrames, volL, volR);
+			outBuffer += numFrames * (outStereo ? 2 : 1);
+			resampled = _resampled;
 		}
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
@@ -231,38 +242,25 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 			_outPosFrac -= FRAC_ONE_LOW;
 		}
 
-		// Loop as long as the _outPos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
-			// Interpolate
-			st_sample_t inL, inR;
-			inL = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			inR = (inStereo ?
-						(st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						inL);
+		// Interpolate as long as the _outPos trails behind, and as long as
+		// there is still space in the output buffer and the resample buffer.
+		const uint maxFrames = MIN<uint>((outEnd - outBuffer) / (outStereo ? 2 : 1), ARRAYSIZE(_resampled) / (inStereo ? 2 : 1));
+		st_sample_t *resampled = _resampled;
+		uint numFrames = 0;
 
-			st_sample_t outL, outR;
-			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-			if (outStereo) {
-				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
-
-				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-				outBuffer += 2;
-			} else {
-				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-				outBuffer += 1;
-			}
+		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && numFrames < maxFrames) {
+			// Interpolate
+			*resampled++ = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+			if (inStereo)
+				*resampled++ = (st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
 
 			// Increment output position
 			_outPosFrac += outPos_inc;
+			numFrames++;
 		}
+
+		_mix(outBuffer, _resampled, numFrames, volL, volR);
+		outBuffer += numFrames * (outStereo ? 2 : 1);
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
@@ -278,7 +276,8 @@ RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_ra
 	_inCurL(0),
 	_inCurR(0),
 	_bufferSize(0),
-	_bufferPos(nullptr) {}
+	_bufferPos(nullptr),
+	_mix(getRateMixFunc<inStereo, outStereo, reverseStereo>()) {}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
 int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <immintrin.h>
+
+#include "audio/rate_intern.h"
+
+namespace Audio {
+
+/**
+ * Divides the 32-bit products by kMaxMixerVolume, rounding towards zero
+ * like the C division in mixFrames does.
+ */
+static inline __m256i divideByMaxVolume(__m256i prod) {
+	const __m256i bias = _mm256_and_si256(_mm256_srai_epi32(prod, 31), _mm256_set1_epi32(Mixer::kMaxMixerVolume - 1));
+	return _mm256_srai_epi32(_mm256_add_epi32(prod, bias), 8);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesAVX2(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	// See mixFramesSSE2 for the lane layout
+	const __m256i vol = reverseStereo ?
+		_mm256_set_epi16(volL, volR, volL, volR, volL, volR, volL, volR, volL, volR, volL, volR, volL, volR, volL, volR) :
+		_mm256_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL, volR, volL, volR, volL, volR, volL, volR, volL);
+
+	// Process eight frames per iteration. All the unpack and pack operations
+	// work within 128-bit lanes, so each lane holds four consecutive frames.
+	for (; numFrames >= 8; numFrames -= 8) {
+		__m256i src;
+		if (inStereo) {
+			src = _mm256_loadu_si256((const __m256i *)in);
+			in += 16;
+		} else {
+			src = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)in));
+			src = _mm256_permute4x64_epi64(src, 0x50);
+			src = _mm256_unpacklo_epi16(src, src);
+			in += 8;
+		}
+
+		if (reverseStereo)
+			src = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src, 0xB1), 0xB1);
+
+		const __m256i prodLo = _mm256_mullo_epi16(src, vol);
+		const __m256i prodHi = _mm256_mulhi_epi16(src, vol);
+		const __m256i scaled0 = divideByMaxVolume(_mm256_unpacklo_epi16(prodLo, prodHi));
+		const __m256i scaled1 = divideByMaxVolume(_mm256_unpackhi_epi16(prodLo, prodHi));
+		const __m256i scaled = _mm256_packs_epi32(scaled0, scaled1);
+
+		if (outStereo) {
+			const __m256i dst = _mm256_loadu_si256((const __m256i *)out);
+			_mm256_storeu_si256((__m256i *)out, _mm256_adds_epi16(dst, scaled));
+			out += 16;
+		} else {
+			__m256i sum = _mm256_madd_epi16(scaled, _mm256_set1_epi16(1));
+			sum = _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_srli_epi32(sum, 31)), 1);
+
+			// Gather the low 64 bits of each lane into the low 128 bits
+			const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(sum, sum), 0x08);
+			const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+			_mm_storeu_si128((__m128i *)out, _mm_adds_epi16(dst, _mm256_castsi256_si128(packed)));
+			out += 8;
+		}
+	}
+
+	mixFrames<inStereo, outStereo, reverseStereo>(out, in, numFrames, volL, volR);
+}
+
+template void mixFramesAVX2<true, true, true>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesAVX2<true, true, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesAVX2<true, false, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesAVX2<false, true, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesAVX2<false, false, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+
+} // End of namespace Audio
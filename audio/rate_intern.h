@@ -0,0 +1,91 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RATE_INTERN_H
+#define AUDIO_RATE_INTERN_H
+
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+namespace Audio {
+
+/**
+ * Signature of the kernels which apply the channel volume to a run of
+ * input frames and add the result, clamped, to the output buffer.
+ *
+ * @param out        Output buffer, interleaved if the output is stereo.
+ * @param in         Input frames, interleaved if the input is stereo.
+ * @param numFrames  Number of frames to mix.
+ * @param volL       Volume for the left channel, at most Mixer::kMaxMixerVolume.
+ * @param volR       Volume for the right channel, at most Mixer::kMaxMixerVolume.
+ */
+typedef void (*RateMixFunc)(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR);
+
+/**
+ * Reference implementation of RateMixFunc. The SIMD variants have to
+ * produce exactly the same output, and use this for their tails.
+ */
+template<bool inStereo, bool outStereo, bool reverseStereo>
+inline void mixFrames(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	for (; numFrames > 0; --numFrames) {
+		st_sample_t inL, inR;
+		inL = *in++;
+		inR = (inStereo ? *in++ : inL);
+
+		st_sample_t outL, outR;
+		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+		if (outStereo) {
+			// Output left channel
+			clampedAdd(out[reverseStereo    ], outL);
+
+			// Output right channel
+			clampedAdd(out[reverseStereo ^ 1], outR);
+
+			out += 2;
+		} else {
+			// Output mono channel
+			clampedAdd(out[0], (outL + outR) / 2);
+
+			out += 1;
+		}
+	}
+}
+
+#ifdef SCUMMVM_SSE2
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesSSE2(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR);
+#endif
+
+#ifdef SCUMMVM_AVX2
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesAVX2(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR);
+#endif
+
+#ifdef SCUMMVM_NEON
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesNEON(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR);
+#endif
+
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,90 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <arm_neon.h>
+
+#include "audio/rate_intern.h"
+
+namespace Audio {
+
+/**
+ * Divides the 32-bit products by kMaxMixerVolume, rounding towards zero
+ * like the C division in mixFrames does.
+ */
+static inline int32x4_t divideByMaxVolume(int32x4_t prod) {
+	const int32x4_t bias = vandq_s32(vshrq_n_s32(prod, 31), vdupq_n_s32(Mixer::kMaxMixerVolume - 1));
+	return vshrq_n_s32(vaddq_s32(prod, bias), 8);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesNEON(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	// See mixFramesSSE2 for the lane layout
+	const int16 vols[4] = {
+		(int16)(reverseStereo ? volR : volL), (int16)(reverseStereo ? volL : volR),
+		(int16)(reverseStereo ? volR : volL), (int16)(reverseStereo ? volL : volR)
+	};
+	const int16x4_t volPair = vld1_s16(vols);
+
+	// Process four frames per iteration
+	for (; numFrames >= 4; numFrames -= 4) {
+		int16x8_t src;
+		if (inStereo) {
+			src = vld1q_s16(in);
+			in += 8;
+		} else {
+			const int16x4_t mono = vld1_s16(in);
+			const int16x4x2_t dup = vzip_s16(mono, mono);
+			src = vcombine_s16(dup.val[0], dup.val[1]);
+			in += 4;
+		}
+
+		if (reverseStereo)
+			src = vrev32q_s16(src);
+
+		const int32x4_t scaled0 = divideByMaxVolume(vmull_s16(vget_low_s16(src), volPair));
+		const int32x4_t scaled1 = divideByMaxVolume(vmull_s16(vget_high_s16(src), volPair));
+
+		if (outStereo) {
+			const int16x8_t scaled = vcombine_s16(vmovn_s32(scaled0), vmovn_s32(scaled1));
+			vst1q_s16(out, vqaddq_s16(vld1q_s16(out), scaled));
+			out += 8;
+		} else {
+			// (outL + outR) / 2, rounding towards zero
+			int32x4_t sum = vcombine_s32(
+				vpadd_s32(vget_low_s32(scaled0), vget_high_s32(scaled0)),
+				vpadd_s32(vget_low_s32(scaled1), vget_high_s32(scaled1)));
+			sum = vshrq_n_s32(vaddq_s32(sum, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(sum), 31))), 1);
+
+			vst1_s16(out, vqadd_s16(vld1_s16(out), vmovn_s32(sum)));
+			out += 4;
+		}
+	}
+
+	mixFrames<inStereo, outStereo, reverseStereo>(out, in, numFrames, volL, volR);
+}
+
+template void mixFramesNEON<true, true, true>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesNEON<true, true, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesNEON<true, false, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesNEON<false, true, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesNEON<false, false, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+
+} // End of namespace Audio
@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "audio/rate_intern.h"
+
+namespace Audio {
+
+/**
+ * Divides the 32-bit products by kMaxMixerVolume, rounding towards zero
+ * like the C division in mixFrames does.
+ */
+static inline __m128i divideByMaxVolume(__m128i prod) {
+	const __m128i bias = _mm_and_si128(_mm_srai_epi32(prod, 31), _mm_set1_epi32(Mixer::kMaxMixerVolume - 1));
+	return _mm_srai_epi32(_mm_add_epi32(prod, bias), 8);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void mixFramesSSE2(st_sample_t *out, const st_sample_t *in, uint numFrames, st_volume_t volL, st_volume_t volR) {
+	// Lane 2n receives the left output sample, lane 2n+1 the right one. When
+	// reversing, the input pairs are swapped, so the volumes follow them.
+	const __m128i vol = reverseStereo ?
+		_mm_set_epi16(volL, volR, volL, volR, volL, volR, volL, volR) :
+		_mm_set_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+	// Process four frames per iteration
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m128i src;
+		if (inStereo) {
+			src = _mm_loadu_si128((const __m128i *)in);
+			in += 8;
+		} else {
+			src = _mm_loadl_epi64((const __m128i *)in);
+			src = _mm_unpacklo_epi16(src, src);
+			in += 4;
+		}
+
+		if (reverseStereo)
+			src = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, 0xB1), 0xB1);
+
+		const __m128i prodLo = _mm_mullo_epi16(src, vol);
+		const __m128i prodHi = _mm_mulhi_epi16(src, vol);
+		const __m128i scaled0 = divideByMaxVolume(_mm_unpacklo_epi16(prodLo, prodHi));
+		const __m128i scaled1 = divideByMaxVolume(_mm_unpackhi_epi16(prodLo, prodHi));
+
+		// The scaled samples always fit into 16 bits, so packing is exact.
+		const __m128i scaled = _mm_packs_epi32(scaled0, scaled1);
+
+		if (outStereo) {
+			const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+			_mm_storeu_si128((__m128i *)out, _mm_adds_epi16(dst, scaled));
+			out += 8;
+		} else {
+			// (outL + outR) / 2, rounding towards zero
+			__m128i sum = _mm_madd_epi16(scaled, _mm_set1_epi16(1));
+			sum = _mm_srai_epi32(_mm_add_epi32(sum, _mm_srli_epi32(sum, 31)), 1);
+
+			const __m128i dst = _mm_loadl_epi64((const __m128i *)out);
+			_mm_storel_epi64((__m128i *)out, _mm_adds_epi16(dst, _mm_packs_epi32(sum, sum)));
+			out += 4;
+		}
+	}
+
+	mixFrames<inStereo, outStereo, reverseStereo>(out, in, numFrames, volL, volR);
+}
+
+template void mixFramesSSE2<true, true, true>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesSSE2<true, true, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesSSE2<true, false, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesSSE2<false, true, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+template void mixFramesSSE2<false, false, false>(st_sample_t *, const st_sample_t *, uint, st_volume_t, st_volume_t);
+
+} // End of namespace Audio
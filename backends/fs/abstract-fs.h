@@ -172,6 +172,16 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Retrieves the size and the last modification time of the file.
+	 *
+	 * The time is only meant to tell whether the file changed, and its unit
+	 * depends on the backend.
+	 *
+	 * @return bool true if the information is available, false otherwise.
+	 */
+	virtual bool getFileInfo(int64 &size, int64 &modificationTime) const { return false; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -182,6 +192,14 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream over the file mapped into memory, if the
+	 * backend supports it.
+	 *
+	 * @return pointer to the stream object, 0 if the file can't be mapped
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream() { return nullptr; }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -23,7 +23,14 @@
 
 #include "backends/fs/posix/posix-iostream.h"
 
+#include "common/memstream.h"
+
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#endif
 
 PosixIoStream *PosixIoStream::makeFromPath(const Common::String &path, bool writeMode) {
 #if defined(HAS_FSEEKO64)
@@ -39,6 +46,44 @@ PosixIoStream *PosixIoStream::makeFromPath(const Common::String &path, bool writ
 }
 
 
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+namespace {
+
+struct MappingDeleter {
+	size_t size;
+	MappingDeleter(size_t s) : size(s) {}
+	void operator()(byte *data) { munmap(data, size); }
+};
+
+} // End of anonymous namespace
+#endif
+
+Common::SeekableReadStream *PosixIoStream::mapFromPath(const Common::String &path) {
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	// MemoryReadStream can only address 4 GB
+	struct stat st;
+	if (fstat(fd, &st) == -1 || st.st_size <= 0 || (uint64)st.st_size > 0xFFFFFFFF) {
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid once the file is closed
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	Common::SharedPtr<byte> block((byte *)data, MappingDeleter(st.st_size));
+	return new Common::SharedMemoryReadStream(block, 0, st.st_size);
+#else
+	return nullptr;
+#endif
+}
+
 PosixIoStream::PosixIoStream(void *handle) :
 		StdioStream(handle) {
 }
@@ -30,6 +30,13 @@
 class PosixIoStream final : public StdioStream {
 public:
 	static PosixIoStream *makeFromPath(const Common::String &path, bool writeMode);
+
+	/**
+	 * Map the file into memory, and return a Common::SharedMemoryReadStream
+	 * over it. Returns nullptr if the system can't map files, or the file is
+	 * empty or too large.
+	 */
+	static Common::SeekableReadStream *mapFromPath(const Common::String &path);
 	PosixIoStream(void *handle);
 
 	int64 size() const override;
@@ -82,10 +82,11 @@ OpenGLGraphicsManager::OpenGLGraphicsManager()
 #endif
 #ifdef USE_OSD
 	  , _osdMessageChangeRequest(false), _osdMessageAlpha(0), _osdMessageFadeStartTime(0), _osdMessageSurface(nullptr),
-	  _osdIconSurface(nullptr)
+	  _osdIconSurface(nullptr), _osdStatsEnabled(ConfMan.getBool("show_upload_stats")), _osdStatsSurface(nullptr),
+	  _osdStatsBytes(0), _osdStatsFrames(0), _osdStatsStartTime(0)
 #endif
 #ifdef USE_SCALERS
-	  , _scalerPlugins(ScalerMan.getPlugins())
+	  , _scalerPlugins(ScalerMan.getPlugins()), _scalerThreads(ConfMan.getBool("scaler_threads"))
 #endif
 	{
 	memset(_gamePalette, 0, sizeof(_gamePalette));
@@ -100,6 +101,7 @@ OpenGLGraphicsManager::~OpenGLGraphicsManager() {
 #ifdef USE_OSD
 	delete _osdMessageSurface;
 	delete _osdIconSurface;
+	delete _osdStatsSurface;
 #endif
 #if !USE_FORCED_GLES
 	ShaderManager::destroy();
@@ -118,6 +120,7 @@ bool OpenGLGraphicsManager::hasFeature(OSystem::Feature f) const {
 	case OSystem::kFeatureCursorMaskInvert:
 #ifdef USE_SCALERS
 	case OSystem::kFeatureScalers:
+	case OSystem::kFeatureScalerThreads:
 #endif
 		return true;
 
@@ -151,6 +154,14 @@ void OpenGLGraphicsManager::setFeatureState(OSystem::Feature f, bool enable) {
 		updateCursorPalette();
 		break;
 
+#ifdef USE_SCALERS
+	case OSystem::kFeatureScalerThreads:
+		_scalerThreads = enable;
+		if (_gameScreen)
+			_gameScreen->enableScalerThreads(enable);
+		break;
+#endif
+
 	default:
 		break;
 	}
@@ -167,6 +178,11 @@ bool OpenGLGraphicsManager::getFeatureState(OSystem::Feature f) const {
 	case OSystem::kFeatureCursorPalette:
 		return _cursorPaletteEnabled;
 
+#ifdef USE_SCALERS
+	case OSystem::kFeatureScalerThreads:
+		return _scalerThreads;
+#endif
+
 	default:
 		return false;
 	}
@@ -525,6 +541,7 @@ OSystem::TransactionError OpenGLGraphicsManager::endGFXTransaction() {
 #ifdef USE_SCALERS
 		if (wantScaler) {
 			_gameScreen->setScaler(_currentState.scalerIndex, _currentState.scaleFactor);
+			_gameScreen->enableScalerThreads(_scalerThreads);
 		}
 #endif
 
@@ -673,6 +690,12 @@ void OpenGLGraphicsManager::updateScreen() {
 	}
 	_overlay->updateGLTexture();
 
+#ifdef USE_OSD
+	if (_osdStatsEnabled) {
+		osdStatsUpdate();
+	}
+#endif
+
 #if !USE_FORCED_GLES
 	if (_libretroPipeline) {
 		_libretroPipeline->beginScaling();
@@ -737,7 +760,7 @@ void OpenGLGraphicsManager::updateScreen() {
 
 #ifdef USE_OSD
 	// Fourth step: Draw the OSD.
-	if (_osdMessageSurface || _osdIconSurface) {
+	if (_osdMessageSurface || _osdIconSurface || _osdStatsSurface) {
 		_targetBuffer->enableBlend(Framebuffer::kBlendModeTraditionalTransparency);
 	}
 
@@ -785,6 +808,12 @@ void OpenGLGraphicsManager::updateScreen() {
 		_pipeline->drawTexture(_osdIconSurface->getGLTexture(),
 		                       dstX, dstY, _osdIconSurface->getWidth(), _osdIconSurface->getHeight());
 	}
+
+	if (_osdStatsSurface) {
+		// Draw the statistics texture.
+		_pipeline->drawTexture(_osdStatsSurface->getGLTexture(),
+		                       kOSDStatsMargin, kOSDStatsMargin, _osdStatsSurface->getWidth(), _osdStatsSurface->getHeight());
+	}
 #endif
 
 	_cursorNeedsRedraw = false;
@@ -1209,6 +1238,42 @@ void OpenGLGraphicsManager::osdMessageUpdateSurface() {
 	_osdMessageNextData.clear();
 	_osdMessageChangeRequest = false;
 }
+
+void OpenGLGraphicsManager::osdStatsUpdate() {
+	_osdStatsBytes += GLTexture::takeUploadedBytes();
+	++_osdStatsFrames;
+
+	const uint32 now = g_system->getMillis();
+	if (_osdStatsSurface && now - _osdStatsStartTime < kOSDStatsInterval) {
+		return;
+	}
+
+	const Common::String text = Common::String::format("Texture uploads: %.1f KB/frame",
+	                                                   _osdStatsBytes / 1024.0 / _osdStatsFrames);
+
+	const Graphics::Font *font = getFontOSD();
+	const uint width = font->getStringWidth(text) + 8;
+	const uint height = font->getFontHeight() + 4;
+
+	if (!_osdStatsSurface) {
+		_osdStatsSurface = createSurface(_defaultFormatAlpha);
+		assert(_osdStatsSurface);
+	}
+	_osdStatsSurface->allocate(width, height);
+
+	Graphics::Surface *dst = _osdStatsSurface->getSurface();
+	dst->fillRect(Common::Rect(0, 0, width, height), dst->format.ARGBToColor(160, 40, 40, 40));
+	font->drawString(dst, text, 4, 2, width - 8, dst->format.RGBToColor(255, 255, 255));
+
+	_osdStatsSurface->updateGLTexture();
+
+	// The statistics themselves are not part of the frame.
+	GLTexture::takeUploadedBytes();
+
+	_osdStatsBytes = 0;
+	_osdStatsFrames = 0;
+	_osdStatsStartTime = now;
+}
 #endif
 
 void OpenGLGraphicsManager::displayActivityIconOnOSD(const Graphics::Surface *icon) {
@@ -1411,6 +1476,10 @@ void OpenGLGraphicsManager::notifyContextCreate(ContextType type,
 	if (_osdIconSurface) {
 		_osdIconSurface->recreate();
 	}
+
+	if (_osdStatsSurface) {
+		_osdStatsSurface->recreate();
+	}
 #endif
 }
 
@@ -1439,6 +1508,10 @@ void OpenGLGraphicsManager::notifyContextDestroy() {
 	if (_osdIconSurface) {
 		_osdIconSurface->destroy();
 	}
+
+	if (_osdStatsSurface) {
+		_osdStatsSurface->destroy();
+	}
 #endif
 
 #if !USE_FORCED_GLES
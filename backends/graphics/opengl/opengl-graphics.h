@@ -450,6 +450,11 @@ protected:
 	 * The list of scaler plugins
 	 */
 	const PluginList &_scalerPlugins;
+
+	/**
+	 * Whether the game screen is scaled on several threads.
+	 */
+	bool _scalerThreads;
 #endif
 
 #ifdef USE_OSD
@@ -511,6 +516,38 @@ private:
 		kOSDIconTopMargin = 10,
 		kOSDIconRightMargin = 10
 	};
+
+	/**
+	 * Whether the texture upload statistics are shown.
+	 */
+	bool _osdStatsEnabled;
+
+	/**
+	 * Count the texture data uploaded for a frame, and refresh the
+	 * statistics surface once in a while.
+	 */
+	void osdStatsUpdate();
+
+	/**
+	 * The texture upload statistics' contents.
+	 */
+	Surface *_osdStatsSurface;
+
+	/**
+	 * The bytes uploaded and frames drawn since the statistics were shown.
+	 */
+	uint32 _osdStatsBytes;
+	uint32 _osdStatsFrames;
+
+	/**
+	 * When the statistics were shown.
+	 */
+	uint32 _osdStatsStartTime;
+
+	enum {
+		kOSDStatsInterval = 1000,
+		kOSDStatsMargin = 10
+	};
 #endif
 };
 
@@ -43,12 +43,25 @@ GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
 	: _glIntFormat(glIntFormat), _glFormat(glFormat), _glType(glType),
 	  _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
 	  _texCoords(), _glFilter(GL_NEAREST),
-	  _glTexture(0) {
+	  _glTexture(0), _pixelBuffers(), _currentPixelBuffer(0) {
 	create();
 }
 
 GLTexture::~GLTexture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#if !USE_FORCED_GLES && !USE_FORCED_GLES2
+	if (_pixelBuffers[0]) {
+		GL_CALL_SAFE(glDeleteBuffers, (2, _pixelBuffers));
+	}
+#endif
+}
+
+uint32 GLTexture::_uploadedBytes = 0;
+
+uint32 GLTexture::takeUploadedBytes() {
+	const uint32 bytes = _uploadedBytes;
+	_uploadedBytes = 0;
+	return bytes;
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -113,6 +126,14 @@ void GLTexture::setWrapMode(WrapMode wrapMode) {
 void GLTexture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+#if !USE_FORCED_GLES && !USE_FORCED_GLES2
+	// The pixel buffers are created again on the next upload.
+	if (_pixelBuffers[0]) {
+		GL_CALL(glDeleteBuffers(2, _pixelBuffers));
+		_pixelBuffers[0] = _pixelBuffers[1] = 0;
+	}
+#endif
 }
 
 void GLTexture::create() {
@@ -199,13 +220,31 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	// Set the texture on the active texture unit.
 	bind();
 
-	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundaries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
+#if !USE_FORCED_GLES && !USE_FORCED_GLES2
+	if (OpenGLContext.pixelBufferObjectSupported) {
+		updateAreaFromPixelBuffer(area, src);
+		return;
+	}
+#endif
+
+#if !USE_FORCED_GLES
+	// Only the area itself is uploaded when we can tell GL the pitch of the
+	// surface.
+	if (OpenGLContext.unpackSubImageSupported) {
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / src.format.bytesPerPixel));
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+		                        _glFormat, _glType, src.getBasePtr(area.left, area.top)));
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+
+		_uploadedBytes += area.width() * area.height() * src.format.bytesPerPixel;
+		return;
+	}
+#endif
+
+	// Otherwise, it is not possible to specify a pitch to glTexSubImage2D,
+	// as OpenGL ES 1.0 and some OpenGL ES 2.0 implementations do not
+	// support GL_UNPACK_ROW_LENGTH. Thus, we are left with the following
+	// options:
 	//
 	// 1) (As we do right now) Simply always update the whole texture lines of
 	//    rect changed. This is simplest to implement. In case performance is
@@ -219,14 +258,50 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	//    graphics manager did but it is much slower! Thus, we do not use it.
 	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
 	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+
+	_uploadedBytes += src.w * area.height() * src.format.bytesPerPixel;
 }
 
+#if !USE_FORCED_GLES && !USE_FORCED_GLES2
+void GLTexture::updateAreaFromPixelBuffer(const Common::Rect &area, const Graphics::Surface &src) {
+	if (!_pixelBuffers[0]) {
+		GL_CALL(glGenBuffers(2, _pixelBuffers));
+	}
+
+	_currentPixelBuffer ^= 1;
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_currentPixelBuffer]));
+
+	// The rows of the area are packed in the buffer. Allocating new storage
+	// for it first lets the driver keep the old one around for as long as
+	// the previous upload from it is still pending, instead of waiting.
+	const uint rowSize = area.width() * src.format.bytesPerPixel;
+	const uint size = rowSize * area.height();
+	GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+
+	if (rowSize == (uint)src.pitch) {
+		GL_CALL(glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, size, src.getBasePtr(0, area.top)));
+	} else {
+		for (int y = 0; y < area.height(); ++y) {
+			GL_CALL(glBufferSubData(GL_PIXEL_UNPACK_BUFFER, y * rowSize, rowSize, src.getBasePtr(area.left, area.top + y)));
+		}
+	}
+
+	// With a bound pixel buffer the data pointer is an offset in it.
+	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+	                        _glFormat, _glType, nullptr));
+
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+	_uploadedBytes += size;
+}
+#endif
+
 //
 // Surface
 //
 
 Surface::Surface()
-	: _allDirty(false), _dirtyArea() {
+	: _allDirty(false), _dirtyAreas() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -234,14 +309,8 @@ void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcP
 	assert(x + w <= (uint)dstSurf->w);
 	assert(y + h <= (uint)dstSurf->h);
 
-	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = Common::Rect(x, y, x + w, y + h);
-	} else {
-		_dirtyArea.extend(Common::Rect(x, y, x + w, y + h));
+	if (!_allDirty) {
+		addDirtyArea(_dirtyAreas, Common::Rect(x, y, x + w, y + h));
 	}
 
 	const byte *src = (const byte *)srcPtr;
@@ -267,12 +336,42 @@ void Surface::fill(uint32 color) {
 	flagDirty();
 }
 
-Common::Rect Surface::getDirtyArea() const {
+Common::Array<Common::Rect> Surface::getDirtyAreas() const {
 	if (_allDirty) {
-		return Common::Rect(getWidth(), getHeight());
+		return Common::Array<Common::Rect>(1, Common::Rect(getWidth(), getHeight()));
 	} else {
-		return _dirtyArea;
+		return _dirtyAreas;
+	}
+}
+
+void Surface::addDirtyArea(Common::Array<Common::Rect> &areas, const Common::Rect &area) {
+	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
+	// parameters is an empty rect. Thus, we skip empty areas.
+	if (area.isEmpty()) {
+		return;
+	}
+
+	// Merge the area with all areas it overlaps. The merged area can then
+	// overlap areas which were checked before, so start over each time.
+	Common::Rect merged = area;
+	for (uint i = 0; i < areas.size();) {
+		if (areas[i].intersects(merged)) {
+			merged.extend(areas[i]);
+			areas.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
 	}
+
+	if (areas.size() >= kMaxDirtyAreas) {
+		for (uint i = 0; i < areas.size(); ++i) {
+			merged.extend(areas[i]);
+		}
+		areas.clear();
+	}
+
+	areas.push_back(merged);
 }
 
 //
@@ -332,9 +431,14 @@ void Texture::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		Common::Rect dirtyArea = dirtyAreas[i];
+		updateGLTexture(dirtyArea);
+	}
 
-	updateGLTexture(dirtyArea);
+	// We should have handled everything, thus not dirty anymore.
+	clearDirty();
 }
 
 void Texture::updateGLTexture(Common::Rect &dirtyArea) {
@@ -368,9 +472,6 @@ void Texture::updateGLTexture(Common::Rect &dirtyArea) {
 	}
 
 	_glTexture.updateArea(dirtyArea, _textureData);
-
-	// We should have handled everything, thus not dirty anymore.
-	clearDirty();
 }
 
 FakeTexture::FakeTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType, const Graphics::PixelFormat &format, const Graphics::PixelFormat &fakeFormat)
@@ -453,12 +554,15 @@ void FakeTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
 
-	applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+		applyPaletteAndMask(dst, src, outSurf->pitch, _rgbData.pitch, _rgbData.w, dirtyArea, outSurf->format, _rgbData.format);
+	}
 
 	// Do generic handling of updating the texture.
 	Texture::updateGLTexture();
@@ -510,25 +614,28 @@ void TextureRGB555::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
+		const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -552,23 +659,26 @@ void TextureRGBA8888Swap::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
+		uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
 
-	const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
+		const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint32 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint32 color = *src++;
 
-			*dst++ = SWAP_BYTES_32(color);
-		}
+				*dst++ = SWAP_BYTES_32(color);
+			}
 
-		src = (const uint32 *)((const byte *)src + srcAdd);
-		dst = (uint32 *)((byte *)dst + dstAdd);
+			src = (const uint32 *)((const byte *)src + srcAdd);
+			dst = (uint32 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -578,7 +688,7 @@ void TextureRGBA8888Swap::updateGLTexture() {
 #ifdef USE_SCALERS
 
 ScaledTexture::ScaledTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType, const Graphics::PixelFormat &format, const Graphics::PixelFormat &fakeFormat)
-	: FakeTexture(glIntFormat, glFormat, glType, format, fakeFormat), _convData(nullptr), _scaler(nullptr), _scalerIndex(0), _scaleFactor(1), _extraPixels(0) {
+	: FakeTexture(glIntFormat, glFormat, glType, format, fakeFormat), _convData(nullptr), _scaler(nullptr), _scalerIndex(0), _scaleFactor(1), _extraPixels(0), _scalerThreads(false) {
 }
 
 ScaledTexture::~ScaledTexture() {
@@ -619,46 +729,56 @@ void ScaledTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
-
-	// Extend the dirty region for scalers
+	// Extend the dirty regions for scalers
 	// that "smear" the screen, e.g. 2xSAI
-	dirtyArea.grow(_extraPixels);
-	dirtyArea.clip(Common::Rect(0, 0, _rgbData.w, _rgbData.h));
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	Common::Array<Common::Rect> scaledAreas;
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		Common::Rect dirtyArea = dirtyAreas[i];
+		dirtyArea.grow(_extraPixels);
+		dirtyArea.clip(Common::Rect(0, 0, _rgbData.w, _rgbData.h));
+		addDirtyArea(scaledAreas, dirtyArea);
+	}
 
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	uint srcPitch = _rgbData.pitch;
-	byte *dst;
-	uint dstPitch;
+	for (uint i = 0; i < scaledAreas.size(); ++i) {
+		Common::Rect dirtyArea = scaledAreas[i];
 
-	if (_convData) {
-		dst = (byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
-		dstPitch = _convData->pitch;
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		uint srcPitch = _rgbData.pitch;
+		byte *dst;
+		uint dstPitch;
 
-		applyPaletteAndMask(dst, src, dstPitch, srcPitch, _rgbData.w, dirtyArea, _convData->format, _rgbData.format);
+		if (_convData) {
+			dst = (byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
+			dstPitch = _convData->pitch;
 
-		src = dst;
-		srcPitch = dstPitch;
-	}
+			applyPaletteAndMask(dst, src, dstPitch, srcPitch, _rgbData.w, dirtyArea, _convData->format, _rgbData.format);
 
-	dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
-	dstPitch = outSurf->pitch;
+			src = dst;
+			srcPitch = dstPitch;
+		}
 
-	if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
-		_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
-	} else {
-		Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
-		                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
-		                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
-	}
+		dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
+		dstPitch = outSurf->pitch;
 
-	dirtyArea.left   *= _scaleFactor;
-	dirtyArea.right  *= _scaleFactor;
-	dirtyArea.top    *= _scaleFactor;
-	dirtyArea.bottom *= _scaleFactor;
+		if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
+			_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
+		} else {
+			Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
+			                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
+			                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
+		}
 
-	// Do generic handling of updating the texture.
-	Texture::updateGLTexture(dirtyArea);
+		dirtyArea.left   *= _scaleFactor;
+		dirtyArea.right  *= _scaleFactor;
+		dirtyArea.top    *= _scaleFactor;
+		dirtyArea.bottom *= _scaleFactor;
+
+		// Do generic handling of updating the texture.
+		Texture::updateGLTexture(dirtyArea);
+	}
+
+	clearDirty();
 }
 
 void ScaledTexture::setScaler(uint scalerIndex, int scaleFactor) {
@@ -673,6 +793,7 @@ void ScaledTexture::setScaler(uint scalerIndex, int scaleFactor) {
 
 	if (!_scaler) {
 		_scaler = scalerPlugin.createInstance(_format);
+		_scaler->enableThreads(_scalerThreads);
 	}
 	_scaler->setFactor(scaleFactor);
 
@@ -680,6 +801,12 @@ void ScaledTexture::setScaler(uint scalerIndex, int scaleFactor) {
 	_scaleFactor = _scaler->getFactor();
 	_extraPixels = scalerPlugin.extraPixels();
 }
+
+void ScaledTexture::enableScalerThreads(bool enable) {
+	_scalerThreads = enable;
+	if (_scaler)
+		_scaler->enableThreads(enable);
+}
 #endif
 
 #if !USE_FORCED_GLES
@@ -818,7 +945,10 @@ void TextureCLUT8GPU::updateGLTexture() {
 
 	// Update CLUT8 texture if necessary.
 	if (Surface::isDirty()) {
-		_clut8Texture.updateArea(getDirtyArea(), _clut8Data);
+		const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+		for (uint i = 0; i < dirtyAreas.size(); ++i) {
+			_clut8Texture.updateArea(dirtyAreas[i], _clut8Data);
+		}
 		clearDirty();
 	}
 
@@ -28,6 +28,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 class Scaler;
@@ -114,6 +115,12 @@ public:
 	 */
 	void updateArea(const Common::Rect &area, const Graphics::Surface &src);
 
+	/**
+	 * Query the number of bytes uploaded to all textures since the last
+	 * call, and restart counting.
+	 */
+	static uint32 takeUploadedBytes();
+
 	/**
 	 * Query the GL texture's width.
 	 */
@@ -158,6 +165,18 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+	/**
+	 * Upload through one of two pixel buffer objects, which are used in
+	 * turns so that the driver does not need to wait for the previous
+	 * upload to finish.
+	 */
+	void updateAreaFromPixelBuffer(const Common::Rect &area, const Graphics::Surface &src);
+
+	GLuint _pixelBuffers[2];
+	uint _currentPixelBuffer;
+
+	static uint32 _uploadedBytes;
 };
 
 /**
@@ -223,7 +242,7 @@ public:
 	void fill(uint32 color);
 
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyAreas.empty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -252,6 +271,7 @@ public:
 	virtual void setPalette(uint start, uint colors, const byte *palData) {}
 
 	virtual void setScaler(uint scalerIndex, int scaleFactor) {}
+	virtual void enableScalerThreads(bool enable) {}
 
 	/**
 	 * Update underlying OpenGL texture to reflect current state.
@@ -263,12 +283,26 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyAreas.clear(); }
 
-	Common::Rect getDirtyArea() const;
+	/**
+	 * @return The areas changed since the last update. They do not overlap.
+	 */
+	Common::Array<Common::Rect> getDirtyAreas() const;
+
+	/**
+	 * Add an area to a list of non-overlapping areas. It is merged with the
+	 * areas it overlaps, and all of them are merged into one once there are
+	 * too many of them.
+	 */
+	static void addDirtyArea(Common::Array<Common::Rect> &areas, const Common::Rect &area);
 private:
+	enum {
+		kMaxDirtyAreas = 8
+	};
+
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	Common::Array<Common::Rect> _dirtyAreas;
 };
 
 /**
@@ -312,6 +346,9 @@ public:
 protected:
 	const Graphics::PixelFormat _format;
 
+	/**
+	 * Upload one area of the texture data, without clearing the dirty state.
+	 */
 	void updateGLTexture(Common::Rect &dirtyArea);
 
 private:
@@ -385,12 +422,14 @@ public:
 	void updateGLTexture() override;
 
 	void setScaler(uint scalerIndex, int scaleFactor) override;
+	void enableScalerThreads(bool enable) override;
 protected:
 	Graphics::Surface *_convData;
 	Scaler *_scaler;
 	uint _scalerIndex;
 	uint _extraPixels;
 	uint _scaleFactor;
+	bool _scalerThreads;
 };
 #endif
 
@@ -137,6 +137,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_transactionMode(kTransactionNone),
 	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr),
 	_needRestoreAfterOverlay(false), _isInOverlayPalette(false), _isDoubleBuf(false), _prevForceRedraw(false), _numPrevDirtyRects(0),
+	_damagedRects(NUM_DIRTY_RECT), _logFrameStats(ConfMan.getBool("show_upload_stats")),
 	_prevCursorNeedsRedraw(false),
 	_mouseKeyColor(0) {
 
@@ -173,6 +174,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 #endif
 
 	_scaler = nullptr;
+	_scalerThreads = ConfMan.getBool("scaler_threads");
 	_maxExtraPixels = ScalerMan.getMaxExtraPixels();
 
 	_videoMode.fullscreen = ConfMan.getBool("fullscreen");
@@ -209,6 +211,7 @@ bool SurfaceSdlGraphicsManager::hasFeature(OSystem::Feature f) const {
 		(f == OSystem::kFeatureFullscreenMode) ||
 #ifdef USE_SCALERS
 		(f == OSystem::kFeatureScalers) ||
+		(f == OSystem::kFeatureScalerThreads) ||
 #endif
 #ifdef USE_ASPECT
 		(f == OSystem::kFeatureAspectRatioCorrection) ||
@@ -240,6 +243,11 @@ void SurfaceSdlGraphicsManager::setFeatureState(OSystem::Feature f, bool enable)
 	case OSystem::kFeatureVSync:
 		setVSync(enable);
 		break;
+	case OSystem::kFeatureScalerThreads:
+		_scalerThreads = enable;
+		if (_scaler)
+			_scaler->enableThreads(enable);
+		break;
 	case OSystem::kFeatureCursorPalette:
 		_cursorPaletteDisabled = !enable;
 		blitCursor();
@@ -270,6 +278,8 @@ bool SurfaceSdlGraphicsManager::getFeatureState(OSystem::Feature f) const {
 		return _videoMode.vsync;
 	case OSystem::kFeatureFilteringMode:
 		return _videoMode.filtering;
+	case OSystem::kFeatureScalerThreads:
+		return _scalerThreads;
 	case OSystem::kFeatureCursorPalette:
 		return !_cursorPaletteDisabled;
 	default:
@@ -652,10 +662,12 @@ void SurfaceSdlGraphicsManager::setGraphicsModeIntern() {
 
 		_scalerPlugin = &_scalerPlugins[_videoMode.scalerIndex]->get<ScalerPluginObject>();
 		_scaler = _scalerPlugin->createInstance(format);
+		_scaler->enableThreads(_scalerThreads);
 	}
 
 	_scaler->setFactor(_videoMode.scaleFactor);
 	_extraPixels = _scalerPlugin->extraPixels();
+	_damagedRects.setHalo(_extraPixels);
 	_useOldSrc = _scalerPlugin->useOldSource();
 	if (_useOldSrc) {
 		_scaler->enableSource(true);
@@ -1277,6 +1289,23 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		_isInOverlayPalette = _overlayVisible;
 	}
 
+	// Take the areas to redraw from the merged list.
+	_numDirtyRects = 0;
+	if (!_forceRedraw) {
+		for (uint i = 0; i < _damagedRects.size(); ++i) {
+			const Common::Rect &rect = _damagedRects[i];
+			SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+
+			r->x = rect.left;
+			r->y = rect.top;
+			r->w = rect.width();
+			r->h = rect.height();
+		}
+	}
+	_frameStats.rects += _numDirtyRects;
+	_frameStats.damagedPixels += _damagedRects.getAddedArea();
+	_damagedRects.clear();
+
 	// In case of double buferring partially good version may be on another page,
 	// so we need to fully redraw
 	if (_isDoubleBuf && _numDirtyRects)
@@ -1374,6 +1403,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 
 				_scaler->scale((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
 						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y);
+				_frameStats.scaledPixels += dst_w * dst_h;
 
 				r->x = dst_x;
 				r->y = dst_y;
@@ -1497,6 +1527,28 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	if (_isDoubleBuf)
 		SDL_Flip(_hwScreen);
 #endif
+
+	if (_logFrameStats)
+		updateFrameStats(width * height);
+}
+
+void SurfaceSdlGraphicsManager::updateFrameStats(int screenPixels) {
+	++_frameStats.frames;
+	_frameStats.screenPixels += screenPixels;
+
+	const uint32 now = SDL_GetTicks();
+	if (now - _frameStats.startTime < 1000)
+		return;
+
+	if (_frameStats.startTime != 0) {
+		debug("Redraw: %u rects, %u damaged and %u scaled pixels per frame, %u%% of the screen",
+		      _frameStats.rects / _frameStats.frames, _frameStats.damagedPixels / _frameStats.frames,
+		      _frameStats.scaledPixels / _frameStats.frames,
+		      (uint)((uint64)_frameStats.scaledPixels * 100 / _frameStats.screenPixels));
+	}
+
+	_frameStats = FrameStats();
+	_frameStats.startTime = now;
 }
 
 bool SurfaceSdlGraphicsManager::saveScreenshot(const Common::String &filename) const {
@@ -1689,11 +1741,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	if (_forceRedraw)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceRedraw = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!inOverlay && !realCoordinates) {
@@ -1739,18 +1786,11 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 		makeRectStretchable(x, y, w, h, _videoMode.filtering);
 #endif
 
-	if (w == width && h == height) {
-		_forceRedraw = true;
-		return;
-	}
-
 	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
-
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
+		// The merged rect can end up covering the whole screen.
+		const Common::Rect &merged = _damagedRects.add(Common::Rect(x, y, x + w, y + h));
+		if (merged.width() == width && merged.height() == height)
+			_forceRedraw = true;
 	}
 }
 
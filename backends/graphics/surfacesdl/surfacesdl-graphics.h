@@ -24,6 +24,7 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/graphics/sdl/sdl-graphics.h"
+#include "graphics/dirtyrects.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
@@ -329,6 +330,7 @@ protected:
 	const PluginList &_scalerPlugins;
 	ScalerPluginObject *_scalerPlugin;
 	Scaler *_scaler, *_mouseScaler;
+	bool _scalerThreads;
 	uint _maxExtraPixels;
 	uint _extraPixels;
 
@@ -352,6 +354,29 @@ protected:
 	SDL_Rect _prevDirtyRectList[NUM_DIRTY_RECT];
 	int _numPrevDirtyRects;
 
+	// The areas changed since the last update, which are merged whenever
+	// scaling them together is cheaper. They are copied to _dirtyRectList
+	// when updating the screen.
+	Graphics::DirtyRectList _damagedRects;
+
+	// Redraw statistics, which are logged once a second when the
+	// "show_upload_stats" option is set
+	struct FrameStats {
+		uint32 startTime;
+		uint frames;
+		uint rects;
+		uint damagedPixels;
+		uint scaledPixels;
+		uint screenPixels;
+
+		FrameStats() : startTime(0), frames(0), rects(0), damagedPixels(0), scaledPixels(0), screenPixels(0) {}
+	};
+
+	bool _logFrameStats;
+	FrameStats _frameStats;
+
+	void updateFrameStats(int screenPixels);
+
 	struct MousePos {
 		// The size and hotspot of the original cursor image.
 		int16 w, h;
@@ -179,6 +179,7 @@ MODULE_OBJS += \
 	graphics/surfacesdl/surfacesdl-graphics.o \
 	mixer/sdl/sdl-mixer.o \
 	mutex/sdl/sdl-mutex.o \
+	threads/sdl/sdl-threads.o \
 	timer/sdl/sdl-timer.o
 
 ifndef RISCOS
@@ -298,7 +299,8 @@ MODULE_OBJS += \
 	graphics3d/opengl/surfacerenderer.o \
 	graphics3d/opengl/texture.o \
 	graphics3d/opengl/tiledsurface.o \
-	mutex/pthread/pthread-mutex.o
+	mutex/pthread/pthread-mutex.o \
+	threads/pthread/pthread-threads.o
 endif
 
 ifdef AMIGAOS
@@ -388,6 +390,7 @@ endif
 ifdef IPHONE
 MODULE_OBJS += \
 	mutex/pthread/pthread-mutex.o \
+	threads/pthread/pthread-threads.o \
 	graphics/ios/ios-graphics.o \
 	graphics/ios/renderbuffer.o \
 	graphics3d/ios/ios-graphics3d.o \
@@ -413,6 +416,11 @@ endif
 ifeq ($(BACKEND),null)
 MODULE_OBJS += \
 	mixer/null/null-mixer.o
+ifdef POSIX
+MODULE_OBJS += \
+	mutex/pthread/pthread-mutex.o \
+	threads/pthread/pthread-threads.o
+endif
 endif
 
 ifdef MIYOO
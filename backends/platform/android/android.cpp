@@ -65,6 +65,7 @@
 #include "backends/audiocd/default/default-audiocd.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 
@@ -630,7 +631,8 @@ bool OSystem_Android::hasFeature(Feature f) {
 			f == kFeatureOpenUrl ||
 			f == kFeatureClipboardSupport ||
 			f == kFeatureKbdMouseSpeed ||
-			f == kFeatureJoystickDeadzone) {
+			f == kFeatureJoystickDeadzone ||
+			f == kFeatureThreads) {
 		return true;
 	}
 	/* Even if we are using the 2D graphics manager,
@@ -763,6 +765,22 @@ Common::MutexInternal *OSystem_Android::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_Android::createThread(Common::ThreadProc proc, void *param) {
+	return createPthreadThreadInternal(proc, param);
+}
+
+Common::SemaphoreInternal *OSystem_Android::createSemaphore() {
+	return createPthreadSemaphoreInternal();
+}
+
+uint OSystem_Android::getCpuCount() {
+	return getPthreadCpuCount();
+}
+
+uintptr OSystem_Android::getCurrentThreadId() {
+	return getPthreadCurrentThreadId();
+}
+
 void OSystem_Android::quit() {
 	ENTER();
 
@@ -28,6 +28,7 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/mutex.h"
+#include "common/thread.h"
 #include "common/ustr.h"
 #include "audio/mixer_intern.h"
 #include "backends/modular-backend.h"
@@ -205,6 +206,10 @@ public:
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param) override;
+	Common::SemaphoreInternal *createSemaphore() override;
+	uint getCpuCount() override;
+	uintptr getCurrentThreadId() override;
 
 	void quit() override;
 
@@ -50,6 +50,7 @@
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
 #include "backends/fs/chroot/chroot-fs-factory.h"
 #include "backends/fs/posix/posix-fs.h"
 #include "audio/mixer.h"
@@ -157,6 +158,7 @@ bool OSystem_iOS7::hasFeature(Feature f) {
 	case kFeatureKbdMouseSpeed:
 	case kFeatureOpenGLForGame:
 	case kFeatureShadersForGame:
+	case kFeatureThreads:
 		return true;
 
 	default:
@@ -377,6 +379,22 @@ Common::MutexInternal *OSystem_iOS7::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_iOS7::createThread(Common::ThreadProc proc, void *param) {
+	return createPthreadThreadInternal(proc, param);
+}
+
+Common::SemaphoreInternal *OSystem_iOS7::createSemaphore() {
+	return createPthreadSemaphoreInternal();
+}
+
+uint OSystem_iOS7::getCpuCount() {
+	return getPthreadCpuCount();
+}
+
+uintptr OSystem_iOS7::getCurrentThreadId() {
+	return getPthreadCurrentThreadId();
+}
+
 void OSystem_iOS7::quit() {
 }
 
@@ -28,6 +28,7 @@
 #include "backends/keymapper/hardware-input.h"
 #include "common/events.h"
 #include "common/str.h"
+#include "common/thread.h"
 #include "common/ustr.h"
 #include "audio/mixer_intern.h"
 #include "backends/fs/posix/posix-fs-factory.h"
@@ -120,6 +121,10 @@ public:
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param) override;
+	Common::SemaphoreInternal *createSemaphore() override;
+	uint getCpuCount() override;
+	uintptr getCurrentThreadId() override;
 
 	static void mixCallback(void *sys, byte *samples, int len);
 	virtual void setupMixer(void);
@@ -49,6 +49,10 @@ typedef void (*sighandler_t)(int);
 #if defined(USE_NULL_DRIVER)
 #include "backends/modular-backend.h"
 #include "backends/mutex/null/null-mutex.h"
+#ifdef POSIX
+#include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
+#endif
 #include "base/main.h"
 
 #ifndef NULL_DRIVER_USE_FOR_TEST
@@ -82,9 +86,17 @@ public:
 
 	virtual void initBackend();
 
+	virtual bool hasFeature(Feature f);
+
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual Common::MutexInternal *createMutex();
+#ifdef POSIX
+	virtual Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param);
+	virtual Common::SemaphoreInternal *createSemaphore();
+	virtual uint getCpuCount();
+	virtual uintptr getCurrentThreadId();
+#endif
 	virtual uint32 getMillis(bool skipRecord = false);
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
@@ -157,6 +169,25 @@ void OSystem_NULL::initBackend() {
 	BaseBackend::initBackend();
 }
 
+bool OSystem_NULL::hasFeature(Feature f) {
+	// There is no platform layer to query the CPU with, so rely on the
+	// compiler builtins where available, and otherwise only report the
+	// instruction sets the compiler was allowed to use everywhere.
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	if (f == kFeatureCpuSSE2) return __builtin_cpu_supports("sse2");
+	if (f == kFeatureCpuAVX2) return __builtin_cpu_supports("avx2");
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	if (f == kFeatureCpuNEON) return true;
+#endif
+#ifdef POSIX
+	if (f == kFeatureThreads) return true;
+#endif
+	if (!_graphicsManager)
+		return false;
+	return ModularGraphicsBackend::hasFeature(f);
+}
+
 bool OSystem_NULL::pollEvent(Common::Event &event) {
 #ifndef NULL_DRIVER_USE_FOR_TEST
 	((DefaultTimerManager *)getTimerManager())->checkTimers();
@@ -185,9 +216,37 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 Common::MutexInternal *OSystem_NULL::createMutex() {
+#ifdef POSIX
+	return createPthreadMutexInternal();
+#else
 	return new NullMutexInternal();
+#endif
+}
+
+#ifdef POSIX
+Common::ThreadInternal *OSystem_NULL::createThread(Common::ThreadProc proc, void *param) {
+	return createPthreadThreadInternal(proc, param);
 }
 
+Common::SemaphoreInternal *OSystem_NULL::createSemaphore() {
+	return createPthreadSemaphoreInternal();
+}
+
+uint OSystem_NULL::getCpuCount() {
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	// Run the tests on several workers even on a single core, so that the
+	// job system and the code using it are tested with real concurrency
+	return MAX<uint>(getPthreadCpuCount(), 4);
+#else
+	return getPthreadCpuCount();
+#endif
+}
+
+uintptr OSystem_NULL::getCurrentThreadId() {
+	return getPthreadCurrentThreadId();
+}
+#endif
+
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #ifdef POSIX
 	timeval curTime;
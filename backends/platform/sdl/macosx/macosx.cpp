@@ -261,6 +261,20 @@ Common::String OSystem_MacOSX::getDefaultIconsPath() {
 	return defaultIconsPath;
 }
 
+Common::String OSystem_MacOSX::getDefaultCachePath() {
+	const char *prefix = getenv("HOME");
+	if (prefix == nullptr) {
+		return Common::String();
+	}
+
+	const Common::String cachePath = "Library/Caches/" + getMacBundleName();
+	if (!Posix::assureDirectoryExists(cachePath, prefix)) {
+		return Common::String();
+	}
+
+	return Common::String(prefix) + "/" + cachePath;
+}
+
 Common::String OSystem_MacOSX::getScreenshotsPath() {
 	// If the user has configured a screenshots path, use it
 	const Common::String path = OSystem_SDL::getScreenshotsPath();
@@ -44,6 +44,7 @@
 #include "backends/events/sdl/legacy-sdl-events.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threads/sdl/sdl-threads.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -182,6 +183,16 @@ bool OSystem_SDL::hasFeature(Feature f) {
 	if (f == kFeatureJoystickDeadzone || f == kFeatureKbdMouseSpeed) {
 		return _eventSource->isJoystickConnected();
 	}
+	if (f == kFeatureThreads) return true;
+#if defined(SCUMMVM_SSE2)
+	if (f == kFeatureCpuSSE2) return SDL_HasSSE2();
+#endif
+#if defined(SCUMMVM_AVX2) && SDL_VERSION_ATLEAST(2, 0, 4)
+	if (f == kFeatureCpuAVX2) return SDL_HasAVX2();
+#endif
+#if defined(SCUMMVM_NEON) && SDL_VERSION_ATLEAST(2, 0, 6)
+	if (f == kFeatureCpuNEON) return SDL_HasNEON();
+#endif
 #if defined(USE_OPENGL_GAME) || defined(USE_OPENGL_SHADERS)
 	/* Even if we are using the 2D graphics manager,
 	 * we are at one initGraphics3d call of supporting OpenGL */
@@ -694,6 +705,22 @@ Common::MutexInternal *OSystem_SDL::createMutex() {
 	return createSdlMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_SDL::createThread(Common::ThreadProc proc, void *param) {
+	return createSdlThreadInternal(proc, param);
+}
+
+Common::SemaphoreInternal *OSystem_SDL::createSemaphore() {
+	return createSdlSemaphoreInternal();
+}
+
+uint OSystem_SDL::getCpuCount() {
+	return getSdlCpuCount();
+}
+
+uintptr OSystem_SDL::getCurrentThreadId() {
+	return getSdlCurrentThreadId();
+}
+
 uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	uint32 millis = SDL_GetTicks();
 
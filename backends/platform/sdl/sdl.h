@@ -31,6 +31,7 @@
 #include "backends/platform/sdl/sdl-window.h"
 
 #include "common/array.h"
+#include "common/thread.h"
 
 #ifdef USE_DISCORD
 class DiscordPresence;
@@ -83,6 +84,10 @@ public:
 	void setWindowCaption(const Common::U32String &caption) override;
 	void addSysArchivesToSearchSet(Common::SearchSet &s, int priority = 0) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(Common::ThreadProc proc, void *param) override;
+	Common::SemaphoreInternal *createSemaphore() override;
+	uint getCpuCount() override;
+	uintptr getCurrentThreadId() override;
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	void getTimeAndDate(TimeDate &td, bool skipRecord = false) const override;
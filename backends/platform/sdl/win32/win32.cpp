@@ -274,6 +274,24 @@ Common::String OSystem_Win32::getDefaultIconsPath() {
 	return Win32::tcharToString(iconsPath);
 }
 
+Common::String OSystem_Win32::getDefaultCachePath() {
+	TCHAR cachePath[MAX_PATH];
+
+	if (_isPortable) {
+		Win32::getProcessDirectory(cachePath, MAX_PATH);
+		_tcscat(cachePath, TEXT("\\Cache\\"));
+	} else {
+		// Use the Application Data directory of the user profile
+		if (!Win32::getApplicationDataDirectory(cachePath)) {
+			return Common::String();
+		}
+		_tcscat(cachePath, TEXT("\\Cache\\"));
+	}
+	CreateDirectory(cachePath, nullptr);
+
+	return Win32::tcharToString(cachePath);
+}
+
 Common::String OSystem_Win32::getScreenshotsPath() {
 	// If the user has configured a screenshots path, use it
 	Common::String screenshotsPath = ConfMan.get("screenshotpath");
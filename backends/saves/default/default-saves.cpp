@@ -32,6 +32,7 @@
 #include "backends/saves/default/default-saves.h"
 
 #include "common/savefile.h"
+#include "common/saveindex.h"
 #include "common/util.h"
 #include "common/fs.h"
 #include "common/archive.h"
@@ -51,6 +52,10 @@ DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSave
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	clearSaveIndexes();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -142,6 +147,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		}
 	}
 
+	invalidateSaveIndex(filename);
+
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	// Update file's timestamp
 	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
@@ -165,7 +172,16 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	Common::WriteStream *stream = sf;
+	if (compress) {
+		// Chunked saves can be seeked in without decompressing all of them,
+		// and are still regular gzip files.
+		if (ConfMan.getBool("seekable_saves"))
+			stream = Common::wrapChunkedCompressedWriteStream(sf);
+		else
+			stream = Common::wrapCompressedWriteStream(sf);
+	}
+	Common::OutSaveFile *const result = new Common::OutSaveFile(stream);
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -179,6 +195,8 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	if (getError().getCode() != Common::kNoError)
 		return false;
 
+	invalidateSaveIndex(filename);
+
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	// Update file's timestamp
 	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
@@ -232,6 +250,74 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+bool DefaultSaveFileManager::getSavefileInfo(const Common::String &filename, int64 &size, int64 &modificationTime) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return false;
+
+	return file->_value.getFileInfo(size, modificationTime);
+}
+
+Common::SaveIndex *DefaultSaveFileManager::getSaveIndex(const Common::String &target) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return nullptr;
+
+	// Indexes of another directory are of no use anymore.
+	if (_saveIndexDirectory != _cachedDirectory) {
+		clearSaveIndexes();
+		_saveIndexDirectory = _cachedDirectory;
+	}
+
+	Common::SaveIndex *index;
+	SaveIndexMap::const_iterator i = _saveIndexes.find(target);
+	if (i != _saveIndexes.end()) {
+		index = i->_value;
+	} else {
+		index = new Common::SaveIndex(this, target);
+		index->load();
+		_saveIndexes[target] = index;
+	}
+
+	// The files CloudManager is downloading are about to be replaced.
+	bool changed = false;
+	for (Common::StringArray::const_iterator f = _lockedFiles.begin(), end = _lockedFiles.end(); f != end; ++f)
+		changed = index->remove(*f) || changed;
+	if (changed)
+		index->flush();
+
+	return index;
+}
+
+void DefaultSaveFileManager::invalidateSaveIndex(const Common::String &filename) {
+	if (Common::SaveIndex::isIndexName(filename))
+		return;
+
+	const Common::String target = Common::SaveIndex::getTarget(filename);
+	if (target.empty())
+		return;
+
+	// Avoid creating an index for targets which do not have one.
+	if (!_saveIndexes.contains(target) && !_saveFileCache.contains(Common::SaveIndex::getIndexName(target)))
+		return;
+
+	Common::SaveIndex *index = getSaveIndex(target);
+	if (index && index->remove(filename))
+		index->flush();
+}
+
+void DefaultSaveFileManager::clearSaveIndexes() {
+	for (SaveIndexMap::iterator i = _saveIndexes.begin(); i != _saveIndexes.end(); ++i)
+		delete i->_value;
+	_saveIndexes.clear();
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
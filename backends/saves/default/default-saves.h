@@ -35,6 +35,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -43,6 +44,8 @@ public:
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool getSavefileInfo(const Common::String &filename, int64 &size, int64 &modificationTime) override;
+	Common::SaveIndex *getSaveIndex(const Common::String &target) override;
 
 #ifdef USE_LIBCURL
 
@@ -82,6 +85,18 @@ protected:
 	 */
 	void assureCached(const Common::String &savePathName);
 
+	/**
+	 * Drop the entry of a savefile from the index of its target, because the
+	 * savefile is about to change.
+	 */
+	void invalidateSaveIndex(const Common::String &filename);
+
+	/**
+	 * Forget all the save indexes. Their changes which were not flushed yet
+	 * are lost, so these should only be new entries.
+	 */
+	void clearSaveIndexes();
+
 	typedef Common::HashMap<Common::String, Common::FSNode, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileCache;
 
 	/**
@@ -99,6 +114,18 @@ protected:
 	 */
 	Common::StringArray _lockedFiles;
 
+	typedef Common::HashMap<Common::String, Common::SaveIndex *> SaveIndexMap;
+
+	/**
+	 * The save indexes loaded from the currently cached directory.
+	 */
+	SaveIndexMap _saveIndexes;
+
+	/**
+	 * The directory the save indexes were loaded from.
+	 */
+	Common::String _saveIndexDirectory;
+
 private:
 	/**
 	 * The currently cached directory.
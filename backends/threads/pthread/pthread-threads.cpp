@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
+#include "common/scummsys.h"
+
+#if defined(POSIX) || defined(__ANDROID__) || defined(IPHONE)
+
+#include "backends/threads/pthread/pthread-threads.h"
+
+#include "common/textconsole.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+class PthreadThreadInternal final : public Common::ThreadInternal {
+public:
+	PthreadThreadInternal(Common::ThreadProc proc, void *param) : _proc(proc), _param(param), _joinable(false) {}
+	~PthreadThreadInternal() override { join(); }
+
+	bool start() {
+		_joinable = (pthread_create(&_thread, nullptr, run, this) == 0);
+		return _joinable;
+	}
+
+	void join() override {
+		if (_joinable) {
+			if (pthread_join(_thread, nullptr) != 0)
+				warning("pthread_join() failed");
+			_joinable = false;
+		}
+	}
+
+private:
+	static void *run(void *data) {
+		PthreadThreadInternal *thread = (PthreadThreadInternal *)data;
+		thread->_proc(thread->_param);
+		return nullptr;
+	}
+
+	pthread_t _thread;
+	Common::ThreadProc _proc;
+	void *_param;
+	bool _joinable;
+};
+
+/**
+ * Unnamed POSIX semaphores are not available on iOS, so this is built from
+ * a mutex and a condition variable instead.
+ */
+class PthreadSemaphoreInternal final : public Common::SemaphoreInternal {
+public:
+	PthreadSemaphoreInternal() : _count(0) {
+		pthread_mutex_init(&_mutex, nullptr);
+		pthread_cond_init(&_cond, nullptr);
+	}
+
+	~PthreadSemaphoreInternal() override {
+		pthread_cond_destroy(&_cond);
+		pthread_mutex_destroy(&_mutex);
+	}
+
+	void wait() override {
+		pthread_mutex_lock(&_mutex);
+		while (_count == 0)
+			pthread_cond_wait(&_cond, &_mutex);
+		--_count;
+		pthread_mutex_unlock(&_mutex);
+	}
+
+	void post() override {
+		pthread_mutex_lock(&_mutex);
+		++_count;
+		pthread_cond_signal(&_cond);
+		pthread_mutex_unlock(&_mutex);
+	}
+
+private:
+	pthread_mutex_t _mutex;
+	pthread_cond_t _cond;
+	uint _count;
+};
+
+Common::ThreadInternal *createPthreadThreadInternal(Common::ThreadProc proc, void *param) {
+	PthreadThreadInternal *thread = new PthreadThreadInternal(proc, param);
+	if (!thread->start()) {
+		warning("pthread_create() failed");
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::SemaphoreInternal *createPthreadSemaphoreInternal() {
+	return new PthreadSemaphoreInternal();
+}
+
+uint getPthreadCpuCount() {
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 1 ? (uint)count : 1;
+}
+
+uintptr getPthreadCurrentThreadId() {
+	return (uintptr)pthread_self();
+}
+
+#endif
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threads/sdl/sdl-threads.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+
+class SdlThreadInternal final : public Common::ThreadInternal {
+public:
+	SdlThreadInternal(Common::ThreadProc proc, void *param) : _proc(proc), _param(param) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		_thread = SDL_CreateThread(run, "ScummVM worker", this);
+#else
+		_thread = SDL_CreateThread(run, this);
+#endif
+	}
+
+	~SdlThreadInternal() override { join(); }
+
+	bool isValid() const { return _thread != nullptr; }
+
+	void join() override {
+		if (_thread) {
+			SDL_WaitThread(_thread, nullptr);
+			_thread = nullptr;
+		}
+	}
+
+private:
+	static int SDLCALL run(void *data) {
+		SdlThreadInternal *thread = (SdlThreadInternal *)data;
+		thread->_proc(thread->_param);
+		return 0;
+	}
+
+	SDL_Thread *_thread;
+	Common::ThreadProc _proc;
+	void *_param;
+};
+
+class SdlSemaphoreInternal final : public Common::SemaphoreInternal {
+public:
+	SdlSemaphoreInternal() { _sem = SDL_CreateSemaphore(0); }
+	~SdlSemaphoreInternal() override { SDL_DestroySemaphore(_sem); }
+
+	bool isValid() const { return _sem != nullptr; }
+
+	void wait() override { SDL_SemWait(_sem); }
+	void post() override { SDL_SemPost(_sem); }
+
+private:
+	SDL_sem *_sem;
+};
+
+Common::ThreadInternal *createSdlThreadInternal(Common::ThreadProc proc, void *param) {
+	SdlThreadInternal *thread = new SdlThreadInternal(proc, param);
+	if (!thread->isValid()) {
+		warning("SDL_CreateThread() failed: %s", SDL_GetError());
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::SemaphoreInternal *createSdlSemaphoreInternal() {
+	SdlSemaphoreInternal *sem = new SdlSemaphoreInternal();
+	if (!sem->isValid()) {
+		warning("SDL_CreateSemaphore() failed: %s", SDL_GetError());
+		delete sem;
+		return nullptr;
+	}
+	return sem;
+}
+
+uint getSdlCpuCount() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	return MAX(SDL_GetCPUCount(), 1);
+#else
+	return 1;
+#endif
+}
+
+uintptr getSdlCurrentThreadId() {
+	return SDL_ThreadID();
+}
+
+#endif
@@ -189,6 +189,8 @@ static const char HELP_STRING4[] =
 	"  --aspect-ratio           Enable aspect ratio correction\n"
 	"  --[no-]dirtyrects        Enable dirty rectangles optimisation in software renderer\n"
 	"                           (default: enabled)\n"
+	"  --tinygl-threads=NUM     Rasterize on NUM threads in software renderer\n"
+	"                           (0 = one per CPU core, default: 1)\n"
 	"  --render-mode=MODE       Enable additional render modes (hercGreen, hercAmber,\n"
 	"                           cga, ega, vga, amiga, fmtowns, pc9821, pc9801, 2gs,\n"
 	"                           atari, macintosh, macintoshbw)\n"
@@ -298,9 +300,12 @@ void registerDefaults() {
 	ConfMan.registerDefault("stretch_mode", "default");
 	ConfMan.registerDefault("scaler", "default");
 	ConfMan.registerDefault("scale_factor", -1);
+	ConfMan.registerDefault("scaler_threads", false);
 	ConfMan.registerDefault("shader", "default");
 	ConfMan.registerDefault("show_fps", false);
+	ConfMan.registerDefault("show_upload_stats", false);
 	ConfMan.registerDefault("dirtyrects", true);
+	ConfMan.registerDefault("tinygl_threads", 1);
 	ConfMan.registerDefault("vsync", true);
 
 	// Sound & Music
@@ -336,6 +341,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("boot_param", 0);
 	ConfMan.registerDefault("dump_scripts", false);
 	ConfMan.registerDefault("save_slot", -1);
+	ConfMan.registerDefault("seekable_saves", false);
 	ConfMan.registerDefault("autosave_period", 5 * 60); // By default, trigger autosave every 5 minutes
 	ConfMan.registerDefault("engine_speed", 60); // FPS limit for 3D games
 
@@ -371,6 +377,7 @@ void registerDefaults() {
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
+	ConfMan.registerDefault("gui_show_frame_times", false);
 
 	ConfMan.registerDefault("gui_browser_show_hidden", false);
 	ConfMan.registerDefault("gui_browser_native", true);
@@ -846,6 +853,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("dirtyrects")
 			END_OPTION
 
+			DO_LONG_OPTION_INT("tinygl-threads")
+			END_OPTION
+
 			DO_LONG_OPTION("gamma")
 			END_OPTION
 
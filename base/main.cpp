@@ -30,6 +30,7 @@
 // FIXME: Avoid using printf
 #define FORBIDDEN_SYMBOL_EXCEPTION_printf
 
+#include "engines/advancedDetector.h"
 #include "engines/engine.h"
 #include "engines/metaengine.h"
 #include "base/commandLine.h"
@@ -43,6 +44,7 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/jobs.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
@@ -848,6 +850,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	Cloud::CloudManager::destroy();
 #endif
 #endif
+	// Stop the worker threads before unloading the code their jobs may run
+	Common::JobSystem::destroy();
 	PluginManager::instance().unloadDetectionPlugin();
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
@@ -869,6 +873,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	Graphics::shutdownTTF();
 #endif
 	EngineManager::destroy();
+	MD5CacheManager::destroy();
 	Graphics::YUVToRGBManager::destroy();
 
 	return 0;
@@ -741,6 +741,9 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 		}
 	}
 
+	// Keep the MD5s computed so far, should ScummVM not exit cleanly
+	MD5Man.flushPersistentCache(false);
+
 	return DetectionResults(candidates);
 }
 
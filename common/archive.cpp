@@ -184,6 +184,34 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	invalidateIndex();
+}
+
+void SearchSet::invalidateIndex() {
+	_index.clear();
+	_indexValid = false;
+}
+
+uint SearchSet::findInIndex(const Path &path) const {
+	if (!_indexValid) {
+		Array<Path> paths;
+		uint pos = 0;
+		for (ArchiveNodeList::const_iterator it = _list.begin(); it != _list.end(); ++it, ++pos) {
+			paths.clear();
+			it->_indexed = it->_arc->listMemberPaths(paths);
+			if (!it->_indexed)
+				continue;
+
+			for (Array<Path>::const_iterator p = paths.begin(); p != paths.end(); ++p) {
+				if (!_index.contains(*p))
+					_index[*p] = pos;
+			}
+		}
+		_indexValid = true;
+	}
+
+	PathIndex::const_iterator entry = _index.find(path);
+	return entry != _index.end() ? entry->_value : 0xFFFFFFFF;
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -265,6 +293,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateIndex();
 	}
 }
 
@@ -288,6 +317,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateIndex();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -310,8 +340,14 @@ bool SearchSet::hasFile(const Path &path) const {
 	if (path.empty())
 		return false;
 
+	// Indexed archives before the first one listing the file don't have it
+	const uint first = findInIndex(path);
+	uint pos = 0;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
+	for (; it != _list.end(); ++it, ++pos) {
+		if (it->_indexed && pos < first)
+			continue;
 		if (it->_arc->hasFile(path))
 			return true;
 	}
@@ -343,8 +379,13 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
 	if (path.empty())
 		return ArchiveMemberPtr();
 
+	const uint first = findInIndex(path);
+	uint pos = 0;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
+	for (; it != _list.end(); ++it, ++pos) {
+		if (it->_indexed && pos < first)
+			continue;
 		if (it->_arc->hasFile(path))
 			return it->_arc->getMember(path);
 	}
@@ -356,8 +397,13 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	const uint first = findInIndex(path);
+	uint pos = 0;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
+	for (; it != _list.end(); ++it, ++pos) {
+		if (it->_indexed && pos < first)
+			continue;
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(path);
 		if (stream)
 			return stream;
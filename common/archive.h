@@ -22,6 +22,7 @@
 #ifndef COMMON_ARCHIVE_H
 #define COMMON_ARCHIVE_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/list.h"
 #include "common/path.h"
@@ -130,6 +131,18 @@ public:
 	 */
 	virtual int listMembers(ArchiveMemberList &list) const = 0;
 
+	/**
+	 * Add the paths of all files in the archive to the list, the way
+	 * hasFile() matches them, if the archive can tell them up front.
+	 *
+	 * SearchSet uses this to find the archive containing a file without
+	 * asking each archive in turn. Archives which return false are always
+	 * asked.
+	 *
+	 * @return true if the list now holds all files of the archive.
+	 */
+	virtual bool listMemberPaths(Array<Path> &list) const { return false; }
+
 	/**
 	 * Return an ArchiveMember representation of the given file.
 	 */
@@ -247,13 +260,30 @@ class SearchSet : public Archive {
 		String	_name;
 		Archive	*_arc;
 		bool	_autoFree;
+		mutable bool _indexed; //!< Whether the files of the archive are in _index.
 		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree), _indexed(false) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
 	ArchiveNodeList _list;
 
+	/**
+	 * Position in _list of the first archive listing each file, for the
+	 * archives which can list their files. Built on first use, and dropped
+	 * whenever the list changes.
+	 */
+	typedef HashMap<Path, uint, Path::IgnoreCaseAndMac_Hash, Path::IgnoreCaseAndMac_EqualsTo> PathIndex;
+	mutable PathIndex _index;
+	mutable bool _indexValid;
+
+	/**
+	 * Return the position of the first indexed archive which has @p path.
+	 * Indexed archives before it can be skipped when looking for the file.
+	 */
+	uint findInIndex(const Path &path) const;
+	void invalidateIndex();
+
 	ArchiveNodeList::iterator find(const String &name);
 	ArchiveNodeList::const_iterator find(const String &name) const;
 
@@ -262,7 +292,7 @@ class SearchSet : public Archive {
 	bool _ignoreClashes;
 
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _indexValid(false), _ignoreClashes(false) { }
 	virtual ~SearchSet() { clear(); }
 
 	/**
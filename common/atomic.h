@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+#if !defined(__GNUC__)
+#include <atomic>
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_atomic Atomic variables
+ * @ingroup common
+ *
+ * @brief Integer and pointer variables which can be shared between threads
+ *        without holding a Mutex.
+ * @{
+ */
+
+/**
+ * An integer or pointer which is read and modified atomically.
+ *
+ * Loads have acquire semantics and stores have release semantics, so a
+ * thread that loads a value stored by another thread also sees everything
+ * that thread wrote before the store. The read-modify-write operations are
+ * sequentially consistent.
+ *
+ * Only use this with types no larger than a pointer: wider types are not
+ * lock-free on all the platforms we support.
+ */
+template<typename T>
+class Atomic : NonCopyable {
+public:
+	Atomic() : _value() {}
+	explicit Atomic(T value) : _value(value) {}
+
+#if defined(__GNUC__)
+	T load() const { return __atomic_load_n(&_value, __ATOMIC_ACQUIRE); }
+	void store(T value) { __atomic_store_n(&_value, value, __ATOMIC_RELEASE); }
+
+	/** Load the value without ordering any other memory accesses around it. */
+	T loadRelaxed() const { return __atomic_load_n(&_value, __ATOMIC_RELAXED); }
+	/** Store the value without ordering any other memory accesses around it. */
+	void storeRelaxed(T value) { __atomic_store_n(&_value, value, __ATOMIC_RELAXED); }
+
+	T exchange(T value) { return __atomic_exchange_n(&_value, value, __ATOMIC_SEQ_CST); }
+
+	/**
+	 * Replace the value with @p desired if it is equal to @p expected.
+	 * Otherwise, @p expected receives the current value.
+	 *
+	 * @return Whether the value was replaced.
+	 */
+	bool compareExchange(T &expected, T desired) {
+		return __atomic_compare_exchange_n(&_value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	}
+
+	/** Add @p value and return the previous value. */
+	T fetchAdd(T value) { return __atomic_fetch_add(&_value, value, __ATOMIC_SEQ_CST); }
+	/** Subtract @p value and return the previous value. */
+	T fetchSub(T value) { return __atomic_fetch_sub(&_value, value, __ATOMIC_SEQ_CST); }
+
+private:
+	T _value;
+#else
+	T load() const { return _value.load(std::memory_order_acquire); }
+	void store(T value) { _value.store(value, std::memory_order_release); }
+
+	T loadRelaxed() const { return _value.load(std::memory_order_relaxed); }
+	void storeRelaxed(T value) { _value.store(value, std::memory_order_relaxed); }
+
+	T exchange(T value) { return _value.exchange(value); }
+	bool compareExchange(T &expected, T desired) { return _value.compare_exchange_strong(expected, desired); }
+
+	T fetchAdd(T value) { return _value.fetch_add(value); }
+	T fetchSub(T value) { return _value.fetch_sub(value); }
+
+private:
+	std::atomic<T> _value;
+#endif
+};
+
+/**
+ * Prevent memory accesses before the fence and memory accesses after it
+ * from being reordered against each other, as seen by any other thread.
+ */
+inline void atomicThreadFence() {
+#if defined(__GNUC__)
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
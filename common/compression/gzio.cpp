@@ -927,8 +927,9 @@ GzioReadStream::get_new_block()
 void
 GzioReadStream::inflate_window ()
 {
-  /* initialize window */
-  _wp = 0;
+  /* initialize window, which is partly there after restoring a checkpoint */
+  _wp = _resumeWp;
+  _resumeWp = 0;
 
   /*
    *  Main decompression loop.
@@ -941,6 +942,7 @@ GzioReadStream::inflate_window ()
 	  if (_lastBlock)
 	    break;
 
+	  save_checkpoint ();
 	  get_new_block ();
 	}
 
@@ -993,6 +995,7 @@ void
 GzioReadStream::initialize_tables()
 {
   _savedOffset = 0;
+  _resumeWp = 0;
   parentSeek (_dataOffset);
 
   /* Initialize the bit buffer.  */
@@ -1011,6 +1014,79 @@ GzioReadStream::initialize_tables()
 }
 
 
+GzioIndex::~GzioIndex()
+{
+  for (uint i = 0; i < _checkpoints.size(); i++)
+    delete[] _checkpoints[i].slide;
+}
+
+const GzioIndex::Checkpoint *
+GzioIndex::find (uint64 offset) const
+{
+  /* Binary search for the last checkpoint at or before offset.  */
+  uint lo = 0, hi = _checkpoints.size();
+  while (lo < hi)
+    {
+      uint mid = (lo + hi) / 2;
+      if (_checkpoints[mid].offset <= offset)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  return lo ? &_checkpoints[lo - 1] : nullptr;
+}
+
+/*
+ *  Save the state between two blocks, when far enough from the last
+ *  checkpoint.  Nothing is needed from the previous block but the
+ *  sliding window, which holds the last WSIZE bytes of output.
+ */
+void
+GzioReadStream::save_checkpoint ()
+{
+  if (!_index)
+    return;
+
+  uint64 offset = _savedOffset + _wp;
+  uint64 last = _index->_checkpoints.empty () ? 0 : _index->_checkpoints.back ().offset;
+  if (offset < last + _index->_span)
+    return;
+
+  GzioIndex::Checkpoint checkpoint;
+  checkpoint.offset = offset;
+  checkpoint.inputPos = _input->pos () - (_inbufSize - _inbufD);
+  checkpoint.bb = _bb;
+  checkpoint.bk = _bk;
+  checkpoint.wp = _wp;
+  checkpoint.slide = new uint8[WSIZE];
+  memcpy (checkpoint.slide, _slide, WSIZE);
+  _index->_checkpoints.push_back (checkpoint);
+}
+
+void
+GzioReadStream::restore_checkpoint (const GzioIndex::Checkpoint &checkpoint)
+{
+  /* The window is aligned on WSIZE, and resumes where the checkpoint was.  */
+  _savedOffset = checkpoint.offset - checkpoint.wp;
+  _resumeWp = checkpoint.wp;
+  memcpy (_slide, checkpoint.slide, WSIZE);
+  parentSeek (checkpoint.inputPos);
+
+  _bb = checkpoint.bb;
+  _bk = checkpoint.bk;
+
+  /* We are between two blocks.  */
+  _lastBlock = 0;
+  _blockLen = 0;
+
+  huft_free (_tl);
+  huft_free (_td);
+  _tl = NULL;
+  _td = NULL;
+}
+
+
 static uint8
 mod_31 (uint16 v)
 {
@@ -1062,9 +1138,20 @@ GzioReadStream::readAtOffset (int64 offset, byte *buf, uint32 len)
 {
   int32 ret = 0;
 
-  /* Do we reset decompression to the beginning of the file?  */
+  /*
+   *  Do we reset decompression to the beginning of the file, or to the
+   *  nearest checkpoint?  Going far forward also skips to a checkpoint.
+   */
+  const GzioIndex::Checkpoint *checkpoint = _index ? _index->find (offset) : nullptr;
   if (_savedOffset > offset + WSIZE)
-    initialize_tables ();
+    {
+      if (checkpoint)
+	restore_checkpoint (*checkpoint);
+      else
+	initialize_tables ();
+    }
+  else if (checkpoint && (int64) checkpoint->offset > _savedOffset)
+    restore_checkpoint (*checkpoint);
 
   /*
    *  This loop operates upon uncompressed data only.  The only
@@ -1152,25 +1239,27 @@ bool GzioReadStream::seek(int64 offs, int whence) {
 	return true;
 }
 
-GzioReadStream* GzioReadStream::openDeflate(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent)
+GzioReadStream* GzioReadStream::openDeflate(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent, const SharedPtr<GzioIndex> &index)
 {
   GzioReadStream *gzio = new GzioReadStream(parent, disposeParent, uncompressed_size, GzioReadStream::Mode::ZLIB);
 
+  gzio->_index = index;
   gzio->initialize_tables ();
 
   return gzio;
 }
 
-GzioReadStream* GzioReadStream::openClickteam(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent)
+GzioReadStream* GzioReadStream::openClickteam(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent, const SharedPtr<GzioIndex> &index)
 {
   GzioReadStream *gzio = new GzioReadStream(parent, disposeParent, uncompressed_size, GzioReadStream::Mode::CLICKTEAM);
 
+  gzio->_index = index;
   gzio->initialize_tables ();
 
   return gzio;
 }
 
-GzioReadStream* GzioReadStream::openZlib(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent)
+GzioReadStream* GzioReadStream::openZlib(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent, const SharedPtr<GzioIndex> &index)
 {
   GzioReadStream* gzio = new GzioReadStream(parent, disposeParent, uncompressed_size, GzioReadStream::Mode::ZLIB);
 
@@ -1180,6 +1269,7 @@ GzioReadStream* GzioReadStream::openZlib(Common::SeekableReadStream *parent, uin
       return nullptr;
     }
 
+  gzio->_index = index;
   gzio->initialize_tables();
 
   return gzio;
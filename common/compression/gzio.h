@@ -35,18 +35,63 @@
  */
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/stream.h"
 #include "common/ptr.h"
 
 namespace Common {
 
+/**
+ * Snapshots of the inflate state, taken about every MB as a stream is
+ * decompressed, so that seeking restarts from the nearest snapshot instead of
+ * the start of the data. An index can be shared by all the streams over the
+ * same compressed data, but not across threads.
+ */
+class GzioIndex {
+public:
+	/** @param span  Minimum distance between two snapshots, in uncompressed bytes. */
+	GzioIndex(uint32 span = 1024 * 1024) : _span(span) {}
+	~GzioIndex();
+
+	uint size() const { return _checkpoints.size(); }
+
+private:
+	friend class GzioReadStream;
+
+	struct Checkpoint {
+		/* The position in the uncompressed data.  */
+		uint64 offset;
+		/* The position in the parent stream, after the bytes in the bit buffer.  */
+		int64 inputPos;
+		/* The bit buffer.  */
+		unsigned long bb;
+		/* The bits in the bit buffer.  */
+		unsigned bk;
+		/* The position in the slide.  */
+		unsigned wp;
+		/* The sliding window.  */
+		uint8 *slide;
+	};
+
+	/** Return the last checkpoint at or before @p offset, or nullptr. */
+	const Checkpoint *find(uint64 offset) const;
+
+	uint32 _span;
+	Array<Checkpoint> _checkpoints;
+};
+
 /* The state stored in filesystem-specific data.  */
 class GzioReadStream : public Common::SeekableReadStream
 {
 public:
-	static GzioReadStream* openClickteam(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent = DisposeAfterUse::NO);
-	static GzioReadStream* openDeflate(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent = DisposeAfterUse::NO);
-	static GzioReadStream* openZlib(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent = DisposeAfterUse::NO);
+	/**
+	 * Streams which are seeked around should be given an index, which
+	 * they fill as they decompress. Pass the same index to all the
+	 * streams opened on the same data.
+	 */
+	static GzioReadStream* openClickteam(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent = DisposeAfterUse::NO, const SharedPtr<GzioIndex> &index = SharedPtr<GzioIndex>());
+	static GzioReadStream* openDeflate(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent = DisposeAfterUse::NO, const SharedPtr<GzioIndex> &index = SharedPtr<GzioIndex>());
+	static GzioReadStream* openZlib(Common::SeekableReadStream *parent, uint64 uncompressed_size, DisposeAfterUse::Flag disposeParent = DisposeAfterUse::NO, const SharedPtr<GzioIndex> &index = SharedPtr<GzioIndex>());
 	static int32 clickteamDecompress (byte *outbuf, uint32 outsize, byte *inbuf, uint32 insize, int64 off = 0);
 	static int32 deflateDecompress (byte *outbuf, uint32 outsize, byte *inbuf, uint32 insize, int64 off = 0);
 	static int32 zlibDecompress (byte *outbuf, uint32 outsize, byte *inbuf, uint32 insize, int64 off = 0);
@@ -107,6 +152,10 @@ private:
 	int _bd;
 	/* The original offset value.  */
 	int64 _savedOffset;
+	/* The position in the slide at which the next window starts.  */
+	unsigned _resumeWp;
+	/* The snapshots of the state, if seeking is expected.  */
+	SharedPtr<GzioIndex> _index;
 
 	bool _err;
 
@@ -125,11 +174,13 @@ private:
 	  _lastBlock(0), _codeState (0), _inflateN(0),
 	  _inflateD(0), _bb(0), _bk(0), _wp(0), _tl(nullptr),
 	  _td(nullptr), _bl(0),
-	  _bd(0), _savedOffset(0), _err(false), _mode(mode), _input(parent, disposeParent),
+	  _bd(0), _savedOffset(0), _resumeWp(0), _err(false), _mode(mode), _input(parent, disposeParent),
 	  _inbufD(0), _inbufSize(0), _uncompressedSize(uncompressedSize), _streamPos(0), _eos(false) {}
 
 	void inflate_window();
 	void initialize_tables();
+	void save_checkpoint();
+	void restore_checkpoint(const GzioIndex::Checkpoint &checkpoint);
 	bool test_zlib_header();
 	void get_new_block();
 	byte parentGetByte();
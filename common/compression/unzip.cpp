@@ -219,10 +219,12 @@ int unzGetCurrentFileInfo(unzFile file,
    from it, and close it (you can close it before reading all the file)
    */
 
-Common::SharedArchiveContents unzOpenCurrentFile(unzFile file, const Common::CRC32& crc);
+Common::SharedArchiveContents unzOpenCurrentFile(unzFile file, const Common::CRC32& crc, Common::SharedPtr<Common::GzioIndex> *index = nullptr);
 /*
   Open for reading data the current file in the zipfile.
   If there is no error, the return value is UNZ_OK.
+  Large deflated files of archives in memory are decompressed as they are
+  read, and fill index, which is created if needed, to seek in them.
 */
 
 int unzCloseCurrentFile(unzFile file);
@@ -272,6 +274,11 @@ int unzGetLocalExtrafield(unzFile file, voidp buf, unsigned len);
 #define UNZ_MAXFILENAMEINZIP (256)
 #endif
 
+/* Deflated files from this size on are decompressed as they are read */
+#ifndef UNZ_STREAMED_SIZE
+#define UNZ_STREAMED_SIZE (4 * 1024 * 1024)
+#endif
+
 #define SIZECENTRALDIRITEM (0x2e)
 #define SIZEZIPLOCALHEADER (0x1e)
 
@@ -909,7 +916,7 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s *s, uInt *piSizeVar,
   Open for reading data the current file in the zipfile.
   If there is no error and the file is opened, the return value is UNZ_OK.
 */
-Common::SharedArchiveContents unzOpenCurrentFile (unzFile file, const Common::CRC32 &crc) {
+Common::SharedArchiveContents unzOpenCurrentFile (unzFile file, const Common::CRC32 &crc, Common::SharedPtr<Common::GzioIndex> *index) {
 	uInt iSizeVar;
 	unz_s *s;
 	uLong offset_local_extrafield;  /* offset of the local extra field */
@@ -932,6 +939,39 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file, const Common::CR
 
 	uint32 crc32_wait = s->cur_file_info.crc;
 
+	// Stored files of archives in memory, e.g. mapped ones, share that memory
+	if (s->cur_file_info.compression_method == 0 && s->_stream->getRawData()) {
+		s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+		Common::SeekableReadStream *member = s->_stream->readStream(s->cur_file_info.compressed_size);
+		if (member->size() != (int64)s->cur_file_info.uncompressed_size) {
+			delete member;
+			warning("Truncated file in zip archive");
+			return Common::SharedArchiveContents();
+		}
+
+		uint32 crc32_data = crc.crcFast(member->getRawData(), s->cur_file_info.uncompressed_size);
+		if (crc32_data != crc32_wait) {
+			delete member;
+			warning("CRC32 mismatch: %08x, %08x", crc32_data, crc32_wait);
+			return Common::SharedArchiveContents();
+		}
+
+		return Common::SharedArchiveContents::bypass(member);
+	}
+
+	// Large deflated files are rather decompressed on the fly, from a stream
+	// sharing the archive memory which doesn't depend on the archive. Their
+	// CRC can't be checked.
+	if (s->cur_file_info.compression_method == Z_DEFLATED && index &&
+	    s->cur_file_info.uncompressed_size >= UNZ_STREAMED_SIZE && s->_stream->getRawData()) {
+		s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+		Common::SeekableReadStream *member = s->_stream->readStream(s->cur_file_info.compressed_size);
+		if (!*index)
+			index->reset(new Common::GzioIndex());
+		return Common::SharedArchiveContents::bypass(Common::GzioReadStream::openDeflate(member,
+				s->cur_file_info.uncompressed_size, DisposeAfterUse::YES, *index));
+	}
+
 	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
 	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
 	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
@@ -972,6 +1012,8 @@ class ZipArchive : public MemcachingCaseInsensitiveArchive {
 	unzFile _zipFile;
 	Common::CRC32 _crc;
 	bool _flattenTree;
+	/* Indexes of the streamed files, to seek in them */
+	mutable HashMap<String, SharedPtr<GzioIndex>, IgnoreCase_Hash, IgnoreCase_EqualTo> _indexes;
 
 public:
 	ZipArchive(unzFile zipFile, bool flattenTree);
@@ -1044,7 +1086,7 @@ Common::SharedArchiveContents ZipArchive::readContentsForPath(const Common::Stri
 	if (unzLocateFile(_zipFile, name.c_str(), 2) != UNZ_OK)
 		return Common::SharedArchiveContents();
 
-	return unzOpenCurrentFile(_zipFile, _crc);
+	return unzOpenCurrentFile(_zipFile, _crc, &_indexes[name]);
 }
 
 Archive *makeZipArchive(const String &name, bool flattenTree) {
@@ -1052,7 +1094,7 @@ Archive *makeZipArchive(const String &name, bool flattenTree) {
 }
 
 Archive *makeZipArchive(const FSNode &node, bool flattenTree) {
-	return makeZipArchive(node.createReadStream(), flattenTree);
+	return makeZipArchive(node.createMappedReadStream(), flattenTree);
 }
 
 Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree) {
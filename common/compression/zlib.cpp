@@ -23,6 +23,10 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/compression/zlib.h"
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/jobs.h"
+#include "common/memstream.h"
 #include "common/ptr.h"
 #include "common/util.h"
 #include "common/stream.h"
@@ -227,10 +231,26 @@ static bool _shownBackwardSeekingWarning = false;
 class GZipReadStream : public SeekableReadStream {
 protected:
 	enum {
-		BUFSIZE = 16384		// 1 << MAX_WBITS
+		BUFSIZE = 16384,		// 1 << MAX_WBITS
+		WINDOWSIZE = 32768,
+		CHECKPOINT_SPAN = 1024 * 1024
+	};
+
+	/**
+	 * The state of the decompression between two deflate blocks, saved about
+	 * every MB, from which it restarts when seeking back or far forward.
+	 * This needs inflateGetDictionary(), added in zlib 1.2.7.1.
+	 */
+	struct Checkpoint {
+		uint32 out;		///< Position in the uncompressed data
+		int64 in;		///< Position in the wrapped stream
+		int bits;		///< Bits of the byte before 'in' which are not decoded yet
+		uint windowSize;
+		byte *window;	///< The last 32 KB of uncompressed data
 	};
 
 	byte	_buf[BUFSIZE];
+	Array<Checkpoint> _checkpoints;
 
 	ScopedPtr<SeekableReadStream> _wrapped;
 	z_stream _stream;
@@ -279,6 +299,69 @@ public:
 
 	~GZipReadStream() {
 		inflateEnd(&_stream);
+		for (uint i = 0; i < _checkpoints.size(); ++i)
+			delete[] _checkpoints[i].window;
+	}
+
+	void saveCheckpoint(uint32 out) {
+#if ZLIB_VERNUM >= 0x1271
+		// Only at the end of a block, and not after the last one
+		if (_zlibErr != Z_OK || !(_stream.data_type & 128) || (_stream.data_type & 64))
+			return;
+
+		const uint32 last = _checkpoints.empty() ? 0 : _checkpoints.back().out;
+		if (out < last + CHECKPOINT_SPAN)
+			return;
+
+		Checkpoint checkpoint;
+		checkpoint.out = out;
+		checkpoint.in = _wrapped->pos() - _stream.avail_in;
+		checkpoint.bits = _stream.data_type & 7;
+		checkpoint.window = new byte[WINDOWSIZE];
+		uInt windowSize = WINDOWSIZE;
+		if (inflateGetDictionary(&_stream, checkpoint.window, &windowSize) != Z_OK) {
+			delete[] checkpoint.window;
+			return;
+		}
+		checkpoint.windowSize = windowSize;
+		_checkpoints.push_back(checkpoint);
+#endif
+	}
+
+	const Checkpoint *findCheckpoint(uint32 pos) const {
+		uint lo = 0, hi = _checkpoints.size();
+		while (lo < hi) {
+			const uint mid = (lo + hi) / 2;
+			if (_checkpoints[mid].out <= pos)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo ? &_checkpoints[lo - 1] : nullptr;
+	}
+
+	bool restoreCheckpoint(const Checkpoint &checkpoint) {
+#if ZLIB_VERNUM >= 0x1271
+		// The data after a checkpoint is raw deflate data
+		_zlibErr = inflateReset2(&_stream, -MAX_WBITS);
+		if (_zlibErr != Z_OK)
+			return false;
+
+		_wrapped->seek(checkpoint.in - (checkpoint.bits ? 1 : 0), SEEK_SET);
+		if (checkpoint.bits) {
+			const byte partial = _wrapped->readByte();
+			_zlibErr = inflatePrime(&_stream, checkpoint.bits, partial >> (8 - checkpoint.bits));
+		}
+		if (_zlibErr == Z_OK)
+			_zlibErr = inflateSetDictionary(&_stream, checkpoint.window, checkpoint.windowSize);
+
+		_stream.next_in = _buf;
+		_stream.avail_in = 0;
+		_pos = checkpoint.out;
+		return _zlibErr == Z_OK;
+#else
+		return false;
+#endif
 	}
 
 	bool err() const override { return (_zlibErr != Z_OK) && (_zlibErr != Z_STREAM_END); }
@@ -298,7 +381,13 @@ public:
 				_stream.next_in = _buf;
 				_stream.avail_in = _wrapped->read(_buf, BUFSIZE);
 			}
+#if ZLIB_VERNUM >= 0x1271
+			// Stop at the end of each block, to save checkpoints
+			_zlibErr = inflate(&_stream, Z_BLOCK);
+			saveCheckpoint(_pos + dataSize - _stream.avail_out);
+#else
 			_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+#endif
 		}
 
 		// Update the position counter
@@ -338,10 +427,14 @@ public:
 
 		assert(newPos >= 0);
 
-		if ((uint32)newPos < _pos) {
-			// To search backward, we have to restart the whole decompression
-			// from the start of the file. A rather wasteful operation, best
-			// to avoid it. :/
+		const Checkpoint *checkpoint = findCheckpoint(newPos);
+		if (checkpoint && ((uint32)newPos < _pos || checkpoint->out > _pos)) {
+			if (!restoreCheckpoint(*checkpoint))
+				return false;
+		} else if ((uint32)newPos < _pos) {
+			// Without a checkpoint, to search backward, we have to restart the
+			// whole decompression from the start of the file. A rather
+			// wasteful operation, best to avoid it. :/
 
 #ifndef RELEASE_BUILD
 			if (!_shownBackwardSeekingWarning) {
@@ -355,7 +448,12 @@ public:
 
 			_pos = 0;
 			_wrapped->seek(0, SEEK_SET);
+#if ZLIB_VERNUM >= 0x1271
+			// Back to detecting the header, after restoring a checkpoint
+			_zlibErr = inflateReset2(&_stream, MAX_WBITS + 32);
+#else
 			_zlibErr = inflateReset(&_stream);
+#endif
 			if (_zlibErr != Z_OK)
 				return false; // FIXME: STREAM REWRITE
 			_stream.next_in = _buf;
@@ -487,6 +585,297 @@ public:
 	int64 pos() const override { return _pos; }
 };
 
+/**
+ * The chunked gzip format is a gzip stream whose deflate data is made of
+ * chunks which were compressed independently of each other. Every chunk but
+ * the last one ends with a full flush, so that the chunks can be decompressed
+ * on their own, and compressed in parallel. The whole is still a regular gzip
+ * stream, which GZipReadStream reads as well.
+ *
+ * The gzip trailer is followed by the offset of every chunk in the stream,
+ * and by a footer made of the size of the chunks, their number, a tag, and
+ * the uncompressed size again. The latter makes the stream end like a gzip
+ * stream, where GZipReadStream looks for the uncompressed size.
+ */
+enum {
+	kChunkedGZipChunkSize = 64 * 1024,
+	kChunkedGZipHeaderSize = 10,
+	kChunkedGZipTrailerSize = 8,
+	kChunkedGZipFooterSize = 16
+};
+
+static const uint32 kChunkedGZipTag = MKTAG('S','V','M','Z');
+
+/**
+ * A stream which reads the chunked gzip format. Seeking only needs the
+ * chunk at the new position to be decompressed.
+ */
+class ChunkedGZipReadStream : public SeekableReadStream {
+protected:
+	ScopedPtr<SeekableReadStream> _wrapped;
+	Array<uint32> _offsets;		///< Offset of every chunk, and of the trailer
+	uint32 _chunkSize;
+	uint32 _size;
+	uint32 _pos;
+	bool _eos;
+	bool _err;
+
+	Array<byte> _chunk;
+	Array<byte> _compressed;
+	int _loadedChunk;
+
+	ChunkedGZipReadStream(SeekableReadStream *w, uint32 chunkSize, uint32 size)
+		: _wrapped(w), _chunkSize(chunkSize), _size(size), _pos(0), _eos(false), _err(false), _loadedChunk(-1) {
+	}
+
+	bool loadChunk(int chunk) {
+		if (chunk == _loadedChunk)
+			return true;
+
+		const uint32 start = chunk * _chunkSize;
+		const uint32 chunkSize = MIN(_chunkSize, _size - start);
+		const uint32 compressedSize = _offsets[chunk + 1] - _offsets[chunk];
+
+		_compressed.resize(compressedSize);
+		if (!_wrapped->seek(_offsets[chunk], SEEK_SET) || _wrapped->read(_compressed.data(), compressedSize) != compressedSize)
+			return false;
+
+		_chunk.resize(chunkSize);
+		_loadedChunk = -1;
+
+		z_stream stream = {};
+		if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+			return false;
+		stream.next_in = _compressed.data();
+		stream.avail_in = compressedSize;
+		stream.next_out = _chunk.data();
+		stream.avail_out = chunkSize;
+		const int zlibErr = inflate(&stream, Z_SYNC_FLUSH);
+		inflateEnd(&stream);
+
+		if ((zlibErr != Z_OK && zlibErr != Z_STREAM_END) || stream.avail_out != 0)
+			return false;
+
+		_loadedChunk = chunk;
+		return true;
+	}
+
+public:
+	/**
+	 * Wrap a stream in the chunked gzip format.
+	 *
+	 * @return The new stream, or nullptr if the stream is in another format,
+	 *         in which case the caller keeps the stream.
+	 */
+	static ChunkedGZipReadStream *open(SeekableReadStream *w) {
+		const int64 fileSize = w->size();
+		if (fileSize < kChunkedGZipHeaderSize + kChunkedGZipTrailerSize + kChunkedGZipFooterSize || fileSize > 0xFFFFFFFF)
+			return nullptr;
+
+		w->seek(-kChunkedGZipFooterSize, SEEK_END);
+		const uint32 chunkSize = w->readUint32LE();
+		const uint32 numChunks = w->readUint32LE();
+		const uint32 tag = w->readUint32BE();
+		const uint32 size = w->readUint32LE();
+		w->seek(0, SEEK_SET);
+
+		if (tag != kChunkedGZipTag || chunkSize == 0 || numChunks != MAX<uint32>(1, (size + (uint64)chunkSize - 1) / chunkSize))
+			return nullptr;
+
+		const int64 indexPos = fileSize - kChunkedGZipFooterSize - (int64)numChunks * 4;
+		const uint32 trailerPos = indexPos - kChunkedGZipTrailerSize;
+		if (indexPos < kChunkedGZipHeaderSize + kChunkedGZipTrailerSize)
+			return nullptr;
+
+		Array<uint32> offsets(numChunks + 1);
+		w->seek(indexPos, SEEK_SET);
+		for (uint32 i = 0; i < numChunks; ++i)
+			offsets[i] = w->readUint32LE();
+		offsets[numChunks] = trailerPos;
+		w->seek(0, SEEK_SET);
+
+		if (w->err() || offsets[0] != kChunkedGZipHeaderSize)
+			return nullptr;
+		for (uint32 i = 0; i < numChunks; ++i) {
+			if (offsets[i] > offsets[i + 1])
+				return nullptr;
+		}
+
+		ChunkedGZipReadStream *stream = new ChunkedGZipReadStream(w, chunkSize, size);
+		stream->_offsets = offsets;
+		return stream;
+	}
+
+	bool err() const override { return _err || _wrapped->err(); }
+	void clearErr() override {
+		_err = false;
+		_eos = false;
+		_wrapped->clearErr();
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		byte *dst = (byte *)dataPtr;
+		uint32 total = 0;
+
+		while (total < dataSize) {
+			if (_pos >= _size) {
+				_eos = true;
+				break;
+			}
+
+			const int chunk = _pos / _chunkSize;
+			if (!loadChunk(chunk)) {
+				_err = true;
+				break;
+			}
+
+			const uint32 offset = _pos - chunk * _chunkSize;
+			const uint32 count = MIN<uint32>(dataSize - total, _chunk.size() - offset);
+			memcpy(dst + total, _chunk.data() + offset, count);
+			total += count;
+			_pos += count;
+		}
+
+		return total;
+	}
+
+	bool eos() const override { return _eos; }
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		int64 newPos;
+		switch (whence) {
+		case SEEK_END:
+			newPos = _size + offset;
+			break;
+		case SEEK_CUR:
+			newPos = _pos + offset;
+			break;
+		case SEEK_SET:
+		default:
+			newPos = offset;
+			break;
+		}
+
+		if (newPos < 0 || newPos > _size)
+			return false;
+
+		_pos = newPos;
+		_eos = false;
+		return true;
+	}
+};
+
+/**
+ * A stream which writes the chunked gzip format.
+ *
+ * The data is kept uncompressed until the stream is finalized, which allows
+ * seeking while saving, and then compressed in parallel.
+ */
+class ChunkedGZipWriteStream : public SeekableWriteStream {
+protected:
+	struct Chunk {
+		Array<byte> data;
+		bool ok;
+	};
+
+	ScopedPtr<WriteStream> _wrapped;
+	MemoryWriteStreamDynamic _data;
+	bool _finalized;
+	bool _err;
+
+	static void compressChunk(const byte *src, uint32 size, bool last, Chunk &chunk) {
+		chunk.ok = false;
+
+		z_stream stream = {};
+		if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			return;
+
+		// A full flush needs a few bytes more than deflateBound() counts
+		chunk.data.resize(deflateBound(&stream, size) + 16);
+		stream.next_in = const_cast<byte *>(src);
+		stream.avail_in = size;
+		stream.next_out = chunk.data.data();
+		stream.avail_out = chunk.data.size();
+
+		const int zlibErr = deflate(&stream, last ? Z_FINISH : Z_FULL_FLUSH);
+		chunk.ok = (last ? zlibErr == Z_STREAM_END : zlibErr == Z_OK) && stream.avail_in == 0 && stream.avail_out != 0;
+		chunk.data.resize(stream.total_out);
+		deflateEnd(&stream);
+	}
+
+	bool writeAll(const void *dataPtr, uint32 dataSize) {
+		return _wrapped->write(dataPtr, dataSize) == dataSize;
+	}
+
+public:
+	ChunkedGZipWriteStream(WriteStream *w) : _wrapped(w), _data(DisposeAfterUse::YES), _finalized(false), _err(false) {
+		assert(w != nullptr);
+	}
+
+	~ChunkedGZipWriteStream() {
+		finalize();
+	}
+
+	bool err() const override { return _err || _wrapped->err(); }
+	void clearErr() override { _wrapped->clearErr(); }
+
+	void finalize() override {
+		if (_finalized)
+			return;
+		_finalized = true;
+
+		const byte *data = _data.getData();
+		const uint32 size = _data.size();
+		const uint32 numChunks = MAX<uint32>(1, (size + kChunkedGZipChunkSize - 1) / kChunkedGZipChunkSize);
+
+		Array<Chunk> chunks(numChunks);
+		JobMan.parallelFor(0, numChunks, [&chunks, data, size, numChunks](int i) {
+			const uint32 start = i * kChunkedGZipChunkSize;
+			compressChunk(data + start, MIN<uint32>(kChunkedGZipChunkSize, size - start), (uint32)i == numChunks - 1, chunks[i]);
+		});
+
+		// The header zlib writes for gzip streams without a name nor a time
+		static const byte header[kChunkedGZipHeaderSize] = { 0x1F, 0x8B, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 3 };
+		_err = !writeAll(header, sizeof(header));
+
+		Array<uint32> offsets(numChunks);
+		uint32 offset = kChunkedGZipHeaderSize;
+		for (uint32 i = 0; i < numChunks && !_err; ++i) {
+			offsets[i] = offset;
+			offset += chunks[i].data.size();
+			_err = !chunks[i].ok || !writeAll(chunks[i].data.data(), chunks[i].data.size());
+		}
+
+		if (!_err) {
+			_wrapped->writeUint32LE(crc32(0, data, size));
+			_wrapped->writeUint32LE(size);
+
+			for (uint32 i = 0; i < numChunks; ++i)
+				_wrapped->writeUint32LE(offsets[i]);
+
+			_wrapped->writeUint32LE(kChunkedGZipChunkSize);
+			_wrapped->writeUint32LE(numChunks);
+			_wrapped->writeUint32BE(kChunkedGZipTag);
+			_wrapped->writeUint32LE(size);
+		}
+
+		// Finalize the wrapped savefile, too
+		_wrapped->finalize();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		if (_finalized)
+			return 0;
+		return _data.write(dataPtr, dataSize);
+	}
+
+	int64 pos() const override { return _data.pos(); }
+	int64 size() const override { return _data.size(); }
+	bool seek(int64 offset, int whence = SEEK_SET) override { return _data.seek(offset, whence); }
+};
+
 #endif	// USE_ZLIB
 
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize) {
@@ -502,6 +891,11 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 		toBeWrapped->seek(-2, SEEK_CUR);
 		if (isCompressed) {
 #if defined(USE_ZLIB)
+			if (header == 0x1F8B) {
+				SeekableReadStream *chunked = ChunkedGZipReadStream::open(toBeWrapped);
+				if (chunked)
+					return chunked;
+			}
 			return new GZipReadStream(toBeWrapped, knownSize);
 #else
 			delete toBeWrapped;
@@ -520,5 +914,13 @@ WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 	return toBeWrapped;
 }
 
+WriteStream *wrapChunkedCompressedWriteStream(WriteStream *toBeWrapped) {
+#if defined(USE_ZLIB)
+	if (toBeWrapped)
+		return new ChunkedGZipWriteStream(toBeWrapped);
+#endif
+	return toBeWrapped;
+}
+
 
 } // End of namespace Common
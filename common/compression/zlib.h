@@ -153,6 +153,21 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
  */
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped);
 
+/**
+ * Take an arbitrary WriteStream and wrap it in a custom stream which provides
+ * transparent compression, like wrapCompressedWriteStream() does. The data is
+ * compressed in independent chunks of 64 KB, in parallel, once the stream is
+ * finalized, so the created stream supports seeking and size().
+ *
+ * The result is a gzip stream followed by an index of the chunks. Any gzip
+ * reader can read it, and the stream returned by wrapCompressedReadStream()
+ * for it only decompresses the chunks which are read.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ */
+WriteStream *wrapChunkedCompressedWriteStream(WriteStream *toBeWrapped);
+
 /** @} */
 
 } // End of namespace Common
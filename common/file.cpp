@@ -142,6 +142,16 @@ uint32 File::read(void *ptr, uint32 len) {
 	return _handle->read(ptr, len);
 }
 
+SeekableReadStream *File::readStream(uint32 dataSize) {
+	assert(_handle);
+	return _handle->readStream(dataSize);
+}
+
+const byte *File::getRawData() const {
+	assert(_handle);
+	return _handle->getRawData();
+}
+
 
 DumpFile::DumpFile() : _handle(nullptr) {
 }
@@ -133,6 +133,9 @@ public:
 	int64 size() const override; /*!< Implement abstract SeekableReadStream method. */
 	bool seek(int64 offs, int whence = SEEK_SET) override;	/*!< Implement abstract SeekableReadStream method. */
 	uint32 read(void *dataPtr, uint32 dataSize) override;	/*!< Implement abstract SeekableReadStream method. */
+
+	SeekableReadStream *readStream(uint32 dataSize) override;	/*!< Override ReadStream method, to share mapped files. */
+	const byte *getRawData() const override;	/*!< Override SeekableReadStream method. */
 };
 
 
@@ -131,6 +131,10 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+bool FSNode::getFileInfo(int64 &size, int64 &modificationTime) const {
+	return _realNode && _realNode->getFileInfo(size, modificationTime);
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -146,6 +150,14 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr || !_realNode->exists() || _realNode->isDirectory())
+		return createReadStream();
+
+	SeekableReadStream *stream = _realNode->createMappedReadStream();
+	return stream ? stream : _realNode->createReadStream();
+}
+
 SeekableWriteStream *FSNode::createWriteStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -353,6 +365,20 @@ int FSDirectory::listMatchingMembers(ArchiveMemberList &list, const Path &patter
 	return matches;
 }
 
+bool FSDirectory::listMemberPaths(Array<Path> &list) const {
+	// The directory may still be created later
+	if (!_node.isDirectory())
+		return false;
+
+	// Cache dir data
+	ensureCached();
+
+	for (NodeCache::const_iterator it = _fileCache.begin(); it != _fileCache.end(); ++it)
+		list.push_back(it->_key);
+
+	return true;
+}
+
 int FSDirectory::listMembers(ArchiveMemberList &list) const {
 	if (!_node.isDirectory())
 		return 0;
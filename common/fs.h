@@ -226,6 +226,17 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Retrieve the size and the last modification time of the file referred
+	 * by this node, without opening it.
+	 *
+	 * The modification time is only meant to tell whether the file changed
+	 * since it was last looked at: its unit depends on the backend.
+	 *
+	 * @return True if the backend provides this information, false otherwise.
+	 */
+	bool getFileInfo(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -235,6 +246,19 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Create a SeekableReadStream over the file mapped into memory, if the
+	 * backend can map it, or else a regular stream like createReadStream().
+	 *
+	 * Mapped streams expose their contents through getRawData(), and
+	 * readStream() returns streams sharing them instead of copies. This
+	 * is meant for large data files: the file must not be modified while
+	 * it is mapped.
+	 *
+	 * @return Pointer to the stream object, 0 in case of a failure.
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -385,6 +409,11 @@ public:
 	 */
 	int listMembers(ArchiveMemberList &list) const override;
 
+	/**
+	 * Add the paths of all files in the directory to the list.
+	 */
+	bool listMemberPaths(Array<Path> &list) const override;
+
 	/**
 	 * Get an ArchiveMember representation of the specified file. A full match of relative
 	 * path and file name is needed for success.
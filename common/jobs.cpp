@@ -0,0 +1,332 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/jobs.h"
+#include "common/debug.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(JobSystem);
+
+/**
+ * A bounded work-stealing deque, after Chase and Lev, using the memory
+ * orderings worked out by Lê et al. for C11 atomics.
+ *
+ * Only the owning thread pushes and pops jobs at the bottom, while any other
+ * thread may steal jobs from the top.
+ */
+class WorkDeque {
+public:
+	WorkDeque() : _top(0), _bottom(0) {}
+
+	/**
+	 * Add a job at the bottom.
+	 *
+	 * @return false if the deque is full.
+	 */
+	bool push(Job *job) {
+		const int32 bottom = _bottom.loadRelaxed();
+		const int32 top = _top.load();
+		if (bottom - top >= kSize)
+			return false;
+
+		_jobs[bottom & (kSize - 1)].storeRelaxed(job);
+		_bottom.store(bottom + 1);
+		return true;
+	}
+
+	/** Remove the most recently pushed job. */
+	Job *pop() {
+		const int32 bottom = _bottom.loadRelaxed() - 1;
+		_bottom.storeRelaxed(bottom);
+		atomicThreadFence();
+		int32 top = _top.loadRelaxed();
+
+		if (top > bottom) {
+			_bottom.storeRelaxed(bottom + 1);
+			return nullptr;
+		}
+
+		Job *job = _jobs[bottom & (kSize - 1)].loadRelaxed();
+		if (top == bottom) {
+			// This is the last job, so race the thieves for it
+			if (!_top.compareExchange(top, top + 1))
+				job = nullptr;
+			_bottom.storeRelaxed(bottom + 1);
+		}
+		return job;
+	}
+
+	/** Remove the least recently pushed job. */
+	Job *steal() {
+		for (;;) {
+			int32 top = _top.load();
+			atomicThreadFence();
+			const int32 bottom = _bottom.load();
+			if (top >= bottom)
+				return nullptr;
+
+			Job *job = _jobs[top & (kSize - 1)].loadRelaxed();
+			if (_top.compareExchange(top, top + 1))
+				return job;
+			// Another thread took this job first, try the next one
+		}
+	}
+
+private:
+	static const int32 kSize = 256;
+
+	Atomic<int32> _top;
+	Atomic<int32> _bottom;
+	Atomic<Job *> _jobs[kSize];
+};
+
+struct JobSystem::Worker {
+	Worker() : owner(nullptr), index(0), thread(nullptr), threadId(0), waiter(nullptr) {}
+
+	WorkDeque deque;
+	JobSystem *owner;
+	uint index;
+	ThreadInternal *thread;
+	/** Set by the thread running this worker before it looks for jobs. */
+	Atomic<uintptr> threadId;
+	/** Used when waiting for a JobGroup. */
+	SemaphoreInternal *waiter;
+};
+
+/** Beyond this, workers mostly contend for memory bandwidth. */
+static const uint kMaxWorkers = 31;
+
+JobGroup::~JobGroup() {
+	if (!isDone())
+		JobMan.wait(*this);
+}
+
+JobSystem::JobSystem() : _workers(nullptr), _numWorkers(0), _numInjected(0), _wakeUp(nullptr), _numSleeping(0), _quit(false) {
+	if (!g_system->hasFeature(OSystem::kFeatureThreads))
+		return;
+
+	const uint numWorkers = MIN(g_system->getCpuCount(), kMaxWorkers + 1) - 1;
+	if (numWorkers == 0)
+		return;
+
+	_wakeUp = g_system->createSemaphore();
+	if (!_wakeUp)
+		return;
+
+	_workers = new Worker[numWorkers + 1];
+	for (uint i = 0; i <= numWorkers; ++i) {
+		_workers[i].owner = this;
+		_workers[i].index = i;
+		_workers[i].waiter = g_system->createSemaphore();
+	}
+
+	// The workers read this while stealing. Should some thread fail to
+	// start, its deque just stays empty.
+	_workers[0].threadId.store(g_system->getCurrentThreadId());
+	_numWorkers = numWorkers;
+
+	for (uint i = 1; i <= numWorkers; ++i) {
+		_workers[i].thread = g_system->createThread(workerMain, &_workers[i]);
+		if (!_workers[i].thread)
+			warning("JobSystem: Could not start worker thread %u", i);
+	}
+
+	debug(1, "JobSystem: Started %u worker threads", numWorkers);
+}
+
+JobSystem::~JobSystem() {
+	if (_numWorkers) {
+		// Jobs not belonging to any group may still be queued
+		while (Job *job = findJob(&_workers[0]))
+			runJob(job);
+
+		_quit.store(true);
+		for (uint i = 1; i <= _numWorkers; ++i)
+			_wakeUp->post();
+
+		for (uint i = 0; i <= _numWorkers; ++i) {
+			if (_workers[i].thread) {
+				_workers[i].thread->join();
+				delete _workers[i].thread;
+			}
+			delete _workers[i].waiter;
+		}
+
+		delete[] _workers;
+		delete _wakeUp;
+	}
+}
+
+void JobSystem::workerMain(void *param) {
+	Worker *self = (Worker *)param;
+	JobSystem *jobs = self->owner;
+	self->threadId.store(g_system->getCurrentThreadId());
+
+	for (;;) {
+		Job *job = jobs->findJob(self);
+		if (!job) {
+			// Announce going to sleep before checking for jobs one last
+			// time, so that schedule() cannot miss waking this thread up
+			jobs->_numSleeping.fetchAdd(1);
+			job = jobs->findJob(self);
+			if (!job) {
+				if (jobs->_quit.load()) {
+					jobs->_numSleeping.fetchSub(1);
+					return;
+				}
+				jobs->_wakeUp->wait();
+			}
+			jobs->_numSleeping.fetchSub(1);
+			if (!job)
+				continue;
+		}
+
+		jobs->runJob(job);
+	}
+}
+
+void JobSystem::schedule(Job *job, JobGroup *group) {
+	job->_group = group;
+	if (group)
+		group->_pending.fetchAdd(1);
+
+	if (!_numWorkers) {
+		runJob(job);
+		return;
+	}
+
+	Worker *self = currentWorker();
+	if (self) {
+		if (!self->deque.push(job)) {
+			runJob(job);
+			return;
+		}
+	} else {
+		StackLock lock(_injectedMutex);
+		_injected.push(job);
+		_numInjected.fetchAdd(1);
+	}
+
+	wakeUpWorker();
+}
+
+JobSystem::Worker *JobSystem::currentWorker() {
+	// There are only a few workers, and looking them up is cheap next to
+	// running a job
+	const uintptr threadId = g_system->getCurrentThreadId();
+	for (uint i = 0; i <= _numWorkers; ++i) {
+		if (_workers[i].threadId.loadRelaxed() == threadId)
+			return &_workers[i];
+	}
+	return nullptr;
+}
+
+void JobSystem::wakeUpWorker() {
+	// This needs to be a read-modify-write, so that it is ordered against
+	// the increment done by a worker going to sleep
+	if (_numSleeping.fetchAdd(0))
+		_wakeUp->post();
+}
+
+void JobSystem::runJob(Job *job) {
+	JobGroup *group = job->_group;
+	job->run();
+	delete job;
+
+	if (group) {
+		// Once the last job is done, the group may be destroyed at any time,
+		// unless a thread is sleeping until it gets woken up
+		if (group->_pending.fetchSub(1) == (JobGroup::kWaiting | 1))
+			group->_waiter->post();
+	}
+}
+
+Job *JobSystem::findJob(Worker *self) {
+	Job *job;
+	if (self) {
+		job = self->deque.pop();
+		if (job)
+			return job;
+	}
+
+	if (_numInjected.load()) {
+		StackLock lock(_injectedMutex);
+		if (!_injected.empty()) {
+			_numInjected.fetchSub(1);
+			return _injected.pop();
+		}
+	}
+
+	const uint numDeques = _numWorkers + 1;
+	const uint start = self ? self->index + 1 : 0;
+	for (uint i = 0; i < numDeques; ++i) {
+		Worker &victim = _workers[(start + i) % numDeques];
+		if (&victim == self)
+			continue;
+
+		job = victim.deque.steal();
+		if (job)
+			return job;
+	}
+
+	return nullptr;
+}
+
+void JobSystem::wait(JobGroup &group) {
+	if (!_numWorkers) {
+		assert(group.isDone());
+		return;
+	}
+
+	Worker *self = currentWorker();
+	while (!group.isDone()) {
+		Job *job = findJob(self);
+		if (job) {
+			runJob(job);
+			continue;
+		}
+
+		// The remaining jobs all run on other threads, so sleep until the
+		// last one finishes
+		SemaphoreInternal *waiter = self ? self->waiter : g_system->createSemaphore();
+		if (!waiter)
+			continue;
+
+		group._waiter = waiter;
+		uint32 pending = group._pending.load();
+		while (pending && !group._pending.compareExchange(pending, pending | JobGroup::kWaiting)) {
+		}
+
+		if (pending) {
+			waiter->wait();
+			group._pending.store(0);
+		}
+		group._waiter = nullptr;
+
+		if (!self)
+			delete waiter;
+	}
+}
+
+} // End of namespace Common
@@ -0,0 +1,286 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_JOBS_H
+#define COMMON_JOBS_H
+
+#include "common/scummsys.h"
+#include "common/atomic.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/queue.h"
+#include "common/singleton.h"
+#include "common/thread.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_jobs Job system
+ * @ingroup common
+ *
+ * @brief Spread CPU-bound work over all the cores of the machine.
+ *
+ * The job system keeps one worker thread per additional CPU core. Every
+ * worker owns a queue of jobs, and idle workers steal jobs from the queues of
+ * busy ones. Threads waiting for jobs to finish run queued jobs themselves
+ * in the meantime, so waiting from within a job cannot deadlock.
+ *
+ * On backends without OSystem::kFeatureThreads, or with a single CPU core,
+ * jobs run right away on the thread scheduling them.
+ *
+ * Jobs must not call into the OSystem (except for mutexes), nor into any
+ * other code which is not safe to use from several threads at once.
+ * @{
+ */
+
+class JobGroup;
+class JobSystem;
+
+/**
+ * A unit of work, scheduled with JobSystem::schedule().
+ */
+class Job {
+public:
+	Job() : _group(nullptr) {}
+	virtual ~Job() {}
+
+	virtual void run() = 0;
+
+private:
+	friend class JobSystem;
+	JobGroup *_group;
+};
+
+/**
+ * Keeps track of a set of jobs, so that one can wait for all of them to
+ * finish. A group can be reused once waited for.
+ */
+class JobGroup : NonCopyable {
+public:
+	JobGroup() : _pending(0), _waiter(nullptr) {}
+	/** Waits for any jobs still pending in this group. */
+	~JobGroup();
+
+	/** Return whether all the jobs scheduled in this group have finished. */
+	bool isDone() const { return (_pending.load() & ~kWaiting) == 0; }
+
+private:
+	friend class JobSystem;
+
+	/** Set in _pending while a thread sleeps until the group is done. */
+	static const uint32 kWaiting = 0x80000000;
+
+	Atomic<uint32> _pending;
+	SemaphoreInternal *_waiter;
+};
+
+/**
+ * The result of a job started with JobSystem::async().
+ */
+template<typename T>
+class Future {
+public:
+	Future() {}
+
+	bool isValid() const { return _state.get() != nullptr; }
+	/** Return whether the result is available without waiting. */
+	bool isReady() const { return _state->group.isDone(); }
+
+	/**
+	 * Wait for the job to finish, then return its result.
+	 */
+	const T &get() const;
+
+private:
+	friend class JobSystem;
+
+	struct State {
+		JobGroup group;
+		T value;
+	};
+
+	// Only ever copied on the thread which started the job: the job itself
+	// uses a plain pointer, and the state waits for it before going away.
+	SharedPtr<State> _state;
+};
+
+/**
+ * The job scheduler.
+ *
+ * The first use of JobMan should happen on the main thread.
+ */
+class JobSystem : public Singleton<JobSystem> {
+public:
+	/**
+	 * Return the number of threads running jobs, including the one waiting
+	 * for them. This is 1 when jobs run serially.
+	 */
+	uint getThreadCount() const { return _numWorkers + 1; }
+
+	/**
+	 * Queue a job to run on any thread. The job system takes ownership of
+	 * the job, and deletes it once it has run.
+	 *
+	 * @param job    The job to run.
+	 * @param group  The group to add the job to, if any.
+	 */
+	void schedule(Job *job, JobGroup *group = nullptr);
+
+	/**
+	 * Queue a function object to run on any thread.
+	 */
+	template<typename F>
+	void schedule(const F &func, JobGroup *group = nullptr) {
+		Job *job = new FunctionJob<F>(func);
+		schedule(job, group);
+	}
+
+	/**
+	 * Wait until all the jobs of @p group have finished.
+	 */
+	void wait(JobGroup &group);
+
+	/**
+	 * Run a function object on any thread, returning a future for its
+	 * result. The function must not return void; use a JobGroup for that.
+	 */
+	template<typename F>
+	auto async(const F &func) -> Future<decltype(func())> {
+		typedef decltype(func()) T;
+		Future<T> future;
+		future._state.reset(new typename Future<T>::State());
+		Job *job = new AsyncJob<F, T>(func, future._state.get());
+		schedule(job, &future._state->group);
+		return future;
+	}
+
+	/**
+	 * Call @p func(i) for every i from @p begin to @p end - 1, spreading the
+	 * calls over all threads, and wait for all of them to return.
+	 *
+	 * @param grainSize  The minimum number of calls made by a single job.
+	 */
+	template<typename F>
+	void parallelFor(int begin, int end, const F &func, int grainSize = 1) {
+		const int count = end - begin;
+		if (count <= 0)
+			return;
+
+		int numChunks = MIN<int>(count / MAX(grainSize, 1), getThreadCount() * kChunksPerThread);
+		if (numChunks <= 1) {
+			for (int i = begin; i < end; ++i)
+				func(i);
+			return;
+		}
+
+		JobGroup group;
+		for (int chunk = 0; chunk < numChunks; ++chunk) {
+			const int from = begin + (int)((int64)count * chunk / numChunks);
+			const int to = begin + (int)((int64)count * (chunk + 1) / numChunks);
+			Job *job = new RangeJob<F>(func, from, to);
+			schedule(job, &group);
+		}
+		wait(group);
+	}
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	JobSystem();
+	~JobSystem();
+
+	/** How many jobs parallelFor() creates per thread, for load balancing. */
+	static const int kChunksPerThread = 4;
+
+	template<typename F>
+	class FunctionJob : public Job {
+	public:
+		FunctionJob(const F &func) : _func(func) {}
+		void run() override { _func(); }
+
+	private:
+		F _func;
+	};
+
+	template<typename F, typename T>
+	class AsyncJob : public Job {
+	public:
+		AsyncJob(const F &func, typename Future<T>::State *state) : _func(func), _state(state) {}
+		void run() override { _state->value = _func(); }
+
+	private:
+		F _func;
+		typename Future<T>::State *_state;
+	};
+
+	template<typename F>
+	class RangeJob : public Job {
+	public:
+		RangeJob(const F &func, int begin, int end) : _func(func), _begin(begin), _end(end) {}
+
+		void run() override {
+			for (int i = _begin; i < _end; ++i)
+				_func(i);
+		}
+
+	private:
+		const F &_func;
+		int _begin, _end;
+	};
+
+	struct Worker;
+
+	static void workerMain(void *param);
+
+	Worker *currentWorker();
+	void runJob(Job *job);
+	Job *findJob(Worker *self);
+	void wakeUpWorker();
+
+	/** Workers 1 to _numWorkers run on their own thread, 0 is the main thread. */
+	Worker *_workers;
+	uint _numWorkers;
+
+	/** Jobs scheduled by threads other than the workers. */
+	Queue<Job *> _injected;
+	Atomic<uint32> _numInjected;
+	Mutex _injectedMutex;
+
+	SemaphoreInternal *_wakeUp;
+	Atomic<uint32> _numSleeping;
+	Atomic<bool> _quit;
+};
+
+template<typename T>
+const T &Future<T>::get() const {
+	if (!_state->group.isDone())
+		JobSystem::instance().wait(_state->group);
+	return _state->value;
+}
+
+/** @} */
+
+} // End of namespace Common
+
+/** Shortcut for accessing the job system. */
+#define JobMan Common::JobSystem::instance()
+
+#endif
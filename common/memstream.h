@@ -93,6 +93,27 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	const byte *getRawData() const override { return _ptrOrig.get(); }
+};
+
+/**
+ * A MemoryReadStream over part of a block of memory which is shared with
+ * other streams, like a file mapped into memory. The block is released
+ * once no stream uses it any more.
+ *
+ * readStream() returns a stream over the same block instead of a copy.
+ */
+class SharedMemoryReadStream : public MemoryReadStream {
+public:
+	SharedMemoryReadStream(const SharedPtr<byte> &block, uint32 offset, uint32 size) :
+		MemoryReadStream(block.get() + offset, size), _block(block), _offset(offset) {}
+
+	SeekableReadStream *readStream(uint32 dataSize) override;
+
+private:
+	SharedPtr<byte> _block;
+	uint32 _offset;
 };
 
 
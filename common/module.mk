@@ -13,6 +13,7 @@ MODULE_OBJS := \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
+	jobs.o \
 	language.o \
 	localization.o \
 	macresman.o \
@@ -26,6 +27,7 @@ MODULE_OBJS := \
 	random.o \
 	rational.o \
 	rendermode.o \
+	saveindex.o \
 	str.o \
 	stream.o \
 	streamdebug.o \
@@ -30,6 +30,8 @@
 
 namespace Common {
 
+class SaveIndex;
+
 /**
  * @defgroup common_savefile Save files
  * @ingroup common
@@ -109,13 +111,15 @@ public:
 
 	/**
 	 * Seeks to a new position within the file.
-	 * This is only supported when creating uncompressed save files.
+	 * This is only supported when creating uncompressed save files, or
+	 * compressed ones with the seekable_saves option.
 	 */
 	bool seek(int64 offset, int whence) override;
 
 	/**
 	 * Returns the size of the save file
-	 * This is only supported when creating uncompressed save files.
+	 * This is only supported when creating uncompressed save files, or
+	 * compressed ones with the seekable_saves option.
 	 */
 	int64 size() const override;
 };
@@ -276,6 +280,29 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Retrieve the size and the last modification time of a savefile
+	 * without opening it.
+	 *
+	 * @param name Name of the savefile.
+	 *
+	 * @return True if the manager provides this information and the file
+	 *         exists, false otherwise.
+	 */
+	virtual bool getSavefileInfo(const String &name, int64 &size, int64 &modificationTime) { return false; }
+
+	/**
+	 * Return the index of the metadata of the savefiles of a target.
+	 *
+	 * The manager owns the index, and drops the entry of a savefile whenever
+	 * it is saved or removed through openForSaving() or removeSavefile().
+	 *
+	 * @param target Target the savefiles belong to.
+	 *
+	 * @return The loaded index, or nullptr if the manager does not keep one.
+	 */
+	virtual SaveIndex *getSaveIndex(const String &target) { return nullptr; }
 };
 
 /** @} */
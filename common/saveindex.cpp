@@ -0,0 +1,279 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/saveindex.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/savefile.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+// Not named after the target, so that the index never shows up in the
+// savefile patterns of the engines.
+static const char *const kIndexPrefix = "saveindex-";
+
+static const uint32 kIndexTag = MKTAG('S','V','M','I');
+static const byte kIndexVersion = 2;
+
+static String readIndexString(SeekableReadStream &in) {
+	const uint16 length = in.readUint16LE();
+	return in.readString(0, length);
+}
+
+static void writeIndexString(WriteStream &out, const String &str) {
+	const uint16 length = MIN<uint>(str.size(), 0xFFFF);
+	out.writeUint16LE(length);
+	out.write(str.c_str(), length);
+}
+
+SaveIndex::SaveIndex(SaveFileManager *saveFileMan, const String &target)
+	: _saveFileMan(saveFileMan), _indexName(getIndexName(target)), _tableSize(0), _modified(false) {
+}
+
+bool SaveIndex::load() {
+	ScopedPtr<SeekableReadStream> in(_saveFileMan->openRawFile(_indexName));
+	if (!in) {
+		_items.clear();
+		_tableSize = 0;
+		_modified = false;
+		return false;
+	}
+
+	return readTable(*in);
+}
+
+bool SaveIndex::load(SeekableReadStream &in) {
+	if (!readTable(in))
+		return false;
+
+	// The stream is not kept, so the thumbnails cannot be read later
+	for (ItemMap::iterator i = _items.begin(); i != _items.end(); ++i) {
+		Item &item = i->_value;
+		if (item.thumbnailLoaded)
+			continue;
+
+		item.thumbnail.resize(item.thumbnailSize);
+		if (!readThumbnail(in, item, item.thumbnail.data())) {
+			warning("SaveIndex: Ignoring truncated index '%s'", _indexName.c_str());
+			_items.clear();
+			return false;
+		}
+		item.thumbnailLoaded = true;
+	}
+
+	return true;
+}
+
+bool SaveIndex::readTable(SeekableReadStream &in) {
+	_items.clear();
+	_tableSize = 0;
+	_modified = false;
+
+	if (in.readUint32BE() != kIndexTag || in.readByte() != kIndexVersion) {
+		warning("SaveIndex: Ignoring invalid index '%s'", _indexName.c_str());
+		return false;
+	}
+
+	const uint32 count = in.readUint32LE();
+	for (uint32 i = 0; i < count && !in.eos(); ++i) {
+		const String filename = readIndexString(in);
+
+		Item &item = _items[filename];
+		item.entry.fileSize = in.readUint32LE();
+		item.entry.modificationTime = in.readSint64LE();
+		item.entry.description = readIndexString(in);
+		item.entry.date = in.readUint32LE();
+		item.entry.time = in.readUint16LE();
+		item.entry.playTime = in.readUint32LE();
+		item.entry.isAutosave = in.readByte() != 0;
+		item.thumbnailOffset = in.readUint32LE();
+		item.thumbnailSize = in.readUint32LE();
+		item.thumbnailLoaded = item.thumbnailSize == 0;
+	}
+
+	if (in.eos() || in.err()) {
+		warning("SaveIndex: Ignoring truncated index '%s'", _indexName.c_str());
+		_items.clear();
+		return false;
+	}
+
+	_tableSize = in.pos();
+	return true;
+}
+
+bool SaveIndex::flush() {
+	if (!_modified)
+		return true;
+
+	// Thumbnails which were never asked for are still only in the old file,
+	// which is gone once it is opened for saving
+	loadThumbnails();
+
+	ScopedPtr<OutSaveFile> out(_saveFileMan->openForSaving(_indexName, false));
+	if (!out)
+		return false;
+
+	write(*out);
+	out->finalize();
+	if (out->err()) {
+		warning("SaveIndex: Failed to write index '%s'", _indexName.c_str());
+		return false;
+	}
+
+	// Everything is in the file now, so the thumbnails can go again
+	for (ItemMap::iterator i = _items.begin(); i != _items.end(); ++i) {
+		i->_value.thumbnail.clear();
+		i->_value.thumbnailLoaded = i->_value.thumbnailSize == 0;
+	}
+
+	_modified = false;
+	return true;
+}
+
+bool SaveIndex::write(WriteStream &out) {
+	loadThumbnails();
+
+	out.writeUint32BE(kIndexTag);
+	out.writeByte(kIndexVersion);
+	out.writeUint32LE(_items.size());
+
+	uint32 thumbnailOffset = 0;
+	for (ItemMap::iterator i = _items.begin(); i != _items.end(); ++i) {
+		Item &item = i->_value;
+		item.thumbnailOffset = thumbnailOffset;
+		item.thumbnailSize = item.thumbnail.size();
+		thumbnailOffset += item.thumbnailSize;
+
+		writeIndexString(out, i->_key);
+		out.writeUint32LE(item.entry.fileSize);
+		out.writeSint64LE(item.entry.modificationTime);
+		writeIndexString(out, item.entry.description);
+		out.writeUint32LE(item.entry.date);
+		out.writeUint16LE(item.entry.time);
+		out.writeUint32LE(item.entry.playTime);
+		out.writeByte(item.entry.isAutosave);
+		out.writeUint32LE(item.thumbnailOffset);
+		out.writeUint32LE(item.thumbnailSize);
+	}
+	_tableSize = out.pos();
+
+	for (ItemMap::iterator i = _items.begin(); i != _items.end(); ++i) {
+		if (!i->_value.thumbnail.empty())
+			out.write(i->_value.thumbnail.data(), i->_value.thumbnail.size());
+	}
+
+	return !out.err();
+}
+
+const SaveIndex::Entry *SaveIndex::find(const String &filename, uint32 fileSize, int64 modificationTime) const {
+	ItemMap::const_iterator i = _items.find(filename);
+	if (i == _items.end())
+		return nullptr;
+
+	const Entry &entry = i->_value.entry;
+	if (entry.fileSize != fileSize || entry.modificationTime != modificationTime)
+		return nullptr;
+	return &entry;
+}
+
+void SaveIndex::set(const String &filename, const Entry &entry, const Array<byte> &thumbnail) {
+	Item &item = _items[filename];
+	item.entry = entry;
+	item.thumbnail = thumbnail;
+	item.thumbnailOffset = 0;
+	item.thumbnailSize = thumbnail.size();
+	item.thumbnailLoaded = true;
+	_modified = true;
+}
+
+bool SaveIndex::remove(const String &filename) {
+	ItemMap::iterator i = _items.find(filename);
+	if (i == _items.end())
+		return false;
+
+	_items.erase(i);
+	_modified = true;
+	return true;
+}
+
+SeekableReadStream *SaveIndex::readThumbnail(const String &filename) const {
+	ItemMap::const_iterator i = _items.find(filename);
+	if (i == _items.end() || i->_value.thumbnailSize == 0)
+		return nullptr;
+
+	const Item &item = i->_value;
+	byte *data = (byte *)malloc(item.thumbnailSize);
+	if (!data)
+		return nullptr;
+
+	if (item.thumbnailLoaded) {
+		memcpy(data, item.thumbnail.data(), item.thumbnailSize);
+	} else {
+		ScopedPtr<SeekableReadStream> in(_saveFileMan->openRawFile(_indexName));
+		if (!in || !readThumbnail(*in, item, data)) {
+			free(data);
+			return nullptr;
+		}
+	}
+
+	return new MemoryReadStream(data, item.thumbnailSize, DisposeAfterUse::YES);
+}
+
+bool SaveIndex::readThumbnail(SeekableReadStream &in, const Item &item, byte *dst) const {
+	return in.seek(_tableSize + item.thumbnailOffset) && in.read(dst, item.thumbnailSize) == item.thumbnailSize;
+}
+
+void SaveIndex::loadThumbnails() {
+	ScopedPtr<SeekableReadStream> in;
+	for (ItemMap::iterator i = _items.begin(); i != _items.end(); ++i) {
+		Item &item = i->_value;
+		if (item.thumbnailLoaded)
+			continue;
+
+		if (!in)
+			in.reset(_saveFileMan->openRawFile(_indexName));
+		item.thumbnail.resize(item.thumbnailSize);
+		if (!in || !readThumbnail(*in, item, item.thumbnail.data())) {
+			item.thumbnail.clear();
+			item.thumbnailSize = 0;
+		}
+		item.thumbnailLoaded = true;
+	}
+}
+
+String SaveIndex::getIndexName(const String &target) {
+	return kIndexPrefix + target + ".dat";
+}
+
+bool SaveIndex::isIndexName(const String &filename) {
+	return filename.hasPrefix(kIndexPrefix);
+}
+
+String SaveIndex::getTarget(const String &filename) {
+	const size_t dot = filename.findLastOf('.');
+	if (dot == String::npos || dot == 0)
+		return String();
+	return filename.substr(0, dot);
+}
+
+} // End of namespace Common
@@ -0,0 +1,182 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_SAVEINDEX_H
+#define COMMON_SAVEINDEX_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_saveindex Save index
+ * @ingroup common
+ *
+ * @brief SaveIndex class for listing savefiles without opening them.
+ *
+ * @{
+ */
+
+class SaveFileManager;
+class SeekableReadStream;
+class WriteStream;
+
+/**
+ * The metadata of the savefiles of a target, kept in a file next to them.
+ *
+ * Reading the metadata of a compressed savefile means inflating all of it,
+ * as the metadata is at its end, so listing many saves can take long. The
+ * index keeps the description, date, play time and thumbnail of every save
+ * it has seen. Only the table of entries is read when the index is loaded,
+ * a thumbnail is read from the index file when it is asked for.
+ *
+ * The save file manager drops the entry of a savefile whenever the savefile
+ * is saved or removed. Entries also remember the size and modification time
+ * of their savefile, so savefiles which were replaced behind the manager's
+ * back are not trusted.
+ *
+ * Only savefiles named after their target, as in "target.s01", are indexed.
+ */
+class SaveIndex {
+public:
+	struct Entry {
+		Entry() : fileSize(0), modificationTime(0), date(0), playTime(0), isAutosave(false) {
+			time = 0;
+		}
+
+		uint32 fileSize;    ///< Size of the savefile when it was indexed.
+		int64 modificationTime; ///< As given by FSNode::getFileInfo() when the savefile was indexed.
+		String description;
+		uint32 date;        ///< Encoded as in the extended savegame header.
+		uint16 time;        ///< Encoded as in the extended savegame header.
+		uint32 playTime;
+		bool isAutosave;
+	};
+
+	SaveIndex(SaveFileManager *saveFileMan, const String &target);
+
+	/**
+	 * Read the table of entries from the index file.
+	 *
+	 * @return False if there is no valid index file, which leaves the index
+	 *         empty.
+	 */
+	bool load();
+
+	/**
+	 * Read the index from a stream, in the format of the index file. Unlike
+	 * load(), this reads the thumbnails right away.
+	 *
+	 * @return False if the stream does not hold a valid index, which leaves
+	 *         the index empty.
+	 */
+	bool load(SeekableReadStream &in);
+
+	/**
+	 * Write the index file back if any entry changed.
+	 */
+	bool flush();
+
+	/**
+	 * Write the index to a stream, in the format of the index file.
+	 *
+	 * @return False if an error occurred while writing.
+	 */
+	bool write(WriteStream &out);
+
+	bool isModified() const { return _modified; }
+
+	/**
+	 * Find the entry of a savefile.
+	 *
+	 * @param fileSize         The current size of the savefile.
+	 * @param modificationTime The current modification time of the savefile.
+	 * @return The entry, or nullptr if the savefile is not indexed or its
+	 *         size or modification time changed since.
+	 */
+	const Entry *find(const String &filename, uint32 fileSize, int64 modificationTime) const;
+
+	/**
+	 * Add or replace the entry of a savefile.
+	 *
+	 * @param thumbnail The thumbnail, as written by Graphics::saveThumbnail().
+	 */
+	void set(const String &filename, const Entry &entry, const Array<byte> &thumbnail);
+
+	/**
+	 * Drop the entry of a savefile.
+	 *
+	 * @return Whether there was one.
+	 */
+	bool remove(const String &filename);
+
+	/**
+	 * Read the thumbnail of a savefile.
+	 *
+	 * @return A stream to pass to Graphics::loadThumbnail(), or nullptr if
+	 *         the savefile has no thumbnail in the index.
+	 */
+	SeekableReadStream *readThumbnail(const String &filename) const;
+
+	/** Return the name of the index file of a target. */
+	static String getIndexName(const String &target);
+
+	/** Return whether a file is an index file. */
+	static bool isIndexName(const String &filename);
+
+	/**
+	 * Return the target a savefile belongs to, which is its name up to the
+	 * extension, or an empty string if it has none.
+	 */
+	static String getTarget(const String &filename);
+
+private:
+	struct Item {
+		Item() : thumbnailOffset(0), thumbnailSize(0), thumbnailLoaded(true) {}
+
+		Entry entry;
+		uint32 thumbnailOffset; ///< From the end of the table.
+		uint32 thumbnailSize;
+		Array<byte> thumbnail;  ///< Only filled once the thumbnail is loaded.
+		bool thumbnailLoaded;
+	};
+
+	typedef HashMap<String, Item> ItemMap;
+
+	bool readTable(SeekableReadStream &in);
+	bool readThumbnail(SeekableReadStream &in, const Item &item, byte *dst) const;
+	void loadThumbnails();
+
+	SaveFileManager *_saveFileMan;
+	String _indexName;
+	ItemMap _items;
+	uint32 _tableSize;
+	bool _modified;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -107,6 +107,21 @@ uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+SeekableReadStream *SharedMemoryReadStream::readStream(uint32 dataSize) {
+	const uint32 start = pos();
+	if (dataSize > size() - start) {
+		dataSize = size() - start;
+		// Set the end-of-stream flag, as reading the data would
+		byte dummy;
+		seek(0, SEEK_END);
+		read(&dummy, 1);
+	} else {
+		seek(dataSize, SEEK_CUR);
+	}
+
+	return new SharedMemoryReadStream(_block, _offset + start, dataSize);
+}
+
 bool MemoryReadStream::seek(int64 offs, int whence) {
 	// Pre-Condition
 	assert(_pos <= _size);
@@ -622,8 +622,10 @@ public:
 	 * if reading more data failed. This is because of an I/O error or because
 	 * the end of the stream was reached. It can be determined by
 	 * calling err() and eos().
+	 *
+	 * Streams over shared memory return a stream sharing it instead.
 	 */
-	SeekableReadStream *readStream(uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 
 	/**
 	 * Reads in a terminated string. Upon successful completion,
@@ -700,6 +702,16 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Return the whole contents of the stream if they are in memory, for
+	 * example because the file is mapped into memory, so that they can be
+	 * used without reading them. The pointer is valid as long as the
+	 * stream exists.
+	 *
+	 * @return The contents of the stream, or nullptr if they have to be read.
+	 */
+	virtual const byte *getRawData() const { return nullptr; }
+
 	/**
 	 * Read at most one less than the number of characters specified
 	 * by @p bufSize from the stream and store them in the string buffer.
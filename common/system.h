@@ -52,6 +52,7 @@ class MutexInternal;
 struct Rect;
 class SaveFileManager;
 class SearchSet;
+class SemaphoreInternal;
 class String;
 #if defined(USE_TASKBAR)
 class TaskbarManager;
@@ -63,6 +64,7 @@ class TextToSpeechManager;
 #if defined(USE_SYSDIALOGS)
 class DialogManager;
 #endif
+class ThreadInternal;
 class TimerManager;
 class SeekableReadStream;
 class WriteStream;
@@ -534,6 +536,12 @@ public:
 		*/
 		kFeatureScalers,
 
+		/**
+		* If supported, this feature flag can be used to check if the
+		* scalers spread their work over several threads.
+		*/
+		kFeatureScalerThreads,
+
 		/**
 		* Shaders.
 		*/
@@ -548,7 +556,40 @@ public:
 		/**
 		* For platforms that should not have a Quit button.
 		*/
-		kFeatureNoQuit
+		kFeatureNoQuit,
+
+		/**
+		 * The CPU running ScummVM supports SSE2 instructions.
+		 *
+		 * Code built with SCUMMVM_SSE2 must check this feature before
+		 * calling into any SSE2 code path.
+		 */
+		kFeatureCpuSSE2,
+
+		/**
+		 * The CPU running ScummVM supports AVX2 instructions.
+		 *
+		 * Code built with SCUMMVM_AVX2 must check this feature before
+		 * calling into any AVX2 code path.
+		 */
+		kFeatureCpuAVX2,
+
+		/**
+		 * The CPU running ScummVM supports NEON instructions.
+		 *
+		 * Code built with SCUMMVM_NEON must check this feature before
+		 * calling into any NEON code path.
+		 */
+		kFeatureCpuNEON,
+
+		/**
+		 * The backend can run code on additional threads, using
+		 * createThread() and createSemaphore().
+		 *
+		 * Without this feature, Common::JobSystem runs all jobs on
+		 * the calling thread.
+		 */
+		kFeatureThreads
 	};
 
 	/**
@@ -1503,6 +1544,50 @@ public:
 	/** @} */
 
 
+	/**
+	 * @defgroup common_system_threads Worker threads
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Backends supporting kFeatureThreads can start worker threads, which
+	 * Common::JobSystem uses to spread CPU-bound work over several cores.
+	 * Code running on a worker thread must not call any other OSystem
+	 * method, except for creating and using mutexes and semaphores, and
+	 * getCurrentThreadId().
+	 *
+	 * The default implementations do not support threads.
+	 */
+
+	/**
+	 * Create and start a new thread, which calls @p proc with @p param.
+	 *
+	 * @return The new thread, or nullptr if an error occurred.
+	 */
+	virtual Common::ThreadInternal *createThread(void (*proc)(void *param), void *param) { return nullptr; }
+
+	/**
+	 * Create a new semaphore, with an initial count of zero.
+	 *
+	 * @return The new semaphore, or nullptr if an error occurred.
+	 */
+	virtual Common::SemaphoreInternal *createSemaphore() { return nullptr; }
+
+	/**
+	 * Return the number of logical CPU cores available to ScummVM.
+	 */
+	virtual uint getCpuCount() { return 1; }
+
+	/**
+	 * Return an identifier of the calling thread. No two threads running at
+	 * the same time share one.
+	 *
+	 * Backends supporting kFeatureThreads must implement this.
+	 */
+	virtual uintptr getCurrentThreadId() { return 0; }
+
+	/** @} */
+
+
 
 	/** @defgroup common_system_sound Sound
 	 *  @ingroup common_system
@@ -1714,6 +1799,14 @@ public:
 	 */
 	virtual Common::String getDefaultLogFileName() { return Common::String(); }
 
+	/**
+	 * Get the default directory where ScummVM keeps data it can rebuild at
+	 * any time, like the indices speeding up game detection.
+	 *
+	 * Ports returning an empty string only keep such data in memory.
+	 */
+	virtual Common::String getDefaultCachePath() { return Common::String(); }
+
 	/**
 	 * Register the default values for the settings the backend uses into the
 	 * configuration manager.
@@ -0,0 +1,70 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_THREAD_H
+#define COMMON_THREAD_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_thread Threads
+ * @ingroup common
+ *
+ * @brief Backend interfaces for worker threads.
+ *
+ * These are only created through OSystem::createThread() and
+ * OSystem::createSemaphore(), on backends supporting
+ * OSystem::kFeatureThreads. Engines should not use them directly, but go
+ * through Common::JobSystem instead.
+ * @{
+ */
+
+/** Entry point of a thread created with OSystem::createThread(). */
+typedef void (*ThreadProc)(void *param);
+
+class ThreadInternal {
+public:
+	virtual ~ThreadInternal() {}
+
+	/** Wait until the thread procedure has returned. */
+	virtual void join() = 0;
+};
+
+/**
+ * A counting semaphore, initially zero.
+ */
+class SemaphoreInternal {
+public:
+	virtual ~SemaphoreInternal() {}
+
+	/** Wait until the count is non-zero, then decrement it. */
+	virtual void wait() = 0;
+	/** Increment the count, waking up one waiting thread. */
+	virtual void post() = 0;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -24,6 +24,7 @@
 #include "common/debug.h"
 #include "common/util.h"
 #include "common/file.h"
+#include "common/jobs.h"
 #include "common/macresman.h"
 #include "common/md5.h"
 #include "common/config-manager.h"
@@ -516,6 +517,114 @@ namespace Common {
 	DECLARE_SINGLETON(MD5CacheManager);
 }
 
+/** Bump this whenever the way MD5s are computed changes. */
+static const uint32 kMD5CacheVersion = 1;
+
+/** Minimum delay between two writes of the on-disk MD5 cache, in ms. */
+static const uint32 kMD5CacheFlushInterval = 30 * 1000;
+
+bool MD5CacheManager::getPersistentCacheFile(Common::FSNode &node) const {
+	const Common::String cachePath = g_system->getDefaultCachePath();
+	if (cachePath.empty())
+		return false;
+
+	Common::FSNode dir(cachePath);
+	if (!dir.isDirectory())
+		return false;
+
+	node = dir.getChild("detection-md5.dat");
+	return true;
+}
+
+void MD5CacheManager::loadPersistentCache() {
+	persistentLoaded = true;
+
+	Common::FSNode node;
+	if (!getPersistentCacheFile(node) || !node.exists())
+		return;
+
+	Common::File file;
+	if (!file.open(node))
+		return;
+
+	if (file.readUint32BE() != MKTAG('M', 'D', '5', 'C') || file.readUint32LE() != kMD5CacheVersion)
+		return;
+
+	const uint32 count = file.readUint32LE();
+	for (uint32 i = 0; i < count; ++i) {
+		Common::String key = file.readString();
+		PersistentEntry entry;
+		entry.fileSize = file.readSint64LE();
+		entry.modificationTime = file.readSint64LE();
+		entry.md5 = file.readString();
+
+		if (file.eos() || file.err()) {
+			warning("MD5CacheManager: Discarding truncated cache file '%s'", node.getPath().c_str());
+			persistentHashMap.clear();
+			return;
+		}
+
+		persistentHashMap[key] = entry;
+	}
+
+	debugC(2, kDebugGlobalDetection, "Loaded %d cached MD5s", persistentHashMap.size());
+}
+
+void MD5CacheManager::flushPersistentCache(bool force) {
+	if (!persistentDirty)
+		return;
+
+	const uint32 time = g_system->getMillis();
+	if (!force && time - persistentFlushTime < kMD5CacheFlushInterval)
+		return;
+
+	persistentDirty = false;
+	persistentFlushTime = time;
+
+	Common::FSNode node;
+	Common::DumpFile file;
+	if (!getPersistentCacheFile(node) || !file.open(node))
+		return;
+
+	file.writeUint32BE(MKTAG('M', 'D', '5', 'C'));
+	file.writeUint32LE(kMD5CacheVersion);
+	file.writeUint32LE(persistentHashMap.size());
+	for (PersistentHashMap::const_iterator i = persistentHashMap.begin(); i != persistentHashMap.end(); ++i) {
+		file.writeString(i->_key);
+		file.writeByte(0);
+		file.writeSint64LE(i->_value.fileSize);
+		file.writeSint64LE(i->_value.modificationTime);
+		file.writeString(i->_value.md5);
+		file.writeByte(0);
+	}
+
+	if (!file.flush() || file.err())
+		warning("MD5CacheManager: Could not write '%s'", node.getPath().c_str());
+}
+
+bool MD5CacheManager::getPersistentMD5(const Common::String &key, int64 fileSize, int64 modificationTime, Common::String &md5) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentHashMap::const_iterator i = persistentHashMap.find(key);
+	if (i == persistentHashMap.end() || i->_value.fileSize != fileSize || i->_value.modificationTime != modificationTime)
+		return false;
+
+	md5 = i->_value.md5;
+	return true;
+}
+
+void MD5CacheManager::setPersistentMD5(const Common::String &key, int64 fileSize, int64 modificationTime, const Common::String &md5) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	PersistentEntry &entry = persistentHashMap[key];
+	entry.fileSize = fileSize;
+	entry.modificationTime = modificationTime;
+	entry.md5 = md5;
+	persistentDirty = true;
+}
+
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -574,12 +683,43 @@ const char *md5PropToGameFile(MD5Properties flags) {
 
 static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngine::FileMap &allFiles, MD5Properties md5prop, const Common::String &fname, FileProperties &fileProps);
 
+/**
+ * Get the key of a file in the on-disk MD5 cache, along with the size and
+ * modification time validating the entry. Only plain files have one, since
+ * Mac forks may be looked up in several files.
+ */
+static bool getPersistentMD5Key(uint md5Bytes, const AdvancedMetaEngine::FileMap &allFiles, MD5Properties md5prop, const Common::String &fname, Common::String &key, int64 &fileSize, int64 &modificationTime) {
+	if (md5prop & (kMD5MacResFork | kMD5MacDataFork))
+		return false;
+
+	AdvancedMetaEngine::FileMap::const_iterator file = allFiles.find(fname);
+	if (file == allFiles.end() || !file->_value.getFileInfo(fileSize, modificationTime))
+		return false;
+
+	key = Common::String::format("%s:%d:%s", md5PropToCachePrefix(md5prop), md5Bytes, file->_value.getPath().c_str());
+	return true;
+}
+
 bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::String &fname, FileProperties &fileProps) const {
 	Common::String hashname = Common::String::format("%s:%s:%d", md5PropToCachePrefix(md5prop), fname.c_str(), _md5Bytes);
 
 	if (MD5Man.contains(hashname)) {
 		fileProps.md5 = MD5Man.getMD5(hashname);
 		fileProps.size = MD5Man.getSize(hashname);
+		if (!(md5prop & (kMD5MacResFork | kMD5MacDataFork)))
+			fileProps.md5prop = (MD5Properties)(md5prop & kMD5Tail);
+		return true;
+	}
+
+	Common::String key;
+	int64 fileSize, modificationTime;
+	const bool persistent = getPersistentMD5Key(_md5Bytes, allFiles, md5prop, fname, key, fileSize, modificationTime);
+
+	if (persistent && MD5Man.getPersistentMD5(key, fileSize, modificationTime, fileProps.md5)) {
+		fileProps.size = fileSize;
+		fileProps.md5prop = (MD5Properties)(md5prop & kMD5Tail);
+		MD5Man.setMD5(hashname, fileProps.md5);
+		MD5Man.setSize(hashname, fileProps.size);
 		return true;
 	}
 
@@ -588,11 +728,105 @@ bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, MD5
 	if (res) {
 		MD5Man.setMD5(hashname, fileProps.md5);
 		MD5Man.setSize(hashname, fileProps.size);
+
+		if (persistent && fileProps.size == fileSize)
+			MD5Man.setPersistentMD5(key, fileSize, modificationTime, fileProps.md5);
 	}
 
 	return res;
 }
 
+/** How many files precomputeFileProperties() keeps open at once. */
+static const uint kMaxFilesHashedAtOnce = 64;
+
+void AdvancedMetaEngineDetection::precomputeFileProperties(const FileMap &allFiles) const {
+	struct FileHash {
+		Common::String hashname;
+		Common::String key;
+		int64 fileSize;
+		int64 modificationTime;
+		MD5Properties md5prop;
+		Common::FSNode node;
+		Common::File *file;
+		uint8 digest[16];
+	};
+
+	// Gather the plain files which are neither in the memory nor in the
+	// disk cache yet. Mac forks are left to getFileProperties().
+	Common::Array<FileHash> hashes;
+	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> queued;
+
+	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
+		const ADGameDescription *g = (const ADGameDescription *)descPtr;
+
+		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
+			if (!allFiles.contains(fileDesc->fileName))
+				continue;
+
+			FileHash hash;
+			hash.md5prop = gameFileToMD5Props(fileDesc, g->flags);
+			hash.hashname = Common::String::format("%s:%s:%d", md5PropToCachePrefix(hash.md5prop), fileDesc->fileName, _md5Bytes);
+			if (MD5Man.contains(hash.hashname) || queued.contains(hash.hashname))
+				continue;
+
+			queued[hash.hashname] = true;
+
+			Common::String md5;
+			if (!getPersistentMD5Key(_md5Bytes, allFiles, hash.md5prop, fileDesc->fileName, hash.key, hash.fileSize, hash.modificationTime) ||
+			    MD5Man.getPersistentMD5(hash.key, hash.fileSize, hash.modificationTime, md5))
+				continue;
+
+			hash.node = allFiles[fileDesc->fileName];
+			hash.file = nullptr;
+			hashes.push_back(hash);
+		}
+	}
+
+	// Open the files here, since only the reading and hashing is safe to do
+	// on other threads
+	for (uint first = 0; first < hashes.size(); first += kMaxFilesHashedAtOnce) {
+		const uint last = MIN<uint>(first + kMaxFilesHashedAtOnce, hashes.size());
+
+		for (uint i = first; i < last; ++i) {
+			FileHash &hash = hashes[i];
+			hash.file = new Common::File();
+			if (!hash.file->open(hash.node)) {
+				delete hash.file;
+				hash.file = nullptr;
+			}
+		}
+
+		const uint md5Bytes = _md5Bytes;
+		JobMan.parallelFor(first, last, [&hashes, md5Bytes](int i) {
+			FileHash &hash = hashes[i];
+			if (!hash.file)
+				return;
+
+			if ((hash.md5prop & kMD5Tail) && hash.file->size() > md5Bytes)
+				hash.file->seek(-(int64)md5Bytes, SEEK_END);
+			Common::computeStreamMD5(*hash.file, hash.digest, md5Bytes);
+		});
+
+		for (uint i = first; i < last; ++i) {
+			FileHash &hash = hashes[i];
+			if (!hash.file)
+				continue;
+
+			const int64 size = hash.file->size();
+			delete hash.file;
+
+			Common::String md5;
+			for (int j = 0; j < 16; j++)
+				md5 += Common::String::format("%02x", (int)hash.digest[j]);
+
+			MD5Man.setMD5(hash.hashname, md5);
+			MD5Man.setSize(hash.hashname, size);
+			if (size == hash.fileSize)
+				MD5Man.setPersistentMD5(hash.key, hash.fileSize, hash.modificationTime, md5);
+		}
+	}
+}
+
 bool AdvancedMetaEngine::getFilePropertiesExtern(uint md5Bytes, const FileMap &allFiles, MD5Properties md5prop, const Common::String &fname, FileProperties &fileProps) const {
 	return getFilePropertiesIntern(md5Bytes, allFiles, md5prop, fname, fileProps);
 }
@@ -712,6 +946,7 @@ ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &pa
 	debugC(3, kDebugGlobalDetection, "Starting detection for engine '%s' in dir '%s'", getName(), parent.getPath().c_str());
 
 	preprocessDescriptions();
+	precomputeFileProperties(allFiles);
 
 	// Check which files are included in some ADGameDescription *and* whether
 	// they are present. Compute MD5s and file sizes for the available files.
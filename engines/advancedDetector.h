@@ -472,6 +472,13 @@ protected:
 	/** Get the properties (size and MD5) of this file. */
 	bool getFileProperties(const FileMap &allFiles, MD5Properties md5prop, const Common::String &fname, FileProperties &fileProps) const;
 
+	/**
+	 * Compute the MD5s of all the files from @p allFiles which are part of
+	 * the game descriptions, using all the CPU cores. The results end up in
+	 * the MD5 cache, where getFileProperties() picks them up.
+	 */
+	void precomputeFileProperties(const FileMap &allFiles) const;
+
 	/** Convert an AD game description into the shared game description format. */
 	virtual DetectedGame toDetectedGame(const ADDetectedGame &adGame, ADDetectedGameExtraInfo *extraInfo = nullptr) const;
 
@@ -595,7 +602,7 @@ public:
 		return (md5HashMap.contains(fname) && sizeHashMap.contains(fname));
 	}
 
-	MD5CacheManager() {
+	MD5CacheManager() : persistentLoaded(false), persistentDirty(false), persistentFlushTime(0) {
 		clear();
 	}
 
@@ -604,13 +611,47 @@ public:
 		sizeHashMap.clear(true);
 	}
 
+	/**
+	 * Look up an MD5 in the cache kept on disk across runs, which clear()
+	 * does not affect. An entry only matches while the file keeps the same
+	 * size and modification time.
+	 */
+	bool getPersistentMD5(const Common::String &key, int64 fileSize, int64 modificationTime, Common::String &md5);
+	void setPersistentMD5(const Common::String &key, int64 fileSize, int64 modificationTime, const Common::String &md5);
+
+	/**
+	 * Write the on-disk cache if it changed. Unless @p force is set, this
+	 * is skipped when the cache was written recently, so that it can be
+	 * called after detecting each directory of a large library.
+	 */
+	void flushPersistentCache(bool force);
+
 private:
 	friend class Common::Singleton<MD5CacheManager>;
 
+	~MD5CacheManager() {
+		flushPersistentCache(true);
+	}
+
+	void loadPersistentCache();
+	bool getPersistentCacheFile(Common::FSNode &node) const;
+
 	typedef Common::HashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileHashMap;
 	typedef Common::HashMap<Common::String, int64, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SizeHashMap;
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
+
+	struct PersistentEntry {
+		int64 fileSize;
+		int64 modificationTime;
+		Common::String md5;
+	};
+
+	typedef Common::HashMap<Common::String, PersistentEntry> PersistentHashMap;
+	PersistentHashMap persistentHashMap;
+	bool persistentLoaded;
+	bool persistentDirty;
+	uint32 persistentFlushTime;
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
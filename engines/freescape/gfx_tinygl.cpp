@@ -63,6 +63,7 @@ void TinyGLRenderer::init() {
 	computeScreenViewport();
 
 	TinyGL::createContext(_screenW, _screenH, g_system->getScreenFormat(), 512, true, ConfMan.getBool("dirtyrects"));
+	TinyGL::setRenderThreads(ConfMan.getInt("tinygl_threads"));
 
 	tglMatrixMode(TGL_PROJECTION);
 	tglLoadIdentity();
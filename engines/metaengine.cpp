@@ -26,7 +26,9 @@
 #include "backends/keymapper/standard-actions.h"
 
 #include "common/gui_options.h"
+#include "common/memstream.h"
 #include "common/savefile.h"
+#include "common/saveindex.h"
 #include "common/system.h"
 #include "common/translation.h"
 
@@ -356,6 +358,92 @@ int MetaEngine::findEmptySaveSlot(const char *target) {
 	return -1;
 }
 
+/**
+ * Return the save index which keeps the metadata of a savefile, if any.
+ */
+static Common::SaveIndex *getSaveIndex(const char *target, const Common::String &filename) {
+	// The save file manager finds the index of a savefile from its name.
+	if (!target || Common::SaveIndex::getTarget(filename) != target)
+		return nullptr;
+
+	return g_system->getSavefileManager()->getSaveIndex(target);
+}
+
+bool MetaEngine::findIndexedSaveMetaInfos(const char *target, int slot, bool loadThumbnail, SaveStateDescriptor &desc) const {
+	const Common::String filename = getSavegameFile(slot, target);
+	Common::SaveIndex *index = getSaveIndex(target, filename);
+	if (!index)
+		return false;
+
+	int64 size, modificationTime;
+	if (!g_system->getSavefileManager()->getSavefileInfo(filename, size, modificationTime))
+		return false;
+
+	const Common::SaveIndex::Entry *entry = index->find(filename, size, modificationTime);
+	if (!entry)
+		return false;
+
+	ExtendedSavegameHeader header;
+	header.description = entry->description;
+	header.date = entry->date;
+	header.time = entry->time;
+	header.playtime = entry->playTime;
+
+	desc = SaveStateDescriptor(this, slot, Common::U32String());
+	parseSavegameHeader(&header, &desc);
+	desc.setAutosave(entry->isAutosave);
+
+	if (loadThumbnail) {
+		Common::ScopedPtr<Common::SeekableReadStream> thumbnail(index->readThumbnail(filename));
+		if (thumbnail && Graphics::loadThumbnail(*thumbnail, header.thumbnail))
+			desc.setThumbnail(header.thumbnail);
+	}
+
+	return true;
+}
+
+void MetaEngine::indexSaveMetaInfos(const char *target, int slot, const ExtendedSavegameHeader &header) const {
+	const Common::String filename = getSavegameFile(slot, target);
+	Common::SaveIndex *index = getSaveIndex(target, filename);
+	if (!index)
+		return;
+
+	int64 size, modificationTime;
+	if (!g_system->getSavefileManager()->getSavefileInfo(filename, size, modificationTime))
+		return;
+
+	Common::SaveIndex::Entry entry;
+	entry.fileSize = size;
+	entry.modificationTime = modificationTime;
+	entry.description = header.description;
+	entry.date = header.date;
+	entry.time = header.time;
+	entry.playTime = header.playtime;
+	entry.isAutosave = header.isAutosave;
+
+	Common::Array<byte> thumbnail;
+	if (header.thumbnail) {
+		// Store the thumbnail at the size the save/load dialog shows it.
+		Common::ScopedPtr<Graphics::Surface> scaled;
+		const Graphics::Surface *thumb = header.thumbnail;
+		if (thumb->w > kThumbnailWidth) {
+			scaled.reset(thumb->scale(kThumbnailWidth, thumb->h * kThumbnailWidth / thumb->w, true));
+			thumb = scaled.get();
+		}
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		if (Graphics::saveThumbnail(out, *thumb)) {
+			thumbnail.resize(out.size());
+			memcpy(thumbnail.data(), out.getData(), out.size());
+		}
+
+		if (scaled)
+			scaled->free();
+	}
+
+	index->set(filename, entry, thumbnail);
+}
+
 SaveStateList MetaEngine::listSaves(const char *target) const {
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateList();
@@ -376,13 +464,21 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		int slotNum = atoi(slotStr);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
-			SaveStateDescriptor desc = querySaveMetaInfos(target, slotNum);
+			// Saves in the index are listed without their thumbnail, the
+			// save/load dialog queries the thumbnails of the page it shows.
+			SaveStateDescriptor desc;
+			if (!findIndexedSaveMetaInfos(target, slotNum, false, desc))
+				desc = querySaveMetaInfos(target, slotNum);
 			if (desc.getSaveSlot() != -1) {
 				saveList.push_back(desc);
 			}
 		}
 	}
 
+	Common::SaveIndex *index = saveFileMan->getSaveIndex(target);
+	if (index)
+		index->flush();
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
@@ -447,6 +543,10 @@ SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot)
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
+	SaveStateDescriptor indexed;
+	if (findIndexedSaveMetaInfos(target, slot, true, indexed))
+		return indexed;
+
 	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
 		getSavegameFile(slot, target)));
 
@@ -456,6 +556,9 @@ SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot)
 			return SaveStateDescriptor();
 		}
 
+		f.reset();
+		indexSaveMetaInfos(target, slot, header);
+
 		// Create the return descriptor
 		SaveStateDescriptor desc(this, slot, Common::U32String());
 		parseSavegameHeader(&header, &desc);
@@ -227,6 +227,25 @@ protected:
 	 */
 	int findEmptySaveSlot(const char *target);
 
+	/**
+	 * Look up the metadata of a savefile in the save index of the target,
+	 * which spares reading the whole savefile.
+	 *
+	 * @param target        Name of a config manager target.
+	 * @param slot          Slot number of the save state.
+	 * @param loadThumbnail Whether to read the thumbnail as well.
+	 * @param desc          Set to the metadata of the savefile.
+	 *
+	 * @return Whether the savefile was found in the index.
+	 */
+	bool findIndexedSaveMetaInfos(const char *target, int slot, bool loadThumbnail, SaveStateDescriptor &desc) const;
+
+	/**
+	 * Add the extended savegame header of a savefile to the save index of
+	 * the target.
+	 */
+	void indexSaveMetaInfos(const char *target, int slot, const ExtendedSavegameHeader &header) const;
+
 	/**
 	 * Return a list of extra GUI options for the specified target.
 	 *
@@ -68,6 +68,10 @@ public:
 	virtual void dimRegionInOut(float fade) = 0;
 	virtual void drawInViewport() = 0;
 	virtual void drawRgbaTexture() = 0;
+	/**
+	 *  Cover the viewport with as many shaded quads, every other one blended
+	 */
+	virtual void drawFillRateTest(int layers) = 0;
 
 	virtual void enableFog(const Math::Vector4d &fogColor) = 0;
 
@@ -359,6 +359,51 @@ void OpenGLRenderer::drawRgbaTexture() {
 	glPopMatrix();
 }
 
+void OpenGLRenderer::drawFillRateTest(int layers) {
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	glShadeModel(GL_SMOOTH);
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// Each quad is in front of the previous ones
+	for (int i = 0; i < layers; i++) {
+		if (i & 1)
+			glEnable(GL_BLEND);
+		else
+			glDisable(GL_BLEND);
+
+		const float shade = (float)i / layers;
+		const float z = 0.9f - 1.8f * shade;
+		glBegin(GL_TRIANGLE_STRIP);
+		glColor4f(shade, 0.0f, 1.0f - shade, 0.5f);
+		glVertex3f(-1.0f, 1.0f, z);
+		glColor4f(0.0f, 1.0f, shade, 0.5f);
+		glVertex3f(1.0f, 1.0f, z);
+		glColor4f(1.0f, shade, 0.0f, 0.5f);
+		glVertex3f(-1.0f, -1.0f, z);
+		glColor4f(shade, shade, shade, 0.5f);
+		glVertex3f(1.0f, -1.0f, z);
+		glEnd();
+	}
+
+	glDisable(GL_BLEND);
+
+	glMatrixMode(GL_MODELVIEW);
+	glPopMatrix();
+
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+}
+
 } // End of namespace Playground3d
 
 #endif
@@ -249,6 +249,10 @@ void ShaderRenderer::drawRgbaTexture() {
 	_bitmapShader->unbind();
 }
 
+void ShaderRenderer::drawFillRateTest(int layers) {
+	error("Fill rate test not implemented yet");
+}
+
 } // End of namespace Playground3d
 
 #endif
@@ -95,6 +95,7 @@ void TinyGLRenderer::init() {
 
 	_context = TinyGL::createContext(kOriginalWidth, kOriginalHeight, g_system->getScreenFormat(), 512, true, ConfMan.getBool("dirtyrects"));
 	TinyGL::setContext(_context);
+	TinyGL::setRenderThreads(ConfMan.getInt("tinygl_threads"));
 
 	tglMatrixMode(TGL_PROJECTION);
 	tglLoadIdentity();
@@ -430,4 +431,49 @@ void TinyGLRenderer::drawRgbaTexture() {
 	tglPopMatrix();
 }
 
+void TinyGLRenderer::drawFillRateTest(int layers) {
+	tglMatrixMode(TGL_PROJECTION);
+	tglPushMatrix();
+	tglLoadIdentity();
+
+	tglMatrixMode(TGL_MODELVIEW);
+	tglPushMatrix();
+	tglLoadIdentity();
+
+	tglShadeModel(TGL_SMOOTH);
+	tglEnable(TGL_DEPTH_TEST);
+	tglDepthFunc(TGL_LESS);
+	tglDepthMask(TGL_TRUE);
+	tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+
+	// Each quad is in front of the previous ones
+	for (int i = 0; i < layers; i++) {
+		if (i & 1)
+			tglEnable(TGL_BLEND);
+		else
+			tglDisable(TGL_BLEND);
+
+		const float shade = (float)i / layers;
+		const float z = 0.9f - 1.8f * shade;
+		tglBegin(TGL_TRIANGLE_STRIP);
+		tglColor4f(shade, 0.0f, 1.0f - shade, 0.5f);
+		tglVertex3f(-1.0f, 1.0f, z);
+		tglColor4f(0.0f, 1.0f, shade, 0.5f);
+		tglVertex3f(1.0f, 1.0f, z);
+		tglColor4f(1.0f, shade, 0.0f, 0.5f);
+		tglVertex3f(-1.0f, -1.0f, z);
+		tglColor4f(shade, shade, shade, 0.5f);
+		tglVertex3f(1.0f, -1.0f, z);
+		tglEnd();
+	}
+
+	tglDisable(TGL_BLEND);
+
+	tglMatrixMode(TGL_MODELVIEW);
+	tglPopMatrix();
+
+	tglMatrixMode(TGL_PROJECTION);
+	tglPopMatrix();
+}
+
 } // End of namespace Playground3d
@@ -54,6 +54,7 @@ public:
 	void dimRegionInOut(float fade) override;
 	void drawInViewport() override;
 	void drawRgbaTexture() override;
+	void drawFillRateTest(int layers) override;
 
 	void enableFog(const Math::Vector4d &fogColor) override;
 
@@ -59,7 +59,8 @@ Playground3dEngine::Playground3dEngine(OSystem *syst)
 		_clearColor(0.0f, 0.0f, 0.0f, 1.0f), _fogColor(0.0f, 0.0f, 0.0f, 1.0f),
         _fade(1.0f), _fadeIn(false),
 		_rgbaTexture(nullptr), _rgbTexture(nullptr), _rgb565Texture(nullptr),
-		_rgba5551Texture(nullptr), _rgba4444Texture(nullptr) {
+		_rgba5551Texture(nullptr), _rgba4444Texture(nullptr),
+		_fillRateStart(0), _fillRateDelay(0), _fillRateFrames(0) {
 }
 
 Playground3dEngine::~Playground3dEngine() {
@@ -80,6 +81,7 @@ Common::Error Playground3dEngine::run() {
 	// 3 - fade in/out
 	// 4 - moving filled rectangle in viewport
 	// 5 - drawing RGBA pattern texture to check endian correctness
+	// 6 - fill rate benchmark, with shaded, depth tested and blended quads
 	int testId = 1;
 	_fogEnable = false;
 
@@ -120,6 +122,10 @@ Common::Error Playground3dEngine::run() {
 			_rgba4444Texture = generateRgbaTexture(120, 120, pixelFormatRGB4444);
 			break;
 		}
+		case 6:
+			_clearColor = Math::Vector4d(0.0f, 0.0f, 0.0f, 1.0f);
+			_fillRateStart = _system->getMillis();
+			break;
 		default:
 			assert(false);
 	}
@@ -217,6 +223,25 @@ void Playground3dEngine::drawRgbaTexture() {
 	_gfx->drawRgbaTexture();
 }
 
+void Playground3dEngine::drawFillRateTest() {
+	_gfx->drawFillRateTest(kFillRateLayers);
+}
+
+void Playground3dEngine::reportFillRate() {
+	if (++_fillRateFrames < kFillRateFrames)
+		return;
+
+	// The time the frame limiter waited doesn't count
+	const Common::Rect vp = _gfx->viewport();
+	const uint32 millis = MAX<uint32>(_system->getMillis() - _fillRateStart - _fillRateDelay, 1);
+	const uint64 pixels = (uint64)vp.width() * vp.height() * kFillRateLayers * _fillRateFrames;
+	debug("Fill rate: %.1f Mpixels/s, %.1f fps", pixels / (millis * 1000.0), _fillRateFrames * 1000.0 / millis);
+
+	_fillRateFrames = 0;
+	_fillRateDelay = 0;
+	_fillRateStart = _system->getMillis();
+}
+
 void Playground3dEngine::drawFrame(int testId) {
 	_gfx->clear(_clearColor);
 
@@ -253,13 +278,24 @@ void Playground3dEngine::drawFrame(int testId) {
 			_gfx->loadTextureRGBA4444(_rgba4444Texture);
 			drawRgbaTexture();
 			break;
+		case 6:
+			drawFillRateTest();
+			break;
 		default:
 			assert(false);
 	}
 
 	_gfx->flipBuffer();
 
-	_frameLimiter->delayBeforeSwap();
+	if (testId == 6) {
+		// TinyGL draws when the buffer is flipped
+		const uint32 delayStart = _system->getMillis();
+		_frameLimiter->delayBeforeSwap();
+		_fillRateDelay += _system->getMillis() - delayStart;
+		reportFillRate();
+	} else {
+		_frameLimiter->delayBeforeSwap();
+	}
 	_system->updateScreen();
 	_frameLimiter->startFrame();
 }
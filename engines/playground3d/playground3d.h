@@ -62,12 +62,20 @@ private:
 
 	float _rotateAngleX, _rotateAngleY, _rotateAngleZ;
 
+	static const int kFillRateLayers = 8;
+	static const int kFillRateFrames = 100;
+	uint32 _fillRateStart;
+	uint32 _fillRateDelay;
+	int _fillRateFrames;
+
 	Graphics::Surface *generateRgbaTexture(int width, int height, Graphics::PixelFormat format);
 	void drawAndRotateCube();
 	void drawPolyOffsetTest();
 	void dimRegionInOut();
 	void drawInViewport();
 	void drawRgbaTexture();
+	void drawFillRateTest();
+	void reportFillRate();
 };
 
 } // End of namespace Playground3d
@@ -77,6 +77,7 @@ static int parse_reg_t(EngineState *s, const char *str, reg_t *dest);
 
 Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_engine(engine), _debugState(engine->_debugState), _videoFrameDelay(0),
+	_vmBenchmarkRunning(false), _vmBenchmarkStartTime(0), _vmBenchmarkDuration(0), _vmBenchmarkStartSteps(0),
 	_gameFlagsGlobal(_engine->_features->getGameFlagsGlobal()) {
 
 	assert(_engine);
@@ -119,6 +120,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -235,6 +237,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("vm_benchmark",		WRAP_METHOD(Console, cmdVMBenchmark));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -360,6 +363,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows statistics of the resource cache\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -450,6 +454,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" vm_benchmark - Runs a saved game as fast as possible and shows the number of SCI operations executed per second\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -1066,6 +1071,24 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	debugPrintf("Locked: %d bytes, cached: %d bytes of %d\n",
+		resMan->getMemoryLocked(), resMan->getMemoryCached(), resMan->getMaxMemoryCached());
+	debugPrintf("%-16s %8s %8s %10s %9s\n", "Type", "Hits", "Misses", "Prefetches", "Evictions");
+
+	for (int i = 0; i < kResourceTypeInvalid; ++i) {
+		const ResourceManager::CacheStats &stats = resMan->getCacheStats((ResourceType)i);
+		if (stats.hits || stats.misses || stats.prefetches || stats.evictions) {
+			debugPrintf("%-16s %8u %8u %10u %9u\n", getResourceTypeName((ResourceType)i),
+				stats.hits, stats.misses, stats.prefetches, stats.evictions);
+		}
+	}
+
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -3367,6 +3390,63 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMBenchmark(int argc, const char **argv) {
+	if (argc < 2 || argc > 3) {
+		debugPrintf("Restores a saved game and runs it without any delays for some time,\n");
+		debugPrintf("then shows the number of SCI operations executed per second\n");
+		debugPrintf("Usage: %s <filename> [<seconds>]\n", argv[0]);
+		debugPrintf("The game runs for 10 seconds by default\n");
+		return true;
+	}
+
+	int seconds = 10;
+	if (argc == 3 && (!parseInteger(argv[2], seconds) || seconds <= 0)) {
+		debugPrintf("Invalid number of seconds\n");
+		return true;
+	}
+
+	Common::SaveFileManager *saveFileMan = g_engine->getSaveFileManager();
+	Common::SeekableReadStream *in = saveFileMan->openForLoading(argv[1]);
+	if (!in) {
+		debugPrintf("Saved game '%s' not found.\n", argv[1]);
+		return true;
+	}
+
+	gamestate_restore(_engine->_gamestate, in);
+	delete in;
+
+	if (_engine->_gamestate->r_acc == make_reg(0, 1)) {
+		debugPrintf("Restoring gamestate '%s' failed.\n", argv[1]);
+		return true;
+	}
+
+	_vmBenchmarkSave = argv[1];
+	_vmBenchmarkRunning = true;
+	_vmBenchmarkStartTime = g_system->getMillis();
+	_vmBenchmarkDuration = seconds * 1000;
+	_vmBenchmarkStartSteps = _engine->_gamestate->scriptStepCounter;
+
+	return cmdExit(0, nullptr);
+}
+
+bool Console::updateVMBenchmark() {
+	if (!_vmBenchmarkRunning)
+		return false;
+
+	const uint32 elapsed = g_system->getMillis() - _vmBenchmarkStartTime;
+	if (elapsed < _vmBenchmarkDuration)
+		return true;
+
+	_vmBenchmarkRunning = false;
+
+	const uint32 steps = (uint32)_engine->_gamestate->scriptStepCounter - _vmBenchmarkStartSteps;
+	debugPrintf("Ran '%s' for %u ms: %u SCI operations, %u per second\n",
+		_vmBenchmarkSave.c_str(), elapsed, steps, (uint32)((uint64)steps * 1000 / elapsed));
+	attach();
+
+	return false;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	int curScriptNr = -1;
 
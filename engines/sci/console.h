@@ -46,6 +46,15 @@ public:
 	 */
 	void attach(const char *entry = nullptr) override;
 
+	/**
+	 * Checks whether the VM benchmark started by the vm_benchmark command is
+	 * still running, and reports its result once it is done. Called instead
+	 * of sleeping, so that the game runs as fast as possible meanwhile.
+	 *
+	 * @return Whether the benchmark is still running.
+	 */
+	bool updateVMBenchmark();
+
 private:
 	void preEnter() override;
 	void postEnter() override;
@@ -78,6 +87,7 @@ private:
 	bool cmdList(int argc, const char **argv);
 	bool cmdResourceIntegrityDump(int argc, const char **argv);
 	bool cmdAllocList(int argc, const char **argv);
+	bool cmdResourceCache(int argc, const char **argv);
 	bool cmdHexgrep(int argc, const char **argv);
 	bool cmdVerifyScripts(int argc, const char **argv);
 	// Game
@@ -162,6 +172,7 @@ private:
 	bool cmdBreakpointAddress(int argc, const char **argv);
 	// VM
 	bool cmdScriptSteps(int argc, const char **argv);
+	bool cmdVMBenchmark(int argc, const char **argv);
 	bool cmdScriptObjects(int argc, const char **argv);
 	bool cmdScriptStrings(int argc, const char **argv);
 	bool cmdScriptSaid(int argc, const char **argv);
@@ -219,6 +230,11 @@ private:
 	DebugState &_debugState;
 	Common::String _videoFile;
 	int _videoFrameDelay;
+	Common::String _vmBenchmarkSave;
+	bool _vmBenchmarkRunning;
+	uint32 _vmBenchmarkStartTime;
+	uint32 _vmBenchmarkDuration;
+	uint32 _vmBenchmarkStartSteps;
 	uint16 _gameFlagsGlobal;
 };
 
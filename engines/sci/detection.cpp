@@ -52,6 +52,7 @@ static const DebugChannelDef debugFlagList[] = {
 	{Sci::kDebugLevelAvoidPath, "Pathfinding", "Pathfinding debugging"},
 	{Sci::kDebugLevelDclInflate, "DCL", "DCL inflate debugging"},
 	{Sci::kDebugLevelVM, "VM", "VM debugging"},
+	{Sci::kDebugLevelVMChecks, "VMChecks", "Check the stack and jumps of every VM instruction"},
 	{Sci::kDebugLevelScripts, "Scripts", "Notifies when scripts are unloaded"},
 	{Sci::kDebugLevelPatcher, "Patcher", "Notifies when scripts or resources are patched"},
 	{Sci::kDebugLevelWorkarounds, "Workarounds", "Notifies when workarounds are triggered"},
@@ -277,6 +277,12 @@ public:
 	reg_t &getVariableRef(uint var) { return _variables[var]; }
 
 	uint16 getMethodCount() const { return _methodCount; }
+
+	/**
+	 * @returns The data the object was loaded from. Clones share it with the
+	 * object they were cloned from.
+	 */
+	const byte *getBaseData() const { return _baseObj.data(); }
 	reg_t getPos() const { return _pos; }
 
 	void saveLoadWithSerializer(Common::Serializer &ser) override;
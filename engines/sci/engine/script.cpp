@@ -74,6 +74,32 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_instructionIndex.clear();
+	_instructions.clear();
+}
+
+const PMachineInstruction &Script::decodeInstruction(uint32 offset) {
+	if (offset >= _buf->size())
+		error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
+			offset, _buf->size());
+
+	PMachineInstruction instruction;
+	instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.opparams);
+
+	if (_instructionIndex.empty())
+		_instructionIndex.resize(_buf->size());
+
+	// The index holds 16 bit numbers, so once they are all used up the
+	// remaining instructions are decoded every time
+	if (_instructions.size() >= 0xFFFF) {
+		_uncachedInstruction = instruction;
+		return _uncachedInstruction;
+	}
+
+	_instructions.push_back(instruction);
+	_instructionIndex[offset] = _instructions.size();
+	return _instructions.back();
 }
 
 enum {
@@ -59,6 +59,15 @@ enum : uint {
 	kNoRelocation = 0xFFFFFFFF
 };
 
+/**
+ * A PMachine instruction, as decoded by readPMachineInstruction().
+ */
+struct PMachineInstruction {
+	int16 opparams[4];
+	byte extOpcode;
+	uint16 size; ///< Length of the instruction in bytes
+};
+
 struct offsetLookupArrayEntry {
 	uint16    type;       // type of entry
 	uint16    id;         // id of this type, first item inside script data is 1, second item is 2, etc.
@@ -101,6 +110,16 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * Index + 1 in _instructions of the instruction at each offset of the
+	 * buffer, 0 if the instruction was not decoded yet. Only allocated once
+	 * code of the script is run.
+	 */
+	Common::Array<uint16> _instructionIndex;
+	Common::Array<PMachineInstruction> _instructions;
+	/** Used for the instructions which do not fit in _instructions anymore */
+	PMachineInstruction _uncachedInstruction;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -126,6 +145,22 @@ public:
 	ObjMap &getObjectMap() { return _objects; }
 	const ObjMap &getObjectMap() const { return _objects; }
 
+	/**
+	 * Returns the instruction at the given offset of the buffer. Every
+	 * instruction is only decoded the first time it is run; run_vm() uses
+	 * this instead of readPMachineInstruction().
+	 *
+	 * The returned reference is only valid until the next call.
+	 */
+	const PMachineInstruction &getInstruction(uint32 offset) {
+		if (offset < _instructionIndex.size()) {
+			const uint16 index = _instructionIndex[offset];
+			if (index)
+				return _instructions[index - 1];
+		}
+		return decodeInstruction(offset);
+	}
+
 	// speed optimization: inline due to frequent calling
 	bool offsetIsObject(uint32 offset) const {
 		return _buf->getUint16SEAt(offset + SCRIPT_OBJECT_MAGIC_OFFSET) == SCRIPT_OBJECT_MAGIC_NUMBER;
@@ -367,6 +402,8 @@ private:
 	 * Apply workarounds to known broken Said strings
 	 */
 	void applySaidWorkarounds();
+
+	const PMachineInstruction &decodeInstruction(uint32 offset);
 };
 
 } // End of namespace Sci
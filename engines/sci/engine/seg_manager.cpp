@@ -79,6 +79,8 @@ void SegManager::resetSegMan() {
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
+
+	_selectorLookupCache.clear();
 }
 
 void SegManager::initSysStrings() {
@@ -166,6 +168,7 @@ void SegManager::deallocate(SegmentId seg) {
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
+		_selectorLookupCache.clear();
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
 			// If the locals block has been stored in a segment with an ID
@@ -1087,6 +1090,7 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 			return segmentId;
 		} else {
 			scr->freeScript(true);
+			_selectorLookupCache.clear();
 		}
 	} else {
 		scr = allocateScript(scriptNum, &segmentId);
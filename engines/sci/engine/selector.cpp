@@ -327,6 +327,13 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
+void SelectorLookupCache::clear() {
+	for (uint i = 0; i < kSize; ++i) {
+		_entries[i].baseData = nullptr;
+		_entries[i].selector = -1;
+	}
+}
+
 SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
 	const Object *obj = segMan->getObject(obj_location);
 	int index;
@@ -342,34 +349,57 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
 	}
 
-	index = obj->locateVarSelector(segMan, selectorId);
+	// The result only depends on the object's variable and method tables
+	// and those of its superclasses
+	const byte *baseData = obj->getBaseData();
+	const reg_t superClass = obj->getSuperClassSelector();
+	const bool isClass = obj->isClass();
+	SelectorLookupCache::Entry &entry = segMan->getSelectorLookupCache().getEntry(baseData, selectorId);
+
+	if (!(entry.baseData == baseData && entry.selector == selectorId && entry.superClass == superClass && entry.isClass == isClass)) {
+		entry.baseData = baseData;
+		entry.selector = selectorId;
+		entry.superClass = superClass;
+		entry.isClass = isClass;
+		entry.type = kSelectorNone;
+
+		index = obj->locateVarSelector(segMan, selectorId);
+
+		if (index >= 0) {
+			// Found it as a variable
+			entry.type = kSelectorVariable;
+			entry.varIndex = index;
+		} else {
+			// Check if it's a method, with recursive lookup in superclasses
+			while (obj) {
+				index = obj->funcSelectorPosition(selectorId);
+				if (index >= 0) {
+					entry.type = kSelectorMethod;
+					entry.function = obj->getFunction(index);
+					break;
+				} else {
+					obj = segMan->getObject(obj->getSuperClassSelector());
+				}
+			}
+		}
+	}
 
-	if (index >= 0) {
-		// Found it as a variable
+	switch (entry.type) {
+	case kSelectorVariable:
 		if (varp) {
 			varp->obj = obj_location;
-			varp->varindex = index;
-		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
-			}
+			varp->varindex = entry.varIndex;
 		}
-
-		return kSelectorNone;
+		break;
+	case kSelectorMethod:
+		if (fptr)
+			*fptr = entry.function;
+		break;
+	default:
+		break;
 	}
 
-
-//	return _lookupSelector_function(segMan, obj, selectorId, fptr);
+	return entry.type;
 }
 
 } // End of namespace Sci
@@ -179,8 +179,8 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 // 16 bit:
 #define PUSH(v) PUSH32(make_reg(0, v))
 // 32 bit:
-#define PUSH32(a) (*(validate_stack_addr(s, (s->xs->sp)++)) = (a))
-#define POP32() (*(validate_stack_addr(s, --(s->xs->sp))))
+#define PUSH32(a) (*(vmChecks ? validate_stack_addr(s, (s->xs->sp)++) : (s->xs->sp)++) = (a))
+#define POP32() (*(vmChecks ? validate_stack_addr(s, --(s->xs->sp)) : --(s->xs->sp)))
 
 ExecStack *execute_method(EngineState *s, uint16 script, uint16 pubfunct, StackPtr sp, reg_t calling_obj, uint16 argc, StackPtr argp) {
 	int seg = s->_segMan->getScriptSegment(script);
@@ -539,13 +539,96 @@ uint32 findOffset(const int16 relOffset, const Script *scr, const uint32 pcOffse
 	return offset;
 }
 
+// Reads the instruction at the program counter and moves past it. The
+// operands are read in place from the decoded instruction cache of the
+// script, so they must not be used after anything which may run scripts.
+#define VM_FETCH() \
+	do { \
+		const PMachineInstruction &instruction = scr->getInstruction(s->xs->addr.pc.getOffset()); \
+		opparams = instruction.opparams; \
+		extOpcode = instruction.extOpcode; \
+		s->xs->addr.pc.incOffset(instruction.size); \
+		opcode = extOpcode >> 1; \
+	} while (0)
+
+#if defined(__GNUC__) && !defined(ABORT_ON_INFINITE_LOOP)
+// Threaded dispatch: each instruction jumps straight to the code of the next
+// one through a table of label addresses, which keeps the indirect jumps
+// apart for the branch predictor. Whenever the execution stack changes, or
+// something wants to see every instruction, the instruction ends by going
+// around the loop in run_vm() instead.
+#define VM_THREADED_DISPATCH
+// Label addresses and computed gotos are GNU extensions
+#pragma GCC diagnostic ignored "-Wpedantic"
+#define VM_LABEL(name) label_##name:
+#define VM_NEXT() \
+	if (fastDispatch && !s->_executionStackPosChanged && s->abortScriptProcessing == kAbortNone && !g_sci->_debugState.debugging) { \
+		++s->scriptStepCounter; \
+		g_sci->_debugState.old_pc_offset = s->xs->addr.pc.getOffset(); \
+		g_sci->_debugState.old_sp = s->xs->sp; \
+		VM_FETCH(); \
+		goto *dispatchTable[opcode]; \
+	} \
+	break
+#else
+#define VM_LABEL(name)
+#define VM_NEXT() break
+#endif
+
+#define VM_OP(op) VM_LABEL(op) case op
+
 void run_vm(EngineState *s) {
 	assert(s);
 
 	int temp;
 	reg_t r_temp; // Temporary register
 	StackPtr s_temp; // Temporary stack pointer
-	int16 opparams[4]; // opcode parameters
+	const int16 *opparams; // opcode parameters
+	byte extOpcode;
+	byte opcode;
+	// Whether to check the stack and the jumps of every instruction
+	bool vmChecks = false;
+
+#ifdef VM_THREADED_DISPATCH
+	// Whether instructions may go on to the next one without going around
+	// the loop below
+	bool fastDispatch = false;
+
+	static const void *const dispatchTable[128] = {
+		&&label_op_bnot, &&label_op_add, &&label_op_sub, &&label_op_mul,
+		&&label_op_div, &&label_op_mod, &&label_op_shr, &&label_op_shl,
+		&&label_op_xor, &&label_op_and, &&label_op_or, &&label_op_neg,
+		&&label_op_not, &&label_op_eq_, &&label_op_ne_, &&label_op_gt_,
+		&&label_op_ge_, &&label_op_lt_, &&label_op_le_, &&label_op_ugt_,
+		&&label_op_uge_, &&label_op_ult_, &&label_op_ule_, &&label_op_bt,
+		&&label_op_bnt, &&label_op_jmp, &&label_op_ldi, &&label_op_push,
+		&&label_op_pushi, &&label_op_toss, &&label_op_dup, &&label_op_link,
+		&&label_op_call, &&label_op_callk, &&label_op_callb, &&label_op_calle,
+		&&label_op_ret, &&label_op_send, &&label_op_info, &&label_op_superP,
+		&&label_op_class, &&label_dummy, &&label_op_self, &&label_op_super,
+		&&label_op_rest, &&label_op_lea, &&label_op_selfID, &&label_dummy,
+		&&label_op_pprev, &&label_op_pToa, &&label_op_aTop, &&label_op_pTos,
+		&&label_op_sTop, &&label_op_ipToa, &&label_op_dpToa, &&label_op_ipTos,
+		&&label_op_dpTos, &&label_op_lofsa, &&label_op_lofss, &&label_op_push0,
+		&&label_op_push1, &&label_op_push2, &&label_op_pushSelf, &&label_op_line,
+		&&label_op_lag, &&label_op_lal, &&label_op_lat, &&label_op_lap,
+		&&label_op_lsg, &&label_op_lsl, &&label_op_lst, &&label_op_lsp,
+		&&label_op_lagi, &&label_op_lali, &&label_op_lati, &&label_op_lapi,
+		&&label_op_lsgi, &&label_op_lsli, &&label_op_lsti, &&label_op_lspi,
+		&&label_op_sag, &&label_op_sal, &&label_op_sat, &&label_op_sap,
+		&&label_op_ssg, &&label_op_ssl, &&label_op_sst, &&label_op_ssp,
+		&&label_op_sagi, &&label_op_sali, &&label_op_sati, &&label_op_sapi,
+		&&label_op_ssgi, &&label_op_ssli, &&label_op_ssti, &&label_op_sspi,
+		&&label_op_plusag, &&label_op_plusal, &&label_op_plusat, &&label_op_plusap,
+		&&label_op_plussg, &&label_op_plussl, &&label_op_plusst, &&label_op_plussp,
+		&&label_op_plusagi, &&label_op_plusali, &&label_op_plusati, &&label_op_plusapi,
+		&&label_op_plussgi, &&label_op_plussli, &&label_op_plussti, &&label_op_plusspi,
+		&&label_op_minusag, &&label_op_minusal, &&label_op_minusat, &&label_op_minusap,
+		&&label_op_minussg, &&label_op_minussl, &&label_op_minusst, &&label_op_minussp,
+		&&label_op_minusagi, &&label_op_minusali, &&label_op_minusati, &&label_op_minusapi,
+		&&label_op_minussgi, &&label_op_minussli, &&label_op_minussti, &&label_op_minusspi
+	};
+#endif
 
 	s->r_rest = 0;	// &rest adjusts the parameter count by this value
 	// Current execution data:
@@ -617,18 +700,19 @@ void run_vm(EngineState *s) {
 		Console *con = g_sci->getSciDebugger();
 		con->onFrame();
 
-		if (s->xs->sp < s->xs->fp)
+		// The debugger may have changed any of these
+		vmChecks = DebugMan.isDebugChannelEnabled(kDebugLevelVMChecks);
+#ifdef VM_THREADED_DISPATCH
+		fastDispatch = !vmChecks && !(g_sci->_debugState._activeBreakpointTypes & BREAK_ADDRESS) && !con->isAttached();
+#endif
+
+		if (vmChecks && s->xs->sp < s->xs->fp)
 			error("run_vm(): stack underflow, sp: %04x:%04x, fp: %04x:%04x",
 			PRINT_REG(*s->xs->sp), PRINT_REG(*s->xs->fp));
 
-		if (s->xs->addr.pc.getOffset() >= scr->getBufSize())
-			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
-			s->xs->addr.pc.getOffset(), scr->getBufSize());
-
-		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
-		const byte opcode = extOpcode >> 1;
+		// Get opcode. Instructions are decoded the first time they are run,
+		// which also checks that the program counter is within the script
+		VM_FETCH();
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
 #ifdef ABORT_ON_INFINITE_LOOP
@@ -646,175 +730,178 @@ void run_vm(EngineState *s) {
 		prevOpcode = opcode;
 #endif
 
+#ifdef VM_THREADED_DISPATCH
+		goto *dispatchTable[opcode];
+#endif
 		switch (opcode) {
 
-		case op_bnot: // 0x00 (00)
+		VM_OP(op_bnot): // 0x00 (00)
 			// Binary not
 			s->r_acc = make_reg(0, 0xffff ^ s->r_acc.requireUint16());
-			break;
+			VM_NEXT();
 
-		case op_add: // 0x01 (01)
+		VM_OP(op_add): // 0x01 (01)
 			s->r_acc = POP32() + s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_sub: // 0x02 (02)
+		VM_OP(op_sub): // 0x02 (02)
 			s->r_acc = POP32() - s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_mul: // 0x03 (03)
+		VM_OP(op_mul): // 0x03 (03)
 			s->r_acc = POP32() * s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_div: // 0x04 (04)
+		VM_OP(op_div): // 0x04 (04)
 			// we check for division by 0 inside the custom reg_t division operator
 			s->r_acc = POP32() / s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_mod: // 0x05 (05)
+		VM_OP(op_mod): // 0x05 (05)
 			// we check for division by 0 inside the custom reg_t modulo operator
 			s->r_acc = POP32() % s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_shr: // 0x06 (06)
+		VM_OP(op_shr): // 0x06 (06)
 			// Shift right logical
 			s->r_acc = POP32() >> s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_shl: // 0x07 (07)
+		VM_OP(op_shl): // 0x07 (07)
 			// Shift left logical
 			s->r_acc = POP32() << s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_xor: // 0x08 (08)
+		VM_OP(op_xor): // 0x08 (08)
 			s->r_acc = POP32() ^ s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_and: // 0x09 (09)
+		VM_OP(op_and): // 0x09 (09)
 			s->r_acc = POP32() & s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_or: // 0x0a (10)
+		VM_OP(op_or): // 0x0a (10)
 			s->r_acc = POP32() | s->r_acc;
-			break;
+			VM_NEXT();
 
-		case op_neg:	// 0x0b (11)
+		VM_OP(op_neg):	// 0x0b (11)
 			s->r_acc = make_reg(0, -s->r_acc.requireSint16());
-			break;
+			VM_NEXT();
 
-		case op_not: // 0x0c (12)
+		VM_OP(op_not): // 0x0c (12)
 			s->r_acc = make_reg(0, !(s->r_acc.getOffset() || s->r_acc.getSegment()));
 			// Must allow pointers to be negated, as this is used for checking whether objects exist
-			break;
+			VM_NEXT();
 
-		case op_eq_: // 0x0d (13)
+		VM_OP(op_eq_): // 0x0d (13)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() == s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_ne_: // 0x0e (14)
+		VM_OP(op_ne_): // 0x0e (14)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() != s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_gt_: // 0x0f (15)
+		VM_OP(op_gt_): // 0x0f (15)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() > s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_ge_: // 0x10 (16)
+		VM_OP(op_ge_): // 0x10 (16)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() >= s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_lt_: // 0x11 (17)
+		VM_OP(op_lt_): // 0x11 (17)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() < s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_le_: // 0x12 (18)
+		VM_OP(op_le_): // 0x12 (18)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() <= s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_ugt_: // 0x13 (19)
+		VM_OP(op_ugt_): // 0x13 (19)
 			// > (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().gtU(s->r_acc));
-			break;
+			VM_NEXT();
 
-		case op_uge_: // 0x14 (20)
+		VM_OP(op_uge_): // 0x14 (20)
 			// >= (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().geU(s->r_acc));
-			break;
+			VM_NEXT();
 
-		case op_ult_: // 0x15 (21)
+		VM_OP(op_ult_): // 0x15 (21)
 			// < (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().ltU(s->r_acc));
-			break;
+			VM_NEXT();
 
-		case op_ule_: // 0x16 (22)
+		VM_OP(op_ule_): // 0x16 (22)
 			// <= (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().leU(s->r_acc));
-			break;
+			VM_NEXT();
 
-		case op_bt: // 0x17 (23)
+		VM_OP(op_bt): // 0x17 (23)
 			// Branch relative if true
 			if (s->r_acc.getOffset() || s->r_acc.getSegment())
 				s->xs->addr.pc.incOffset(opparams[0]);
 
-			if (s->xs->addr.pc.getOffset() >= local_script->getScriptSize())
+			if (vmChecks && s->xs->addr.pc.getOffset() >= local_script->getScriptSize())
 				error("[VM] op_bt: request to jump past the end of script %d (offset %d, script is %d bytes)",
 					local_script->getScriptNumber(), s->xs->addr.pc.getOffset(), local_script->getScriptSize());
-			break;
+			VM_NEXT();
 
-		case op_bnt: // 0x18 (24)
+		VM_OP(op_bnt): // 0x18 (24)
 			// Branch relative if not true
 			if (!(s->r_acc.getOffset() || s->r_acc.getSegment()))
 				s->xs->addr.pc.incOffset(opparams[0]);
 
-			if (s->xs->addr.pc.getOffset() >= local_script->getScriptSize())
+			if (vmChecks && s->xs->addr.pc.getOffset() >= local_script->getScriptSize())
 				error("[VM] op_bnt: request to jump past the end of script %d (offset %d, script is %d bytes)",
 					local_script->getScriptNumber(), s->xs->addr.pc.getOffset(), local_script->getScriptSize());
-			break;
+			VM_NEXT();
 
-		case op_jmp: // 0x19 (25)
+		VM_OP(op_jmp): // 0x19 (25)
 			s->xs->addr.pc.incOffset(opparams[0]);
 
-			if (s->xs->addr.pc.getOffset() >= local_script->getScriptSize())
+			if (vmChecks && s->xs->addr.pc.getOffset() >= local_script->getScriptSize())
 				error("[VM] op_jmp: request to jump past the end of script %d (offset %d, script is %d bytes)",
 					local_script->getScriptNumber(), s->xs->addr.pc.getOffset(), local_script->getScriptSize());
-			break;
+			VM_NEXT();
 
-		case op_ldi: // 0x1a (26)
+		VM_OP(op_ldi): // 0x1a (26)
 			// Load data immediate
 			s->r_acc = make_reg(0, opparams[0]);
-			break;
+			VM_NEXT();
 
-		case op_push: // 0x1b (27)
+		VM_OP(op_push): // 0x1b (27)
 			// Push to stack
 			PUSH32(s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_pushi: // 0x1c (28)
+		VM_OP(op_pushi): // 0x1c (28)
 			// Push immediate
 			PUSH(opparams[0]);
-			break;
+			VM_NEXT();
 
-		case op_toss: // 0x1d (29)
+		VM_OP(op_toss): // 0x1d (29)
 			// TOS (Top Of Stack) subtract
 			s->xs->sp--;
-			break;
+			VM_NEXT();
 
-		case op_dup: // 0x1e (30)
+		VM_OP(op_dup): // 0x1e (30)
 			// Duplicate TOD (Top Of Stack) element
 			r_temp = s->xs->sp[-1];
 			PUSH32(r_temp);
-			break;
+			VM_NEXT();
 
-		case op_link: // 0x1f (31)
+		VM_OP(op_link): // 0x1f (31)
 			s->variablesMax[VAR_TEMP] = s->xs->tempCount = opparams[0];
 
 			// We shouldn't initialize temp variables at all
@@ -823,9 +910,9 @@ void run_vm(EngineState *s) {
 				s->xs->sp[i] = make_reg(kUninitializedSegment, 0);
 
 			s->xs->sp += opparams[0];
-			break;
+			VM_NEXT();
 
-		case op_call: { // 0x20 (32)
+		VM_OP(op_call): { // 0x20 (32)
 			// Call a script subroutine
 			int argc = (opparams[1] >> 1) // Given as offset, but we need count
 			           + 1 + s->r_rest;
@@ -848,10 +935,10 @@ void run_vm(EngineState *s) {
 			s->xs->sp = call_base;
 
 			s->_executionStackPosChanged = true;
-			break;
+			VM_NEXT();
 		}
 
-		case op_callk: { // 0x21 (33)
+		VM_OP(op_callk): { // 0x21 (33)
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
@@ -885,10 +972,10 @@ void run_vm(EngineState *s) {
 			if (s->abortScriptProcessing != kAbortNone)
 				return; // Stop processing
 
-			break;
+			VM_NEXT();
 		}
 
-		case op_callb: // 0x22 (34)
+		VM_OP(op_callb): // 0x22 (34)
 			// Call base script
 			temp = ((opparams[1] >> 1) + s->r_rest + 1);
 			s_temp = s->xs->sp;
@@ -900,9 +987,9 @@ void run_vm(EngineState *s) {
 			s->r_rest = 0; // Used up the &rest adjustment
 			if (xs_new)    // in case of error, keep old stack
 				s->_executionStackPosChanged = true;
-			break;
+			VM_NEXT();
 
-		case op_calle: // 0x23 (35)
+		VM_OP(op_calle): // 0x23 (35)
 			// Call external script
 			temp = ((opparams[2] >> 1) + s->r_rest + 1);
 			s_temp = s->xs->sp;
@@ -914,9 +1001,9 @@ void run_vm(EngineState *s) {
 			s->r_rest = 0; // Used up the &rest adjustment
 			if (xs_new)  // in case of error, keep old stack
 				s->_executionStackPosChanged = true;
-			break;
+			VM_NEXT();
 
-		case op_ret: // 0x24 (36)
+		VM_OP(op_ret): // 0x24 (36)
 			// Return from an execution loop started by call, calle, callb, send, self or super
 			do {
 				StackPtr old_sp = s->xs->sp;
@@ -960,9 +1047,9 @@ void run_vm(EngineState *s) {
 			s->_executionStackPosChanged = true;
 			xs_new = s->xs;
 
-			break;
+			VM_NEXT();
 
-		case op_send: // 0x25 (37)
+		VM_OP(op_send): // 0x25 (37)
 			// Send for one or more selectors
 			s_temp = s->xs->sp;
 			s->xs->sp -= ((opparams[0] >> 1) + s->r_rest); // Adjust stack
@@ -976,9 +1063,9 @@ void run_vm(EngineState *s) {
 
 			s->r_rest = 0;
 
-			break;
+			VM_NEXT();
 
-		case op_info: // (38)
+		VM_OP(op_info): // (38)
 			if (getSciVersion() < SCI_VERSION_3)
 				error("Dummy opcode 0x%x called", opcode);	// should never happen
 
@@ -986,9 +1073,9 @@ void run_vm(EngineState *s) {
 				s->r_acc = obj->getInfoSelector();
 			else
 				PUSH32(obj->getInfoSelector());
-			break;
+			VM_NEXT();
 
-		case op_superP: // (39)
+		VM_OP(op_superP): // (39)
 			if (getSciVersion() < SCI_VERSION_3)
 				error("Dummy opcode 0x%x called", opcode);	// should never happen
 
@@ -996,19 +1083,21 @@ void run_vm(EngineState *s) {
 				s->r_acc = obj->getSuperClassSelector();
 			else
 				PUSH32(obj->getSuperClassSelector());
-			break;
+			VM_NEXT();
 
-		case op_class: // 0x28 (40)
+		VM_OP(op_class): // 0x28 (40)
 			// Get class address
 			s->r_acc = s->_segMan->getClassAddress((unsigned)opparams[0], SCRIPT_GET_LOCK,
 											s->xs->addr.pc.getSegment());
-			break;
+			VM_NEXT();
 
 		case 0x29: // (41)
+		case 0x2f: // (47)
+		VM_LABEL(dummy)
 			error("Dummy opcode 0x%x called", opcode);	// should never happen
-			break;
+			VM_NEXT();
 
-		case op_self: // 0x2a (42)
+		VM_OP(op_self): // 0x2a (42)
 			// Send to self
 			s_temp = s->xs->sp;
 			s->xs->sp -= ((opparams[0] >> 1) + s->r_rest); // Adjust stack
@@ -1022,9 +1111,9 @@ void run_vm(EngineState *s) {
 				s->_executionStackPosChanged = true;
 
 			s->r_rest = 0;
-			break;
+			VM_NEXT();
 
-		case op_super: // 0x2b (43)
+		VM_OP(op_super): // 0x2b (43)
 			// Send to any class
 			r_temp = s->_segMan->getClassAddress(opparams[0], SCRIPT_GET_LOAD, s->xs->addr.pc.getSegment());
 
@@ -1053,9 +1142,9 @@ void run_vm(EngineState *s) {
 				s->r_rest = 0;
 			}
 
-			break;
+			VM_NEXT();
 
-		case op_rest: // 0x2c (44)
+		VM_OP(op_rest): // 0x2c (44)
 			// Pushes all or part of the parameter variable list on the stack
 			// Index 0 is argc, so normally this will be called as &rest 1 to
 			// forward all the arguments.
@@ -1065,9 +1154,9 @@ void run_vm(EngineState *s) {
 			for (; temp <= s->xs->argc; temp++)
 				PUSH32(s->xs->variables_argp[temp]);
 
-			break;
+			VM_NEXT();
 
-		case op_lea: // 0x2d (45)
+		VM_OP(op_lea): // 0x2d (45)
 			// Load Effective Address
 			temp = (uint16) opparams[0] >> 1;
 			var_number = temp & 0x03; // Get variable type
@@ -1083,25 +1172,21 @@ void run_vm(EngineState *s) {
 			r_temp.setOffset(r_temp.getOffset() * 2); // variables are 16 bit
 			// That's the immediate address now
 			s->r_acc = r_temp;
-			break;
+			VM_NEXT();
 
 
-		case op_selfID: // 0x2e (46)
+		VM_OP(op_selfID): // 0x2e (46)
 			// Get 'self' identity
 			s->r_acc = s->xs->objp;
-			break;
-
-		case 0x2f: // (47)
-			error("Dummy opcode 0x%x called", opcode);	// should never happen
-			break;
+			VM_NEXT();
 
-		case op_pprev: // 0x30 (48)
+		VM_OP(op_pprev): // 0x30 (48)
 			// Pushes the value of the prev register, set by the last comparison
 			// bytecode (eq?, lt?, etc.), on the stack
 			PUSH32(s->r_prev);
-			break;
+			VM_NEXT();
 
-		case op_pToa: // 0x31 (49)
+		VM_OP(op_pToa): // 0x31 (49)
 			// Property To Accumulator
 			if (g_sci->_debugState._activeBreakpointTypes & BREAK_SELECTORREAD) {
 				debugPropertyAccess(obj, s->xs->objp, opparams[0], NULL_SELECTOR,
@@ -1109,9 +1194,9 @@ void run_vm(EngineState *s) {
 				                    s->_segMan, BREAK_SELECTORREAD);
 			}
 			s->r_acc = validate_property(s, obj, opparams[0]);
-			break;
+			VM_NEXT();
 
-		case op_aTop: // 0x32 (50)
+		VM_OP(op_aTop): // 0x32 (50)
 			{
 			// Accumulator To Property
 			reg_t &opProperty = validate_property(s, obj, opparams[0]);
@@ -1125,10 +1210,10 @@ void run_vm(EngineState *s) {
 #ifdef ENABLE_SCI32
 			updateInfoFlagViewVisible(obj, opparams[0], true);
 #endif
-			break;
+			VM_NEXT();
 		}
 
-		case op_pTos: // 0x33 (51)
+		VM_OP(op_pTos): // 0x33 (51)
 			{
 			// Property To Stack
 			reg_t value = validate_property(s, obj, opparams[0]);
@@ -1138,10 +1223,10 @@ void run_vm(EngineState *s) {
 				                    s->_segMan, BREAK_SELECTORREAD);
 			}
 			PUSH32(value);
-			break;
+			VM_NEXT();
 		}
 
-		case op_sTop: // 0x34 (52)
+		VM_OP(op_sTop): // 0x34 (52)
 			{
 			// Stack To Property
 			reg_t newValue = POP32();
@@ -1155,13 +1240,13 @@ void run_vm(EngineState *s) {
 #ifdef ENABLE_SCI32
 			updateInfoFlagViewVisible(obj, opparams[0], true);
 #endif
-			break;
+			VM_NEXT();
 		}
 
-		case op_ipToa: // 0x35 (53)
-		case op_dpToa: // 0x36 (54)
-		case op_ipTos: // 0x37 (55)
-		case op_dpTos: // 0x38 (56)
+		VM_OP(op_ipToa): // 0x35 (53)
+		VM_OP(op_dpToa): // 0x36 (54)
+		VM_OP(op_ipTos): // 0x37 (55)
+		VM_OP(op_dpTos): // 0x38 (56)
 			{
 			// Increment/decrement a property and copy to accumulator,
 			// or push to stack
@@ -1192,11 +1277,11 @@ void run_vm(EngineState *s) {
 				s->r_acc = opProperty;
 			else
 				PUSH32(opProperty);
-			break;
+			VM_NEXT();
 		}
 
-		case op_lofsa: // 0x39 (57)
-		case op_lofss: { // 0x3a (58)
+		VM_OP(op_lofsa): // 0x39 (57)
+		VM_OP(op_lofss): { // 0x3a (58)
 			// Load offset to accumulator or push to stack
 
 			r_temp.setSegment(s->xs->addr.pc.getSegment());
@@ -1209,22 +1294,22 @@ void run_vm(EngineState *s) {
 				s->r_acc = r_temp;
 			else
 				PUSH32(r_temp);
-			break;
+			VM_NEXT();
 		}
 
-		case op_push0: // 0x3b (59)
+		VM_OP(op_push0): // 0x3b (59)
 			PUSH(0);
-			break;
+			VM_NEXT();
 
-		case op_push1: // 0x3c (60)
+		VM_OP(op_push1): // 0x3c (60)
 			PUSH(1);
-			break;
+			VM_NEXT();
 
-		case op_push2: // 0x3d (61)
+		VM_OP(op_push2): // 0x3d (61)
 			PUSH(2);
-			break;
+			VM_NEXT();
 
-		case op_pushSelf: // 0x3e (62)
+		VM_OP(op_pushSelf): // 0x3e (62)
 			// Compensate for a bug in non-Sierra compilers, which seem to generate
 			// pushSelf instructions with the low bit set. This makes the following
 			// heuristic fail and leads to endless loops and crashes. Our
@@ -1236,54 +1321,54 @@ void run_vm(EngineState *s) {
 			} else {
 				// Debug opcode op_file
 			}
-			break;
+			VM_NEXT();
 
-		case op_line: // 0x3f (63)
+		VM_OP(op_line): // 0x3f (63)
 			// Debug opcode (line number)
 			//debug("Script %d, line %d", scr->getScriptNumber(), opparams[0]);
-			break;
+			VM_NEXT();
 
-		case op_lag: // 0x40 (64)
-		case op_lal: // 0x41 (65)
-		case op_lat: // 0x42 (66)
-		case op_lap: // 0x43 (67)
+		VM_OP(op_lag): // 0x40 (64)
+		VM_OP(op_lal): // 0x41 (65)
+		VM_OP(op_lat): // 0x42 (66)
+		VM_OP(op_lap): // 0x43 (67)
 			// Load global, local, temp or param variable into the accumulator
-		case op_lagi: // 0x48 (72)
-		case op_lali: // 0x49 (73)
-		case op_lati: // 0x4a (74)
-		case op_lapi: // 0x4b (75)
+		VM_OP(op_lagi): // 0x48 (72)
+		VM_OP(op_lali): // 0x49 (73)
+		VM_OP(op_lati): // 0x4a (74)
+		VM_OP(op_lapi): // 0x4b (75)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_lagi ? s->r_acc.requireSint16() : 0);
 			s->r_acc = read_var(s, var_type, var_number);
-			break;
+			VM_NEXT();
 
-		case op_lsg: // 0x44 (68)
-		case op_lsl: // 0x45 (69)
-		case op_lst: // 0x46 (70)
-		case op_lsp: // 0x47 (71)
+		VM_OP(op_lsg): // 0x44 (68)
+		VM_OP(op_lsl): // 0x45 (69)
+		VM_OP(op_lst): // 0x46 (70)
+		VM_OP(op_lsp): // 0x47 (71)
 			// Load global, local, temp or param variable into the stack
-		case op_lsgi: // 0x4c (76)
-		case op_lsli: // 0x4d (77)
-		case op_lsti: // 0x4e (78)
-		case op_lspi: // 0x4f (79)
+		VM_OP(op_lsgi): // 0x4c (76)
+		VM_OP(op_lsli): // 0x4d (77)
+		VM_OP(op_lsti): // 0x4e (78)
+		VM_OP(op_lspi): // 0x4f (79)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_lsgi ? s->r_acc.requireSint16() : 0);
 			PUSH32(read_var(s, var_type, var_number));
-			break;
+			VM_NEXT();
 
-		case op_sag: // 0x50 (80)
-		case op_sal: // 0x51 (81)
-		case op_sat: // 0x52 (82)
-		case op_sap: // 0x53 (83)
+		VM_OP(op_sag): // 0x50 (80)
+		VM_OP(op_sal): // 0x51 (81)
+		VM_OP(op_sat): // 0x52 (82)
+		VM_OP(op_sap): // 0x53 (83)
 			// Save the accumulator into the global, local, temp or param variable
-		case op_sagi: // 0x58 (88)
-		case op_sali: // 0x59 (89)
-		case op_sati: // 0x5a (90)
-		case op_sapi: // 0x5b (91)
+		VM_OP(op_sagi): // 0x58 (88)
+		VM_OP(op_sali): // 0x59 (89)
+		VM_OP(op_sati): // 0x5a (90)
+		VM_OP(op_sapi): // 0x5b (91)
 			// Save the accumulator into the global, local, temp or param variable,
 			// using the accumulator as an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
@@ -1291,52 +1376,52 @@ void run_vm(EngineState *s) {
 			if (opcode >= op_sagi)	// load the actual value to store in the accumulator
 				s->r_acc = POP32();
 			write_var(s, var_type, var_number, s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_ssg: // 0x54 (84)
-		case op_ssl: // 0x55 (85)
-		case op_sst: // 0x56 (86)
-		case op_ssp: // 0x57 (87)
+		VM_OP(op_ssg): // 0x54 (84)
+		VM_OP(op_ssl): // 0x55 (85)
+		VM_OP(op_sst): // 0x56 (86)
+		VM_OP(op_ssp): // 0x57 (87)
 			// Save the stack into the global, local, temp or param variable
-		case op_ssgi: // 0x5c (92)
-		case op_ssli: // 0x5d (93)
-		case op_ssti: // 0x5e (94)
-		case op_sspi: // 0x5f (95)
+		VM_OP(op_ssgi): // 0x5c (92)
+		VM_OP(op_ssli): // 0x5d (93)
+		VM_OP(op_ssti): // 0x5e (94)
+		VM_OP(op_sspi): // 0x5f (95)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_ssgi ? s->r_acc.requireSint16() : 0);
 			write_var(s, var_type, var_number, POP32());
-			break;
+			VM_NEXT();
 
-		case op_plusag: // 0x60 (96)
-		case op_plusal: // 0x61 (97)
-		case op_plusat: // 0x62 (98)
-		case op_plusap: // 0x63 (99)
+		VM_OP(op_plusag): // 0x60 (96)
+		VM_OP(op_plusal): // 0x61 (97)
+		VM_OP(op_plusat): // 0x62 (98)
+		VM_OP(op_plusap): // 0x63 (99)
 			// Increment the global, local, temp or param variable and save it
 			// to the accumulator
-		case op_plusagi: // 0x68 (104)
-		case op_plusali: // 0x69 (105)
-		case op_plusati: // 0x6a (106)
-		case op_plusapi: // 0x6b (107)
+		VM_OP(op_plusagi): // 0x68 (104)
+		VM_OP(op_plusali): // 0x69 (105)
+		VM_OP(op_plusati): // 0x6a (106)
+		VM_OP(op_plusapi): // 0x6b (107)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_plusagi ? s->r_acc.requireSint16() : 0);
 			s->r_acc = read_var(s, var_type, var_number) + 1;
 			write_var(s, var_type, var_number, s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_plussg: // 0x64 (100)
-		case op_plussl: // 0x65 (101)
-		case op_plusst: // 0x66 (102)
-		case op_plussp: // 0x67 (103)
+		VM_OP(op_plussg): // 0x64 (100)
+		VM_OP(op_plussl): // 0x65 (101)
+		VM_OP(op_plusst): // 0x66 (102)
+		VM_OP(op_plussp): // 0x67 (103)
 			// Increment the global, local, temp or param variable and save it
 			// to the stack
-		case op_plussgi: // 0x6c (108)
-		case op_plussli: // 0x6d (109)
-		case op_plussti: // 0x6e (110)
-		case op_plusspi: // 0x6f (111)
+		VM_OP(op_plussgi): // 0x6c (108)
+		VM_OP(op_plussli): // 0x6d (109)
+		VM_OP(op_plussti): // 0x6e (110)
+		VM_OP(op_plusspi): // 0x6f (111)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
@@ -1344,36 +1429,36 @@ void run_vm(EngineState *s) {
 			r_temp = read_var(s, var_type, var_number) + 1;
 			PUSH32(r_temp);
 			write_var(s, var_type, var_number, r_temp);
-			break;
+			VM_NEXT();
 
-		case op_minusag: // 0x70 (112)
-		case op_minusal: // 0x71 (113)
-		case op_minusat: // 0x72 (114)
-		case op_minusap: // 0x73 (115)
+		VM_OP(op_minusag): // 0x70 (112)
+		VM_OP(op_minusal): // 0x71 (113)
+		VM_OP(op_minusat): // 0x72 (114)
+		VM_OP(op_minusap): // 0x73 (115)
 			// Decrement the global, local, temp or param variable and save it
 			// to the accumulator
-		case op_minusagi: // 0x78 (120)
-		case op_minusali: // 0x79 (121)
-		case op_minusati: // 0x7a (122)
-		case op_minusapi: // 0x7b (123)
+		VM_OP(op_minusagi): // 0x78 (120)
+		VM_OP(op_minusali): // 0x79 (121)
+		VM_OP(op_minusati): // 0x7a (122)
+		VM_OP(op_minusapi): // 0x7b (123)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_minusagi ? s->r_acc.requireSint16() : 0);
 			s->r_acc = read_var(s, var_type, var_number) - 1;
 			write_var(s, var_type, var_number, s->r_acc);
-			break;
+			VM_NEXT();
 
-		case op_minussg: // 0x74 (116)
-		case op_minussl: // 0x75 (117)
-		case op_minusst: // 0x76 (118)
-		case op_minussp: // 0x77 (119)
+		VM_OP(op_minussg): // 0x74 (116)
+		VM_OP(op_minussl): // 0x75 (117)
+		VM_OP(op_minusst): // 0x76 (118)
+		VM_OP(op_minussp): // 0x77 (119)
 			// Decrement the global, local, temp or param variable and save it
 			// to the stack
-		case op_minussgi: // 0x7c (124)
-		case op_minussli: // 0x7d (125)
-		case op_minussti: // 0x7e (126)
-		case op_minusspi: // 0x7f (127)
+		VM_OP(op_minussgi): // 0x7c (124)
+		VM_OP(op_minussli): // 0x7d (125)
+		VM_OP(op_minussti): // 0x7e (126)
+		VM_OP(op_minusspi): // 0x7f (127)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
@@ -1381,7 +1466,7 @@ void run_vm(EngineState *s) {
 			r_temp = read_var(s, var_type, var_number) - 1;
 			PUSH32(r_temp);
 			write_var(s, var_type, var_number, r_temp);
-			break;
+			VM_NEXT();
 
 		default:
 			error("run_vm(): illegal opcode %x", opcode);
@@ -1391,7 +1476,7 @@ void run_vm(EngineState *s) {
 		if (s->_executionStackPosChanged) // Force initialization
 			s->xs = xs_new;
 
-		if (s->xs != &(s->_executionStack.back())) {
+		if (vmChecks && s->xs != &(s->_executionStack.back())) {
 			error("xs is stale (%p vs %p); last command was %02x",
 					(void *)s->xs, (void *)&(s->_executionStack.back()),
 					opcode);
@@ -403,6 +403,48 @@ void script_debug(EngineState *s);
 SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
 		ObjVarRef *varp, reg_t *fptr);
 
+/**
+ * Cache of the results of lookupSelector(), so that sends to the same kind of
+ * object do not have to search its class hierarchy every time.
+ *
+ * Results are looked up by the data an object was loaded from, which is
+ * shared by clones, and the selector. As scripts can change the superclass
+ * and -info- of objects, these are checked on every lookup as well.
+ */
+class SelectorLookupCache {
+public:
+	struct Entry {
+		const byte *baseData; ///< nullptr for empty entries
+		Selector selector;
+		reg_t superClass;
+		bool isClass;
+		SelectorType type;
+		int varIndex;         ///< The variable, for kSelectorVariable
+		reg_t function;       ///< The method, for kSelectorMethod
+	};
+
+	SelectorLookupCache() { clear(); }
+
+	/**
+	 * Drop all the results. This must be called whenever a script is
+	 * unloaded, as its data may be reused by another one afterwards.
+	 */
+	void clear();
+
+	/** Returns the entry a result has to be stored in. */
+	Entry &getEntry(const byte *baseData, Selector selector) {
+		const uint hash = (uint)(((uintptr)baseData >> 2) ^ ((uint)selector * 0x9E5));
+		return _entries[hash & (kSize - 1)];
+	}
+
+private:
+	enum {
+		kSize = 1024
+	};
+
+	Entry _entries[kSize];
+};
+
 /**
  * Read a PMachine instruction from a memory buffer and return its length.
  *
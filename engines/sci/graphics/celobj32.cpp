@@ -38,6 +38,7 @@ namespace Sci {
 #pragma mark CelScaler
 
 CelScaler *CelObj::_scaler = nullptr;
+Common::Mutex *CelObj::_drawMutex = nullptr;
 
 void CelScaler::activateScaleTables(const Ratio &scaleX, const Ratio &scaleY) {
 	for (int i = 0; i < ARRAYSIZE(_scaleTables); ++i) {
@@ -83,21 +84,30 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 
 #pragma mark -
 #pragma mark CelObj
-bool CelObj::_drawBlackLines = false;
-
 void CelObj::init() {
 	CelObj::deinit();
-	_drawBlackLines = false;
 	_nextCacheId = 1;
 	_scaler = new CelScaler();
+	_drawMutex = new Common::Mutex();
 	_cache = new CelCache(100);
+	_cacheIndex = new CelCacheIndex();
+	_scaledCache = new ScaledCelCache(16);
+	_scaledCacheIndex = new ScaledCelCacheIndex();
 }
 
 void CelObj::deinit() {
 	delete _scaler;
 	_scaler = nullptr;
+	delete _drawMutex;
+	_drawMutex = nullptr;
 	delete _cache;
 	_cache = nullptr;
+	delete _cacheIndex;
+	_cacheIndex = nullptr;
+	delete _scaledCache;
+	_scaledCache = nullptr;
+	delete _scaledCacheIndex;
+	_scaledCacheIndex = nullptr;
 }
 
 #pragma mark -
@@ -162,8 +172,10 @@ struct SCALER_Scale {
 	// image and takes precedence over _reader.
 	Common::SharedPtr<Buffer> _sourceBuffer;
 	int16 _x;
-	static int16 _valuesX[kCelScalerTableSize];
-	static int16 _valuesY[kCelScalerTableSize];
+	// SSCI used static tables, but cels may be drawn by several threads at
+	// once
+	int16 _valuesX[kCelScalerTableSize];
+	int16 _valuesY[kCelScalerTableSize];
 
 	SCALER_Scale(const CelObj &celObj, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio scaleX, const Ratio scaleY) :
 	_row(nullptr),
@@ -202,8 +214,6 @@ struct SCALER_Scale {
 		// games which use global scaling are the ones that use low-resolution
 		// script coordinates too.
 
-		const CelScalerTable &table = CelObj::_scaler->getScalerTable(scaleX, scaleY);
-
 		const bool useLarryScale = Common::checkGameGUIOption(GAMEOPTION_LARRYSCALE, ConfMan.get("guioptions")) && ConfMan.getBool("enable_larryscale");
 		if (useLarryScale) {
 			// LarryScale is an alternative, high-quality cel scaler implemented
@@ -255,6 +265,9 @@ struct SCALER_Scale {
 				_valuesY[y] = CLIP<int16>(unsafeValue, 0, scaledImageRect.height() - 1);
 			}
 		} else {
+			Common::StackLock lock(*CelObj::_drawMutex);
+			const CelScalerTable &table = CelObj::_scaler->getScalerTable(scaleX, scaleY);
+
 			const bool useGlobalScaling = g_sci->_gfxFrameout->getScriptWidth() == kLowResX;
 			if (useGlobalScaling) {
 				const int16 unscaledX = (scaledPosition.x / scaleX).toInt();
@@ -306,10 +319,29 @@ struct SCALER_Scale {
 	}
 };
 
-template<bool FLIP, typename READER>
-int16 SCALER_Scale<FLIP, READER>::_valuesX[kCelScalerTableSize];
-template<bool FLIP, typename READER>
-int16 SCALER_Scale<FLIP, READER>::_valuesY[kCelScalerTableSize];
+/**
+ * Reads from a cel in the scaled cel cache.
+ */
+struct SCALER_Prescaled {
+	const byte *const _pixels;
+	const int16 _width;
+	const Common::Point _origin;
+	const byte *_row;
+
+	SCALER_Prescaled(const ScaledCelCacheEntry &scaledCel, const Common::Point &scaledPosition) :
+	_pixels(scaledCel.pixels.begin()),
+	_width(scaledCel.valuesX.size()),
+	_origin(scaledPosition),
+	_row(nullptr) {}
+
+	inline void setTarget(const int16 x, const int16 y) {
+		_row = _pixels + (y - _origin.y) * _width + (x - _origin.x);
+	}
+
+	inline byte read() {
+		return *_row++;
+	}
+};
 
 #pragma mark -
 #pragma mark CelObj - Resource readers
@@ -516,7 +548,6 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 	const Common::Point &scaledPosition = screenItem._scaledPosition;
 	const Ratio &scaleX = screenItem._ratioX;
 	const Ratio &scaleY = screenItem._ratioY;
-	_drawBlackLines = screenItem._drawBlackLines;
 
 	if (_remap) {
 		// In SSCI, this check was `g_Remap_numActiveRemaps && _remap`, but
@@ -598,12 +629,11 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 			}
 		}
 	}
-
-	_drawBlackLines = false;
 }
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, bool mirrorX) {
 	_drawMirrored = mirrorX;
+	_drawBlackLines = screenItem._drawBlackLines;
 	draw(target, screenItem, targetRect);
 }
 
@@ -613,6 +643,28 @@ void CelObj::draw(Buffer &target, const Common::Rect &targetRect, const Common::
 	drawTo(target, targetRect, scaledPosition, square, square);
 }
 
+void CelObj::lockForDraw(const ScreenItem &screenItem, const bool mirrorX) {
+	_drawMirrored = mirrorX;
+	_drawBlackLines = screenItem._drawBlackLines;
+
+	if (_lockedResource || (_info.type != kCelTypeView && _info.type != kCelTypePic)) {
+		return;
+	}
+
+	const ResourceType type = _info.type == kCelTypeView ? kResourceTypeView : kResourceTypePic;
+	_lockedResource = g_sci->getResMan()->findResource(ResourceId(type, _info.resourceId), true);
+	if (_lockedResource == nullptr) {
+		error("Failed to load %s from resource manager", _info.toString().c_str());
+	}
+}
+
+void CelObj::unlockForDraw() {
+	if (_lockedResource) {
+		g_sci->getResMan()->unlockResource(_lockedResource);
+		_lockedResource = nullptr;
+	}
+}
+
 void CelObj::drawTo(Buffer &target, Common::Rect const &targetRect, Common::Point const &scaledPosition, Ratio const &scaleX, Ratio const &scaleY) const {
 	if (_remap) {
 		if (scaleX.isOne() && scaleY.isOne()) {
@@ -689,8 +741,19 @@ void CelObj::submitPalette() const {
 int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
+CelCacheIndex *CelObj::_cacheIndex = nullptr;
+ScaledCelCache *CelObj::_scaledCache = nullptr;
+ScaledCelCacheIndex *CelObj::_scaledCacheIndex = nullptr;
+
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
 	*nextInsertIndex = -1;
+
+	CelCacheIndex::const_iterator it = _cacheIndex->find(celInfo);
+	if (it != _cacheIndex->end()) {
+		(*_cache)[it->_value].id = ++_nextCacheId;
+		return it->_value;
+	}
+
 	int oldestId = _nextCacheId + 1;
 	int oldestIndex = 0;
 
@@ -698,22 +761,15 @@ int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) co
 		CelCacheEntry &entry = (*_cache)[i];
 
 		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
-			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
+			*nextInsertIndex = i;
+			return -1;
 		} else if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
 		}
 	}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
-	}
-
+	*nextInsertIndex = oldestIndex;
 	return -1;
 }
 
@@ -723,8 +779,198 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 	}
 
 	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	if (entry.celObj) {
+		CelCacheIndex::iterator it = _cacheIndex->find(entry.celObj->_info);
+		if (it != _cacheIndex->end() && it->_value == cacheIndex) {
+			_cacheIndex->erase(it);
+		}
+	}
+
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	(*_cacheIndex)[_info] = cacheIndex;
+}
+
+template<typename READER>
+ScaledCelCacheEntry *CelObj::getScaledCel(const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
+	// Scripts can draw into bitmaps, so only cels from resources are cached
+	if (_info.type != kCelTypeView && _info.type != kCelTypePic) {
+		return nullptr;
+	}
+
+	// LarryScale does not scale cels the same way, see SCALER_Scale
+	if (Common::checkGameGUIOption(GAMEOPTION_LARRYSCALE, ConfMan.get("guioptions")) && ConfMan.getBool("enable_larryscale")) {
+		return nullptr;
+	}
+
+	const int kMaxScaledCelSize = 640 * 480;
+
+	const int16 scaledWidth = (_width * scaleX).toInt();
+	const int16 scaledHeight = (_height * scaleY).toInt();
+	const Common::Rect scaledRect(scaledPosition.x, scaledPosition.y,
+		scaledPosition.x + scaledWidth, scaledPosition.y + scaledHeight);
+	if (scaledRect.isEmpty() || scaledWidth * scaledHeight > kMaxScaledCelSize ||
+		scaledWidth > kCelScalerTableSize || scaledHeight > kCelScalerTableSize ||
+		!scaledRect.contains(targetRect)) {
+		return nullptr;
+	}
+
+	ScaledCelKey key;
+	key.info = _info;
+	key.mirrored = _drawMirrored;
+	key.scaleX = scaleX;
+	key.scaleY = scaleY;
+	if (g_sci->_gfxFrameout->getScriptWidth() == kLowResX) {
+		// SCALER_Scale subtracts the truncated unscaled position from the
+		// global scaler tables, which only depends on the position modulo
+		// the numerators when that is not negative
+		if (scaledPosition.x < 0 || scaledPosition.y < 0) {
+			return nullptr;
+		}
+
+		key.phaseX = scaledPosition.x % scaleX.getNumerator();
+		key.phaseY = scaledPosition.y % scaleY.getNumerator();
+	}
+
+	Common::Rect rect(targetRect);
+	rect.translate(-scaledPosition.x, -scaledPosition.y);
+
+	ScaledCelCacheEntry *entry = nullptr;
+	bool needsScaling = false;
+	{
+		Common::StackLock lock(*_drawMutex);
+
+		ScaledCelCacheIndex::const_iterator it = _scaledCacheIndex->find(key);
+		if (it != _scaledCacheIndex->end()) {
+			entry = &(*_scaledCache)[it->_value];
+		} else {
+			int index = -1;
+			for (uint i = 0; i < _scaledCache->size(); ++i) {
+				const ScaledCelCacheEntry &candidate = (*_scaledCache)[i];
+				if (candidate.users == 0 && (index == -1 || candidate.id < (*_scaledCache)[index].id)) {
+					index = i;
+				}
+			}
+
+			// Every entry is being drawn from by other threads
+			if (index == -1) {
+				return nullptr;
+			}
+
+			entry = &(*_scaledCache)[index];
+			if (entry->id) {
+				_scaledCacheIndex->erase(entry->key);
+			}
+			entry->key = key;
+			(*_scaledCacheIndex)[key] = index;
+
+			// The same source pixels as SCALER_Scale, which takes them from
+			// the tables built by CelScaler::buildLookupTable
+			entry->usable = true;
+			entry->valuesX.resize(scaledWidth);
+			const int startX = key.phaseX * scaleX.getDenominator() / scaleX.getNumerator();
+			for (int16 x = 0; x < scaledWidth; ++x) {
+				int16 value = (key.phaseX + x) * scaleX.getDenominator() / scaleX.getNumerator() - startX;
+				if (_drawMirrored) {
+					value = _width - 1 - value;
+				}
+				if (value < 0 || value >= _width) {
+					entry->usable = false;
+				}
+				entry->valuesX[x] = value;
+			}
+
+			entry->valuesY.resize(scaledHeight);
+			const int startY = key.phaseY * scaleY.getDenominator() / scaleY.getNumerator();
+			for (int16 y = 0; y < scaledHeight; ++y) {
+				const int16 value = (key.phaseY + y) * scaleY.getDenominator() / scaleY.getNumerator() - startY;
+				if (value < 0 || value >= _height) {
+					entry->usable = false;
+				}
+				entry->valuesY[y] = value;
+			}
+
+			entry->pixels.resize(scaledWidth * scaledHeight);
+			entry->rows.resize(scaledHeight);
+			for (int16 y = 0; y < scaledHeight; ++y) {
+				entry->rows[y].left = entry->rows[y].right = 0;
+				entry->rows[y].busy = false;
+			}
+		}
+
+		entry->id = ++_nextCacheId;
+		if (!entry->usable) {
+			return nullptr;
+		}
+
+		for (int16 y = rect.top; y < rect.bottom; ++y) {
+			const ScaledCelCacheEntry::Row &row = entry->rows[y];
+			if (row.left > rect.left || row.right < rect.right) {
+				needsScaling = true;
+				break;
+			}
+		}
+
+		// The rows are scaled without holding the lock, so they are left alone
+		// by the other threads meanwhile
+		if (needsScaling) {
+			for (int16 y = rect.top; y < rect.bottom; ++y) {
+				if (entry->rows[y].busy) {
+					return nullptr;
+				}
+			}
+			for (int16 y = rect.top; y < rect.bottom; ++y) {
+				entry->rows[y].busy = true;
+			}
+		}
+
+		++entry->users;
+	}
+
+	if (!needsScaling) {
+		return entry;
+	}
+
+	READER reader(*this, _width);
+	for (int16 y = rect.top; y < rect.bottom; ++y) {
+		// Scale the columns missing on either side of those scaled already,
+		// along with any gap between them and targetRect
+		int16 scaledLeft = entry->rows[y].left;
+		int16 scaledRight = entry->rows[y].right;
+		if (scaledLeft >= scaledRight) {
+			scaledLeft = scaledRight = rect.right;
+		} else if (scaledLeft <= rect.left && scaledRight >= rect.right) {
+			continue;
+		}
+
+		const byte *source = reader.getRow(entry->valuesY[y]);
+		byte *target = entry->pixels.begin() + y * scaledWidth;
+		for (int16 x = rect.left; x < scaledLeft; ++x) {
+			target[x] = source[entry->valuesX[x]];
+		}
+		for (int16 x = scaledRight; x < rect.right; ++x) {
+			target[x] = source[entry->valuesX[x]];
+		}
+	}
+
+	Common::StackLock lock(*_drawMutex);
+	for (int16 y = rect.top; y < rect.bottom; ++y) {
+		ScaledCelCacheEntry::Row &row = entry->rows[y];
+		if (row.left < row.right) {
+			row.left = MIN(row.left, rect.left);
+			row.right = MAX(row.right, rect.right);
+		} else {
+			row.left = rect.left;
+			row.right = rect.right;
+		}
+		row.busy = false;
+	}
+	return entry;
+}
+
+void CelObj::releaseScaledCel(ScaledCelCacheEntry &scaledCel) const {
+	Common::StackLock lock(*_drawMutex);
+	--scaledCel.users;
 }
 
 #pragma mark -
@@ -790,6 +1036,31 @@ void CelObj::render(Buffer &target, const Common::Rect &targetRect, const Common
 	}
 }
 
+template<typename MAPPER, typename READER>
+void CelObj::renderScaled(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const {
+	ScaledCelCacheEntry *scaledCel = getScaledCel<READER>(scaleX, scaleY, targetRect, scaledPosition);
+	if (!scaledCel) {
+		if (_drawMirrored) {
+			render<MAPPER, SCALER_Scale<true, READER> >(target, targetRect, scaledPosition, scaleX, scaleY);
+		} else {
+			render<MAPPER, SCALER_Scale<false, READER> >(target, targetRect, scaledPosition, scaleX, scaleY);
+		}
+		return;
+	}
+
+	MAPPER mapper;
+	SCALER_Prescaled scaler(*scaledCel, scaledPosition);
+	if (_drawBlackLines) {
+		RENDERER<MAPPER, SCALER_Prescaled, true> renderer(mapper, scaler, _skipColor, _isMacSource);
+		renderer.draw(target, targetRect, scaledPosition);
+	} else {
+		RENDERER<MAPPER, SCALER_Prescaled, false> renderer(mapper, scaler, _skipColor, _isMacSource);
+		renderer.draw(target, targetRect, scaledPosition);
+	}
+
+	releaseScaledCel(*scaledCel);
+}
+
 void CelObj::drawHzFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
 	render<MAPPER_NoMap, SCALER_NoScale<true, READER_Compressed> >(target, targetRect, scaledPosition);
 }
@@ -807,19 +1078,11 @@ void CelObj::drawUncompHzFlip(Buffer &target, const Common::Rect &targetRect, co
 }
 
 void CelObj::scaleDraw(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
-	if (_drawMirrored) {
-		render<MAPPER_NoMap, SCALER_Scale<true, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	} else {
-		render<MAPPER_NoMap, SCALER_Scale<false, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	}
+	renderScaled<MAPPER_NoMap, READER_Compressed>(target, targetRect, scaledPosition, scaleX, scaleY);
 }
 
 void CelObj::scaleDrawUncomp(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
-	if (_drawMirrored) {
-		render<MAPPER_NoMap, SCALER_Scale<true, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	} else {
-		render<MAPPER_NoMap, SCALER_Scale<false, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	}
+	renderScaled<MAPPER_NoMap, READER_Uncompressed>(target, targetRect, scaledPosition, scaleX, scaleY);
 }
 
 void CelObj::drawHzFlipMap(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
@@ -839,19 +1102,11 @@ void CelObj::drawUncompHzFlipMap(Buffer &target, const Common::Rect &targetRect,
 }
 
 void CelObj::scaleDrawMap(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
-	if (_drawMirrored) {
-		render<MAPPER_Map, SCALER_Scale<true, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	} else {
-		render<MAPPER_Map, SCALER_Scale<false, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	}
+	renderScaled<MAPPER_Map, READER_Compressed>(target, targetRect, scaledPosition, scaleX, scaleY);
 }
 
 void CelObj::scaleDrawUncompMap(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
-	if (_drawMirrored) {
-		render<MAPPER_Map, SCALER_Scale<true, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	} else {
-		render<MAPPER_Map, SCALER_Scale<false, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	}
+	renderScaled<MAPPER_Map, READER_Uncompressed>(target, targetRect, scaledPosition, scaleX, scaleY);
 }
 
 void CelObj::drawNoFlipNoMD(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
@@ -886,10 +1141,7 @@ void CelObj::scaleDrawNoMD(Buffer &target, const Ratio &scaleX, const Ratio &sca
 		return;
 	}
 
-	if (_drawMirrored)
-		render<MAPPER_NoMD, SCALER_Scale<true, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	else
-		render<MAPPER_NoMD, SCALER_Scale<false, READER_Compressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
+	renderScaled<MAPPER_NoMD, READER_Compressed>(target, targetRect, scaledPosition, scaleX, scaleY);
 }
 
 void CelObj::scaleDrawUncompNoMD(Buffer &target, const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const {
@@ -900,11 +1152,7 @@ void CelObj::scaleDrawUncompNoMD(Buffer &target, const Ratio &scaleX, const Rati
 		return;
 	}
 
-	if (_drawMirrored) {
-		render<MAPPER_NoMD, SCALER_Scale<true, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	} else {
-		render<MAPPER_NoMD, SCALER_Scale<false, READER_Uncompressed> >(target, targetRect, scaledPosition, scaleX, scaleY);
-	}
+	renderScaled<MAPPER_NoMD, READER_Uncompressed>(target, targetRect, scaledPosition, scaleX, scaleY);
 }
 
 #pragma mark -
@@ -1126,6 +1374,10 @@ CelObjView *CelObjView::duplicate() const {
 }
 
 const SciSpan<const byte> CelObjView::getResPointer() const {
+	if (_lockedResource) {
+		return *_lockedResource;
+	}
+
 	Resource *const resource = g_sci->getResMan()->findResource(ResourceId(kResourceTypeView, _info.resourceId), false);
 	if (resource == nullptr) {
 		error("Failed to load view %d from resource manager", _info.resourceId);
@@ -1286,6 +1538,10 @@ CelObjPic *CelObjPic::duplicate() const {
 }
 
 const SciSpan<const byte> CelObjPic::getResPointer() const {
+	if (_lockedResource) {
+		return *_lockedResource;
+	}
+
 	const Resource *const resource = g_sci->getResMan()->findResource(ResourceId(kResourceTypePic, _info.resourceId), false);
 	if (resource == nullptr) {
 		error("Failed to load pic %d from resource manager", _info.resourceId);
@@ -1356,6 +1612,9 @@ void CelObjColor::draw(Buffer &target, const ScreenItem &screenItem, const Commo
 	_drawMirrored = mirrorX;
 	draw(target, targetRect);
 }
+void CelObjColor::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
+	draw(target, targetRect);
+}
 void CelObjColor::draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, bool mirrorX) {
 	error("Unsupported method");
 }
@@ -22,6 +22,8 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/mutex.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -105,7 +107,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +117,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -151,6 +153,112 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+struct CelInfo32Hash {
+	uint operator()(const CelInfo32 &info) const {
+		return (info.type << 28) ^ (info.resourceId << 12) ^ (info.loopNo << 8) ^ info.celNo ^
+			(info.bitmap.getSegment() << 16) ^ info.bitmap.getOffset();
+	}
+};
+
+/**
+ * Index of the cel cache, from the CelInfo32 of each cel object in the cache
+ * to its slot.
+ */
+typedef Common::HashMap<CelInfo32, int, CelInfo32Hash> CelCacheIndex;
+
+/**
+ * Identifies a scaled cel. In global scaling mode the source pixels picked
+ * for a scaled cel depend on where it is drawn, but only through the position
+ * modulo the numerators of the scale ratios, so that is all the key keeps.
+ */
+struct ScaledCelKey {
+	CelInfo32 info;
+	bool mirrored;
+	Ratio scaleX;
+	Ratio scaleY;
+	int phaseX;
+	int phaseY;
+
+	ScaledCelKey() : mirrored(false), phaseX(0), phaseY(0) {}
+
+	inline bool operator==(const ScaledCelKey &other) const {
+		return info == other.info && mirrored == other.mirrored &&
+			scaleX == other.scaleX && scaleY == other.scaleY &&
+			phaseX == other.phaseX && phaseY == other.phaseY;
+	}
+};
+
+struct ScaledCelKeyHash {
+	uint operator()(const ScaledCelKey &key) const {
+		return CelInfo32Hash()(key.info) ^ key.mirrored ^
+			(key.scaleX.getNumerator() << 4) ^ (key.scaleX.getDenominator() << 10) ^
+			(key.scaleY.getNumerator() << 16) ^ (key.scaleY.getDenominator() << 22) ^
+			(key.phaseX << 7) ^ (key.phaseY << 19);
+	}
+};
+
+/**
+ * A cel scaled to the size it is drawn at. Scaled screen items are drawn from
+ * these, so that their cels do not have to be decompressed and scaled again
+ * every time they are redrawn. Only the parts of the cel which have been drawn
+ * so far are scaled.
+ */
+struct ScaledCelCacheEntry {
+	/**
+	 * A monotonically increasing cache ID used to identify the least recently
+	 * used item in the cache for replacement.
+	 */
+	int id;
+	ScaledCelKey key;
+
+	/**
+	 * Whether all the source pixels picked by the scaler lie within the cel.
+	 * Cels for which they do not are drawn without this cache.
+	 */
+	bool usable;
+
+	/**
+	 * The source column and row of every column and row of the scaled cel.
+	 */
+	Common::Array<int16> valuesX;
+	Common::Array<int16> valuesY;
+
+	/**
+	 * The pixels of the scaled cel, before they are mapped.
+	 */
+	Common::Array<byte> pixels;
+
+	struct Row {
+		/**
+		 * The columns of the row which have been scaled.
+		 */
+		int16 left;
+		int16 right;
+
+		/**
+		 * Whether a thread is scaling more of the row.
+		 */
+		bool busy;
+	};
+
+	Common::Array<Row> rows;
+
+	/**
+	 * The number of threads drawing from this entry. Entries in use are not
+	 * replaced.
+	 */
+	int users;
+
+	ScaledCelCacheEntry() : id(0), usable(false), users(0) {}
+};
+
+typedef Common::Array<ScaledCelCacheEntry> ScaledCelCache;
+
+/**
+ * Index of the scaled cel cache, from the key of each scaled cel to its slot.
+ */
+typedef Common::HashMap<ScaledCelKey, int, ScaledCelKeyHash> ScaledCelCacheIndex;
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -246,13 +354,13 @@ class CelObj {
 protected:
 	/**
 	 * When true, every second line of the cel will be rendered as a black line.
+	 * This is set by draw methods from the owner screen item.
 	 *
 	 * @see ScreenItem::_drawBlackLines
-	 * @note Using a static member because otherwise this would otherwise need
-	 * to be copied down through several calls. (SSCI did similar, using a
-	 * global variable.)
+	 * @note SSCI used a global variable, which cannot be used when cels are
+	 * drawn from several threads at once.
 	 */
-	static bool _drawBlackLines;
+	bool _drawBlackLines;
 
 	/**
 	 * When true, this cel will be horizontally mirrored when it is drawn. This
@@ -262,9 +370,20 @@ protected:
 	 */
 	bool _drawMirrored;
 
+	/**
+	 * The resource of the cel while it is locked by lockForDraw().
+	 */
+	Resource *_lockedResource;
+
 public:
 	static CelScaler *_scaler;
 
+	/**
+	 * Guards the scaler tables and the scaled cel cache, which are shared by
+	 * all the threads drawing cels.
+	 */
+	static Common::Mutex *_drawMutex;
+
 	/**
 	 * The basic identifying information for this cel. This information
 	 * effectively acts as a composite key for a cel object, and any cel object
@@ -351,6 +470,11 @@ public:
 	 */
 	static void deinit();
 
+	CelObj() :
+		_drawBlackLines(false),
+		_drawMirrored(false),
+		_lockedResource(nullptr) {}
+
 	virtual ~CelObj() {};
 
 	/**
@@ -358,7 +482,7 @@ public:
 	 * information from the given screen item. The mirroring of the cel will be
 	 * unchanged from any previous call to draw.
 	 */
-	void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const;
+	virtual void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const;
 
 	/**
 	 * Draws the cel to the target buffer using the priority and positioning
@@ -389,6 +513,20 @@ public:
 	 */
 	void drawTo(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const;
 
+	/**
+	 * Sets the mirroring of the cel like draw does, and locks its resource
+	 * until unlockForDraw() is called. While it is locked, the cel can be
+	 * drawn with draw(Buffer &, const ScreenItem &, const Common::Rect &)
+	 * from several threads at once, since it no longer goes through the
+	 * resource manager.
+	 */
+	void lockForDraw(const ScreenItem &screenItem, const bool mirrorX);
+
+	/**
+	 * Unlocks the resource locked by lockForDraw().
+	 */
+	void unlockForDraw();
+
 	/**
 	 * Creates a copy of this cel on the free store and returns a pointer to the
 	 * new object. The new cel will point to a shared copy of bitmap/resource
@@ -423,6 +561,12 @@ private:
 	template<typename MAPPER, typename SCALER>
 	void render(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const;
 
+	/**
+	 * Draws the cel scaled, from the scaled cel cache if possible.
+	 */
+	template<typename MAPPER, typename READER>
+	void renderScaled(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const;
+
 	void drawHzFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
 	void drawNoFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
 	void drawUncompNoFlip(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
@@ -477,6 +621,38 @@ protected:
 	 * Puts a copy of this CelObj into the cache at the given cache index.
 	 */
 	void putCopyInCache(int index) const;
+
+	/**
+	 * The slots of the cel objects in the cache.
+	 */
+	static CelCacheIndex *_cacheIndex;
+
+	/**
+	 * A cache of the most recently drawn scaled cels.
+	 */
+	static ScaledCelCache *_scaledCache;
+
+	/**
+	 * The slots of the scaled cels in the cache.
+	 */
+	static ScaledCelCacheIndex *_scaledCacheIndex;
+
+	/**
+	 * Returns this cel scaled by the given ratios to be drawn at the given
+	 * position, scaling the part of it within targetRect first if it is not
+	 * cached yet. Returns nullptr for cels which cannot be cached: cels from
+	 * bitmaps, which scripts can draw into, large cels, cels for which the
+	 * scaler picks pixels outside of the cel, and cels drawn while another
+	 * thread is scaling the same rows. The returned entry must be handed back
+	 * with releaseScaledCel().
+	 */
+	template<typename READER>
+	ScaledCelCacheEntry *getScaledCel(const Ratio &scaleX, const Ratio &scaleY, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
+
+	/**
+	 * Allows the cache entry returned by getScaledCel() to be replaced again.
+	 */
+	void releaseScaledCel(ScaledCelCacheEntry &scaledCel) const;
 };
 
 #pragma mark -
@@ -597,6 +773,7 @@ public:
 	 * Block fills the target buffer with the cel color.
 	 */
 	void draw(Buffer &target, const Common::Rect &targetRect) const;
+	void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const override;
 	void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX) override;
 	void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX) override;
 
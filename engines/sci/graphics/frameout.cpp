@@ -22,6 +22,8 @@
 #include "common/algorithm.h"
 #include "common/config-manager.h"
 #include "common/events.h"
+#include "common/gui_options.h"
+#include "common/jobs.h"
 #include "common/keyboard.h"
 #include "common/list.h"
 #include "common/str.h"
@@ -505,10 +507,7 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 
 	_remapOccurred = _palette->updateForFrame();
 
-	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
-		drawEraseList(eraseLists[i], *_planes[i]);
-		drawScreenItemList(screenItemLists[i]);
-	}
+	drawLists(screenItemLists, eraseLists);
 
 	if (robotIsActive) {
 		robotPlayer.frameAlmostVisible();
@@ -562,10 +561,7 @@ void GfxFrameout::palMorphFrameOut(const int8 *styleRanges, PlaneShowStyle *show
 
 	_remapOccurred = _palette->updateForFrame();
 
-	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
-		drawEraseList(eraseLists[i], *_planes[i]);
-		drawScreenItemList(screenItemLists[i]);
-	}
+	drawLists(screenItemLists, eraseLists);
 
 	Palette nextPalette(_palette->getNextPalette());
 
@@ -617,10 +613,7 @@ void GfxFrameout::palMorphFrameOut(const int8 *styleRanges, PlaneShowStyle *show
 
 	_remapOccurred = _palette->updateForFrame();
 
-	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
-		drawEraseList(eraseLists[i], *_planes[i]);
-		drawScreenItemList(screenItemLists[i]);
-	}
+	drawLists(screenItemLists, eraseLists);
 
 	_palette->submit(nextPalette);
 	_palette->updateFFrame();
@@ -986,26 +979,85 @@ void GfxFrameout::calcLists(ScreenItemListList &drawLists, EraseListList &eraseL
 	}
 }
 
-void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane) {
+void GfxFrameout::drawLists(const ScreenItemListList &screenItemLists, const EraseListList &eraseLists) {
+	// The show list and the cels are set up first, since neither can be
+	// touched by several threads at once. LarryScale scales the whole cel
+	// for every draw, so each band would do all of that work again.
+	bool canDrawInBands = JobMan.getThreadCount() > 1 &&
+		!(Common::checkGameGUIOption(GAMEOPTION_LARRYSCALE, ConfMan.get("guioptions")) && ConfMan.getBool("enable_larryscale"));
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		if (_planes[i]->_type == kPlaneTypeColored) {
+			const RectList &eraseList = eraseLists[i];
+			for (RectList::size_type j = 0; j < eraseList.size(); ++j) {
+				mergeToShowList(*eraseList[j], _showList, _overdrawThreshold);
+			}
+		}
+
+		const DrawList &screenItemList = screenItemLists[i];
+		for (DrawList::size_type j = 0; j < screenItemList.size(); ++j) {
+			const DrawItem &drawItem = *screenItemList[j];
+			mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
+			const ScreenItem &screenItem = *drawItem.screenItem;
+			CelObj &celObj = *screenItem._celObj;
+			celObj.lockForDraw(screenItem, screenItem._mirrorX ^ celObj._mirrorX);
+
+			// Black lines start at the top of each draw rect, which cutting
+			// the rect into bands would move
+			if (screenItem._drawBlackLines) {
+				canDrawInBands = false;
+			}
+		}
+	}
+
+	// Planes and screen items overlap each other, so each band of the screen
+	// gets all the lists drawn into it in the same order the whole screen
+	// would, and looks exactly the same as if it were drawn on its own
+	const int16 screenWidth = _currentBuffer.w;
+	const int16 screenHeight = _currentBuffer.h;
+	int numBands = 1;
+	if (canDrawInBands) {
+		numBands = CLIP<int>(screenHeight / kMinBandHeight, 1, JobMan.getThreadCount() * 4);
+	}
+
+	JobMan.parallelFor(0, numBands, [this, &screenItemLists, &eraseLists, numBands, screenWidth, screenHeight](int band) {
+		const Common::Rect bandRect(0, screenHeight * band / numBands, screenWidth, screenHeight * (band + 1) / numBands);
+		for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+			drawEraseList(eraseLists[i], *_planes[i], bandRect);
+			drawScreenItemList(screenItemLists[i], bandRect);
+		}
+	});
+
+	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
+		const DrawList &screenItemList = screenItemLists[i];
+		for (DrawList::size_type j = 0; j < screenItemList.size(); ++j) {
+			screenItemList[j]->screenItem->_celObj->unlockForDraw();
+		}
+	}
+}
+
+void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane, const Common::Rect &bandRect) {
 	if (plane._type != kPlaneTypeColored) {
 		return;
 	}
 
 	const RectList::size_type eraseListSize = eraseList.size();
 	for (RectList::size_type i = 0; i < eraseListSize; ++i) {
-		mergeToShowList(*eraseList[i], _showList, _overdrawThreshold);
-		_currentBuffer.fillRect(*eraseList[i], plane._back);
+		const Common::Rect rect = eraseList[i]->findIntersectingRect(bandRect);
+		if (!rect.isEmpty()) {
+			_currentBuffer.fillRect(rect, plane._back);
+		}
 	}
 }
 
-void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
+void GfxFrameout::drawScreenItemList(const DrawList &screenItemList, const Common::Rect &bandRect) {
 	const DrawList::size_type drawListSize = screenItemList.size();
 	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
 		const DrawItem &drawItem = *screenItemList[i];
-		mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
-		const ScreenItem &screenItem = *drawItem.screenItem;
-		CelObj &celObj = *screenItem._celObj;
-		celObj.draw(_currentBuffer, screenItem, drawItem.rect, screenItem._mirrorX ^ celObj._mirrorX);
+		const Common::Rect rect = drawItem.rect.findIntersectingRect(bandRect);
+		if (!rect.isEmpty()) {
+			const ScreenItem &screenItem = *drawItem.screenItem;
+			screenItem._celObj->draw(_currentBuffer, screenItem, rect);
+		}
 	}
 }
 
@@ -355,18 +355,31 @@ private:
 	void calcLists(ScreenItemListList &drawLists, EraseListList &eraseLists, const Common::Rect &eraseRect = Common::Rect());
 
 	/**
-	 * Erases the areas in the given erase list from the visible screen buffer
-	 * by filling them with the color from the corresponding plane. This is an
-	 * optimisation for colored-type planes only; other plane types have to be
-	 * redrawn from pixel data.
+	 * The smallest height of the bands of the screen drawn by drawLists.
 	 */
-	void drawEraseList(const RectList &eraseList, const Plane &plane);
+	static const int16 kMinBandHeight = 16;
 
 	/**
-	 * Draws all screen items from the given draw list to the visible screen
-	 * buffer.
+	 * Draws the erase and draw lists of every plane to the visible screen
+	 * buffer, and adds the areas they cover to the show list. The screen is
+	 * cut into horizontal bands, which are drawn by different threads.
 	 */
-	void drawScreenItemList(const DrawList &screenItemList);
+	void drawLists(const ScreenItemListList &screenItemLists, const EraseListList &eraseLists);
+
+	/**
+	 * Erases the areas in the given erase list from the given band of the
+	 * visible screen buffer by filling them with the color from the
+	 * corresponding plane. This is an optimisation for colored-type planes
+	 * only; other plane types have to be redrawn from pixel data.
+	 */
+	void drawEraseList(const RectList &eraseList, const Plane &plane, const Common::Rect &bandRect);
+
+	/**
+	 * Draws all screen items from the given draw list to the given band of
+	 * the visible screen buffer. The cels of the screen items must have been
+	 * locked with CelObj::lockForDraw.
+	 */
+	void drawScreenItemList(const DrawList &screenItemList, const Common::Rect &bandRect);
 
 	/**
 	 * Adds a new rectangle to the list of regions to write out to the hardware.
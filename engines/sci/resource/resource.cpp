@@ -210,6 +210,11 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
+	_lruNewer = _lruOlder = nullptr;
+	_cachePriority = 0;
+	_compression = kCompNone;
+	_prefetching = false;
+	_prefetched = false;
 }
 
 Resource::~Resource() {
@@ -1001,13 +1006,16 @@ void ResourceManager::freeResourceSources() {
 }
 
 ResourceManager::ResourceManager(const bool detectionMode) :
-	_detectionMode(detectionMode) {}
+	_detectionMode(detectionMode), _lruNewest(nullptr), _lruOldest(nullptr),
+	_cacheInflation(0), _memoryPrefetched(0) {}
 
 void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
-	_LRU.clear();
+	_lruNewest = _lruOldest = nullptr;
+	_cacheInflation = 0;
+	memset(_cacheStats, 0, sizeof(_cacheStats));
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1107,6 +1115,14 @@ void ResourceManager::init() {
 }
 
 ResourceManager::~ResourceManager() {
+	// Prefetches which have not started yet are not needed anymore
+	for (uint i = 0; i < _activePrefetches.size(); ++i) {
+		uint32 queued = Prefetch::kStateQueued;
+		_activePrefetches[i]->state.compareExchange(queued, Prefetch::kStateCancelled);
+	}
+	JobMan.wait(_prefetchJobs);
+	finishPrefetches();
+
 	// freeing resources
 	ResourceMap::iterator itr = _resMap.begin();
 	while (itr != _resMap.end()) {
@@ -1127,7 +1143,17 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+
+	if (res->_lruNewer)
+		res->_lruNewer->_lruOlder = res->_lruOlder;
+	else
+		_lruNewest = res->_lruOlder;
+	if (res->_lruOlder)
+		res->_lruOlder->_lruNewer = res->_lruNewer;
+	else
+		_lruOldest = res->_lruNewer;
+	res->_lruNewer = res->_lruOlder = nullptr;
+
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
@@ -1137,7 +1163,20 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+
+	res->_lruNewer = nullptr;
+	res->_lruOlder = _lruNewest;
+	if (_lruNewest)
+		_lruNewest->_lruNewer = res;
+	else
+		_lruOldest = res;
+	_lruNewest = res;
+
+	// GreedyDual-Size: resources which are expensive to load again for
+	// their size stay in memory longer. The inflation value grows with every
+	// eviction, so resources which are not used again eventually go as well.
+	res->_cachePriority = _cacheInflation + (uint64)getReloadCost(res) * 256 / MAX<uint32>(res->size(), 1);
+
 	_memoryLRU += res->size();
 #ifdef SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1147,27 +1186,59 @@ void ResourceManager::addToLRU(Resource *res) {
 	res->_status = kResStatusEnqueued;
 }
 
+uint32 ResourceManager::getReloadCost(const Resource *res) const {
+	// Rough cost of loading a resource: a fixed cost for reading it from
+	// disk, plus one for each byte, which depends on how it is compressed
+	uint32 costPerByte;
+	switch (res->_compression) {
+	case kCompNone:
+		costPerByte = 1;
+		break;
+	case kCompDCL:
+#ifdef ENABLE_SCI32
+	case kCompSTACpack:
+#endif
+		costPerByte = 6;
+		break;
+	default:
+		costPerByte = 4;
+		break;
+	}
+
+	return 4096 + res->size() * costPerByte;
+}
+
 void ResourceManager::printLRU() {
 	int mem = 0;
 	int entries = 0;
-	Common::List<Resource *>::iterator it = _LRU.begin();
-	Resource *res;
 
-	while (it != _LRU.end()) {
-		res = *it;
+	for (Resource *res = _lruNewest; res; res = res->_lruOlder) {
 		debug("\t%s: %u bytes", res->_id.toString().c_str(), res->size());
 		mem += res->size();
 		++entries;
-		++it;
 	}
 
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
 }
 
 void ResourceManager::freeOldResources() {
+	// Look for the resource with the lowest priority among the least
+	// recently used ones. Considering only a few of them keeps this O(1).
+	const int kEvictionCandidates = 8;
+
 	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		assert(_lruOldest);
+		Resource *goner = _lruOldest;
+		Resource *candidate = goner->_lruNewer;
+		for (int i = 1; i < kEvictionCandidates && candidate; ++i) {
+			if (candidate->_cachePriority < goner->_cachePriority)
+				goner = candidate;
+			candidate = candidate->_lruNewer;
+		}
+
+		_cacheInflation = MAX(_cacheInflation, goner->_cachePriority);
+		++_cacheStats[goner->getType()].evictions;
+
 		removeFromLRU(goner);
 		goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
@@ -1176,6 +1247,199 @@ void ResourceManager::freeOldResources() {
 	}
 }
 
+void ResourceManager::prefetchResource(const ResourceId &id) {
+	// Loading ahead on the calling thread would only make it wait longer
+	if (_detectionMode || JobMan.getThreadCount() < 2)
+		return;
+
+	finishPrefetches();
+
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc || res->_prefetching)
+		return;
+
+	// Only resources from the volumes are loaded ahead, as only those are
+	// read the same way every time
+	ResourceSource *source = res->_source;
+	if (!source || source->getSourceType() != kSourceVolume)
+		return;
+
+	switch (res->getType()) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypeScript:
+	case kResourceTypeSound:
+	case kResourceTypeVocab:
+	case kResourceTypeFont:
+	case kResourceTypeCursor:
+	case kResourceTypePatch:
+	case kResourceTypeBitmap:
+	case kResourceTypePalette:
+	case kResourceTypeHeap:
+		break;
+	case kResourceTypeText:
+	case kResourceTypeMessage:
+		// These may use a different volume version, see
+		// ResourceSource::loadResource()
+		if (g_sci && g_sci->getLanguage() == Common::KO_KOR)
+			return;
+		break;
+	default:
+		return;
+	}
+
+	// The job reads from its own stream, as the ones of getVolumeFile() are
+	// shared
+	Common::SeekableReadStream *file = nullptr;
+	if (source->_resourceFile) {
+		file = source->_resourceFile->createReadStream();
+	} else {
+		Common::File *volume = new Common::File();
+		if (volume->open(source->getLocationName()))
+			file = volume;
+		else
+			delete volume;
+	}
+	if (!file)
+		return;
+
+	Prefetch *prefetch = new Prefetch();
+	prefetch->resource = res;
+	prefetch->result = new Resource(this, res->_id);
+	prefetch->result->_source = source;
+	prefetch->result->_fileOffset = res->_fileOffset;
+	prefetch->file = file;
+	prefetch->volVersion = _volVersion;
+	prefetch->error = SCI_ERROR_NONE;
+	prefetch->state.store(Prefetch::kStateQueued);
+
+	res->_prefetching = true;
+	_activePrefetches.push_back(prefetch);
+	JobMan.schedule([this, prefetch]() { runPrefetch(prefetch); }, &_prefetchJobs);
+}
+
+void ResourceManager::runPrefetch(Prefetch *prefetch) {
+	// The lock is kept until the prefetch is in the finished list, so that
+	// waitForPrefetch() can wait for this job alone
+	prefetch->running.lock();
+
+	uint32 queued = Prefetch::kStateQueued;
+	if (prefetch->state.compareExchange(queued, Prefetch::kStateRunning)) {
+		prefetch->file->seek(prefetch->result->_fileOffset, SEEK_SET);
+		prefetch->error = prefetch->result->decompress(prefetch->volVersion, prefetch->file);
+	}
+	delete prefetch->file;
+	prefetch->file = nullptr;
+
+	// Once in the finished list, the prefetch may be deleted as soon as
+	// _prefetchMutex is released
+	Common::StackLock lock(_prefetchMutex);
+	_finishedPrefetches.push_back(prefetch);
+	prefetch->running.unlock();
+}
+
+void ResourceManager::waitForPrefetch(Resource *res) {
+	Prefetch *prefetch = nullptr;
+	for (uint i = 0; i < _activePrefetches.size(); ++i) {
+		if (_activePrefetches[i]->resource == res) {
+			prefetch = _activePrefetches[i];
+			break;
+		}
+	}
+	assert(prefetch);
+
+	// If no worker has picked up the job yet, the resource is loaded the
+	// usual way rather than waiting for the jobs queued before it
+	uint32 queued = Prefetch::kStateQueued;
+	if (prefetch->state.compareExchange(queued, Prefetch::kStateCancelled)) {
+		res->_prefetching = false;
+		return;
+	}
+
+	prefetch->running.lock();
+	prefetch->running.unlock();
+}
+
+void ResourceManager::claimPrefetched(Resource *res) {
+	for (uint i = 0; i < _prefetchedResources.size(); ++i) {
+		if (_prefetchedResources[i] == res) {
+			_prefetchedResources.remove_at(i);
+			break;
+		}
+	}
+
+	_memoryPrefetched -= res->size();
+	res->_prefetched = false;
+}
+
+void ResourceManager::finishPrefetches() {
+	if (_activePrefetches.empty())
+		return;
+
+	Common::Array<Prefetch *> finished;
+	{
+		Common::StackLock lock(_prefetchMutex);
+		SWAP(finished, _finishedPrefetches);
+	}
+
+	for (uint i = 0; i < finished.size(); ++i) {
+		Prefetch *prefetch = finished[i];
+		Resource *res = prefetch->resource;
+		Resource *result = prefetch->result;
+
+		for (uint j = 0; j < _activePrefetches.size(); ++j) {
+			if (_activePrefetches[j] == prefetch) {
+				_activePrefetches.remove_at(j);
+				break;
+			}
+		}
+
+		if (prefetch->state.load() == Prefetch::kStateCancelled) {
+			// The resource was loaded without waiting, and may even be
+			// prefetched again by now
+			delete result;
+			delete prefetch;
+			continue;
+		}
+
+		res->_prefetching = false;
+		if (prefetch->error) {
+			warning("Error %d occurred while reading %s from resource file %s: %s",
+					prefetch->error, res->_id.toString().c_str(), res->getResourceLocation().c_str(),
+					s_errorDescriptions[prefetch->error]);
+		} else if (res->_status == kResStatusNoMalloc) {
+			res->_id = result->_id;
+			res->_data = result->_data;
+			res->_size = result->_size;
+			res->_compression = result->_compression;
+			res->_status = kResStatusAllocated;
+			result->_data = nullptr;
+
+			if (_patcher)
+				_patcher->applyPatch(*res);
+
+			++_cacheStats[res->getType()].prefetches;
+
+			// Resources loaded ahead only count towards the LRU once the
+			// game asks for them, unless too many of them pile up
+			res->_prefetched = true;
+			_prefetchedResources.push_back(res);
+			_memoryPrefetched += res->size();
+		}
+
+		delete result;
+		delete prefetch;
+	}
+
+	while (_memoryPrefetched > _maxMemoryLRU) {
+		Resource *oldest = _prefetchedResources.front();
+		claimPrefetched(oldest);
+		addToLRU(oldest);
+	}
+
+	freeOldResources();
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1212,15 +1476,26 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_prefetching)
+		waitForPrefetch(retval);
+	finishPrefetches();
+
+	if (retval->_prefetched)
+		claimPrefetched(retval);
+
+	if (retval->_status == kResStatusNoMalloc) {
+		++_cacheStats[retval->getType()].misses;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
-		// The resource is removed from its current position
-		// in the LRU list because it has been requested
-		// again. Below, it will either be locked, or it
-		// will be added back to the LRU list at the 'most
-		// recent' position.
-		removeFromLRU(retval);
+	} else {
+		++_cacheStats[retval->getType()].hits;
+		if (retval->_status == kResStatusEnqueued)
+			// The resource is removed from its current position
+			// in the LRU list because it has been requested
+			// again. Below, it will either be locked, or it
+			// will be added back to the LRU list at the 'most
+			// recent' position.
+			removeFromLRU(retval);
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
@@ -2381,6 +2656,8 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	if (errorNum)
 		return errorNum;
 
+	_compression = compression;
+
 	// getting a decompressor
 	Decompressor *dec = nullptr;
 	switch (compression) {
@@ -25,6 +25,8 @@
 #include "common/str.h"
 #include "common/list.h"
 #include "common/hashmap.h"
+#include "common/jobs.h"
+#include "common/mutex.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/resource/decompressor.h"
@@ -312,6 +314,13 @@ protected:
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
+	// Resource cache, see ResourceManager::freeOldResources()
+	Resource *_lruNewer, *_lruOlder; ///< Neighbours in the LRU list
+	uint64 _cachePriority; ///< GreedyDual-Size priority, while in the LRU list
+	ResourceCompression _compression; ///< For the cost of loading the resource again
+	bool _prefetching; ///< Whether the resource is being loaded in the background
+	bool _prefetched; ///< Whether the resource was loaded ahead and not requested yet
+
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
 	bool loadFromWaveFile(Common::SeekableReadStream *file);
@@ -394,6 +403,27 @@ public:
 	 */
 	Resource *testResource(const ResourceId &id) const;
 
+	/**
+	 * Starts loading a resource in the background, as the game announced
+	 * that it is going to use it. findResource() picks up the result. Only
+	 * resources from the resource volumes are loaded ahead.
+	 * @param id	Id of the resource to load
+	 */
+	void prefetchResource(const ResourceId &id);
+
+	/** Statistics of the resource cache, for the debugger */
+	struct CacheStats {
+		uint32 hits;       ///< Lookups of resources which were in memory
+		uint32 misses;     ///< Lookups of resources which had to be loaded
+		uint32 prefetches; ///< Resources loaded ahead
+		uint32 evictions;  ///< Resources dropped from memory
+	};
+
+	const CacheStats &getCacheStats(ResourceType type) const { return _cacheStats[type]; }
+	int getMemoryLocked() const { return _memoryLocked; }
+	int getMemoryCached() const { return _memoryLRU; }
+	int getMaxMemoryCached() const { return _maxMemoryLRU; }
+
 	/**
 	 * Returns a list of all resources of the specified type.
 	 * @param type		The resource type to look for
@@ -500,7 +530,33 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	Resource *_lruNewest, *_lruOldest; ///< Last Resource Used list
+	uint64 _cacheInflation; ///< The "L" value of GreedyDual-Size eviction
+	CacheStats _cacheStats[kResourceTypeInvalid];
+
+	/** A resource which is loaded in the background */
+	struct Prefetch {
+		enum State {
+			kStateQueued,
+			kStateRunning,
+			kStateCancelled
+		};
+
+		Resource *resource;
+		Resource *result; ///< Loaded by the job, handed over to resource afterwards
+		Common::SeekableReadStream *file;
+		ResVersion volVersion;
+		int error;
+		Common::Atomic<uint32> state;
+		Common::Mutex running; ///< Held by the job while it loads the resource
+	};
+
+	Common::JobGroup _prefetchJobs;
+	Common::Mutex _prefetchMutex;
+	Common::Array<Prefetch *> _activePrefetches; ///< Scheduled and not finished yet
+	Common::Array<Prefetch *> _finishedPrefetches;
+	Common::Array<Resource *> _prefetchedResources; ///< Loaded ahead and not requested yet, oldest first
+	int _memoryPrefetched; ///< Amount of resource bytes in _prefetchedResources
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -646,6 +702,14 @@ protected:
 	void printLRU();
 	void addToLRU(Resource *res);
 	void removeFromLRU(Resource *res);
+	uint32 getReloadCost(const Resource *res) const;
+
+	void runPrefetch(Prefetch *prefetch);
+	void finishPrefetches();
+	/** Waits for the prefetch of the resource, or cancels it if it has not started yet. */
+	void waitForPrefetch(Resource *res);
+	/** Takes a resource which was loaded ahead off the list of unrequested ones. */
+	void claimPrefetched(Resource *res);
 
 	ResourceCompression getViewCompression();
 	ViewType detectViewType();
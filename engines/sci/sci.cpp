@@ -869,6 +869,12 @@ void SciEngine::showQfgImportMessageBox() const {
 }
 
 void SciEngine::sleep(uint32 msecs) {
+	// The game is not throttled while the VM is benchmarked
+	if (_console && _console->updateVMBenchmark()) {
+		_eventMan->getSciEvent(kSciEventPeek);
+		return;
+	}
+
 	if (!msecs) {
 		return;
 	}
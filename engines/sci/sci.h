@@ -117,7 +117,8 @@ enum kDebugLevels {
 	kDebugLevelPatcher       = 1 << 22,
 	kDebugLevelWorkarounds   = 1 << 23,
 	kDebugLevelVideo         = 1 << 24,
-	kDebugLevelGame          = 1 << 25
+	kDebugLevelGame          = 1 << 25,
+	kDebugLevelVMChecks      = 1 << 26
 };
 
 
@@ -54,6 +54,18 @@ static void copy8Col(byte *dst, int dstPitch, const byte *src, int height, uint8
 #endif
 static void clear8Col(byte *dst, int dstPitch, int height, uint8 bitDepth);
 
+static ComposeTextFunc getComposeTextFunc() {
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return composeTextSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return composeTextNEON;
+#endif
+	return nullptr;
+}
+
 struct StripTable {
 	int offsets[160];
 	int run[160];
@@ -215,6 +227,8 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_vertStripNextInc = 0;
 	_zbufferDisabled = false;
 	_objectMode = false;
+	_cacheStrips = false;
+	_stripCacheColorMap = nullptr;
 	_distaff = false;
 }
 
@@ -285,6 +299,7 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -715,6 +730,8 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 				srcPtr += vsPitch;
 				textPtr += _textSurface.pitch - width * m;
 			}
+		} else if (ComposeTextFunc composeText = getComposeTextFunc()) {
+			composeText(_compositeBuf, (const byte *)src, vs->pitch + width * (m - 1), (const byte *)text, _textSurface.pitch, width * m, height * m);
 		} else {
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
@@ -1163,7 +1180,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbCacheStrips);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -2098,6 +2115,7 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_vertStripNextInc = height * vs->pitch - 1 * vs->format.bytesPerPixel;
 
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
+	_cacheStrips = (flag & dbCacheStrips) != 0;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
 	sx = x - vs->xstart / 8;
@@ -2274,6 +2292,9 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 		return result;
 	}
 
+	if (_cacheStrips)
+		return decompressCachedStrip(dstPtr, vs->pitch, stripnr, smap_ptr + offset, height);
+
 	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
 }
 
@@ -2788,6 +2809,61 @@ bool Gdi::decompressBitmap(byte *dst, int dstPitch, const byte *src, int numLine
 	return transpStrip;
 }
 
+bool Gdi::decompressCachedStrip(byte *dst, int dstPitch, int stripnr, const byte *src, int numLinesToProcess) {
+	// The palette workarounds in drawStrip change the color map too, so this
+	// is checked for every strip
+	uint colorMapSize;
+	const byte *colorMap = getRoomColorMap(colorMapSize);
+	if (colorMap != _stripCacheColorMap || colorMapSize != _stripCacheColors.size() ||
+			memcmp(colorMap, _stripCacheColors.data(), colorMapSize) != 0) {
+		clearStripCache();
+		_stripCacheColorMap = colorMap;
+		_stripCacheColors.resize(colorMapSize);
+		memcpy(_stripCacheColors.data(), colorMap, colorMapSize);
+	}
+
+	if ((uint)stripnr >= _stripCache.size())
+		_stripCache.resize(stripnr + 1);
+	CachedStrip &strip = _stripCache[stripnr];
+
+	const int rowSize = 8 * _vm->_bytesPerPixel;
+	if (strip.room == _vm->_roomResource && strip.src == src && strip.height == numLinesToProcess) {
+		const byte *pixels = strip.pixels.data();
+		for (int h = 0; h < numLinesToProcess; ++h) {
+			memcpy(dst, pixels, rowSize);
+			pixels += rowSize;
+			dst += dstPitch;
+		}
+		return false;
+	}
+
+	const bool transpStrip = decompressBitmap(dst, dstPitch, src, numLinesToProcess);
+
+	// Transparent strips depend on what was drawn before them
+	if (transpStrip) {
+		strip = CachedStrip();
+		return true;
+	}
+
+	strip.room = _vm->_roomResource;
+	strip.src = src;
+	strip.height = numLinesToProcess;
+	strip.pixels.resize(rowSize * numLinesToProcess);
+	byte *pixels = strip.pixels.data();
+	for (int h = 0; h < numLinesToProcess; ++h) {
+		memcpy(pixels, dst, rowSize);
+		pixels += rowSize;
+		dst += dstPitch;
+	}
+	return false;
+}
+
+void Gdi::clearStripCache() {
+	_stripCache.clear();
+	_stripCacheColorMap = nullptr;
+	_stripCacheColors.clear();
+}
+
 void Gdi::decompressMaskImg(byte *dst, const byte *src, int height) const {
 	byte b, c;
 
@@ -4050,6 +4126,11 @@ void Gdi::unkDecode11(byte *dst, int dstPitch, const byte *src, int height) cons
 void GdiHE16bit::writeRoomColor(byte *dst, byte color) const {
 	WRITE_UINT16(dst, READ_LE_UINT16(_vm->_hePalettes + 2048 + color * 2));
 }
+
+const byte *GdiHE16bit::getRoomColorMap(uint &size) const {
+	size = 256 * 2;
+	return _vm->_hePalettes + 2048;
+}
 #endif
 
 void Gdi::writeRoomColor(byte *dst, byte color) const {
@@ -4060,6 +4141,11 @@ void Gdi::writeRoomColor(byte *dst, byte color) const {
 	*dst = _roomPalette[(color + _paletteMod) & 0xFF];
 }
 
+const byte *Gdi::getRoomColorMap(uint &size) const {
+	size = 256;
+	return _roomPalette;
+}
+
 
 #pragma mark -
 #pragma mark --- Transition effects ---
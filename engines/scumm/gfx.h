@@ -22,8 +22,10 @@
 #ifndef SCUMM_GFX_H
 #define SCUMM_GFX_H
 
+#include "common/array.h"
 #include "common/system.h"
 #include "common/list.h"
+#include "common/rect.h"
 
 #include "graphics/surface.h"
 
@@ -204,6 +206,21 @@ struct StripTable;
 #define CHARSET_MASK_TRANSPARENCY	 0xFD
 #define CHARSET_MASK_TRANSPARENCY_32 0xFDFDFDFD
 
+/**
+ * Compose the text surface over 8 bpp game graphics: every pixel of @p text
+ * which is CHARSET_MASK_TRANSPARENCY shows the pixel of @p src below it. The
+ * rows of @p dst follow each other without any gap.
+ */
+typedef void (*ComposeTextFunc)(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height);
+
+#ifdef SCUMMVM_SSE2
+void composeTextSSE2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height);
+#endif
+
+#ifdef SCUMMVM_NEON
+void composeTextNEON(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height);
+#endif
+
 class Gdi {
 protected:
 	ScummEngine *_vm;
@@ -219,6 +236,33 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/** Flag which is true when the strips being drawn may be cached, see dbCacheStrips. */
+	bool _cacheStrips;
+
+	struct CachedStrip {
+		CachedStrip() : room(0), src(nullptr), height(0) {}
+
+		int room;
+		const byte *src;             ///< The compressed strip
+		int height;
+		Common::Array<byte> pixels;  ///< The decoded strip, 8 pixels per row
+	};
+
+	/**
+	 * The decoded strips of the room background, by strip number. Scrolling
+	 * rooms redraw the same strips over and over again, and copying them is
+	 * a lot cheaper than decoding them.
+	 */
+	Common::Array<CachedStrip> _stripCache;
+
+	/**
+	 * The color map the cached strips were decoded with. The cache is
+	 * dropped whenever the color map changes, for example by palette
+	 * cycling in 16 bpp games.
+	 */
+	const byte *_stripCacheColorMap;
+	Common::Array<byte> _stripCacheColors;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -247,6 +291,12 @@ protected:
 	void drawStripHE(byte *dst, int dstPitch, const byte *src, int width, int height, const bool transpCheck) const;
 	virtual void writeRoomColor(byte *dst, byte color) const;
 
+	/** Return the table writeRoomColor maps colors with, and its size in bytes. */
+	virtual const byte *getRoomColorMap(uint &size) const;
+
+	bool decompressCachedStrip(byte *dst, int dstPitch, int stripnr, const byte *src, int numLinesToProcess);
+	void clearStripCache();
+
 	/* Mask decompressors */
 	void decompressMaskImgOr(byte *dst, const byte *src, int height) const;
 	void decompressMaskImg(byte *dst, const byte *src, int height) const;
@@ -295,7 +345,8 @@ public:
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbCacheStrips   = 1 << 4   ///< Room background strips, which are kept in the strip cache
 	};
 };
 
@@ -468,6 +519,7 @@ public:
 class GdiHE16bit : public GdiHE {
 protected:
 	void writeRoomColor(byte *dst, byte color) const override;
+	const byte *getRoomColorMap(uint &size) const override;
 public:
 	GdiHE16bit(ScummEngine *vm);
 };
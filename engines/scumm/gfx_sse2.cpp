@@ -0,0 +1,48 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "scumm/gfx.h"
+
+namespace Scumm {
+
+void composeTextSSE2(byte *dst, const byte *src, int srcPitch, const byte *text, int textPitch, int width, int height) {
+	const __m128i transparent = _mm_set1_epi8((char)CHARSET_MASK_TRANSPARENCY);
+
+	for (int h = 0; h < height; ++h) {
+		int w = 0;
+		for (; w + 16 <= width; w += 16) {
+			const __m128i t = _mm_loadu_si128((const __m128i *)(text + w));
+			const __m128i s = _mm_loadu_si128((const __m128i *)(src + w));
+			const __m128i mask = _mm_cmpeq_epi8(t, transparent);
+			_mm_storeu_si128((__m128i *)(dst + w), _mm_or_si128(_mm_and_si128(mask, s), _mm_andnot_si128(mask, t)));
+		}
+		for (; w < width; ++w)
+			dst[w] = (text[w] == CHARSET_MASK_TRANSPARENCY) ? src[w] : text[w];
+
+		dst += width;
+		src += srcPitch;
+		text += textPitch;
+	}
+}
+
+} // End of namespace Scumm
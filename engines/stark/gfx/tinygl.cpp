@@ -50,6 +50,7 @@ void TinyGLDriver::init() {
 	computeScreenViewport();
 
 	TinyGL::createContext(kOriginalWidth, kOriginalHeight, g_system->getScreenFormat(), 512, true, ConfMan.getBool("dirtyrects"));
+	TinyGL::setRenderThreads(ConfMan.getInt("tinygl_threads"));
 
 	tglMatrixMode(TGL_PROJECTION);
 	tglLoadIdentity();
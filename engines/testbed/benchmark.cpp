@@ -0,0 +1,432 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/fs.h"
+#include "common/system.h"
+
+#include "graphics/blit.h"
+#include "graphics/font.h"
+#include "graphics/managed_surface.h"
+#include "graphics/fonts/ttf.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/VectorRenderer.h"
+
+#include "gui/browser.h"
+#include "gui/ThemeEngine.h"
+
+#include "video/avi_decoder.h"
+#include "video/bink_decoder.h"
+#include "video/flic_decoder.h"
+#include "video/smk_decoder.h"
+
+#include "testbed/benchmark.h"
+
+namespace Testbed {
+
+double Benchmarks::measureRate(void (*func)(void *), void *param, uint32 minMillis) {
+	// Warm up the caches first
+	func(param);
+
+	uint32 runs = 0;
+	const uint32 start = g_system->getMillis();
+	uint32 elapsed;
+	do {
+		func(param);
+		++runs;
+		elapsed = g_system->getMillis() - start;
+	} while (elapsed < minMillis);
+
+	return runs * 1000.0 / elapsed;
+}
+
+namespace {
+
+struct CrossBlitParams {
+	enum {
+		kWidth = 640,
+		kHeight = 480
+	};
+
+	byte *dst;
+	const byte *src;
+	Graphics::PixelFormat dstFmt;
+	Graphics::PixelFormat srcFmt;
+	uint32 map[256];
+};
+
+void runCrossBlit(void *param) {
+	CrossBlitParams &p = *(CrossBlitParams *)param;
+	Graphics::crossBlit(p.dst, p.src, CrossBlitParams::kWidth * p.dstFmt.bytesPerPixel, CrossBlitParams::kWidth * p.srcFmt.bytesPerPixel,
+						CrossBlitParams::kWidth, CrossBlitParams::kHeight, p.dstFmt, p.srcFmt);
+}
+
+void runCrossBlitMap(void *param) {
+	CrossBlitParams &p = *(CrossBlitParams *)param;
+	Graphics::crossBlitMap(p.dst, p.src, CrossBlitParams::kWidth * p.dstFmt.bytesPerPixel, CrossBlitParams::kWidth,
+						   CrossBlitParams::kWidth, CrossBlitParams::kHeight, p.dstFmt.bytesPerPixel, p.map);
+}
+
+} // End of anonymous namespace
+
+TestExitStatus Benchmarks::crossBlit() {
+	const Graphics::PixelFormat clut8 = Graphics::PixelFormat::createFormatCLUT8();
+	const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	const Graphics::PixelFormat argb1555(2, 5, 5, 5, 1, 10, 5, 0, 15);
+	const Graphics::PixelFormat rgba8888(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	const Graphics::PixelFormat abgr8888(4, 8, 8, 8, 8, 0, 8, 16, 24);
+
+	const struct {
+		const Graphics::PixelFormat *srcFmt;
+		const Graphics::PixelFormat *dstFmt;
+	} pairs[] = {
+		{ &rgb565,   &rgba8888 },
+		{ &rgba8888, &rgb565   },
+		{ &argb8888, &abgr8888 },
+		{ &rgba8888, &argb8888 },
+		{ &argb1555, &rgba8888 },
+		{ &clut8,    &rgba8888 },
+		{ &clut8,    &rgb565   }
+	};
+
+	CrossBlitParams params;
+	byte *src = new byte[CrossBlitParams::kWidth * CrossBlitParams::kHeight * 4];
+	params.dst = new byte[CrossBlitParams::kWidth * CrossBlitParams::kHeight * 4];
+	params.src = src;
+
+	uint32 seed = 1;
+	for (uint i = 0; i < CrossBlitParams::kWidth * CrossBlitParams::kHeight * 4; ++i) {
+		seed = seed * 1103515245 + 12345;
+		src[i] = seed >> 16;
+	}
+	Graphics::convertPaletteToMap(params.map, src, 256, rgba8888);
+
+	Testsuite::logPrintf("Info! crossBlit, %dx%d pixels per run\n", (int)CrossBlitParams::kWidth, (int)CrossBlitParams::kHeight);
+	for (uint i = 0; i < ARRAYSIZE(pairs); ++i) {
+		params.srcFmt = *pairs[i].srcFmt;
+		params.dstFmt = *pairs[i].dstFmt;
+
+		const double rate = measureRate(params.srcFmt.isCLUT8() ? runCrossBlitMap : runCrossBlit, &params);
+		const double mpixPerSec = rate * CrossBlitParams::kWidth * CrossBlitParams::kHeight / 1000000.0;
+		Testsuite::logPrintf("Info! %s -> %s: %.1f MPix/s\n", params.srcFmt.toString().c_str(), params.dstFmt.toString().c_str(), mpixPerSec);
+	}
+
+	delete[] src;
+	delete[] params.dst;
+	return kTestPassed;
+}
+
+namespace {
+
+Video::VideoDecoder *createVideoDecoder(const Common::String &name) {
+	if (name.hasSuffixIgnoreCase(".avi"))
+		return new Video::AVIDecoder();
+#ifdef USE_BINK
+	if (name.hasSuffixIgnoreCase(".bik"))
+		return new Video::BinkDecoder();
+#endif
+	if (name.hasSuffixIgnoreCase(".fli") || name.hasSuffixIgnoreCase(".flc"))
+		return new Video::FlicDecoder();
+	if (name.hasSuffixIgnoreCase(".smk"))
+		return new Video::SmackerDecoder();
+	return nullptr;
+}
+
+/**
+ * Decode the video in @p node, with @p framesAhead frames decoded ahead.
+ *
+ * @return The time the caller spent in decodeNextFrame() per frame, in
+ *         milliseconds, or a negative number on failure.
+ */
+double measureDecodeTime(const Common::FSNode &node, uint framesAhead) {
+	// Stands for the engine drawing a frame and waiting for the next one
+	const uint32 kWorkMillis = 10;
+	const uint kMaxFrames = 200;
+
+	Video::VideoDecoder *video = createVideoDecoder(node.getName());
+	Common::SeekableReadStream *stream = node.createReadStream();
+	if (!video || !stream || !video->loadStream(stream)) {
+		delete video;
+		delete stream;
+		return -1;
+	}
+
+	if (!video->setFramesAhead(framesAhead)) {
+		delete video;
+		return -1;
+	}
+
+	uint frames = 0;
+	const uint32 start = g_system->getMillis();
+	while (frames < kMaxFrames && !video->endOfVideo()) {
+		video->decodeNextFrame();
+		++frames;
+		g_system->delayMillis(kWorkMillis);
+	}
+	const uint32 elapsed = g_system->getMillis() - start;
+
+	delete video;
+	return frames ? ((double)elapsed - frames * kWorkMillis) / frames : -1;
+}
+
+} // End of anonymous namespace
+
+TestExitStatus Benchmarks::videoDecodeAhead() {
+	Common::String info = "Video decoding benchmark. An AVI, Bink, FLIC or Smacker video should be selected using the file browser.";
+
+	if (Testsuite::handleInteractiveInput(info, "OK", "Skip", kOptionRight)) {
+		Testsuite::logPrintf("Info! Skipping test : videoDecodeAhead\n");
+		return kTestSkipped;
+	}
+
+	GUI::BrowserDialog browser(Common::U32String("Select video file"), false);
+	if (browser.runModal() <= 0) {
+		Testsuite::logPrintf("Info! Skipping test : videoDecodeAhead\n");
+		return kTestSkipped;
+	}
+
+	const Common::FSNode node = browser.getResult();
+	static const uint framesAhead[] = { 0, 2, 4 };
+	for (uint i = 0; i < ARRAYSIZE(framesAhead); ++i) {
+		const double millis = measureDecodeTime(node, framesAhead[i]);
+		if (millis < 0) {
+			if (i == 0) {
+				Testsuite::logDetailedPrintf("Cannot decode video %s\n", node.getName().c_str());
+				return kTestFailed;
+			}
+
+			Testsuite::logPrintf("Info! %u frames ahead: not supported\n", framesAhead[i]);
+			continue;
+		}
+
+		Testsuite::logPrintf("Info! %u frames ahead: %.2f ms per frame\n", framesAhead[i], millis);
+	}
+
+	return kTestPassed;
+}
+
+namespace {
+
+struct TextRenderParams {
+	enum {
+		kWidth = 640,
+		kHeight = 480
+	};
+
+	const Graphics::Font *font;
+	Graphics::Surface *dst;
+	Common::Array<Common::U32String> lines;
+};
+
+// Draws every character by itself, which is how strings were drawn before
+// fonts could lay out whole strings.
+void runTextRenderChars(void *param) {
+	TextRenderParams &p = *(TextRenderParams *)param;
+	const uint32 color = p.dst->format.RGBToColor(255, 255, 255);
+	const int lineHeight = p.font->getFontHeight();
+
+	for (uint i = 0; i < p.lines.size(); ++i) {
+		const Common::U32String &line = p.lines[i];
+		int x = 0;
+		uint32 last = 0;
+		for (uint j = 0; j < line.size(); ++j) {
+			x += p.font->getKerningOffset(last, line[j]);
+			last = line[j];
+			if (x + p.font->getBoundingBox(line[j]).right > TextRenderParams::kWidth)
+				break;
+			p.font->drawChar(p.dst, line[j], x, i * lineHeight, color);
+			x += p.font->getCharWidth(line[j]);
+		}
+	}
+}
+
+void runTextRenderStrings(void *param) {
+	TextRenderParams &p = *(TextRenderParams *)param;
+	const uint32 color = p.dst->format.RGBToColor(255, 255, 255);
+	const int lineHeight = p.font->getFontHeight();
+
+	for (uint i = 0; i < p.lines.size(); ++i)
+		p.font->drawString(p.dst, p.lines[i], 0, i * lineHeight, TextRenderParams::kWidth, color, Graphics::kTextAlignLeft, 0, false);
+}
+
+} // End of anonymous namespace
+
+TestExitStatus Benchmarks::textRender() {
+#ifdef USE_FREETYPE2
+	const char *const kFontName = "FreeSans.ttf";
+	const int kFontSize = 12;
+
+	Graphics::Font *font = Graphics::loadTTFFontFromArchive(kFontName, kFontSize);
+	if (!font) {
+		Testsuite::logPrintf("Info! Skipping test : textRender, %s is not available\n", kFontName);
+		return kTestSkipped;
+	}
+
+	TextRenderParams params;
+	params.font = font;
+	params.dst = new Graphics::Surface();
+	params.dst->create(TextRenderParams::kWidth, TextRenderParams::kHeight, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+	static const char *const words[] = {
+		"The", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog,",
+		"while", "Guybrush", "looks", "for", "a", "VAXing", "machine."
+	};
+	const uint numLines = TextRenderParams::kHeight / font->getFontHeight();
+	uint numChars = 0;
+	for (uint i = 0; i < numLines; ++i) {
+		Common::String line;
+		for (uint j = 0; j < 12; ++j) {
+			if (j)
+				line += ' ';
+			line += words[(i * 7 + j) % ARRAYSIZE(words)];
+		}
+		params.lines.push_back(Common::U32String(line));
+		numChars += line.size();
+	}
+
+	Testsuite::logPrintf("Info! textRender, %s %dpt, %u lines with %u characters per run\n", kFontName, kFontSize, numLines, numChars);
+
+	const double charRate = measureRate(runTextRenderChars, &params);
+	Testsuite::logPrintf("Info! drawChar: %.1f screens/s\n", charRate);
+
+	const double stringRate = measureRate(runTextRenderStrings, &params);
+	Testsuite::logPrintf("Info! drawString: %.1f screens/s\n", stringRate);
+
+	params.dst->free();
+	delete params.dst;
+	delete font;
+	return kTestPassed;
+#else
+	Testsuite::logPrintf("Info! Skipping test : textRender, FreeType is not available\n");
+	return kTestSkipped;
+#endif
+}
+
+namespace {
+
+struct GuiRedrawParams {
+	enum {
+		kWidth = 1280,
+		kHeight = 720,
+		kGridColumns = 6,
+		kGridRows = 4,
+		kButtons = 8
+	};
+
+	Graphics::VectorRenderer *renderer;
+	Graphics::ManagedSurface *dst;
+};
+
+// Draws what the launcher in grid view is made of: a gradient background,
+// a scrolled grid of rounded items with shadows, which the bottom of the
+// grid cuts off, and a row of buttons.
+void runGuiRedraw(void *param) {
+	GuiRedrawParams &p = *(GuiRedrawParams *)param;
+	Graphics::VectorRenderer *r = p.renderer;
+	const Common::Rect screen(GuiRedrawParams::kWidth, GuiRedrawParams::kHeight);
+	const Common::Rect grid(20, 60, GuiRedrawParams::kWidth - 20, GuiRedrawParams::kHeight - 80);
+
+	r->setClippingRect(screen);
+	r->setShadowOffset(0);
+	r->setStrokeWidth(0);
+	r->setBevel(0);
+	r->setGradientFactor(1);
+	r->setGradientColors(214, 113, 8, 240, 200, 25);
+	r->setFillMode(Graphics::VectorRenderer::kFillGradient);
+	r->fillSurface();
+
+	r->setBgColor(255, 243, 224);
+	r->setFillMode(Graphics::VectorRenderer::kFillBackground);
+	r->drawRoundedSquare(grid.left, grid.top, 6, grid.width(), grid.height());
+
+	r->setClippingRect(grid);
+	r->setShadowOffset(3);
+	r->setGradientColors(255, 255, 255, 206, 121, 0);
+	r->setFillMode(Graphics::VectorRenderer::kFillGradient);
+	const int itemWidth = grid.width() / GuiRedrawParams::kGridColumns;
+	const int itemHeight = 160;
+	for (int y = 0; y < GuiRedrawParams::kGridRows; ++y) {
+		for (int x = 0; x < GuiRedrawParams::kGridColumns; ++x)
+			r->drawRoundedSquare(grid.left + x * itemWidth + 10, grid.top + y * itemHeight - 40, 8, itemWidth - 20, itemHeight - 20);
+	}
+
+	r->setClippingRect(screen);
+	r->setShadowOffset(2);
+	r->setStrokeWidth(1);
+	r->setFgColor(120, 60, 0);
+	r->setGradientColors(206, 121, 0, 255, 231, 140);
+	const int buttonWidth = (GuiRedrawParams::kWidth - 40) / GuiRedrawParams::kButtons;
+	for (int i = 0; i < GuiRedrawParams::kButtons; ++i)
+		r->drawRoundedSquare(20 + i * buttonWidth + 4, GuiRedrawParams::kHeight - 60, 4, buttonWidth - 8, 32);
+}
+
+} // End of anonymous namespace
+
+TestExitStatus Benchmarks::guiRedraw() {
+	// The renderers draw in the overlay format, like the launcher does
+	const Graphics::PixelFormat format = g_system->getOverlayFormat();
+	if (format.bytesPerPixel == 1) {
+		Testsuite::logPrintf("Info! Skipping test : guiRedraw, the overlay has no 16 or 32 bpp format\n");
+		return kTestSkipped;
+	}
+
+	const struct {
+		GUI::ThemeEngine::GraphicsMode mode;
+		const char *name;
+	} modes[] = {
+		{ GUI::ThemeEngine::kGfxStandard,  "standard"    },
+#ifndef DISABLE_FANCY_THEMES
+		{ GUI::ThemeEngine::kGfxAntialias, "antialiased" }
+#endif
+	};
+
+	GuiRedrawParams params;
+	params.dst = new Graphics::ManagedSurface(GuiRedrawParams::kWidth, GuiRedrawParams::kHeight, format);
+
+	Testsuite::logPrintf("Info! guiRedraw, %s, %dx%d pixels per run\n", format.toString().c_str(), (int)GuiRedrawParams::kWidth, (int)GuiRedrawParams::kHeight);
+	for (uint i = 0; i < ARRAYSIZE(modes); ++i) {
+		params.renderer = Graphics::createRenderer(modes[i].mode);
+		if (!params.renderer)
+			continue;
+		params.renderer->setSurface(params.dst);
+
+		const double rate = measureRate(runGuiRedraw, &params);
+		Testsuite::logPrintf("Info! %s renderer: %.1f redraws/s\n", modes[i].name, rate);
+
+		delete params.renderer;
+	}
+
+	delete params.dst;
+	return kTestPassed;
+}
+
+BenchmarkTestSuite::BenchmarkTestSuite() {
+	// Timings are only meaningful when nothing else runs, so this has to be
+	// enabled explicitly
+	_isTsEnabled = false;
+	addTest("CrossBlit", &Benchmarks::crossBlit, false);
+	addTest("VideoDecodeAhead", &Benchmarks::videoDecodeAhead, true);
+	addTest("TextRender", &Benchmarks::textRender, false);
+	addTest("GuiRedraw", &Benchmarks::guiRedraw, false);
+}
+
+} // End of namespace Testbed
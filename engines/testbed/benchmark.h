@@ -0,0 +1,71 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TESTBED_BENCHMARK_H
+#define TESTBED_BENCHMARK_H
+
+#include "testbed/testsuite.h"
+
+namespace Testbed {
+
+namespace Benchmarks {
+
+// Helper functions for benchmarks
+
+/**
+ * Run @p func repeatedly for at least @p minMillis milliseconds.
+ *
+ * @return The number of runs per second.
+ */
+double measureRate(void (*func)(void *), void *param, uint32 minMillis = 250);
+
+// will contain function declarations for benchmarks
+TestExitStatus crossBlit();
+TestExitStatus videoDecodeAhead();
+TestExitStatus textRender();
+TestExitStatus guiRedraw();
+// add more here
+
+} // End of namespace Benchmarks
+
+class BenchmarkTestSuite : public Testsuite {
+public:
+	/**
+	 * The constructor for the BenchmarkTestSuite
+	 * For every test to be executed one must:
+	 * 1) Create a function that would invoke the test
+	 * 2) Add that test to list by executing addTest()
+	 *
+	 * @see addTest()
+	 */
+	BenchmarkTestSuite();
+	~BenchmarkTestSuite() override {}
+	const char *getName() const override {
+		return "Benchmark";
+	}
+	const char *getDescription() const override {
+		return "Micro-benchmarks of performance critical code";
+	}
+};
+
+} // End of namespace Testbed
+
+#endif // TESTBED_BENCHMARK_H
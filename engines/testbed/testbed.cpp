@@ -31,6 +31,7 @@
 #include "engines/achievements.h"
 #include "engines/util.h"
 
+#include "testbed/benchmark.h"
 #include "testbed/events.h"
 #include "testbed/fs.h"
 #include "testbed/graphics.h"
@@ -170,6 +171,9 @@ void TestbedEngine::pushTestsuites(Common::Array<Testsuite *> &testsuiteList) {
 	// Video decoder
 	ts = new VideoDecoderTestSuite();
 	testsuiteList.push_back(ts);
+	// Benchmarks
+	ts = new BenchmarkTestSuite();
+	testsuiteList.push_back(ts);
 }
 
 TestbedEngine::~TestbedEngine() {
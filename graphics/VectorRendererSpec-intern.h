@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_VECTOR_RENDERER_SPEC_INTERN_H
+#define GRAPHICS_VECTOR_RENDERER_SPEC_INTERN_H
+
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * Pixel format of the span blending kernels, which blend every channel
+ * of a pixel with d + (((s - d) * alpha) >> 8), exactly like
+ * VectorRendererSpec::blendPixelPtr. The alpha channel is blended towards
+ * opaque.
+ *
+ * 32 bpp formats need 8 bit color channels at byte boundaries, and either
+ * no alpha or an 8 bit one. Other formats use the generic code.
+ */
+struct SpanBlendFormat {
+	enum {
+		kChannelA = 0,
+		kChannelR = 1,
+		kChannelG = 2,
+		kChannelB = 3,
+		kChannelCount = 4
+	};
+
+	/** Shift and largest value of each channel, 0 for missing channels */
+	uint8 shift[kChannelCount];
+	uint16 max[kChannelCount];
+	/** Bits of the channels in a pixel */
+	uint32 mask;
+	/** Bits of the alpha channel in a pixel */
+	uint32 alphaMask;
+
+	/**
+	 * Set up blending in @p format.
+	 *
+	 * @return Whether the SIMD kernels can blend in this format.
+	 */
+	bool init(const PixelFormat &format);
+
+	/** Reference implementation of blending a single pixel. */
+	inline uint32 blend(uint32 dst, uint32 color, uint alpha) const {
+		uint32 result = 0;
+		for (int c = 0; c < kChannelCount; ++c) {
+			const int s = (c == kChannelA) ? max[c] : (color >> shift[c]) & max[c];
+			const int d = (dst >> shift[c]) & max[c];
+			result |= (uint32)(d + (((s - d) * (int)alpha) >> 8)) << shift[c];
+		}
+		return result;
+	}
+};
+
+/** Spans shorter than this are not worth calling the SIMD kernels for. */
+const int kMinSimdSpanLength = 16;
+
+/**
+ * Signature of the kernels filling a row with two alternating colors,
+ * starting with @p first. Both colors are the same for solid fills.
+ */
+template<typename PixelType>
+struct SpanFillFunc {
+	typedef void (*Type)(PixelType *dst, uint count, PixelType first, PixelType second);
+};
+
+/**
+ * Signature of the kernels blending a row with a single color. The kernels
+ * are only used for alpha values below 0xff.
+ */
+template<typename PixelType>
+struct SpanBlendFunc {
+	typedef void (*Type)(PixelType *dst, uint count, PixelType color, uint alpha, const SpanBlendFormat &format);
+};
+
+/**
+ * Reference implementation of SpanFillFunc. The SIMD variants use this for
+ * the pixels which do not fill a whole vector.
+ */
+template<typename PixelType>
+inline void spanFill(PixelType *dst, uint count, PixelType first, PixelType second) {
+	for (uint i = 1; i < count; i += 2) {
+		dst[i - 1] = first;
+		dst[i] = second;
+	}
+	if (count & 1)
+		dst[count - 1] = first;
+}
+
+/** Reference implementation of SpanBlendFunc. */
+template<typename PixelType>
+inline void spanBlend(PixelType *dst, uint count, PixelType color, uint alpha, const SpanBlendFormat &format) {
+	for (uint i = 0; i < count; ++i)
+		dst[i] = format.blend(dst[i], color, alpha);
+}
+
+#ifdef SCUMMVM_SSE2
+void spanFillSSE2(uint16 *dst, uint count, uint16 first, uint16 second);
+void spanFillSSE2(uint32 *dst, uint count, uint32 first, uint32 second);
+void spanBlendSSE2(uint16 *dst, uint count, uint16 color, uint alpha, const SpanBlendFormat &format);
+void spanBlendSSE2(uint32 *dst, uint count, uint32 color, uint alpha, const SpanBlendFormat &format);
+#endif
+
+#ifdef SCUMMVM_NEON
+void spanFillNEON(uint16 *dst, uint count, uint16 first, uint16 second);
+void spanFillNEON(uint32 *dst, uint count, uint32 first, uint32 second);
+void spanBlendNEON(uint16 *dst, uint count, uint16 color, uint alpha, const SpanBlendFormat &format);
+void spanBlendNEON(uint32 *dst, uint count, uint32 color, uint alpha, const SpanBlendFormat &format);
+#endif
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <arm_neon.h>
+
+#include "graphics/VectorRendererSpec-intern.h"
+
+namespace Graphics {
+
+namespace {
+
+/** d + (((s - d) * alpha) >> 8) for 16-bit lanes, with @p alpha shifted up by 7. */
+inline int16x8_t blendLanes(int16x8_t d, int16x8_t s, int16x8_t alpha) {
+	// (2 * (s - d) * (alpha << 7)) >> 16 rounds down like the shift by 8
+	return vaddq_s16(d, vqdmulhq_s16(vsubq_s16(s, d), alpha));
+}
+
+} // End of anonymous namespace
+
+void spanFillNEON(uint16 *dst, uint count, uint16 first, uint16 second) {
+	const uint16 pattern[8] = { first, second, first, second, first, second, first, second };
+	const uint16x8_t colors = vld1q_u16(pattern);
+
+	uint i = 0;
+	for (; i + 16 <= count; i += 16) {
+		vst1q_u16(dst + i, colors);
+		vst1q_u16(dst + i + 8, colors);
+	}
+	for (; i + 8 <= count; i += 8)
+		vst1q_u16(dst + i, colors);
+
+	spanFill<uint16>(dst + i, count - i, first, second);
+}
+
+void spanFillNEON(uint32 *dst, uint count, uint32 first, uint32 second) {
+	const uint32 pattern[4] = { first, second, first, second };
+	const uint32x4_t colors = vld1q_u32(pattern);
+
+	uint i = 0;
+	for (; i + 8 <= count; i += 8) {
+		vst1q_u32(dst + i, colors);
+		vst1q_u32(dst + i + 4, colors);
+	}
+	for (; i + 4 <= count; i += 4)
+		vst1q_u32(dst + i, colors);
+
+	spanFill<uint32>(dst + i, count - i, first, second);
+}
+
+void spanBlendNEON(uint16 *dst, uint count, uint16 color, uint alpha, const SpanBlendFormat &format) {
+	// vshlq_u16 shifts right for negative counts
+	int16x8_t shiftLeft[SpanBlendFormat::kChannelCount];
+	int16x8_t shiftRight[SpanBlendFormat::kChannelCount];
+	uint16x8_t max[SpanBlendFormat::kChannelCount];
+	int16x8_t src[SpanBlendFormat::kChannelCount];
+	for (int c = 0; c < SpanBlendFormat::kChannelCount; ++c) {
+		shiftLeft[c] = vdupq_n_s16(format.shift[c]);
+		shiftRight[c] = vdupq_n_s16(-(int)format.shift[c]);
+		max[c] = vdupq_n_u16(format.max[c]);
+		src[c] = vdupq_n_s16(c == SpanBlendFormat::kChannelA ? format.max[c] : (color >> format.shift[c]) & format.max[c]);
+	}
+	const int16x8_t a = vdupq_n_s16(alpha << 7);
+
+	uint i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const uint16x8_t pixels = vld1q_u16(dst + i);
+		uint16x8_t result = vdupq_n_u16(0);
+		for (int c = 0; c < SpanBlendFormat::kChannelCount; ++c) {
+			const int16x8_t d = vreinterpretq_s16_u16(vandq_u16(vshlq_u16(pixels, shiftRight[c]), max[c]));
+			const uint16x8_t blended = vreinterpretq_u16_s16(blendLanes(d, src[c], a));
+			result = vorrq_u16(result, vshlq_u16(blended, shiftLeft[c]));
+		}
+		vst1q_u16(dst + i, result);
+	}
+
+	spanBlend<uint16>(dst + i, count - i, color, alpha, format);
+}
+
+void spanBlendNEON(uint32 *dst, uint count, uint32 color, uint alpha, const SpanBlendFormat &format) {
+	// Every byte is blended, the ones which are not a channel are masked off
+	const int16x8_t src = vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(color | format.alphaMask))));
+	const uint8x16_t mask = vreinterpretq_u8_u32(vdupq_n_u32(format.mask));
+	const int16x8_t a = vdupq_n_s16(alpha << 7);
+
+	uint i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const uint8x16_t pixels = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+		const int16x8_t lo = blendLanes(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pixels))), src, a);
+		const int16x8_t hi = blendLanes(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pixels))), src, a);
+		const uint8x16_t result = vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi));
+		vst1q_u32(dst + i, vreinterpretq_u32_u8(vandq_u8(result, mask)));
+	}
+
+	spanBlend<uint32>(dst + i, count - i, color, alpha, format);
+}
+
+} // End of namespace Graphics
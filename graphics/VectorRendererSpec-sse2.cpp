@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "graphics/VectorRendererSpec-intern.h"
+
+namespace Graphics {
+
+namespace {
+
+/** d + (((s - d) * alpha) >> 8) for 16-bit lanes, with @p alpha shifted up by 7. */
+inline __m128i blendLanes(__m128i d, __m128i s, __m128i alpha) {
+	// (2 * (s - d) * (alpha << 7)) >> 16 rounds down like the shift by 8
+	return _mm_add_epi16(d, _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(s, d), 1), alpha));
+}
+
+} // End of anonymous namespace
+
+void spanFillSSE2(uint16 *dst, uint count, uint16 first, uint16 second) {
+	const __m128i colors = _mm_set_epi16(second, first, second, first, second, first, second, first);
+
+	uint i = 0;
+	for (; i + 16 <= count; i += 16) {
+		_mm_storeu_si128((__m128i *)(dst + i), colors);
+		_mm_storeu_si128((__m128i *)(dst + i + 8), colors);
+	}
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *)(dst + i), colors);
+
+	spanFill<uint16>(dst + i, count - i, first, second);
+}
+
+void spanFillSSE2(uint32 *dst, uint count, uint32 first, uint32 second) {
+	const __m128i colors = _mm_set_epi32(second, first, second, first);
+
+	uint i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm_storeu_si128((__m128i *)(dst + i), colors);
+		_mm_storeu_si128((__m128i *)(dst + i + 4), colors);
+	}
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_si128((__m128i *)(dst + i), colors);
+
+	spanFill<uint32>(dst + i, count - i, first, second);
+}
+
+void spanBlendSSE2(uint16 *dst, uint count, uint16 color, uint alpha, const SpanBlendFormat &format) {
+	__m128i shift[SpanBlendFormat::kChannelCount];
+	__m128i max[SpanBlendFormat::kChannelCount];
+	__m128i src[SpanBlendFormat::kChannelCount];
+	for (int c = 0; c < SpanBlendFormat::kChannelCount; ++c) {
+		shift[c] = _mm_cvtsi32_si128(format.shift[c]);
+		max[c] = _mm_set1_epi16(format.max[c]);
+		src[c] = _mm_set1_epi16(c == SpanBlendFormat::kChannelA ? format.max[c] : (color >> format.shift[c]) & format.max[c]);
+	}
+	const __m128i a = _mm_set1_epi16(alpha << 7);
+
+	uint i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)(dst + i));
+		__m128i result = _mm_setzero_si128();
+		for (int c = 0; c < SpanBlendFormat::kChannelCount; ++c) {
+			const __m128i d = _mm_and_si128(_mm_srl_epi16(pixels, shift[c]), max[c]);
+			result = _mm_or_si128(result, _mm_sll_epi16(blendLanes(d, src[c], a), shift[c]));
+		}
+		_mm_storeu_si128((__m128i *)(dst + i), result);
+	}
+
+	spanBlend<uint16>(dst + i, count - i, color, alpha, format);
+}
+
+void spanBlendSSE2(uint32 *dst, uint count, uint32 color, uint alpha, const SpanBlendFormat &format) {
+	// Every byte is blended, the ones which are not a channel are masked off
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32(color | format.alphaMask), zero);
+	const __m128i mask = _mm_set1_epi32(format.mask);
+	const __m128i a = _mm_set1_epi16(alpha << 7);
+
+	uint i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)(dst + i));
+		const __m128i lo = blendLanes(_mm_unpacklo_epi8(pixels, zero), src, a);
+		const __m128i hi = blendLanes(_mm_unpackhi_epi8(pixels, zero), src, a);
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_and_si128(_mm_packus_epi16(lo, hi), mask));
+	}
+
+	spanBlend<uint32>(dst + i, count - i, color, alpha, format);
+}
+
+} // End of namespace Graphics
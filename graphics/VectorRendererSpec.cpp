@@ -29,6 +29,7 @@
 #include "gui/ThemeEngine.h"
 #include "graphics/VectorRenderer.h"
 #include "graphics/VectorRendererSpec.h"
+#include "graphics/VectorRendererSpec-intern.h"
 
 #define VECTOR_RENDERER_FAST_TRIANGLES
 
@@ -422,6 +423,98 @@ inline frac_t fp_sqroot(uint32 x) {
 
 namespace Graphics {
 
+bool SpanBlendFormat::init(const PixelFormat &format) {
+	const uint8 loss[kChannelCount] = { format.aLoss, format.rLoss, format.gLoss, format.bLoss };
+	const uint8 shifts[kChannelCount] = { format.aShift, format.rShift, format.gShift, format.bShift };
+
+	mask = 0;
+	for (int c = 0; c < kChannelCount; ++c) {
+		max[c] = 0xFF >> loss[c];
+		shift[c] = max[c] ? shifts[c] : 0;
+		mask |= (uint32)max[c] << shift[c];
+	}
+	alphaMask = (uint32)max[kChannelA] << shift[kChannelA];
+
+	if (format.bytesPerPixel == 2)
+		return true;
+
+	if (format.bytesPerPixel == 4) {
+		// The 32 bpp kernels blend whole bytes
+		for (int c = 0; c < kChannelCount; ++c) {
+			if (c == kChannelA && loss[c] == 8)
+				continue;
+			if (loss[c] != 0 || (shift[c] & 7) != 0)
+				return false;
+		}
+		return true;
+	}
+
+	return false;
+}
+
+template<typename PixelType>
+typename SpanFillFunc<PixelType>::Type getSpanFillFunc() {
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return spanFillSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return spanFillNEON;
+#endif
+	return nullptr;
+}
+
+template<>
+SpanFillFunc<byte>::Type getSpanFillFunc<byte>() {
+	return nullptr;
+}
+
+template<typename PixelType>
+typename SpanBlendFunc<PixelType>::Type getSpanBlendFunc() {
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return spanBlendSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return spanBlendNEON;
+#endif
+	return nullptr;
+}
+
+template<>
+SpanBlendFunc<byte>::Type getSpanBlendFunc<byte>() {
+	return nullptr;
+}
+
+/**
+ * Fills several pixels in a row with two alternating colors, using the
+ * SIMD kernels when the row is long enough.
+ *
+ * @param first Pointer to the first pixel to fill.
+ * @param last Pointer to the last pixel to fill.
+ * @param color1 Color of the first pixel, and every other one after it.
+ * @param color2 Color of the second pixel, and every other one after it.
+ * @return Whether the pixels were filled.
+ */
+template<typename PixelType>
+inline bool colorFillSpan(PixelType *first, PixelType *last, PixelType color1, PixelType color2) {
+	static const typename SpanFillFunc<PixelType>::Type fill = getSpanFillFunc<PixelType>();
+
+	if (!fill || last - first < kMinSimdSpanLength)
+		return false;
+
+	fill(first, last - first, color1, color2);
+	return true;
+}
+
+template<typename PixelType>
+void colorFillPattern(PixelType *first, PixelType *last, PixelType color1, PixelType color2) {
+	if (first < last && !colorFillSpan<PixelType>(first, last, color1, color2))
+		spanFill<PixelType>(first, last - first, color1, color2);
+}
+
 /**
  * Fills several pixels in a row with a given color.
  *
@@ -443,6 +536,8 @@ void colorFill(PixelType *first, PixelType *last, PixelType color) {
 	int count = (last - first);
 	if (!count)
 		return;
+	if (colorFillSpan<PixelType>(first, last, color, color))
+		return;
 	int n = (count + 7) >> 3;
 	switch (count % 8) {
 	default:
@@ -483,6 +578,8 @@ void colorFillClip(PixelType *first, PixelType *last, PixelType color, int realX
 
 	if (!count)
 		return;
+	if (colorFillSpan<PixelType>(first, first + count, color, color))
+		return;
 
 	int n = (count + 7) >> 3;
 	switch (count % 8) {
@@ -591,6 +688,8 @@ VectorRendererSpec(PixelFormat format) :
 	_blueMask((0xFF >> format.bLoss) << format.bShift),
 	_alphaMask((0xFF >> format.aLoss) << format.aShift) {
 
+	_blendSpan = _blendFormat.init(format) ? getSpanBlendFunc<PixelType>() : nullptr;
+
 	_clippingArea = Common::Rect(0, 0, 32767, 32767);
 
 	_fgColor = _bgColor = _bevelColor = 0;
@@ -684,16 +783,14 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
+		// The pixels alternate between the colors of even and odd columns
+		const PixelType evenColor = ((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+		const PixelType oddColor = (ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
 
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		if (x & 1)
+			colorFillPattern<PixelType>(ptr, ptr + width, oddColor, evenColor);
+		else
+			colorFillPattern<PixelType>(ptr, ptr + width, evenColor, oddColor);
 	}
 }
 
@@ -726,17 +823,19 @@ gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY)
 	} else if (grad == 3 && ox) {
 		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1], realX, realY, _clippingArea);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		// The pixels alternate between the colors of even and odd columns
+		const PixelType evenColor = ((grad == 2 || grad == 3) && ox) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+		const PixelType oddColor = (ox || grad == 3) ? _gradCache[curGrad + 1] : _gradCache[curGrad];
+
+		const int left = MAX(_clippingArea.left - realX, 0);
+		const int right = MIN(_clippingArea.right - realX, width);
+		if (left >= right)
+			return;
+
+		if ((x + left) & 1)
+			colorFillPattern<PixelType>(ptr + left, ptr + right, oddColor, evenColor);
+		else
+			colorFillPattern<PixelType>(ptr + left, ptr + right, evenColor, oddColor);
 	}
 }
 
@@ -23,6 +23,7 @@
 #define VECTOR_RENDERER_SPEC_H
 
 #include "graphics/VectorRenderer.h"
+#include "graphics/VectorRendererSpec-intern.h"
 
 namespace Graphics {
 
@@ -287,19 +288,21 @@ protected:
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
 	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+		if (_blendSpan && alpha != 0xff && last - first >= kMinSimdSpanLength) {
+			_blendSpan(first, last - first, color, alpha, _blendFormat);
+			return;
+		}
+
 		while (first < last)
 			blendPixelPtr(first++, color, alpha);
 	}
 
 	inline void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
 		if (_clippingArea.top <= realY && realY < _clippingArea.bottom) {
-			while (first < last) {
-				if (_clippingArea.left <= realX && realX < _clippingArea.right)
-					blendPixelPtr(first++, color, alpha);
-				else
-					++first;
-				++realX;
-			}
+			const int left = MAX<int>(_clippingArea.left - realX, 0);
+			const int right = MIN<int>(_clippingArea.right - realX, last - first);
+			if (left < right)
+				blendFill(first + left, first + right, color, alpha);
 		}
 	}
 
@@ -309,6 +312,9 @@ protected:
 	const PixelFormat _format;
 	const PixelType _redMask, _greenMask, _blueMask, _alphaMask;
 
+	SpanBlendFormat _blendFormat;
+	typename SpanBlendFunc<PixelType>::Type _blendSpan; ///< SIMD kernel for blendFill, if any
+
 	PixelType _fgColor; /**< Foreground color currently being used to draw on the renderer */
 	PixelType _bgColor; /**< Background color currently being used to draw on the renderer */
 
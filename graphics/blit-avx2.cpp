@@ -0,0 +1,156 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <immintrin.h>
+
+#include "graphics/blit-intern.h"
+
+namespace Graphics {
+
+namespace {
+
+struct ConversionAVX2 {
+	__m256i srcShift[PixelConversion::kChannelCount];
+	__m256i srcMask[PixelConversion::kChannelCount];
+	__m256i expandLeft[PixelConversion::kChannelCount];
+	__m256i expandRight[PixelConversion::kChannelCount];
+	__m256i dstLoss[PixelConversion::kChannelCount];
+	__m256i dstShift[PixelConversion::kChannelCount];
+	__m256i constant;
+
+	ConversionAVX2(const PixelConversion &conv) {
+		for (int c = 0; c < PixelConversion::kChannelCount; ++c) {
+			srcShift[c] = _mm256_set1_epi32(conv.srcShift[c]);
+			srcMask[c] = _mm256_set1_epi32(conv.srcMask[c]);
+			expandLeft[c] = _mm256_set1_epi32(conv.expandLeft[c]);
+			expandRight[c] = _mm256_set1_epi32(conv.expandRight[c]);
+			dstLoss[c] = _mm256_set1_epi32(conv.dstLoss[c]);
+			dstShift[c] = _mm256_set1_epi32(conv.dstShift[c]);
+		}
+		constant = _mm256_set1_epi32(conv.constant);
+	}
+
+	inline __m256i convert(__m256i color) const {
+		__m256i result = constant;
+		for (int c = 0; c < PixelConversion::kChannelCount; ++c) {
+			const __m256i v = _mm256_and_si256(_mm256_srlv_epi32(color, srcShift[c]), srcMask[c]);
+			const __m256i expanded = _mm256_or_si256(_mm256_sllv_epi32(v, expandLeft[c]), _mm256_srlv_epi32(v, expandRight[c]));
+			result = _mm256_or_si256(result, _mm256_sllv_epi32(_mm256_srlv_epi32(expanded, dstLoss[c]), dstShift[c]));
+		}
+		return result;
+	}
+};
+
+/** Truncate the 32-bit lanes of @p v to 16 bits and pack them. */
+inline __m128i pack32To16(__m256i v) {
+	v = _mm256_and_si256(v, _mm256_set1_epi32(0xFFFF));
+	// The pack works within 128-bit lanes, so gather the low 64 bits of
+	// each lane afterwards
+	const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08);
+	return _mm256_castsi256_si128(packed);
+}
+
+inline __m128i packMask32To16(__m256i mask) {
+	const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(mask, mask), 0x08);
+	return _mm256_castsi256_si128(packed);
+}
+
+/** Store eight converted pixels, keeping those whose source matched the key. */
+template<typename DstColor, bool hasKey>
+inline void store8(byte *dst, __m256i result, __m256i keyMask) {
+	if (sizeof(DstColor) == 2) {
+		__m128i packed = pack32To16(result);
+		if (hasKey)
+			packed = _mm_blendv_epi8(packed, _mm_loadu_si128((const __m128i *)dst), packMask32To16(keyMask));
+		_mm_storeu_si128((__m128i *)dst, packed);
+	} else {
+		if (hasKey)
+			result = _mm256_blendv_epi8(result, _mm256_loadu_si256((const __m256i *)dst), keyMask);
+		_mm256_storeu_si256((__m256i *)dst, result);
+	}
+}
+
+/** Convert eight pixels. */
+template<typename SrcColor, typename DstColor, bool hasKey>
+inline void convert8(byte *dst, const byte *src, const ConversionAVX2 &conv, __m256i key) {
+	__m256i colors;
+	if (sizeof(SrcColor) == 2)
+		colors = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+	else
+		colors = _mm256_loadu_si256((const __m256i *)src);
+
+	const __m256i keyMask = hasKey ? _mm256_cmpeq_epi32(colors, key) : _mm256_setzero_si256();
+	store8<DstColor, hasKey>(dst, conv.convert(colors), keyMask);
+}
+
+} // End of anonymous namespace
+
+template<typename SrcColor, typename DstColor, bool hasKey>
+void crossBlitRowAVX2(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key) {
+	const ConversionAVX2 convAVX2(conv);
+	const __m256i keyVec = _mm256_set1_epi32(key);
+	const uint vecWidth = w & ~7;
+
+	// See crossBlitRowSSE2 for the order
+	if (sizeof(DstColor) > sizeof(SrcColor)) {
+		crossBlitRow<SrcColor, DstColor, hasKey>(dst + vecWidth * sizeof(DstColor), src + vecWidth * sizeof(SrcColor), w - vecWidth, conv, key);
+		for (uint x = vecWidth; x > 0;) {
+			x -= 8;
+			convert8<SrcColor, DstColor, hasKey>(dst + x * sizeof(DstColor), src + x * sizeof(SrcColor), convAVX2, keyVec);
+		}
+	} else {
+		for (uint x = 0; x < vecWidth; x += 8)
+			convert8<SrcColor, DstColor, hasKey>(dst + x * sizeof(DstColor), src + x * sizeof(SrcColor), convAVX2, keyVec);
+		crossBlitRow<SrcColor, DstColor, hasKey>(dst + vecWidth * sizeof(DstColor), src + vecWidth * sizeof(SrcColor), w - vecWidth, conv, key);
+	}
+}
+
+template<typename DstColor, bool hasKey>
+void crossBlitMapRowAVX2(byte *dst, const byte *src, uint w, const uint32 *map, uint32 key) {
+	const __m256i keyVec = _mm256_set1_epi32(key);
+	const uint vecWidth = w & ~7;
+
+	// Always right to left, see CrossBlitMapRowFunc
+	crossBlitMapRow<DstColor, hasKey>(dst + vecWidth * sizeof(DstColor), src + vecWidth, w - vecWidth, map, key);
+	for (uint x = vecWidth; x > 0;) {
+		x -= 8;
+		const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + x)));
+		const __m256i colors = _mm256_i32gather_epi32((const int *)map, indices, 4);
+		const __m256i keyMask = hasKey ? _mm256_cmpeq_epi32(indices, keyVec) : _mm256_setzero_si256();
+		store8<DstColor, hasKey>(dst + x * sizeof(DstColor), colors, keyMask);
+	}
+}
+
+template void crossBlitRowAVX2<uint16, uint16, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowAVX2<uint16, uint16, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowAVX2<uint16, uint32, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowAVX2<uint16, uint32, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowAVX2<uint32, uint16, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowAVX2<uint32, uint16, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowAVX2<uint32, uint32, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowAVX2<uint32, uint32, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+
+template void crossBlitMapRowAVX2<uint16, false>(byte *, const byte *, uint, const uint32 *, uint32);
+template void crossBlitMapRowAVX2<uint16, true>(byte *, const byte *, uint, const uint32 *, uint32);
+template void crossBlitMapRowAVX2<uint32, false>(byte *, const byte *, uint, const uint32 *, uint32);
+template void crossBlitMapRowAVX2<uint32, true>(byte *, const byte *, uint, const uint32 *, uint32);
+
+} // End of namespace Graphics
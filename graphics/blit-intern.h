@@ -0,0 +1,155 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_BLIT_INTERN_H
+#define GRAPHICS_BLIT_INTERN_H
+
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * Conversion between two 16 or 32 bpp pixel formats, decomposed into shifts
+ * and masks which are the same for every channel, so that the SIMD kernels
+ * can convert several pixels at once.
+ *
+ * A source channel of n bits, with 4 <= n <= 8, is expanded to 8 bits by
+ * ((v << (8 - n)) | (v >> (2n - 8))), which is exactly what
+ * PixelFormat::colorToARGB does for these depths. Missing source channels
+ * are 0, except for alpha which is opaque. Formats with channels of 1 to 3
+ * bits are not supported and use the generic code instead.
+ */
+struct PixelConversion {
+	enum {
+		kChannelA = 0,
+		kChannelR = 1,
+		kChannelG = 2,
+		kChannelB = 3,
+		kChannelCount = 4
+	};
+
+	/** Mask applied to a source channel after shifting it down */
+	uint32 srcMask[kChannelCount];
+	uint8 srcShift[kChannelCount];
+	/** Shifts to expand a source channel to 8 bits */
+	uint8 expandLeft[kChannelCount];
+	uint8 expandRight[kChannelCount];
+	uint8 dstLoss[kChannelCount];
+	uint8 dstShift[kChannelCount];
+	/** Bits set in every converted pixel, from channels missing in the source */
+	uint32 constant;
+
+	/**
+	 * Set up the conversion from @p src to @p dst.
+	 *
+	 * @return Whether both formats can be handled by the SIMD kernels.
+	 */
+	bool init(const PixelFormat &dst, const PixelFormat &src);
+
+	/** Reference implementation of the conversion of a single pixel. */
+	inline uint32 convert(uint32 color) const {
+		uint32 result = constant;
+		for (int c = 0; c < kChannelCount; ++c) {
+			const uint32 v = (color >> srcShift[c]) & srcMask[c];
+			const uint32 expanded = (v << expandLeft[c]) | (v >> expandRight[c]);
+			result |= (expanded >> dstLoss[c]) << dstShift[c];
+		}
+		return result;
+	}
+};
+
+/**
+ * Signature of the kernels converting one row of pixels. The row is
+ * converted from right to left when the destination pixels are wider than
+ * the source pixels, so that a buffer can be converted in place.
+ *
+ * @param dst   Destination row.
+ * @param src   Source row.
+ * @param w     Number of pixels in the row.
+ * @param conv  The conversion to apply.
+ * @param key   Source color to skip, when the kernel uses a color key.
+ */
+typedef void (*CrossBlitRowFunc)(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key);
+
+/**
+ * Signature of the kernels converting one row of CLUT8 pixels through a
+ * palette map. The row is always converted from right to left.
+ */
+typedef void (*CrossBlitMapRowFunc)(byte *dst, const byte *src, uint w, const uint32 *map, uint32 key);
+
+/**
+ * Reference implementation of CrossBlitRowFunc. The SIMD variants have to
+ * produce exactly the same output, and use this for the pixels which do
+ * not fill a whole vector.
+ */
+template<typename SrcColor, typename DstColor, bool hasKey>
+inline void crossBlitRow(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key) {
+	const SrcColor *s = (const SrcColor *)src;
+	DstColor *d = (DstColor *)dst;
+
+	if (sizeof(DstColor) > sizeof(SrcColor)) {
+		for (uint x = w; x-- > 0;) {
+			const uint32 color = s[x];
+			if (!hasKey || color != key)
+				d[x] = conv.convert(color);
+		}
+	} else {
+		for (uint x = 0; x < w; ++x) {
+			const uint32 color = s[x];
+			if (!hasKey || color != key)
+				d[x] = conv.convert(color);
+		}
+	}
+}
+
+/** Reference implementation of CrossBlitMapRowFunc. */
+template<typename DstColor, bool hasKey>
+inline void crossBlitMapRow(byte *dst, const byte *src, uint w, const uint32 *map, uint32 key) {
+	DstColor *d = (DstColor *)dst;
+
+	for (uint x = w; x-- > 0;) {
+		const byte color = src[x];
+		if (!hasKey || color != key)
+			d[x] = map[color];
+	}
+}
+
+#ifdef SCUMMVM_SSE2
+template<typename SrcColor, typename DstColor, bool hasKey>
+void crossBlitRowSSE2(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key);
+#endif
+
+#ifdef SCUMMVM_AVX2
+template<typename SrcColor, typename DstColor, bool hasKey>
+void crossBlitRowAVX2(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key);
+
+template<typename DstColor, bool hasKey>
+void crossBlitMapRowAVX2(byte *dst, const byte *src, uint w, const uint32 *map, uint32 key);
+#endif
+
+#ifdef SCUMMVM_NEON
+template<typename SrcColor, typename DstColor, bool hasKey>
+void crossBlitRowNEON(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key);
+#endif
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <arm_neon.h>
+
+#include "graphics/blit-intern.h"
+
+namespace Graphics {
+
+namespace {
+
+struct ConversionNEON {
+	// vshlq_u32 shifts right for negative counts
+	int32x4_t srcShift[PixelConversion::kChannelCount];
+	uint32x4_t srcMask[PixelConversion::kChannelCount];
+	int32x4_t expandLeft[PixelConversion::kChannelCount];
+	int32x4_t expandRight[PixelConversion::kChannelCount];
+	int32x4_t dstLoss[PixelConversion::kChannelCount];
+	int32x4_t dstShift[PixelConversion::kChannelCount];
+	uint32x4_t constant;
+
+	ConversionNEON(const PixelConversion &conv) {
+		for (int c = 0; c < PixelConversion::kChannelCount; ++c) {
+			srcShift[c] = vdupq_n_s32(-(int32)conv.srcShift[c]);
+			srcMask[c] = vdupq_n_u32(conv.srcMask[c]);
+			expandLeft[c] = vdupq_n_s32(conv.expandLeft[c]);
+			expandRight[c] = vdupq_n_s32(-(int32)conv.expandRight[c]);
+			dstLoss[c] = vdupq_n_s32(-(int32)conv.dstLoss[c]);
+			dstShift[c] = vdupq_n_s32(conv.dstShift[c]);
+		}
+		constant = vdupq_n_u32(conv.constant);
+	}
+
+	inline uint32x4_t convert(uint32x4_t color) const {
+		uint32x4_t result = constant;
+		for (int c = 0; c < PixelConversion::kChannelCount; ++c) {
+			const uint32x4_t v = vandq_u32(vshlq_u32(color, srcShift[c]), srcMask[c]);
+			const uint32x4_t expanded = vorrq_u32(vshlq_u32(v, expandLeft[c]), vshlq_u32(v, expandRight[c]));
+			result = vorrq_u32(result, vshlq_u32(vshlq_u32(expanded, dstLoss[c]), dstShift[c]));
+		}
+		return result;
+	}
+};
+
+/** Convert eight pixels. */
+template<typename SrcColor, typename DstColor, bool hasKey>
+inline void convert8(byte *dst, const byte *src, const ConversionNEON &conv, uint32x4_t key) {
+	uint32x4_t lo, hi;
+	if (sizeof(SrcColor) == 2) {
+		const uint16x8_t colors = vld1q_u16((const uint16 *)src);
+		lo = vmovl_u16(vget_low_u16(colors));
+		hi = vmovl_u16(vget_high_u16(colors));
+	} else {
+		lo = vld1q_u32((const uint32 *)src);
+		hi = vld1q_u32((const uint32 *)src + 4);
+	}
+
+	const uint32x4_t convLo = conv.convert(lo);
+	const uint32x4_t convHi = conv.convert(hi);
+
+	if (sizeof(DstColor) == 2) {
+		uint16x8_t result = vcombine_u16(vmovn_u32(convLo), vmovn_u32(convHi));
+		if (hasKey) {
+			const uint16x8_t mask = vcombine_u16(vmovn_u32(vceqq_u32(lo, key)), vmovn_u32(vceqq_u32(hi, key)));
+			result = vbslq_u16(mask, vld1q_u16((const uint16 *)dst), result);
+		}
+		vst1q_u16((uint16 *)dst, result);
+	} else {
+		uint32x4_t resultLo = convLo;
+		uint32x4_t resultHi = convHi;
+		if (hasKey) {
+			resultLo = vbslq_u32(vceqq_u32(lo, key), vld1q_u32((const uint32 *)dst), resultLo);
+			resultHi = vbslq_u32(vceqq_u32(hi, key), vld1q_u32((const uint32 *)dst + 4), resultHi);
+		}
+		vst1q_u32((uint32 *)dst, resultLo);
+		vst1q_u32((uint32 *)dst + 4, resultHi);
+	}
+}
+
+} // End of anonymous namespace
+
+template<typename SrcColor, typename DstColor, bool hasKey>
+void crossBlitRowNEON(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key) {
+	const ConversionNEON convNEON(conv);
+	const uint32x4_t keyVec = vdupq_n_u32(key);
+	const uint vecWidth = w & ~7;
+
+	// See crossBlitRowSSE2 for the order
+	if (sizeof(DstColor) > sizeof(SrcColor)) {
+		crossBlitRow<SrcColor, DstColor, hasKey>(dst + vecWidth * sizeof(DstColor), src + vecWidth * sizeof(SrcColor), w - vecWidth, conv, key);
+		for (uint x = vecWidth; x > 0;) {
+			x -= 8;
+			convert8<SrcColor, DstColor, hasKey>(dst + x * sizeof(DstColor), src + x * sizeof(SrcColor), convNEON, keyVec);
+		}
+	} else {
+		for (uint x = 0; x < vecWidth; x += 8)
+			convert8<SrcColor, DstColor, hasKey>(dst + x * sizeof(DstColor), src + x * sizeof(SrcColor), convNEON, keyVec);
+		crossBlitRow<SrcColor, DstColor, hasKey>(dst + vecWidth * sizeof(DstColor), src + vecWidth * sizeof(SrcColor), w - vecWidth, conv, key);
+	}
+}
+
+template void crossBlitRowNEON<uint16, uint16, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowNEON<uint16, uint16, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowNEON<uint16, uint32, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowNEON<uint16, uint32, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowNEON<uint32, uint16, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowNEON<uint32, uint16, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowNEON<uint32, uint32, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowNEON<uint32, uint32, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+
+} // End of namespace Graphics
@@ -0,0 +1,142 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "graphics/blit-intern.h"
+
+namespace Graphics {
+
+namespace {
+
+struct ConversionSSE2 {
+	__m128i srcShift[PixelConversion::kChannelCount];
+	__m128i srcMask[PixelConversion::kChannelCount];
+	__m128i expandLeft[PixelConversion::kChannelCount];
+	__m128i expandRight[PixelConversion::kChannelCount];
+	__m128i dstLoss[PixelConversion::kChannelCount];
+	__m128i dstShift[PixelConversion::kChannelCount];
+	__m128i constant;
+
+	ConversionSSE2(const PixelConversion &conv) {
+		for (int c = 0; c < PixelConversion::kChannelCount; ++c) {
+			srcShift[c] = _mm_cvtsi32_si128(conv.srcShift[c]);
+			srcMask[c] = _mm_set1_epi32(conv.srcMask[c]);
+			expandLeft[c] = _mm_cvtsi32_si128(conv.expandLeft[c]);
+			expandRight[c] = _mm_cvtsi32_si128(conv.expandRight[c]);
+			dstLoss[c] = _mm_cvtsi32_si128(conv.dstLoss[c]);
+			dstShift[c] = _mm_cvtsi32_si128(conv.dstShift[c]);
+		}
+		constant = _mm_set1_epi32(conv.constant);
+	}
+
+	inline __m128i convert(__m128i color) const {
+		__m128i result = constant;
+		for (int c = 0; c < PixelConversion::kChannelCount; ++c) {
+			const __m128i v = _mm_and_si128(_mm_srl_epi32(color, srcShift[c]), srcMask[c]);
+			const __m128i expanded = _mm_or_si128(_mm_sll_epi32(v, expandLeft[c]), _mm_srl_epi32(v, expandRight[c]));
+			result = _mm_or_si128(result, _mm_sll_epi32(_mm_srl_epi32(expanded, dstLoss[c]), dstShift[c]));
+		}
+		return result;
+	}
+};
+
+inline __m128i blend(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/** Truncate the 32-bit lanes of @p lo and @p hi to 16 bits and pack them. */
+inline __m128i pack32To16(__m128i lo, __m128i hi) {
+	// There is no unsigned saturating pack in SSE2, so sign extend the low
+	// halves first, which makes the signed saturation a plain truncation.
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+/** Convert eight pixels. */
+template<typename SrcColor, typename DstColor, bool hasKey>
+inline void convert8(byte *dst, const byte *src, const ConversionSSE2 &conv, __m128i key) {
+	__m128i lo, hi;
+	if (sizeof(SrcColor) == 2) {
+		const __m128i colors = _mm_loadu_si128((const __m128i *)src);
+		lo = _mm_unpacklo_epi16(colors, _mm_setzero_si128());
+		hi = _mm_unpackhi_epi16(colors, _mm_setzero_si128());
+	} else {
+		lo = _mm_loadu_si128((const __m128i *)src);
+		hi = _mm_loadu_si128((const __m128i *)src + 1);
+	}
+
+	const __m128i convLo = conv.convert(lo);
+	const __m128i convHi = conv.convert(hi);
+
+	if (sizeof(DstColor) == 2) {
+		__m128i result = pack32To16(convLo, convHi);
+		if (hasKey) {
+			const __m128i mask = _mm_packs_epi32(_mm_cmpeq_epi32(lo, key), _mm_cmpeq_epi32(hi, key));
+			result = blend(mask, _mm_loadu_si128((const __m128i *)dst), result);
+		}
+		_mm_storeu_si128((__m128i *)dst, result);
+	} else {
+		__m128i resultLo = convLo;
+		__m128i resultHi = convHi;
+		if (hasKey) {
+			resultLo = blend(_mm_cmpeq_epi32(lo, key), _mm_loadu_si128((const __m128i *)dst), resultLo);
+			resultHi = blend(_mm_cmpeq_epi32(hi, key), _mm_loadu_si128((const __m128i *)dst + 1), resultHi);
+		}
+		_mm_storeu_si128((__m128i *)dst, resultLo);
+		_mm_storeu_si128((__m128i *)dst + 1, resultHi);
+	}
+}
+
+} // End of anonymous namespace
+
+template<typename SrcColor, typename DstColor, bool hasKey>
+void crossBlitRowSSE2(byte *dst, const byte *src, uint w, const PixelConversion &conv, uint32 key) {
+	const ConversionSSE2 convSSE2(conv);
+	const __m128i keyVec = _mm_set1_epi32(key);
+	const uint vecWidth = w & ~7;
+
+	if (sizeof(DstColor) > sizeof(SrcColor)) {
+		// Right to left, see CrossBlitRowFunc. All the source pixels of a
+		// group are loaded before any destination pixel is stored.
+		crossBlitRow<SrcColor, DstColor, hasKey>(dst + vecWidth * sizeof(DstColor), src + vecWidth * sizeof(SrcColor), w - vecWidth, conv, key);
+		for (uint x = vecWidth; x > 0;) {
+			x -= 8;
+			convert8<SrcColor, DstColor, hasKey>(dst + x * sizeof(DstColor), src + x * sizeof(SrcColor), convSSE2, keyVec);
+		}
+	} else {
+		for (uint x = 0; x < vecWidth; x += 8)
+			convert8<SrcColor, DstColor, hasKey>(dst + x * sizeof(DstColor), src + x * sizeof(SrcColor), convSSE2, keyVec);
+		crossBlitRow<SrcColor, DstColor, hasKey>(dst + vecWidth * sizeof(DstColor), src + vecWidth * sizeof(SrcColor), w - vecWidth, conv, key);
+	}
+}
+
+template void crossBlitRowSSE2<uint16, uint16, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowSSE2<uint16, uint16, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowSSE2<uint16, uint32, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowSSE2<uint16, uint32, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowSSE2<uint32, uint16, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowSSE2<uint32, uint16, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowSSE2<uint32, uint32, false>(byte *, const byte *, uint, const PixelConversion &, uint32);
+template void crossBlitRowSSE2<uint32, uint32, true>(byte *, const byte *, uint, const PixelConversion &, uint32);
+
+} // End of namespace Graphics
@@ -20,8 +20,11 @@
  */
 
 #include "graphics/blit.h"
+#include "graphics/blit-intern.h"
 #include "graphics/pixelformat.h"
 
+#include "common/system.h"
+
 namespace Graphics {
 
 // see graphics/blit-atari.cpp
@@ -193,8 +196,122 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+template<typename SrcColor, typename DstColor, bool hasKey>
+CrossBlitRowFunc getCrossBlitRowFunc() {
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+		return crossBlitRowAVX2<SrcColor, DstColor, hasKey>;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return crossBlitRowSSE2<SrcColor, DstColor, hasKey>;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return crossBlitRowNEON<SrcColor, DstColor, hasKey>;
+#endif
+	return nullptr;
+}
+
+template<typename SrcColor, typename DstColor, bool hasKey>
+bool crossBlitRowsSIMD(byte *dst, const byte *src, const uint dstPitch, const uint srcPitch, const uint w, const uint h,
+				   const PixelFormat &dstFmt, const PixelFormat &srcFmt, const uint32 key) {
+	const CrossBlitRowFunc convertRow = getCrossBlitRowFunc<SrcColor, DstColor, hasKey>();
+	PixelConversion conv;
+	if (!convertRow || !conv.init(dstFmt, srcFmt))
+		return false;
+
+	if (sizeof(DstColor) > sizeof(SrcColor)) {
+		// Bottom to top, for the same reason as in crossBlit
+		for (uint y = h; y-- > 0;)
+			convertRow(dst + y * dstPitch, src + y * srcPitch, w, conv, key);
+	} else {
+		for (uint y = 0; y < h; ++y)
+			convertRow(dst + y * dstPitch, src + y * srcPitch, w, conv, key);
+	}
+	return true;
+}
+
+/**
+ * Convert between 16 and 32 bpp formats with the SIMD kernels, if the CPU
+ * and both formats support them.
+ *
+ * @return Whether the conversion was done.
+ */
+template<bool hasKey>
+bool crossBlitSIMD(byte *dst, const byte *src, const uint dstPitch, const uint srcPitch, const uint w, const uint h,
+				   const PixelFormat &dstFmt, const PixelFormat &srcFmt, const uint32 key) {
+	if (srcFmt.bytesPerPixel == 2 && dstFmt.bytesPerPixel == 2)
+		return crossBlitRowsSIMD<uint16, uint16, hasKey>(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt, key);
+	else if (srcFmt.bytesPerPixel == 2 && dstFmt.bytesPerPixel == 4)
+		return crossBlitRowsSIMD<uint16, uint32, hasKey>(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt, key);
+	else if (srcFmt.bytesPerPixel == 4 && dstFmt.bytesPerPixel == 2)
+		return crossBlitRowsSIMD<uint32, uint16, hasKey>(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt, key);
+	else if (srcFmt.bytesPerPixel == 4 && dstFmt.bytesPerPixel == 4)
+		return crossBlitRowsSIMD<uint32, uint32, hasKey>(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt, key);
+	return false;
+}
+
+/**
+ * Convert CLUT8 pixels to 16 or 32 bpp through a map with the SIMD kernels,
+ * if the CPU supports them.
+ *
+ * @return Whether the conversion was done.
+ */
+template<bool hasKey>
+bool crossBlitMapSIMD(byte *dst, const byte *src, const uint dstPitch, const uint srcPitch, const uint w, const uint h,
+					  const uint bytesPerPixel, const uint32 *map, const uint32 key) {
+	CrossBlitMapRowFunc convertRow = nullptr;
+#ifdef SCUMMVM_AVX2
+	// The other instruction sets lack a gather, which makes a lookup as
+	// fast as the plain C++ loop.
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		if (bytesPerPixel == 2)
+			convertRow = crossBlitMapRowAVX2<uint16, hasKey>;
+		else if (bytesPerPixel == 4)
+			convertRow = crossBlitMapRowAVX2<uint32, hasKey>;
+	}
+#endif
+	if (!convertRow)
+		return false;
+
+	// Bottom to top, for the same reason as in crossBlitMap
+	for (uint y = h; y-- > 0;)
+		convertRow(dst + y * dstPitch, src + y * srcPitch, w, map, key);
+	return true;
+}
+
 } // End of anonymous namespace
 
+bool PixelConversion::init(const PixelFormat &dst, const PixelFormat &src) {
+	const uint8 srcLosses[kChannelCount] = { src.aLoss, src.rLoss, src.gLoss, src.bLoss };
+	const uint8 srcShifts[kChannelCount] = { src.aShift, src.rShift, src.gShift, src.bShift };
+	const uint8 dstLosses[kChannelCount] = { dst.aLoss, dst.rLoss, dst.gLoss, dst.bLoss };
+	const uint8 dstShifts[kChannelCount] = { dst.aShift, dst.rShift, dst.gShift, dst.bShift };
+
+	constant = 0;
+	for (int c = 0; c < kChannelCount; ++c) {
+		const uint bits = 8 - srcLosses[c];
+		dstLoss[c] = dstLosses[c];
+		dstShift[c] = dstShifts[c];
+
+		if (bits == 0) {
+			srcMask[c] = 0;
+			srcShift[c] = expandLeft[c] = expandRight[c] = 0;
+			if (c == kChannelA)
+				constant |= (0xFF >> dstLoss[c]) << dstShift[c];
+		} else if (bits >= 4 && bits <= 8) {
+			srcMask[c] = (1 << bits) - 1;
+			srcShift[c] = srcShifts[c];
+			expandLeft[c] = 8 - bits;
+			expandRight[c] = 2 * bits - 8;
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+
 // Function to blit a rect from one color format to another
 bool crossBlit(byte *dst, const byte *src,
 			   const uint dstPitch, const uint srcPitch,
@@ -212,6 +329,9 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+	if (crossBlitSIMD<false>(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt, 0))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
@@ -270,6 +390,9 @@ bool crossKeyBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+	if (crossBlitSIMD<true>(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt, key))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
@@ -320,6 +443,9 @@ bool crossBlitMap(byte *dst, const byte *src,
 	if ((bytesPerPixel == 3) || (!bytesPerPixel))
 		return false;
 
+	if (crossBlitMapSIMD<false>(dst, src, dstPitch, srcPitch, w, h, bytesPerPixel, map, 0))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w);
 	const uint dstDelta = (dstPitch - w * bytesPerPixel);
@@ -359,6 +485,9 @@ bool crossKeyBlitMap(byte *dst, const byte *src,
 	if ((bytesPerPixel == 3) || (!bytesPerPixel))
 		return false;
 
+	if (crossBlitMapSIMD<true>(dst, src, dstPitch, srcPitch, w, h, bytesPerPixel, map, key))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w);
 	const uint dstDelta = (dstPitch - w * bytesPerPixel);
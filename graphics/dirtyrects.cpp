@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/dirtyrects.h"
+
+namespace Graphics {
+
+DirtyRectList::DirtyRectList(uint maxRects, uint halo, uint rectCost)
+	: _maxRects(maxRects), _halo(halo), _rectCost(rectCost), _addedArea(0) {
+	assert(maxRects > 0);
+	_rects.reserve(maxRects);
+}
+
+const Common::Rect &DirtyRectList::add(const Common::Rect &area) {
+	assert(!area.isEmpty());
+	_addedArea += area.width() * area.height();
+
+	Common::Rect merged = area;
+	for (;;) {
+		// Merge with the first rect which is not more expensive to redraw
+		// together. The merged rect is larger, so start over with it.
+		uint i;
+		for (i = 0; i < _rects.size(); ++i) {
+			if (mergeCost(_rects[i], merged) <= 0)
+				break;
+		}
+
+		if (i == _rects.size()) {
+			if (_rects.size() < _maxRects)
+				break;
+
+			// There is no room left, so merge with the rect which costs
+			// the least to merge with.
+			i = 0;
+			int bestCost = mergeCost(_rects[0], merged);
+			for (uint j = 1; j < _rects.size(); ++j) {
+				const int cost = mergeCost(_rects[j], merged);
+				if (cost < bestCost) {
+					bestCost = cost;
+					i = j;
+				}
+			}
+		}
+
+		merged.extend(_rects[i]);
+		_rects[i] = _rects.back();
+		_rects.pop_back();
+	}
+
+	_rects.push_back(merged);
+	return _rects.back();
+}
+
+void DirtyRectList::clear() {
+	_rects.clear();
+	_addedArea = 0;
+}
+
+uint DirtyRectList::cost(const Common::Rect &rect) const {
+	return (rect.width() + 2 * _halo) * (rect.height() + 2 * _halo) + _rectCost;
+}
+
+uint DirtyRectList::getArea() const {
+	uint area = 0;
+	for (uint i = 0; i < _rects.size(); ++i)
+		area += _rects[i].width() * _rects[i].height();
+	return area;
+}
+
+int DirtyRectList::mergeCost(const Common::Rect &a, const Common::Rect &b) const {
+	Common::Rect merged = a;
+	merged.extend(b);
+	return (int)cost(merged) - (int)cost(a) - (int)cost(b);
+}
+
+} // End of namespace Graphics
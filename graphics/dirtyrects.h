@@ -0,0 +1,112 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_DIRTYRECTS_H
+#define GRAPHICS_DIRTYRECTS_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Graphics {
+
+/**
+ * @defgroup graphics_dirtyrects Dirty rects
+ * @ingroup graphics
+ *
+ * @brief DirtyRectList class for tracking the areas of a screen to redraw.
+ *
+ * @{
+ */
+
+/**
+ * A list of the areas of a surface which need to be redrawn.
+ *
+ * Areas are merged whenever redrawing them as one rect is not more expensive
+ * than redrawing them apart. The cost of a rect is the number of pixels in
+ * it and in the halo around it, which a scaler reads as well, plus a fixed
+ * cost for every rect. Once the list is full, a new area is merged with the
+ * rect which makes it grow the least, so the list never falls back to a
+ * full redraw by itself.
+ */
+class DirtyRectList {
+public:
+	enum {
+		/** The default cost of a rect, in pixels. */
+		kDefaultRectCost = 256
+	};
+
+	/**
+	 * @param maxRects The maximum number of rects in the list.
+	 * @param halo     The width of the border read around every rect.
+	 * @param rectCost The fixed cost of a rect, in pixels.
+	 */
+	DirtyRectList(uint maxRects, uint halo = 0, uint rectCost = kDefaultRectCost);
+
+	void setHalo(uint halo) { _halo = halo; }
+
+	/**
+	 * Add an area to the list.
+	 *
+	 * @return The rect the area ended up in, after merging.
+	 */
+	const Common::Rect &add(const Common::Rect &area);
+
+	/**
+	 * Remove all the rects, and reset the statistics.
+	 */
+	void clear();
+
+	bool empty() const { return _rects.empty(); }
+	uint size() const { return _rects.size(); }
+	const Common::Rect &operator[](uint i) const { return _rects[i]; }
+
+	/**
+	 * @return The cost of redrawing a rect.
+	 */
+	uint cost(const Common::Rect &rect) const;
+
+	/**
+	 * @return The number of pixels in the rects of the list.
+	 */
+	uint getArea() const;
+
+	/**
+	 * @return The number of pixels in all areas added since the list was
+	 *         cleared, before merging.
+	 */
+	uint getAddedArea() const { return _addedArea; }
+
+private:
+	/** How much more merging two rects costs than keeping them apart. */
+	int mergeCost(const Common::Rect &a, const Common::Rect &b) const;
+
+	Common::Array<Common::Rect> _rects;
+	uint _maxRects;
+	uint _halo;
+	uint _rectCost;
+	uint _addedArea;
+};
+
+/** @} */
+
+} // End of namespace Graphics
+
+#endif
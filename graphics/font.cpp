@@ -105,6 +105,31 @@ int getStringWidthImpl(const Font &font, const StringType &str) {
 	return space;
 }
 
+// Only fonts which lay out whole strings draw runs, and they only do that for
+// Unicode strings.
+bool drawRunImpl(const Font &font, Surface *dst, const Common::String &str, int x, int y, int leftX, int rightX, uint32 color) {
+	return false;
+}
+
+bool drawRunImpl(const Font &font, ManagedSurface *dst, const Common::String &str, int x, int y, int leftX, int rightX, uint32 color) {
+	return false;
+}
+
+bool drawRunImpl(const Font &font, Surface *dst, const Common::U32String &str, int x, int y, int leftX, int rightX, uint32 color) {
+	return font.drawRun(dst, str, x, y, leftX, rightX, color, nullptr, nullptr);
+}
+
+bool drawRunImpl(const Font &font, ManagedSurface *dst, const Common::U32String &str, int x, int y, int leftX, int rightX, uint32 color) {
+	const uint32 transColor = dst->getTransparentColor();
+	Common::Rect drawnArea;
+	if (!font.drawRun(dst->surfacePtr(), str, x, y, leftX, rightX, color, dst->hasTransparentColor() ? &transColor : nullptr, &drawnArea))
+		return false;
+
+	if (!drawnArea.isEmpty())
+		dst->addDirtyRect(drawnArea);
+	return true;
+}
+
 template<class SurfaceType, class StringType>
 void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) {
 	// The logic in getBoundingImpl is the same as we use here. In case we
@@ -120,6 +145,9 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		x = x + w - width;
 	x += deltax;
 
+	if (drawRunImpl(font, dst, str, x, y, leftX, rightX, color))
+		return;
+
 	typename StringType::unsigned_type last = 0;
 	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
 		const typename StringType::unsigned_type cur = *i;
@@ -450,6 +478,9 @@ int Font::getStringWidth(const Common::String &str) const {
 }
 
 int Font::getStringWidth(const Common::U32String &str) const {
+	const int width = getRunWidth(str);
+	if (width >= 0)
+		return width;
 	return getStringWidthImpl(*this, str);
 }
 
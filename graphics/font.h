@@ -189,6 +189,50 @@ public:
 	/** @overload */
 	Common::Rect getBoundingBox(const Common::U32String &str, int x = 0, int _y = 0, const int w = 0, TextAlign align = kTextAlignLeft, int deltax = 0, bool useEllipsis = false) const;
 
+	/**
+	 * Return the width of a string laid out as a whole.
+	 *
+	 * Fonts which keep the layout of the strings they draw can answer this
+	 * without querying every character again.
+	 *
+	 * The default implementation returns -1, which makes getStringWidth
+	 * add up the widths of the characters.
+	 *
+	 * @param str  The string to measure.
+	 *
+	 * @return The width of the string, or -1 if the font does not lay out
+	 *         strings by itself.
+	 */
+	virtual int getRunWidth(const Common::U32String &str) const { return -1; }
+
+	/**
+	 * Draw a string laid out as a whole.
+	 *
+	 * The characters are drawn exactly as drawString would draw them one by
+	 * one, including kerning. Characters which end left of @p leftX are
+	 * skipped, and drawing stops at the first character which ends right of
+	 * @p rightX.
+	 *
+	 * The default implementation returns false, which makes drawString
+	 * draw the characters one by one.
+	 *
+	 * @param dst               The surface to draw on.
+	 * @param str               The string to draw.
+	 * @param x                 The x coordinate of the first character.
+	 * @param y                 The y coordinate of the characters.
+	 * @param leftX             The left edge of the text area.
+	 * @param rightX            The right edge of the text area.
+	 * @param color             The color of the characters.
+	 * @param transparentColor  If not nullptr, pixels of this color on
+	 *                          @p dst are left alone.
+	 * @param drawnArea         If not nullptr, receives the area which was
+	 *                          drawn to.
+	 *
+	 * @return Whether the string was drawn.
+	 */
+	virtual bool drawRun(Surface *dst, const Common::U32String &str, int x, int y, int leftX, int rightX,
+	                     uint32 color, const uint32 *transparentColor, Common::Rect *drawnArea) const { return false; }
+
 	/**
 	 * Draw a character at a specific point on the surface.
 	 *
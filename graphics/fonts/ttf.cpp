@@ -161,6 +161,10 @@ public:
 	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
 	void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
 
+	int getRunWidth(const Common::U32String &str) const override;
+	bool drawRun(Surface *dst, const Common::U32String &str, int x, int y, int leftX, int rightX,
+	             uint32 color, const uint32 *transparentColor, Common::Rect *drawnArea) const override;
+
 private:
 	bool _initialized;
 	FT_Face _face;
@@ -172,7 +176,9 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
-		Surface image;
+		uint page;            ///< Atlas page holding the glyph image
+		int atlasX, atlasY;   ///< Position of the glyph image in its page
+		int width, height;
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
@@ -183,6 +189,54 @@ private:
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
+	const Glyph *findGlyph(uint32 chr) const;
+
+	/**
+	 * The glyph images are packed into shelves of 8-bit coverage pages,
+	 * rather than each kept in a surface of its own.
+	 */
+	mutable Common::Array<Surface *> _atlasPages;
+	mutable int _atlasPageSize;
+	mutable int _shelfPage, _shelfX, _shelfY, _shelfHeight;
+
+	/** Reserve room for a glyph image, and return where to write it. */
+	uint8 *allocateGlyph(Glyph &glyph, int w, int h) const;
+	uint addAtlasPage(int w, int h) const;
+
+	const uint8 *getGlyphPixels(const Glyph &glyph) const {
+		return (const uint8 *)_atlasPages[glyph.page]->getBasePtr(glyph.atlasX, glyph.atlasY);
+	}
+	int getGlyphPitch(const Glyph &glyph) const { return _atlasPages[glyph.page]->pitch; }
+
+	/** Kerning offsets of glyph slot pairs, as (left << 16) | right */
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerning;
+
+	/**
+	 * A string laid out by drawString(): the glyphs with their pen positions,
+	 * which spares looking up every character and every kerning pair again.
+	 */
+	struct RunGlyph {
+		Glyph glyph;
+		bool hasGlyph;
+		int x;                ///< Pen position, from the start of the string
+		int right;            ///< Right of the bounding box, from the start of the string
+	};
+
+	struct Run {
+		Common::Array<RunGlyph> glyphs;
+		int width;
+	};
+
+	enum {
+		kMaxCachedRuns = 512
+	};
+
+	typedef Common::HashMap<Common::U32String, Run> RunCache;
+	mutable RunCache _runs;
+
+	const Run &layoutRun(const Common::U32String &str) const;
+	void blitGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color, const uint32 *transparentColor) const;
 
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
@@ -203,7 +257,8 @@ private:
 TTFFont::TTFFont()
 	: _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
 	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
-	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
+	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false),
+	  _atlasPageSize(0), _shelfPage(-1), _shelfX(0), _shelfY(0), _shelfHeight(0) {
 }
 
 TTFFont::~TTFFont() {
@@ -213,11 +268,13 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	for (uint i = 0; i < _atlasPages.size(); ++i) {
+		_atlasPages[i]->free();
+		delete _atlasPages[i];
+	}
 }
 
 bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
@@ -552,58 +609,53 @@ int TTFFont::getMaxCharWidth() const {
 	return _width;
 }
 
-int TTFFont::getCharWidth(uint32 chr) const {
+const TTFFont::Glyph *TTFFont::findGlyph(uint32 chr) const {
 	assureCached(chr);
 	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
 	if (glyphEntry == _glyphs.end())
-		return 0;
+		return nullptr;
 	else
-		return glyphEntry->_value.advance;
+		return &glyphEntry->_value;
+}
+
+int TTFFont::getCharWidth(uint32 chr) const {
+	const Glyph *glyph = findGlyph(chr);
+	return glyph ? glyph->advance : 0;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
-
-	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
-
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *leftGlyph = findGlyph(left);
+	const Glyph *rightGlyph = findGlyph(right);
+	if (!leftGlyph || !rightGlyph || !leftGlyph->slot || !rightGlyph->slot)
 		return 0;
-	}
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
-	} else {
-		return 0;
+	// TrueType fonts have at most 65535 glyphs
+	const bool cacheable = leftGlyph->slot <= 0xFFFF && rightGlyph->slot <= 0xFFFF;
+	const uint32 key = (leftGlyph->slot << 16) | rightGlyph->slot;
+	if (cacheable) {
+		KerningCache::const_iterator kerning = _kerning.find(key);
+		if (kerning != _kerning.end())
+			return kerning->_value;
 	}
 
-	if (!leftGlyph || !rightGlyph)
-		return 0;
-
 	FT_Vector kerningVector;
-	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	FT_Get_Kerning(_face, leftGlyph->slot, rightGlyph->slot, FT_KERNING_DEFAULT, &kerningVector);
+	const int offset = kerningVector.x / 64;
+
+	if (cacheable)
+		_kerning[key] = offset;
+	return offset;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph)
 		return Common::Rect();
-	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
-	}
+
+	return Common::Rect(glyph->xOffset, glyph->yOffset, glyph->xOffset + glyph->width, glyph->yOffset + glyph->height);
 }
 
 namespace {
@@ -672,15 +724,15 @@ void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 col
 	dst->addDirtyRect(charBox);
 }
 
-void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
+void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return;
-
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph *glyph = findGlyph(chr);
+	if (glyph)
+		blitGlyph(dst, *glyph, x, y, color, transparentColor);
+}
 
+void TTFFont::blitGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color,
+		const uint32 *transparentColor) const {
 	x += glyph.xOffset;
 	y += glyph.yOffset;
 
@@ -689,10 +741,14 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.width;
+	int h = glyph.height;
+
+	if (w <= 0 || h <= 0)
+		return;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	const int srcPitch = getGlyphPitch(glyph);
+	const uint8 *srcPos = getGlyphPixels(glyph);
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -708,7 +764,7 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * srcPitch;
 		h += y;
 		y = 0;
 	}
@@ -737,15 +793,88 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += srcPitch;
 		}
 	} else if (dst->format.bytesPerPixel == 1) {
-		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
+	}
+}
+
+const TTFFont::Run &TTFFont::layoutRun(const Common::U32String &str) const {
+	RunCache::const_iterator cached = _runs.find(str);
+	if (cached != _runs.end())
+		return cached->_value;
+
+	// Strings drawn once, like the lines of a scrolling text, would make
+	// the cache grow forever.
+	if (_runs.size() >= kMaxCachedRuns)
+		_runs.clear();
+
+	// This follows the logic of Font::drawString().
+	Run &run = _runs[str];
+	run.glyphs.resize(str.size());
+
+	int x = 0;
+	uint32 last = 0;
+	for (uint i = 0; i < str.size(); ++i) {
+		const uint32 cur = str[i];
+		x += getKerningOffset(last, cur);
+		last = cur;
+
+		RunGlyph &runGlyph = run.glyphs[i];
+		const Glyph *glyph = findGlyph(cur);
+		runGlyph.hasGlyph = glyph != nullptr;
+		runGlyph.x = x;
+		if (glyph) {
+			runGlyph.glyph = *glyph;
+			runGlyph.right = x + glyph->xOffset + glyph->width;
+			x += glyph->advance;
+		} else {
+			runGlyph.right = x;
+		}
 	}
+
+	run.width = x;
+	return run;
+}
+
+int TTFFont::getRunWidth(const Common::U32String &str) const {
+	return layoutRun(str).width;
+}
+
+bool TTFFont::drawRun(Surface *dst, const Common::U32String &str, int x, int y, int leftX, int rightX,
+		uint32 color, const uint32 *transparentColor, Common::Rect *drawnArea) const {
+	const Run &run = layoutRun(str);
+
+	Common::Rect area;
+	for (uint i = 0; i < run.glyphs.size(); ++i) {
+		const RunGlyph &runGlyph = run.glyphs[i];
+		if (x + runGlyph.right > rightX)
+			break;
+		if (x + runGlyph.right < leftX || !runGlyph.hasGlyph)
+			continue;
+
+		const Glyph &glyph = runGlyph.glyph;
+		blitGlyph(dst, glyph, x + runGlyph.x, y, color, transparentColor);
+
+		if (drawnArea && glyph.width > 0 && glyph.height > 0) {
+			const int left = x + runGlyph.x + glyph.xOffset;
+			const int top = y + glyph.yOffset;
+			const Common::Rect glyphArea(left, top, left + glyph.width, top + glyph.height);
+			if (area.isEmpty())
+				area = glyphArea;
+			else
+				area.extend(glyphArea);
+		}
+	}
+
+	if (drawnArea)
+		*drawnArea = area;
+	return true;
 }
 
 bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
@@ -813,7 +942,10 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	if (bitmap->pixel_mode != FT_PIXEL_MODE_MONO && bitmap->pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		return false;
+	}
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -822,11 +954,14 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
+	// Blank glyphs get no room in the atlas, and have nothing to copy
+	uint8 *dst = allocateGlyph(glyph, bitmap->width, bitmap->rows);
+	const int dstPitch = dst ? getGlyphPitch(glyph) : 0;
+	const int rows = dst ? bitmap->rows : 0;
 
 	switch (bitmap->pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
-		for (int y = 0; y < (int)bitmap->rows; ++y) {
+		for (int y = 0; y < rows; ++y) {
 			const uint8 *curSrc = src;
 			uint8 mask = 0;
 
@@ -835,28 +970,23 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					dst[x] = 255;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += dstPitch;
 			src += srcPitch;
 		}
 		break;
 
-	case FT_PIXEL_MODE_GRAY:
-		for (int y = 0; y < (int)bitmap->rows; ++y) {
+	default:
+		for (int y = 0; y < rows; ++y) {
 			memcpy(dst, src, bitmap->width);
-			dst += glyph.image.pitch;
+			dst += dstPitch;
 			src += srcPitch;
 		}
 		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 #if FAKE_BOLD == 1
@@ -868,6 +998,60 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	return true;
 }
 
+uint8 *TTFFont::allocateGlyph(Glyph &glyph, int w, int h) const {
+	glyph.page = 0;
+	glyph.atlasX = glyph.atlasY = 0;
+	glyph.width = w;
+	glyph.height = h;
+
+	// Blank glyphs, like spaces, have no image
+	if (w <= 0 || h <= 0) {
+		glyph.width = glyph.height = 0;
+		return nullptr;
+	}
+
+	if (!_atlasPageSize) {
+		// Room for a few dozen glyphs of the largest size per page
+		_atlasPageSize = 256;
+		while (_atlasPageSize < 8 * MAX(_width, _height) && _atlasPageSize < 2048)
+			_atlasPageSize *= 2;
+	}
+
+	if (w > _atlasPageSize || h > _atlasPageSize) {
+		glyph.page = addAtlasPage(w, h);
+		return (uint8 *)_atlasPages[glyph.page]->getPixels();
+	}
+
+	if (_shelfPage < 0 || _shelfX + w > _atlasPageSize) {
+		// Start a new shelf below the current one
+		_shelfY += _shelfHeight;
+		_shelfX = 0;
+		_shelfHeight = 0;
+	}
+
+	if (_shelfPage < 0 || _shelfY + h > _atlasPageSize) {
+		_shelfPage = addAtlasPage(_atlasPageSize, _atlasPageSize);
+		_shelfX = _shelfY = _shelfHeight = 0;
+	}
+
+	glyph.page = _shelfPage;
+	glyph.atlasX = _shelfX;
+	glyph.atlasY = _shelfY;
+
+	_shelfX += w;
+	_shelfHeight = MAX(_shelfHeight, h);
+
+	return (uint8 *)_atlasPages[glyph.page]->getBasePtr(glyph.atlasX, glyph.atlasY);
+}
+
+uint TTFFont::addAtlasPage(int w, int h) const {
+	// Surface::create() clears the page, which monochrome glyphs rely on
+	Surface *page = new Surface();
+	page->create(w, h, PixelFormat::createFormatCLUT8());
+	_atlasPages.push_back(page);
+	return _atlasPages.size() - 1;
+}
+
 void TTFFont::assureCached(uint32 chr) const {
 	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
 		return;
@@ -6,6 +6,7 @@ MODULE_OBJS := \
 	blit-alpha.o \
 	blit-scale.o \
 	cursorman.o \
+	dirtyrects.o \
 	font.o \
 	fontman.o \
 	fonts/amigafont.o \
@@ -71,6 +72,26 @@ MODULE_OBJS += \
 	blit-atari.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	blit-sse2.o \
+	VectorRendererSpec-sse2.o
+$(MODULE)/blit-sse2.o: CXXFLAGS += -msse2
+$(MODULE)/VectorRendererSpec-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	blit-avx2.o
+$(MODULE)/blit-avx2.o: CXXFLAGS += -mavx2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	blit-neon.o \
+	VectorRendererSpec-neon.o
+endif
+
 ifdef USE_TINYGL
 MODULE_OBJS += \
 	tinygl/api.o \
@@ -97,6 +118,17 @@ MODULE_OBJS += \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
 	tinygl/zdirtyrect.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/zspan-sse2.o
+$(MODULE)/tinygl/zspan-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	tinygl/zspan-neon.o
+endif
 endif
 
 ifdef USE_ASPECT
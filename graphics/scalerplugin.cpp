@@ -53,7 +53,12 @@ void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 			Normal1x<uint32>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 		}
 	} else {
-		scaleIntern(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		forEachBand(height, [&](int from, int to) {
+			scaleIntern(srcPtr + from * srcPitch, srcPitch,
+			            dstPtr + from * _factor * dstPitch, dstPitch,
+			            width, to - from, x, y + from);
+		});
+		finishScale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
 	}
 }
 
@@ -111,6 +116,14 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 	            _oldSrc + offset, srcPitch,
 	            width, height,
 	            (uint8 *)_bufferedOutput.getBasePtr(x * _factor, y * _factor), _bufferedOutput.pitch);
+}
+
+void SourceScaler::finishScale(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+						 uint32 dstPitch, int width, int height, int x, int y) {
+	// Other bands may still compare against the old source while being
+	// scaled, so it is only updated once the whole rect is done.
+	if (!_enable)
+		return;
 
 	// Update the destination buffer
 	byte *buffer = (byte *)_bufferedOutput.getBasePtr(x * _factor, y * _factor);
@@ -121,7 +134,7 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 	}
 
 	// Update old src
-	byte *oldSrc = _oldSrc + offset;
+	byte *oldSrc = _oldSrc + (_padding + x) * _format.bytesPerPixel + (_padding + y) * srcPitch;
 	while (height--) {
 		memcpy(oldSrc, srcPtr, width * _format.bytesPerPixel);
 		oldSrc += srcPitch;
@@ -22,12 +22,13 @@
 #define GRAPHICS_SCALERPLUGIN_H
 
 #include "base/plugins.h"
+#include "common/jobs.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
 class Scaler {
 public:
-	Scaler(const Graphics::PixelFormat &format) : _format(format) {}
+	Scaler(const Graphics::PixelFormat &format) : _format(format), _threaded(false) {}
 	virtual ~Scaler() {}
 
 	/**
@@ -94,15 +95,63 @@ public:
 		assert(0);
 	}
 
+	/**
+	 * Enable or disable scaling on several threads. Large rects are then
+	 * split into horizontal bands, which are scaled in parallel by the job
+	 * system. The output is the same either way. It is initially disabled.
+	 */
+	void enableThreads(bool enable) { _threaded = enable; }
+
 protected:
 	/**
+	 * Scale a part of the rect passed to scale(). It may be called for
+	 * several bands of the same rect at once, from different threads, so it
+	 * must not modify the state of the scaler.
+	 *
+	 * The rows around the band, up to the number of extra pixels of the
+	 * plugin, are read from the source like for a whole rect: they are
+	 * not modified while scaling, so the bands do not depend on each other.
+	 *
 	 * @see scale
 	 */
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) = 0;
 
+	/**
+	 * Called by scale() once all the bands of a rect have been scaled.
+	 */
+	virtual void finishScale(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+	                         uint32 dstPitch, int width, int height, int x, int y) {}
+
 	uint _factor;
 	Graphics::PixelFormat _format;
+
+private:
+	/** The minimum number of rows of a band. */
+	static const int kMinBandHeight = 16;
+
+	/**
+	 * Call @p func(from, to) for horizontal bands covering the @p height
+	 * rows of a rect, in parallel when threads are enabled and the rect is
+	 * large enough.
+	 */
+	template<typename F>
+	void forEachBand(int height, const F &func) {
+		int numBands = 1;
+		if (_threaded)
+			numBands = MIN<int>(height / kMinBandHeight, JobMan.getThreadCount() * 2);
+
+		if (numBands <= 1) {
+			func(0, height);
+			return;
+		}
+
+		JobMan.parallelFor(0, numBands, [&](int band) {
+			func(height * band / numBands, height * (band + 1) / numBands);
+		});
+	}
+
+	bool _threaded;
 };
 
 /**
@@ -127,6 +176,9 @@ protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	                         uint32 dstPitch, int width, int height, int x, int y) final;
 
+	virtual void finishScale(const uint8 *srcPtr, uint32 srcPitch, const uint8 *dstPtr,
+	                         uint32 dstPitch, int width, int height, int x, int y) final;
+
 	/**
 	 * Scalers must implement this function. It will be called by oldSrcScale.
 	 * If by comparing the src and oldsrc images it is discovered that no change
@@ -358,6 +358,7 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 }
 
 void GLContext::deinit() {
+	freeTileContexts();
 	disposeDrawCallLists();
 	disposeResources();
 
@@ -37,6 +37,9 @@ ContextHandle *createContext(int screenW, int screenH, Graphics::PixelFormat pix
 void destroyContext();
 void destroyContext(ContextHandle *handle);
 void setContext(ContextHandle *handle);
+// Rasterize the frames of the current context in tiles, on count threads
+// (0 for as many as the job system runs, 1 to rasterize on the caller only)
+void setRenderThreads(int count);
 void presentBuffer();
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas);
 void getSurfaceRef(Graphics::Surface &surface);
@@ -29,6 +29,7 @@
 
 #include "common/scummsys.h"
 #include "common/endian.h"
+#include "common/system.h"
 
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
@@ -79,6 +80,23 @@ static void memset_l(void *adr, int val, int count) {
 		*p++ = val;
 }
 
+static SpanKernels getSpanKernels(const Graphics::PixelFormat &format) {
+	// 32 bpp with 8 bit channels only
+	if (format.bytesPerPixel != 4 || format.rBits() != 8 || format.gBits() != 8 || format.bBits() != 8 ||
+	    (format.aBits() != 8 && format.aBits() != 0))
+		return kSpanKernelsNone;
+
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return kSpanKernelsSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		return kSpanKernelsNEON;
+#endif
+	return kSpanKernelsNone;
+}
+
 FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer) {
 	_pbufWidth = width;
 	_pbufHeight = height;
@@ -93,6 +111,9 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	else
 		_sbuf = nullptr;
 
+	_ownsBuffers = true;
+	_spanKernels = getSpanKernels(_pbufFormat);
+
 	_offscreenBuffer.pbuf = _pbuf;
 	_offscreenBuffer.zbuf = _zbuf;
 
@@ -101,13 +122,53 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	_enableScissor = false;
 }
 
+FrameBuffer::FrameBuffer() {
+	_pbufWidth = 0;
+	_pbufHeight = 0;
+	_pbufBpp = 0;
+	_pbufPitch = 0;
+
+	_pbuf = nullptr;
+	_zbuf = nullptr;
+	_sbuf = nullptr;
+	_ownsBuffers = false;
+	_spanKernels = kSpanKernelsNone;
+
+	_offscreenBuffer.pbuf = nullptr;
+	_offscreenBuffer.zbuf = nullptr;
+
+	_currentTexture = nullptr;
+
+	_enableScissor = false;
+}
+
 FrameBuffer::~FrameBuffer() {
+	if (!_ownsBuffers)
+		return;
+
 	gl_free(_pbuf);
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
 }
 
+void FrameBuffer::shareBuffers(const FrameBuffer &other) {
+	_pbufWidth = other._pbufWidth;
+	_pbufHeight = other._pbufHeight;
+	_pbufFormat = other._pbufFormat;
+	_pbufBpp = other._pbufBpp;
+	_pbufPitch = other._pbufPitch;
+
+	_pbuf = other._pbuf;
+	_zbuf = other._zbuf;
+	_sbuf = other._sbuf;
+	_spanKernels = other._spanKernels;
+	_offscreenBuffer = other._offscreenBuffer;
+
+	_textureSize = other._textureSize;
+	_textureSizeMask = other._textureSizeMask;
+}
+
 Buffer *FrameBuffer::genOffscreenBuffer() {
 	Buffer *buf = (Buffer *)gl_malloc(sizeof(Buffer));
 	buf->pbuf = (byte *)gl_zalloc(_pbufHeight * _pbufPitch);
@@ -102,10 +102,30 @@ struct ZBufferPoint {
 	}
 };
 
+/** The SIMD span kernels which can draw to a frame buffer, see zspan.h. */
+enum SpanKernels {
+	kSpanKernelsNone,
+	kSpanKernelsSSE2,
+	kSpanKernelsNEON
+};
+
+struct SpanState;
+
 struct FrameBuffer {
 	FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer);
+	/**
+	 * Create a frame buffer without buffers of its own, which draws to the
+	 * buffers of another one once shareBuffers() has been called.
+	 */
+	FrameBuffer();
 	~FrameBuffer();
 
+	/**
+	 * Draw to the buffers of @p other, keeping a state of its own, so that
+	 * several threads can draw to different parts of the buffers at once.
+	 */
+	void shareBuffers(const FrameBuffer &other);
+
 	Graphics::PixelFormat getPixelFormat() {
 		return _pbufFormat;
 	}
@@ -386,6 +406,8 @@ private:
 		writePixel(pixel, 255, rSrc, gSrc, bSrc);
 	}
 
+	void getSpanState(SpanState &state) const;
+
 	FORCEINLINE bool scissorPixel(int x, int y) {
 		return !_clipRectangle.contains(x, y);
 	}
@@ -750,6 +772,8 @@ private:
 
 	uint *_zbuf;
 	byte *_sbuf;
+	bool _ownsBuffers;
+	SpanKernels _spanKernels;
 
 	bool _enableStencil;
 	int _textureSize;
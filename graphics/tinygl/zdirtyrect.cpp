@@ -24,6 +24,7 @@
 #include "graphics/tinygl/gl.h"
 
 #include "common/debug.h"
+#include "common/jobs.h"
 #include "common/math.h"
 
 namespace TinyGL {
@@ -193,12 +194,20 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 
 		// Execute draw calls.
-		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+		if (canRenderTiles()) {
+			Common::List<Common::Rect> dirtyRects;
 			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					(*it)->execute(dirtyRegion, true);
+				dirtyRects.push_back((*itRect).rectangle);
+			}
+			renderTiles(&dirtyRects);
+		} else {
+			for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+				Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+				for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
+					Common::Rect dirtyRegion = (*itRect).rectangle;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						(*it)->execute(dirtyRegion, true);
+					}
 				}
 			}
 		}
@@ -240,8 +249,15 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
+	if (canRenderTiles()) {
+		renderTiles(nullptr);
+	} else {
+		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+			(*it)->execute(true);
+		}
+	}
+
 	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-		(*it)->execute(true);
 		delete *it;
 	}
 
@@ -252,6 +268,142 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	_drawCallAllocator[_currentAllocatorIndex].reset();
 }
 
+// Height of the bands of the frame buffer which the threads rasterize
+static const int kRenderTileHeight = 16;
+
+void GLContext::setRenderThreads(int count) {
+	if (count <= 0)
+		count = JobMan.getThreadCount();
+	if (count <= 1)
+		count = 0;
+	if (count == (int)_tileContexts.size())
+		return;
+
+	freeTileContexts();
+
+	// Every thread rasterizes with a context of its own, whose frame buffer
+	// draws to the buffers of this one
+	for (int i = 0; i < count; i++) {
+		GLContext *c = new GLContext();
+		c->fb = new FrameBuffer();
+		c->vertex_max = POLYGON_MAX_VERTEX;
+		c->vertex = (GLVertex *)gl_malloc(POLYGON_MAX_VERTEX * sizeof(GLVertex));
+		c->_profilingEnabled = false;
+		_tileContexts.push_back(c);
+	}
+}
+
+void GLContext::freeTileContexts() {
+	for (uint i = 0; i < _tileContexts.size(); i++) {
+		gl_free(_tileContexts[i]->vertex);
+		delete _tileContexts[i]->fb;
+		delete _tileContexts[i];
+	}
+	_tileContexts.clear();
+	_tileBins.clear();
+}
+
+bool GLContext::canRenderTiles() const {
+	// The triangle counters of the profiler are not shared between threads
+	return !_tileContexts.empty() && render_mode == TGL_RENDER && !_profilingEnabled;
+}
+
+void GLContext::renderTiles(const Common::List<Common::Rect> *dirtyRects) {
+	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef Common::List<Common::Rect>::const_iterator RectangleIterator;
+
+	_tileBins.resize((fb->getPixelBufferHeight() + kRenderTileHeight - 1) / kRenderTileHeight);
+
+	for (uint i = 0; i < _tileContexts.size(); i++) {
+		GLContext *c = _tileContexts[i];
+		c->fb->shareBuffers(*fb);
+		c->render_mode = render_mode;
+		c->current_cull_face = current_cull_face;
+		c->vertex_n = vertex_n;
+		c->_textureSize = _textureSize;
+	}
+
+	// Rasterization and clear calls go to the bins of the tiles they cover.
+	// Blits can't be split in tiles, so the bins are flushed before each of
+	// them, which then runs on this thread.
+	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+		const DrawCall *call = *it;
+		if (call->getType() == DrawCall::DrawCall_Blitting) {
+			flushTileBins(dirtyRects);
+			if (dirtyRects) {
+				for (RectangleIterator itRect = dirtyRects->begin(); itRect != dirtyRects->end(); ++itRect) {
+					if ((*itRect).intersects(call->getDirtyRegion()))
+						call->execute(*itRect, true);
+				}
+			} else {
+				call->execute(true);
+			}
+			continue;
+		}
+
+		const Common::Rect region = call->getDirtyRegion();
+		if (region.isEmpty())
+			continue;
+		for (int tile = region.top / kRenderTileHeight; tile <= (region.bottom - 1) / kRenderTileHeight; tile++) {
+			_tileBins[tile].push_back(call);
+		}
+	}
+
+	flushTileBins(dirtyRects);
+}
+
+void GLContext::flushTileBins(const Common::List<Common::Rect> *dirtyRects) {
+	int lastTile = (int)_tileBins.size() - 1;
+	while (lastTile >= 0 && _tileBins[lastTile].empty())
+		lastTile--;
+	if (lastTile < 0)
+		return;
+
+	// Each tile is rasterized by a single thread at a time, which owns its
+	// part of the color, depth and stencil buffers until the tile is done
+	Common::Atomic<int> nextTile(0);
+	Common::JobGroup group;
+	for (uint i = 0; i < _tileContexts.size(); i++) {
+		GLContext *c = _tileContexts[i];
+		JobMan.schedule([this, c, dirtyRects, lastTile, &nextTile]() {
+			int tile;
+			while ((tile = nextTile.fetchAdd(1)) <= lastTile) {
+				renderTile(c, tile, dirtyRects);
+			}
+		}, &group);
+	}
+	JobMan.wait(group);
+
+	for (uint i = 0; i < _tileBins.size(); i++) {
+		_tileBins[i].resize(0);
+	}
+}
+
+void GLContext::renderTile(GLContext *c, int tile, const Common::List<Common::Rect> *dirtyRects) const {
+	typedef Common::List<Common::Rect>::const_iterator RectangleIterator;
+
+	const Common::Array<const DrawCall *> &bin = _tileBins[tile];
+	const Common::Rect band(0, tile * kRenderTileHeight, fb->getPixelBufferWidth(),
+	                        MIN((tile + 1) * kRenderTileHeight, fb->getPixelBufferHeight()));
+
+	for (uint i = 0; i < bin.size(); i++) {
+		if (!dirtyRects) {
+			bin[i]->executeTile(c, band);
+			continue;
+		}
+
+		for (RectangleIterator itRect = dirtyRects->begin(); itRect != dirtyRects->end(); ++itRect) {
+			const Common::Rect clip = (*itRect).findIntersectingRect(band);
+			if (clip.intersects(bin[i]->getDirtyRegion()))
+				bin[i]->executeTile(c, clip);
+		}
+	}
+}
+
+void setRenderThreads(int count) {
+	gl_get_context()->setRenderThreads(count);
+}
+
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
 	GLContext *c = gl_get_context();
 	if (c->_enableDirtyRectangles) {
@@ -266,6 +418,10 @@ void presentBuffer() {
 	presentBuffer(dirtyAreas);
 }
 
+void DrawCall::executeTile(GLContext *c, const Common::Rect &tile) const {
+	error("DrawCall::executeTile: draw calls of type %d can't be split in tiles", (int)_type);
+}
+
 bool DrawCall::operator==(const DrawCall &other) const {
 	if (_type == other._type) {
 		switch (_type) {
@@ -294,8 +450,8 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleFront = c->draw_triangle_front;
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
-	_state = captureState();
-	if (c->_enableDirtyRectangles) {
+	_state = captureState(c);
+	if (c->_enableDirtyRectangles || !c->_tileContexts.empty()) {
 		computeDirtyRegion();
 	}
 }
@@ -338,15 +494,43 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 
 	RasterizationDrawCall::RasterizationState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
 	}
-	applyState(_state);
+	applyState(c, _state);
 
 	GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
 	c->vertex = _vertex;
 	c->vertex_cnt = _vertexCount;
+	rasterize(c);
+
+	c->vertex = prevVertex;
+	c->vertex_cnt = prevVertexCount;
+
+	if (restoreState) {
+		applyState(c, backupState);
+	}
+}
+
+void RasterizationDrawCall::executeTile(GLContext *c, const Common::Rect &tile) const {
+	applyState(c, _state);
+
+	// Drawing modifies the vertices, so each thread works on its own copy
+	if (_vertexCount > c->vertex_max) {
+		c->vertex_max = _vertexCount;
+		c->vertex = (GLVertex *)gl_realloc(c->vertex, sizeof(GLVertex) * c->vertex_max);
+	}
+	memcpy(c->vertex, _vertex, sizeof(GLVertex) * _vertexCount);
+	c->vertex_cnt = _vertexCount;
+
+	c->fb->setScissorRectangle(tile);
+	rasterize(c);
+	c->fb->resetScissorRectangle();
+}
+
+void RasterizationDrawCall::rasterize(GLContext *c) const {
+	GLVertex *vertex = c->vertex;
 	c->draw_triangle_front = (gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (gl_draw_triangle_func)_drawTriangleBack;
 
@@ -425,17 +609,11 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 		error("glBegin: type %x not handled", c->begin_type);
 	}
 
-	c->vertex = prevVertex;
-	c->vertex_cnt = prevVertexCount;
-
-	if (restoreState) {
-		applyState(backupState);
-	}
+	c->vertex = vertex;
 }
 
-RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
+RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState(GLContext *c) const {
 	RasterizationState state;
-	GLContext *c = gl_get_context();
 	state.enableBlending = c->blending_enabled;
 	state.sfactor = c->source_blending_factor;
 	state.dfactor = c->destination_blending_factor;
@@ -484,8 +662,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state) const {
-	GLContext *c = gl_get_context();
+void RasterizationDrawCall::applyState(GLContext *c, const RasterizationDrawCall::RasterizationState &state) const {
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
 	c->fb->enableAlphaTest(state.alphaTestEnabled);
@@ -690,7 +867,7 @@ ClearBufferDrawCall::ClearBufferDrawCall(bool clearZBuffer, int zValue,
 	  _rValue(rValue), _gValue(gValue), _bValue(bValue), _clearStencilBuffer(clearStencilBuffer),
 	  _stencilValue(stencilValue), DrawCall(DrawCall_Clear) {
 	TinyGL::GLContext *c = gl_get_context();
-	if (c->_enableDirtyRectangles) {
+	if (c->_enableDirtyRectangles || !c->_tileContexts.empty()) {
 		_dirtyRegion = c->renderRect;
 	}
 }
@@ -708,6 +885,12 @@ void ClearBufferDrawCall::execute(const Common::Rect &clippingRectangle, bool re
 	                   _clearStencilBuffer, _stencilValue);
 }
 
+void ClearBufferDrawCall::executeTile(GLContext *c, const Common::Rect &tile) const {
+	c->fb->clearRegion(tile.left, tile.top, tile.width(), tile.height(),
+	                   _clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue,
+	                   _clearStencilBuffer, _stencilValue);
+}
+
 bool ClearBufferDrawCall::operator==(const ClearBufferDrawCall &other) const {
 	return
 		_clearZBuffer == other._clearZBuffer &&
@@ -55,6 +55,11 @@ public:
 	}
 	virtual void execute(bool restoreState) const = 0;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const = 0;
+	/**
+	 * Execute the call within @p tile only, on @p c, the context of a thread
+	 * rasterizing its own tiles of the frame buffer. Blits can't do this.
+	 */
+	virtual void executeTile(GLContext *c, const Common::Rect &tile) const;
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
 protected:
@@ -70,6 +75,7 @@ public:
 	bool operator==(const ClearBufferDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual void executeTile(GLContext *c, const Common::Rect &tile) const;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -89,6 +95,7 @@ public:
 	bool operator==(const RasterizationDrawCall &other) const;
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
+	virtual void executeTile(GLContext *c, const Common::Rect &tile) const;
 
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
@@ -150,8 +157,9 @@ private:
 
 	RasterizationState _state;
 
-	RasterizationState captureState() const;
-	void applyState(const RasterizationState &state) const;
+	RasterizationState captureState(GLContext *c) const;
+	void applyState(GLContext *c, const RasterizationState &state) const;
+	void rasterize(GLContext *c) const;
 };
 
 // Encapsulate a blit call: it might execute either a color buffer or z buffer blit.
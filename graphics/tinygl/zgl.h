@@ -463,6 +463,10 @@ struct GLContext {
 	bool _debugRectsEnabled;
 	bool _profilingEnabled;
 
+	// Rasterization of the draw calls in tiles, on several threads
+	Common::Array<GLContext *> _tileContexts;
+	Common::Array<Common::Array<const DrawCall *> > _tileBins;
+
 	void gl_vertex_transform(GLVertex *v);
 	void gl_calc_fog_factor(GLVertex *v);
 
@@ -520,6 +524,13 @@ public:
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
 
+	void setRenderThreads(int count);
+	void freeTileContexts();
+	bool canRenderTiles() const;
+	void renderTiles(const Common::List<Common::Rect> *dirtyRects);
+	void flushTileBins(const Common::List<Common::Rect> *dirtyRects);
+	void renderTile(GLContext *c, int tile, const Common::List<Common::Rect> *dirtyRects) const;
+
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
 
 	GLSpecBuf *specbuf_get_buffer(const int shininess_i, const float shininess);
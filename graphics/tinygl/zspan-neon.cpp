@@ -0,0 +1,369 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <arm_neon.h>
+
+#include "graphics/tinygl/zspan.h"
+
+namespace TinyGL {
+
+namespace {
+
+/** The values of 4 pixels in a row, from v stepping by d. */
+inline uint32x4_t ramp(uint v, int d) {
+	const uint32 values[4] = { v, v + d, v + 2 * (uint)d, v + 3 * (uint)d };
+	return vld1q_u32(values);
+}
+
+inline uint32x4_t step4(int d) {
+	return vdupq_n_u32(4 * (uint)d);
+}
+
+inline bool anyLane(uint32x4_t mask) {
+	return vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(mask)), 0) != 0;
+}
+
+// vshlq_u32 shifts right for negative counts
+inline uint32x4_t shiftLeft(uint32x4_t v, uint shift) {
+	return vshlq_u32(v, vdupq_n_s32(shift));
+}
+
+inline uint32x4_t shiftRight(uint32x4_t v, uint shift) {
+	return vshlq_u32(v, vdupq_n_s32(-(int)shift));
+}
+
+/** A depth or alpha test, passing for some relations of a value to a reference. */
+struct CompareNEON {
+	uint32x4_t less, equal, greater;
+
+	CompareNEON(bool passLess, bool passEqual, bool passGreater) {
+		less = vdupq_n_u32(passLess ? 0xFFFFFFFF : 0);
+		equal = vdupq_n_u32(passEqual ? 0xFFFFFFFF : 0);
+		greater = vdupq_n_u32(passGreater ? 0xFFFFFFFF : 0);
+	}
+
+	/** The lanes where the test passes. */
+	inline uint32x4_t pass(uint32x4_t reference, uint32x4_t value) const {
+		return vorrq_u32(vorrq_u32(vandq_u32(vcltq_u32(value, reference), less), vandq_u32(vceqq_u32(value, reference), equal)),
+		                 vandq_u32(vcgtq_u32(value, reference), greater));
+	}
+};
+
+struct DepthTestNEON : CompareNEON {
+	DepthTestNEON(const SpanState &state) : CompareNEON(state.depthLess, state.depthEqual, state.depthGreater) {}
+};
+
+struct AlphaTestNEON : CompareNEON {
+	AlphaTestNEON(const SpanState &state) : CompareNEON(state.alphaLess, state.alphaEqual, state.alphaGreater) {}
+};
+
+/** (uint)(float)z, with the same rounding as the scalar code. */
+inline uint32x4_t roundDepth(uint32x4_t z) {
+	return vcvtq_u32_f32(vcvtq_f32_u32(z));
+}
+
+inline uint32x4_t mul8(uint32x4_t x, uint32x4_t f) {
+	return vshrq_n_u32(vmulq_u32(x, f), 8);
+}
+
+inline void blendFactor(int factor, uint32x4_t &r, uint32x4_t &g, uint32x4_t &b, uint32x4_t rOther, uint32x4_t gOther, uint32x4_t bOther, uint32x4_t aSrc, uint32x4_t aDst) {
+	const uint32x4_t ff = vdupq_n_u32(0xFF);
+	switch (factor) {
+	case TGL_ZERO:
+		r = g = b = vdupq_n_u32(0);
+		break;
+	case TGL_DST_COLOR:
+		r = mul8(r, rOther);
+		g = mul8(g, gOther);
+		b = mul8(b, bOther);
+		break;
+	case TGL_ONE_MINUS_DST_COLOR:
+		r = mul8(r, vsubq_u32(ff, rOther));
+		g = mul8(g, vsubq_u32(ff, gOther));
+		b = mul8(b, vsubq_u32(ff, bOther));
+		break;
+	case TGL_SRC_ALPHA:
+		r = mul8(r, aSrc);
+		g = mul8(g, aSrc);
+		b = mul8(b, aSrc);
+		break;
+	case TGL_ONE_MINUS_SRC_ALPHA:
+		r = mul8(r, vsubq_u32(ff, aSrc));
+		g = mul8(g, vsubq_u32(ff, aSrc));
+		b = mul8(b, vsubq_u32(ff, aSrc));
+		break;
+	case TGL_DST_ALPHA:
+		r = mul8(r, aDst);
+		g = mul8(g, aDst);
+		b = mul8(b, aDst);
+		break;
+	case TGL_ONE_MINUS_DST_ALPHA:
+		r = mul8(r, vsubq_u32(ff, aDst));
+		g = mul8(g, vsubq_u32(ff, aDst));
+		b = mul8(b, vsubq_u32(ff, aDst));
+		break;
+	default:
+		break;
+	}
+}
+
+/** Computes the pixels written for source colors, like spanWritePixel(). */
+struct PixelWriterNEON {
+	uint32x4_t ff, alphaMask, alphaFill, opaque;
+	uint aShift, rShift, gShift, bShift;
+	int srcFactor, dstFactor;
+
+	PixelWriterNEON(const SpanState &state) {
+		ff = vdupq_n_u32(0xFF);
+		alphaMask = vdupq_n_u32(state.alphaMask);
+		// Formats without alpha read as opaque
+		alphaFill = vdupq_n_u32(0xFF ^ state.alphaMask);
+		opaque = vdupq_n_u32(state.alphaMask << state.aShift);
+		aShift = state.aShift;
+		rShift = state.rShift;
+		gShift = state.gShift;
+		bShift = state.bShift;
+		srcFactor = state.srcFactor;
+		dstFactor = state.dstFactor;
+	}
+
+	template <bool kBlendingEnabled>
+	inline uint32x4_t color(uint32x4_t aSrc, uint32x4_t rSrc, uint32x4_t gSrc, uint32x4_t bSrc, uint32x4_t dst) const {
+		if (!kBlendingEnabled) {
+			return vorrq_u32(vorrq_u32(shiftLeft(vandq_u32(aSrc, alphaMask), aShift), shiftLeft(rSrc, rShift)),
+			                 vorrq_u32(shiftLeft(gSrc, gShift), shiftLeft(bSrc, bShift)));
+		}
+
+		const uint32x4_t aDst = vorrq_u32(vandq_u32(shiftRight(dst, aShift), alphaMask), alphaFill);
+		uint32x4_t rDst = vandq_u32(shiftRight(dst, rShift), ff);
+		uint32x4_t gDst = vandq_u32(shiftRight(dst, gShift), ff);
+		uint32x4_t bDst = vandq_u32(shiftRight(dst, bShift), ff);
+		blendFactor(srcFactor, rSrc, gSrc, bSrc, rDst, gDst, bDst, aSrc, aDst);
+		blendFactor(dstFactor, rDst, gDst, bDst, rSrc, gSrc, bSrc, aSrc, aDst);
+		return vorrq_u32(vorrq_u32(opaque, shiftLeft(vminq_u32(vaddq_u32(rDst, rSrc), ff), rShift)),
+		                 vorrq_u32(shiftLeft(vminq_u32(vaddq_u32(gDst, gSrc), ff), gShift),
+		                           shiftLeft(vminq_u32(vaddq_u32(bDst, bSrc), ff), bShift)));
+	}
+};
+
+/** A color channel of 4 pixels, from the fixed point values of the span. */
+template <int kBits>
+inline uint32x4_t channel(uint32x4_t v) {
+	return vandq_u32(vshrq_n_u32(v, kBits - 8), vdupq_n_u32(0xFF));
+}
+
+/** Light a texel channel like putPixelTexture, (c * (v >> 8)) >> 8 truncated to a byte. */
+template <int kBits>
+inline uint32x4_t modulate(uint32x4_t c, uint32x4_t v) {
+	return vandq_u32(vshrq_n_u32(vmulq_u32(c, vshrq_n_u32(v, kBits - 8)), kBits - 8), vdupq_n_u32(0xFF));
+}
+
+} // End of anonymous namespace
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void shadeSpanNEON(Span span, const SpanState &state) {
+	const DepthTestNEON depthTest(state);
+	const PixelWriterNEON writer(state);
+
+	uint32x4_t z = ramp(span.z, span.dzdx);
+	uint32x4_t r = ramp(span.r, kSmoothMode ? span.drdx : 0);
+	uint32x4_t g = ramp(span.g, kSmoothMode ? span.dgdx : 0);
+	uint32x4_t b = ramp(span.b, kSmoothMode ? span.dbdx : 0);
+	uint32x4_t a = ramp(span.a, kSmoothMode ? span.dadx : 0);
+	const uint32x4_t dz = step4(span.dzdx);
+	const uint32x4_t dr = step4(span.drdx);
+	const uint32x4_t dg = step4(span.dgdx);
+	const uint32x4_t db = step4(span.dbdx);
+	const uint32x4_t da = step4(span.dadx);
+
+	const int vecCount = span.count & ~3;
+	for (int i = 0; i < vecCount; i += 4) {
+		uint32 *depths = span.depths + i;
+		uint32 *pixels = span.pixels + i;
+		const uint32x4_t stored = vld1q_u32(depths);
+		const uint32x4_t pass = kDepthTestEnabled ? depthTest.pass(z, stored) : vdupq_n_u32(0xFFFFFFFF);
+
+		if (!kDepthTestEnabled || anyLane(pass)) {
+			if (kDepthWrite)
+				vst1q_u32(depths, vbslq_u32(pass, roundDepth(z), stored));
+
+			const uint32x4_t dst = vld1q_u32(pixels);
+			const uint32x4_t color = writer.color<kBlendingEnabled>(channel<ZB_POINT_ALPHA_BITS>(a), channel<ZB_POINT_RED_BITS>(r),
+			                                                        channel<ZB_POINT_GREEN_BITS>(g), channel<ZB_POINT_BLUE_BITS>(b), dst);
+			vst1q_u32(pixels, vbslq_u32(pass, color, dst));
+		}
+
+		z = vaddq_u32(z, dz);
+		if (kSmoothMode) {
+			r = vaddq_u32(r, dr);
+			g = vaddq_u32(g, dg);
+			b = vaddq_u32(b, db);
+			a = vaddq_u32(a, da);
+		}
+	}
+
+	span.advance(vecCount, kSmoothMode);
+	shadeSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(span, state);
+}
+
+template <bool kDepthTestEnabled>
+void depthSpanNEON(Span span, const SpanState &state) {
+	const DepthTestNEON depthTest(state);
+	uint32x4_t z = ramp(span.z, span.dzdx);
+	const uint32x4_t dz = step4(span.dzdx);
+
+	const int vecCount = span.count & ~3;
+	for (int i = 0; i < vecCount; i += 4) {
+		uint32 *depths = span.depths + i;
+		if (kDepthTestEnabled) {
+			const uint32x4_t stored = vld1q_u32(depths);
+			vst1q_u32(depths, vbslq_u32(depthTest.pass(z, stored), z, stored));
+		} else {
+			vst1q_u32(depths, z);
+		}
+		z = vaddq_u32(z, dz);
+	}
+
+	span.advance(vecCount, false);
+	depthSpan<kDepthTestEnabled>(span, state);
+}
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void textureSpanNEON(TextureSpan span, const SpanState &state) {
+	const DepthTestNEON depthTest(state);
+	const AlphaTestNEON alphaTest(state);
+	const uint32x4_t alphaRef = vdupq_n_u32(state.alphaRef);
+	const PixelWriterNEON writer(state);
+	const uint32x4_t ff = vdupq_n_u32(0xFF);
+
+	const Span &row = span.span;
+	uint32x4_t z = ramp(row.z, row.dzdx);
+	uint32x4_t r = ramp(row.r, kSmoothMode ? row.drdx : 0);
+	uint32x4_t g = ramp(row.g, kSmoothMode ? row.dgdx : 0);
+	uint32x4_t b = ramp(row.b, kSmoothMode ? row.dbdx : 0);
+	uint32x4_t a = ramp(row.a, kSmoothMode ? row.dadx : 0);
+	const uint32x4_t dz = step4(row.dzdx);
+	const uint32x4_t dr = step4(row.drdx);
+	const uint32x4_t dg = step4(row.dgdx);
+	const uint32x4_t db = step4(row.dbdx);
+	const uint32x4_t da = step4(row.dadx);
+
+	for (int block = 0; block < row.count; block += TextureSpan::kBlockSize) {
+		int s, t, dsdx, dtdx;
+		span.nextBlock(s, t, dsdx, dtdx);
+
+		const int end = MIN(block + TextureSpan::kBlockSize, row.count);
+		for (int i = block; i < end; i += 4) {
+			if (i >= span.skip && i + 4 <= end) {
+				uint32 *depths = row.depths + i;
+				uint32 *pixels = row.pixels + i;
+				const uint32x4_t stored = vld1q_u32(depths);
+				uint32x4_t pass = kDepthTestEnabled ? depthTest.pass(z, stored) : vdupq_n_u32(0xFFFFFFFF);
+
+				if (!kDepthTestEnabled || anyLane(pass)) {
+					// Only fetch the texels which may be drawn
+					uint32 lanes[4], texels[4];
+					vst1q_u32(lanes, pass);
+					for (int lane = 0; lane < 4; ++lane) {
+						if (lanes[lane]) {
+							uint8 c_a, c_r, c_g, c_b;
+							span.texture->getARGBAt(span.wrapS, span.wrapT, s + lane * (uint)dsdx, t + lane * (uint)dtdx, c_a, c_r, c_g, c_b);
+							texels[lane] = ((uint32)c_a << 24) | (c_r << 16) | (c_g << 8) | c_b;
+						} else {
+							texels[lane] = 0;
+						}
+					}
+					const uint32x4_t texel = vld1q_u32(texels);
+
+					const uint32x4_t aSrc = modulate<ZB_POINT_ALPHA_BITS>(vshrq_n_u32(texel, 24), a);
+					const uint32x4_t rSrc = modulate<ZB_POINT_RED_BITS>(vandq_u32(vshrq_n_u32(texel, 16), ff), r);
+					const uint32x4_t gSrc = modulate<ZB_POINT_GREEN_BITS>(vandq_u32(vshrq_n_u32(texel, 8), ff), g);
+					const uint32x4_t bSrc = modulate<ZB_POINT_BLUE_BITS>(vandq_u32(texel, ff), b);
+					pass = vandq_u32(pass, alphaTest.pass(alphaRef, aSrc));
+
+					if (kDepthWrite)
+						vst1q_u32(depths, vbslq_u32(pass, roundDepth(z), stored));
+					const uint32x4_t dst = vld1q_u32(pixels);
+					vst1q_u32(pixels, vbslq_u32(pass, writer.color<kBlendingEnabled>(aSrc, rSrc, gSrc, bSrc, dst), dst));
+				}
+			} else {
+				// The ends of the row, pixel by pixel
+				for (int j = MAX(i, span.skip); j < MIN(i + 4, end); ++j) {
+					const uint k = j - i;
+					const uint n = kSmoothMode ? j : 0;
+					texturePixel<kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(
+						row.pixels[j], row.depths[j], row.z + j * (uint)row.dzdx, s + k * (uint)dsdx, t + k * (uint)dtdx,
+						row.r + n * (uint)row.drdx, row.g + n * (uint)row.dgdx, row.b + n * (uint)row.dbdx, row.a + n * (uint)row.dadx,
+						span, state);
+				}
+			}
+
+			z = vaddq_u32(z, dz);
+			s += 4 * (uint)dsdx;
+			t += 4 * (uint)dtdx;
+			if (kSmoothMode) {
+				r = vaddq_u32(r, dr);
+				g = vaddq_u32(g, dg);
+				b = vaddq_u32(b, db);
+				a = vaddq_u32(a, da);
+			}
+		}
+	}
+}
+
+template void shadeSpanNEON<false, false, false, false>(Span, const SpanState &);
+template void shadeSpanNEON<false, false, false, true>(Span, const SpanState &);
+template void shadeSpanNEON<false, false, true, false>(Span, const SpanState &);
+template void shadeSpanNEON<false, false, true, true>(Span, const SpanState &);
+template void shadeSpanNEON<false, true, false, false>(Span, const SpanState &);
+template void shadeSpanNEON<false, true, false, true>(Span, const SpanState &);
+template void shadeSpanNEON<false, true, true, false>(Span, const SpanState &);
+template void shadeSpanNEON<false, true, true, true>(Span, const SpanState &);
+template void shadeSpanNEON<true, false, false, false>(Span, const SpanState &);
+template void shadeSpanNEON<true, false, false, true>(Span, const SpanState &);
+template void shadeSpanNEON<true, false, true, false>(Span, const SpanState &);
+template void shadeSpanNEON<true, false, true, true>(Span, const SpanState &);
+template void shadeSpanNEON<true, true, false, false>(Span, const SpanState &);
+template void shadeSpanNEON<true, true, false, true>(Span, const SpanState &);
+template void shadeSpanNEON<true, true, true, false>(Span, const SpanState &);
+template void shadeSpanNEON<true, true, true, true>(Span, const SpanState &);
+
+template void depthSpanNEON<false>(Span, const SpanState &);
+template void depthSpanNEON<true>(Span, const SpanState &);
+
+template void textureSpanNEON<false, false, false, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<false, false, false, true>(TextureSpan, const SpanState &);
+template void textureSpanNEON<false, false, true, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<false, false, true, true>(TextureSpan, const SpanState &);
+template void textureSpanNEON<false, true, false, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<false, true, false, true>(TextureSpan, const SpanState &);
+template void textureSpanNEON<false, true, true, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<false, true, true, true>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, false, false, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, false, false, true>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, false, true, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, false, true, true>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, true, false, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, true, false, true>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, true, true, false>(TextureSpan, const SpanState &);
+template void textureSpanNEON<true, true, true, true>(TextureSpan, const SpanState &);
+
+} // end of namespace TinyGL
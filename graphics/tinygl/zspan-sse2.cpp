@@ -0,0 +1,373 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <emmintrin.h>
+
+#include "graphics/tinygl/zspan.h"
+
+namespace TinyGL {
+
+namespace {
+
+inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/** The values of 4 pixels in a row, from v stepping by d. */
+inline __m128i ramp(uint v, int d) {
+	return _mm_set_epi32(v + 3 * (uint)d, v + 2 * (uint)d, v + d, v);
+}
+
+inline __m128i step4(int d) {
+	return _mm_set1_epi32(4 * (uint)d);
+}
+
+/** A depth or alpha test, passing for some relations of a value to a reference. */
+struct CompareSSE2 {
+	__m128i less, equal, greater;
+
+	CompareSSE2(bool passLess, bool passEqual, bool passGreater) {
+		less = _mm_set1_epi32(passLess ? -1 : 0);
+		equal = _mm_set1_epi32(passEqual ? -1 : 0);
+		greater = _mm_set1_epi32(passGreater ? -1 : 0);
+	}
+
+	/** The lanes where the test passes. */
+	inline __m128i pass(__m128i reference, __m128i value) const {
+		// SSE2 only compares signed integers
+		const __m128i bias = _mm_set1_epi32((int)0x80000000);
+		const __m128i lt = _mm_cmplt_epi32(_mm_xor_si128(value, bias), _mm_xor_si128(reference, bias));
+		const __m128i eq = _mm_cmpeq_epi32(value, reference);
+		const __m128i gt = _mm_andnot_si128(_mm_or_si128(lt, eq), _mm_set1_epi32(-1));
+		return _mm_or_si128(_mm_or_si128(_mm_and_si128(lt, less), _mm_and_si128(eq, equal)), _mm_and_si128(gt, greater));
+	}
+};
+
+struct DepthTestSSE2 : CompareSSE2 {
+	DepthTestSSE2(const SpanState &state) : CompareSSE2(state.depthLess, state.depthEqual, state.depthGreater) {}
+};
+
+struct AlphaTestSSE2 : CompareSSE2 {
+	AlphaTestSSE2(const SpanState &state) : CompareSSE2(state.alphaLess, state.alphaEqual, state.alphaGreater) {}
+};
+
+/** (uint)(float)z, with the same rounding as the scalar code. */
+inline __m128i roundDepth(__m128i z) {
+	// Both halves convert exactly, so that the sum is rounded once
+	const __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(z, 16)), _mm_set1_ps(65536.0f));
+	const __m128 f = _mm_add_ps(hi, _mm_cvtepi32_ps(_mm_and_si128(z, _mm_set1_epi32(0xFFFF))));
+	const __m128 limit = _mm_set1_ps(2147483648.0f);
+	const __m128 big = _mm_cmpge_ps(f, limit);
+	const __m128i low = _mm_cvttps_epi32(_mm_sub_ps(f, _mm_and_ps(big, limit)));
+	return _mm_xor_si128(low, _mm_and_si128(_mm_castps_si128(big), _mm_set1_epi32((int)0x80000000)));
+}
+
+/** (x * f) >> 8 for 8 bit values, which fit the 16 bit products. */
+inline __m128i mul8(__m128i x, __m128i f) {
+	return _mm_srli_epi32(_mm_mullo_epi16(x, f), 8);
+}
+
+inline void blendFactor(int factor, __m128i &r, __m128i &g, __m128i &b, __m128i rOther, __m128i gOther, __m128i bOther, __m128i aSrc, __m128i aDst) {
+	const __m128i ff = _mm_set1_epi32(0xFF);
+	switch (factor) {
+	case TGL_ZERO:
+		r = g = b = _mm_setzero_si128();
+		break;
+	case TGL_DST_COLOR:
+		r = mul8(r, rOther);
+		g = mul8(g, gOther);
+		b = mul8(b, bOther);
+		break;
+	case TGL_ONE_MINUS_DST_COLOR:
+		r = mul8(r, _mm_sub_epi32(ff, rOther));
+		g = mul8(g, _mm_sub_epi32(ff, gOther));
+		b = mul8(b, _mm_sub_epi32(ff, bOther));
+		break;
+	case TGL_SRC_ALPHA:
+		r = mul8(r, aSrc);
+		g = mul8(g, aSrc);
+		b = mul8(b, aSrc);
+		break;
+	case TGL_ONE_MINUS_SRC_ALPHA:
+		r = mul8(r, _mm_sub_epi32(ff, aSrc));
+		g = mul8(g, _mm_sub_epi32(ff, aSrc));
+		b = mul8(b, _mm_sub_epi32(ff, aSrc));
+		break;
+	case TGL_DST_ALPHA:
+		r = mul8(r, aDst);
+		g = mul8(g, aDst);
+		b = mul8(b, aDst);
+		break;
+	case TGL_ONE_MINUS_DST_ALPHA:
+		r = mul8(r, _mm_sub_epi32(ff, aDst));
+		g = mul8(g, _mm_sub_epi32(ff, aDst));
+		b = mul8(b, _mm_sub_epi32(ff, aDst));
+		break;
+	default:
+		break;
+	}
+}
+
+/** Computes the pixels written for source colors, like spanWritePixel(). */
+struct PixelWriterSSE2 {
+	__m128i ff, aShift, rShift, gShift, bShift, alphaMask, alphaFill, opaque;
+	int srcFactor, dstFactor;
+
+	PixelWriterSSE2(const SpanState &state) {
+		ff = _mm_set1_epi32(0xFF);
+		aShift = _mm_cvtsi32_si128(state.aShift);
+		rShift = _mm_cvtsi32_si128(state.rShift);
+		gShift = _mm_cvtsi32_si128(state.gShift);
+		bShift = _mm_cvtsi32_si128(state.bShift);
+		alphaMask = _mm_set1_epi32(state.alphaMask);
+		// Formats without alpha read as opaque
+		alphaFill = _mm_set1_epi32(0xFF ^ state.alphaMask);
+		opaque = _mm_sll_epi32(alphaMask, aShift);
+		srcFactor = state.srcFactor;
+		dstFactor = state.dstFactor;
+	}
+
+	template <bool kBlendingEnabled>
+	inline __m128i color(__m128i aSrc, __m128i rSrc, __m128i gSrc, __m128i bSrc, __m128i dst) const {
+		if (!kBlendingEnabled) {
+			return _mm_or_si128(_mm_or_si128(_mm_sll_epi32(_mm_and_si128(aSrc, alphaMask), aShift), _mm_sll_epi32(rSrc, rShift)),
+			                    _mm_or_si128(_mm_sll_epi32(gSrc, gShift), _mm_sll_epi32(bSrc, bShift)));
+		}
+
+		const __m128i aDst = _mm_or_si128(_mm_and_si128(_mm_srl_epi32(dst, aShift), alphaMask), alphaFill);
+		__m128i rDst = _mm_and_si128(_mm_srl_epi32(dst, rShift), ff);
+		__m128i gDst = _mm_and_si128(_mm_srl_epi32(dst, gShift), ff);
+		__m128i bDst = _mm_and_si128(_mm_srl_epi32(dst, bShift), ff);
+		blendFactor(srcFactor, rSrc, gSrc, bSrc, rDst, gDst, bDst, aSrc, aDst);
+		blendFactor(dstFactor, rDst, gDst, bDst, rSrc, gSrc, bSrc, aSrc, aDst);
+		// The sums fit the 16 bit lanes
+		return _mm_or_si128(_mm_or_si128(opaque, _mm_sll_epi32(_mm_min_epi16(_mm_add_epi32(rDst, rSrc), ff), rShift)),
+		                    _mm_or_si128(_mm_sll_epi32(_mm_min_epi16(_mm_add_epi32(gDst, gSrc), ff), gShift),
+		                                 _mm_sll_epi32(_mm_min_epi16(_mm_add_epi32(bDst, bSrc), ff), bShift)));
+	}
+};
+
+/** A color channel of 4 pixels, from the fixed point values of the span. */
+template <int kBits>
+inline __m128i channel(__m128i v) {
+	return _mm_and_si128(_mm_srli_epi32(v, kBits - 8), _mm_set1_epi32(0xFF));
+}
+
+/**
+ * Light a texel channel like putPixelTexture, (c * (v >> 8)) >> 8 truncated
+ * to a byte. Only the low 16 bits of the factor matter for that byte.
+ */
+template <int kBits>
+inline __m128i modulate(__m128i c, __m128i v) {
+	return _mm_and_si128(_mm_srli_epi32(_mm_mullo_epi16(c, _mm_srli_epi32(v, kBits - 8)), kBits - 8), _mm_set1_epi32(0xFF));
+}
+
+} // End of anonymous namespace
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void shadeSpanSSE2(Span span, const SpanState &state) {
+	const DepthTestSSE2 depthTest(state);
+	const PixelWriterSSE2 writer(state);
+
+	__m128i z = ramp(span.z, span.dzdx);
+	__m128i r = ramp(span.r, kSmoothMode ? span.drdx : 0);
+	__m128i g = ramp(span.g, kSmoothMode ? span.dgdx : 0);
+	__m128i b = ramp(span.b, kSmoothMode ? span.dbdx : 0);
+	__m128i a = ramp(span.a, kSmoothMode ? span.dadx : 0);
+	const __m128i dz = step4(span.dzdx);
+	const __m128i dr = step4(span.drdx);
+	const __m128i dg = step4(span.dgdx);
+	const __m128i db = step4(span.dbdx);
+	const __m128i da = step4(span.dadx);
+
+	const int vecCount = span.count & ~3;
+	for (int i = 0; i < vecCount; i += 4) {
+		__m128i *depths = (__m128i *)(span.depths + i);
+		__m128i *pixels = (__m128i *)(span.pixels + i);
+		const __m128i stored = _mm_loadu_si128(depths);
+		const __m128i pass = kDepthTestEnabled ? depthTest.pass(z, stored) : _mm_set1_epi32(-1);
+
+		if (!kDepthTestEnabled || _mm_movemask_epi8(pass)) {
+			if (kDepthWrite)
+				_mm_storeu_si128(depths, select(pass, roundDepth(z), stored));
+
+			const __m128i dst = _mm_loadu_si128(pixels);
+			const __m128i color = writer.color<kBlendingEnabled>(channel<ZB_POINT_ALPHA_BITS>(a), channel<ZB_POINT_RED_BITS>(r),
+			                                                     channel<ZB_POINT_GREEN_BITS>(g), channel<ZB_POINT_BLUE_BITS>(b), dst);
+			_mm_storeu_si128(pixels, select(pass, color, dst));
+		}
+
+		z = _mm_add_epi32(z, dz);
+		if (kSmoothMode) {
+			r = _mm_add_epi32(r, dr);
+			g = _mm_add_epi32(g, dg);
+			b = _mm_add_epi32(b, db);
+			a = _mm_add_epi32(a, da);
+		}
+	}
+
+	span.advance(vecCount, kSmoothMode);
+	shadeSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(span, state);
+}
+
+template <bool kDepthTestEnabled>
+void depthSpanSSE2(Span span, const SpanState &state) {
+	const DepthTestSSE2 depthTest(state);
+	__m128i z = ramp(span.z, span.dzdx);
+	const __m128i dz = step4(span.dzdx);
+
+	const int vecCount = span.count & ~3;
+	for (int i = 0; i < vecCount; i += 4) {
+		__m128i *depths = (__m128i *)(span.depths + i);
+		if (kDepthTestEnabled) {
+			const __m128i stored = _mm_loadu_si128(depths);
+			_mm_storeu_si128(depths, select(depthTest.pass(z, stored), z, stored));
+		} else {
+			_mm_storeu_si128(depths, z);
+		}
+		z = _mm_add_epi32(z, dz);
+	}
+
+	span.advance(vecCount, false);
+	depthSpan<kDepthTestEnabled>(span, state);
+}
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void textureSpanSSE2(TextureSpan span, const SpanState &state) {
+	const DepthTestSSE2 depthTest(state);
+	const AlphaTestSSE2 alphaTest(state);
+	const __m128i alphaRef = _mm_set1_epi32(state.alphaRef);
+	const PixelWriterSSE2 writer(state);
+	const __m128i ff = _mm_set1_epi32(0xFF);
+
+	const Span &row = span.span;
+	__m128i z = ramp(row.z, row.dzdx);
+	__m128i r = ramp(row.r, kSmoothMode ? row.drdx : 0);
+	__m128i g = ramp(row.g, kSmoothMode ? row.dgdx : 0);
+	__m128i b = ramp(row.b, kSmoothMode ? row.dbdx : 0);
+	__m128i a = ramp(row.a, kSmoothMode ? row.dadx : 0);
+	const __m128i dz = step4(row.dzdx);
+	const __m128i dr = step4(row.drdx);
+	const __m128i dg = step4(row.dgdx);
+	const __m128i db = step4(row.dbdx);
+	const __m128i da = step4(row.dadx);
+
+	for (int block = 0; block < row.count; block += TextureSpan::kBlockSize) {
+		int s, t, dsdx, dtdx;
+		span.nextBlock(s, t, dsdx, dtdx);
+
+		const int end = MIN(block + TextureSpan::kBlockSize, row.count);
+		for (int i = block; i < end; i += 4) {
+			if (i >= span.skip && i + 4 <= end) {
+				__m128i *depths = (__m128i *)(row.depths + i);
+				__m128i *pixels = (__m128i *)(row.pixels + i);
+				const __m128i stored = _mm_loadu_si128(depths);
+				__m128i pass = kDepthTestEnabled ? depthTest.pass(z, stored) : _mm_set1_epi32(-1);
+				const int lanes = _mm_movemask_ps(_mm_castsi128_ps(pass));
+
+				if (lanes) {
+					// Only fetch the texels which may be drawn
+					uint32 texels[4];
+					for (int lane = 0; lane < 4; ++lane) {
+						if (lanes & (1 << lane)) {
+							uint8 c_a, c_r, c_g, c_b;
+							span.texture->getARGBAt(span.wrapS, span.wrapT, s + lane * (uint)dsdx, t + lane * (uint)dtdx, c_a, c_r, c_g, c_b);
+							texels[lane] = ((uint32)c_a << 24) | (c_r << 16) | (c_g << 8) | c_b;
+						} else {
+							texels[lane] = 0;
+						}
+					}
+					const __m128i texel = _mm_loadu_si128((const __m128i *)texels);
+
+					const __m128i aSrc = modulate<ZB_POINT_ALPHA_BITS>(_mm_srli_epi32(texel, 24), a);
+					const __m128i rSrc = modulate<ZB_POINT_RED_BITS>(_mm_and_si128(_mm_srli_epi32(texel, 16), ff), r);
+					const __m128i gSrc = modulate<ZB_POINT_GREEN_BITS>(_mm_and_si128(_mm_srli_epi32(texel, 8), ff), g);
+					const __m128i bSrc = modulate<ZB_POINT_BLUE_BITS>(_mm_and_si128(texel, ff), b);
+					pass = _mm_and_si128(pass, alphaTest.pass(alphaRef, aSrc));
+
+					if (kDepthWrite)
+						_mm_storeu_si128(depths, select(pass, roundDepth(z), stored));
+					const __m128i dst = _mm_loadu_si128(pixels);
+					_mm_storeu_si128(pixels, select(pass, writer.color<kBlendingEnabled>(aSrc, rSrc, gSrc, bSrc, dst), dst));
+				}
+			} else {
+				// The ends of the row, pixel by pixel
+				for (int j = MAX(i, span.skip); j < MIN(i + 4, end); ++j) {
+					const uint k = j - i;
+					const uint n = kSmoothMode ? j : 0;
+					texturePixel<kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(
+						row.pixels[j], row.depths[j], row.z + j * (uint)row.dzdx, s + k * (uint)dsdx, t + k * (uint)dtdx,
+						row.r + n * (uint)row.drdx, row.g + n * (uint)row.dgdx, row.b + n * (uint)row.dbdx, row.a + n * (uint)row.dadx,
+						span, state);
+				}
+			}
+
+			z = _mm_add_epi32(z, dz);
+			s += 4 * (uint)dsdx;
+			t += 4 * (uint)dtdx;
+			if (kSmoothMode) {
+				r = _mm_add_epi32(r, dr);
+				g = _mm_add_epi32(g, dg);
+				b = _mm_add_epi32(b, db);
+				a = _mm_add_epi32(a, da);
+			}
+		}
+	}
+}
+
+template void shadeSpanSSE2<false, false, false, false>(Span, const SpanState &);
+template void shadeSpanSSE2<false, false, false, true>(Span, const SpanState &);
+template void shadeSpanSSE2<false, false, true, false>(Span, const SpanState &);
+template void shadeSpanSSE2<false, false, true, true>(Span, const SpanState &);
+template void shadeSpanSSE2<false, true, false, false>(Span, const SpanState &);
+template void shadeSpanSSE2<false, true, false, true>(Span, const SpanState &);
+template void shadeSpanSSE2<false, true, true, false>(Span, const SpanState &);
+template void shadeSpanSSE2<false, true, true, true>(Span, const SpanState &);
+template void shadeSpanSSE2<true, false, false, false>(Span, const SpanState &);
+template void shadeSpanSSE2<true, false, false, true>(Span, const SpanState &);
+template void shadeSpanSSE2<true, false, true, false>(Span, const SpanState &);
+template void shadeSpanSSE2<true, false, true, true>(Span, const SpanState &);
+template void shadeSpanSSE2<true, true, false, false>(Span, const SpanState &);
+template void shadeSpanSSE2<true, true, false, true>(Span, const SpanState &);
+template void shadeSpanSSE2<true, true, true, false>(Span, const SpanState &);
+template void shadeSpanSSE2<true, true, true, true>(Span, const SpanState &);
+
+template void depthSpanSSE2<false>(Span, const SpanState &);
+template void depthSpanSSE2<true>(Span, const SpanState &);
+
+template void textureSpanSSE2<false, false, false, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<false, false, false, true>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<false, false, true, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<false, false, true, true>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<false, true, false, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<false, true, false, true>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<false, true, true, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<false, true, true, true>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, false, false, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, false, false, true>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, false, true, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, false, true, true>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, true, false, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, true, false, true>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, true, true, false>(TextureSpan, const SpanState &);
+template void textureSpanSSE2<true, true, true, true>(TextureSpan, const SpanState &);
+
+} // end of namespace TinyGL
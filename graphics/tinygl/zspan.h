@@ -0,0 +1,377 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_TINYGL_ZSPAN_H
+#define GRAPHICS_TINYGL_ZSPAN_H
+
+#include "graphics/tinygl/texelbuffer.h"
+#include "graphics/tinygl/zbuffer.h"
+
+namespace TinyGL {
+
+/**
+ * The frame buffer state the span kernels depend on, for 32 bpp pixels
+ * with 8 bit channels.
+ */
+struct SpanState {
+	// Which relations of the stored depth to the new one pass the depth test
+	bool depthLess, depthEqual, depthGreater;
+	// Which relations of the source alpha to alphaRef pass the alpha test,
+	// used by textured spans only
+	bool alphaLess, alphaEqual, alphaGreater;
+	uint alphaRef;
+	uint aShift, rShift, gShift, bShift;
+	// 0xFF, or 0 if the format has no alpha channel
+	uint32 alphaMask;
+	int srcFactor, dstFactor;
+};
+
+/**
+ * A run of pixels of a triangle row, with the values at its first pixel and
+ * their steps, in the fixed point formats of fillTriangle.
+ */
+struct Span {
+	uint32 *pixels;
+	uint *depths;
+	int count;
+	uint z, r, g, b, a;
+	int dzdx, drdx, dgdx, dbdx, dadx;
+
+	/** Skip the first pixels of the span. */
+	void advance(int n, bool smooth) {
+		if (pixels)
+			pixels += n;
+		depths += n;
+		count -= n;
+		z += (uint)n * dzdx;
+		if (smooth) {
+			r += (uint)n * drdx;
+			g += (uint)n * dgdx;
+			b += (uint)n * dbdx;
+			a += (uint)n * dadx;
+		}
+	}
+
+	/** Clip the span, which starts at column x, to the columns [left, right). */
+	bool clip(int x, int left, int right, bool smooth) {
+		const int end = MIN(x + count, right);
+		if (end <= MAX(x, left))
+			return false;
+		if (x < left) {
+			advance(left - x, smooth);
+			x = left;
+		}
+		count = end - x;
+		return true;
+	}
+};
+
+/**
+ * A row of a textured triangle. The texture coordinates are divided by the
+ * depth at the start of every block of kBlockSize pixels, and interpolated
+ * linearly within it, using the floating point values of fillTriangle.
+ */
+struct TextureSpan {
+	static const int kBlockSize = 8;
+
+	/** The whole row, the blocks start at its first pixel. */
+	Span span;
+	/** The number of pixels at the start of the row not to draw. */
+	int skip;
+	const TexelBuffer *texture;
+	uint wrapS, wrapT;
+	float sz, tz, fz, zinv;
+	float dszdx, dtzdx, fdzdx;
+	// The steps over a whole block
+	float ndszdx, ndtzdx, fndzdx;
+
+	/** Return the texture coordinates of the next block and their steps. */
+	void nextBlock(int &s, int &t, int &dsdx, int &dtdx) {
+		const float ss = sz * zinv;
+		const float tt = tz * zinv;
+		s = (int)ss;
+		t = (int)tt;
+		dsdx = (int)((dszdx - ss * fdzdx) * zinv);
+		dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+		fz += fndzdx;
+		zinv = (float)(1.0 / fz);
+		sz += ndszdx;
+		tz += ndtzdx;
+	}
+
+	/** Clip the row, which starts at column x, to the columns [left, right). */
+	bool clip(int x, int left, int right) {
+		const int end = MIN(x + span.count, right);
+		if (end <= MAX(x, left))
+			return false;
+		skip = MAX(left - x, 0);
+		span.count = end - x;
+		return true;
+	}
+};
+
+typedef void (*ShadeSpanFunc)(Span span, const SpanState &state);
+typedef void (*DepthSpanFunc)(Span span, const SpanState &state);
+typedef void (*TextureSpanFunc)(TextureSpan span, const SpanState &state);
+
+inline bool spanDepthTest(uint zSrc, uint zDst, const SpanState &state) {
+	if (zDst < zSrc)
+		return state.depthLess;
+	if (zDst == zSrc)
+		return state.depthEqual;
+	return state.depthGreater;
+}
+
+inline bool spanAlphaTest(uint aSrc, const SpanState &state) {
+	if (aSrc < state.alphaRef)
+		return state.alphaLess;
+	if (aSrc == state.alphaRef)
+		return state.alphaEqual;
+	return state.alphaGreater;
+}
+
+/** Scale a channel by a blending factor, the way FrameBuffer::writePixel does. */
+inline void spanBlendFactor(int factor, uint &r, uint &g, uint &b, uint rOther, uint gOther, uint bOther, uint aSrc, uint aDst) {
+	switch (factor) {
+	case TGL_ZERO:
+		r = g = b = 0;
+		break;
+	case TGL_DST_COLOR:
+		r = (r * rOther) >> 8;
+		g = (g * gOther) >> 8;
+		b = (b * bOther) >> 8;
+		break;
+	case TGL_ONE_MINUS_DST_COLOR:
+		r = (r * (255 - rOther)) >> 8;
+		g = (g * (255 - gOther)) >> 8;
+		b = (b * (255 - bOther)) >> 8;
+		break;
+	case TGL_SRC_ALPHA:
+		r = (r * aSrc) >> 8;
+		g = (g * aSrc) >> 8;
+		b = (b * aSrc) >> 8;
+		break;
+	case TGL_ONE_MINUS_SRC_ALPHA:
+		r = (r * (255 - aSrc)) >> 8;
+		g = (g * (255 - aSrc)) >> 8;
+		b = (b * (255 - aSrc)) >> 8;
+		break;
+	case TGL_DST_ALPHA:
+		r = (r * aDst) >> 8;
+		g = (g * aDst) >> 8;
+		b = (b * aDst) >> 8;
+		break;
+	case TGL_ONE_MINUS_DST_ALPHA:
+		r = (r * (255 - aDst)) >> 8;
+		g = (g * (255 - aDst)) >> 8;
+		b = (b * (255 - aDst)) >> 8;
+		break;
+	default:
+		break;
+	}
+}
+
+/** Write a pixel which passed all the tests, like FrameBuffer::writePixel does without fog. */
+template <bool kBlendingEnabled, bool kDepthWrite>
+inline void spanWritePixel(uint32 &pixel, uint &depth, uint z, uint aSrc, uint rSrc, uint gSrc, uint bSrc, const SpanState &state) {
+	if (kDepthWrite) {
+		// The depth goes through a float in writePixel
+		depth = (uint)(float)z;
+	}
+	if (!kBlendingEnabled) {
+		pixel = ((aSrc & state.alphaMask) << state.aShift) | (rSrc << state.rShift) |
+		        (gSrc << state.gShift) | (bSrc << state.bShift);
+	} else {
+		uint aDst = state.alphaMask ? (pixel >> state.aShift) & 0xFF : 0xFF;
+		uint rDst = (pixel >> state.rShift) & 0xFF;
+		uint gDst = (pixel >> state.gShift) & 0xFF;
+		uint bDst = (pixel >> state.bShift) & 0xFF;
+		spanBlendFactor(state.srcFactor, rSrc, gSrc, bSrc, rDst, gDst, bDst, aSrc, aDst);
+		spanBlendFactor(state.dstFactor, rDst, gDst, bDst, rSrc, gSrc, bSrc, aSrc, aDst);
+		pixel = (state.alphaMask << state.aShift) | (MIN<uint>(rDst + rSrc, 255) << state.rShift) |
+		        (MIN<uint>(gDst + gSrc, 255) << state.gShift) | (MIN<uint>(bDst + bSrc, 255) << state.bShift);
+	}
+}
+
+/**
+ * Draw a span of an untextured triangle without fog, alpha or stencil test,
+ * pixel by pixel like FrameBuffer::putPixelNoTexture. The SIMD kernels give
+ * exactly the same results. TGL_SRC_ALPHA_SATURATE is not supported as
+ * destination factor.
+ */
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void shadeSpan(Span span, const SpanState &state) {
+	for (int i = 0; i < span.count; ++i) {
+		if (!kDepthTestEnabled || spanDepthTest(span.z, span.depths[i], state)) {
+			spanWritePixel<kBlendingEnabled, kDepthWrite>(span.pixels[i], span.depths[i], span.z,
+			                                              (byte)(span.a >> (ZB_POINT_ALPHA_BITS - 8)),
+			                                              (byte)(span.r >> (ZB_POINT_RED_BITS - 8)),
+			                                              (byte)(span.g >> (ZB_POINT_GREEN_BITS - 8)),
+			                                              (byte)(span.b >> (ZB_POINT_BLUE_BITS - 8)), state);
+		}
+		span.z += span.dzdx;
+		if (kSmoothMode) {
+			span.r += span.drdx;
+			span.g += span.dgdx;
+			span.b += span.dbdx;
+			span.a += span.dadx;
+		}
+	}
+}
+
+/**
+ * Write the depth of a span of a triangle drawn to the depth buffer only,
+ * like FrameBuffer::putPixelDepth. The pixels are not used.
+ */
+template <bool kDepthTestEnabled>
+void depthSpan(Span span, const SpanState &state) {
+	for (int i = 0; i < span.count; ++i) {
+		if (!kDepthTestEnabled || spanDepthTest(span.z, span.depths[i], state))
+			span.depths[i] = span.z;
+		span.z += span.dzdx;
+	}
+}
+
+/**
+ * Draw a pixel of a textured triangle lit by its color, like
+ * FrameBuffer::putPixelTexture without fog and stencil test.
+ */
+template <bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+inline void texturePixel(uint32 &pixel, uint &depth, uint z, int s, int t, uint r, uint g, uint b, uint a,
+                         const TextureSpan &span, const SpanState &state) {
+	if (kDepthTestEnabled && !spanDepthTest(z, depth, state))
+		return;
+
+	uint8 c_a, c_r, c_g, c_b;
+	span.texture->getARGBAt(span.wrapS, span.wrapT, s, t, c_a, c_r, c_g, c_b);
+	c_a = (c_a * (a >> (ZB_POINT_ALPHA_BITS - 8))) >> (ZB_POINT_ALPHA_BITS - 8);
+	c_r = (c_r * (r >> (ZB_POINT_RED_BITS - 8))) >> (ZB_POINT_RED_BITS - 8);
+	c_g = (c_g * (g >> (ZB_POINT_GREEN_BITS - 8))) >> (ZB_POINT_GREEN_BITS - 8);
+	c_b = (c_b * (b >> (ZB_POINT_BLUE_BITS - 8))) >> (ZB_POINT_BLUE_BITS - 8);
+	if (spanAlphaTest(c_a, state))
+		spanWritePixel<kBlendingEnabled, kDepthWrite>(pixel, depth, z, c_a, c_r, c_g, c_b, state);
+}
+
+/**
+ * Draw the row of a textured triangle pixel by pixel. The SIMD kernels give
+ * exactly the same results, fetching the texels one by one too. The same
+ * restrictions as for shadeSpan() apply, except that the alpha test is
+ * supported.
+ */
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void textureSpan(TextureSpan span, const SpanState &state) {
+	Span &row = span.span;
+	for (int block = 0; block < row.count; block += TextureSpan::kBlockSize) {
+		int s, t, dsdx, dtdx;
+		span.nextBlock(s, t, dsdx, dtdx);
+
+		const int end = MIN(block + TextureSpan::kBlockSize, row.count);
+		for (int i = block; i < end; ++i) {
+			if (i >= span.skip) {
+				texturePixel<kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(row.pixels[i], row.depths[i], row.z, s, t,
+				                                                               row.r, row.g, row.b, row.a, span, state);
+			}
+			row.z += row.dzdx;
+			s += dsdx;
+			t += dtdx;
+			if (kSmoothMode) {
+				row.r += row.drdx;
+				row.g += row.dgdx;
+				row.b += row.dbdx;
+				row.a += row.dadx;
+			}
+		}
+	}
+}
+
+#ifdef SCUMMVM_SSE2
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void shadeSpanSSE2(Span span, const SpanState &state);
+
+template <bool kDepthTestEnabled>
+void depthSpanSSE2(Span span, const SpanState &state);
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void textureSpanSSE2(TextureSpan span, const SpanState &state);
+#endif
+
+#ifdef SCUMMVM_NEON
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void shadeSpanNEON(Span span, const SpanState &state);
+
+template <bool kDepthTestEnabled>
+void depthSpanNEON(Span span, const SpanState &state);
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+void textureSpanNEON(TextureSpan span, const SpanState &state);
+#endif
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+ShadeSpanFunc getShadeSpanFunc(SpanKernels kernels) {
+	switch (kernels) {
+#ifdef SCUMMVM_SSE2
+	case kSpanKernelsSSE2:
+		return shadeSpanSSE2<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>;
+#endif
+#ifdef SCUMMVM_NEON
+	case kSpanKernelsNEON:
+		return shadeSpanNEON<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+template <bool kDepthTestEnabled>
+DepthSpanFunc getDepthSpanFunc(SpanKernels kernels) {
+	switch (kernels) {
+#ifdef SCUMMVM_SSE2
+	case kSpanKernelsSSE2:
+		return depthSpanSSE2<kDepthTestEnabled>;
+#endif
+#ifdef SCUMMVM_NEON
+	case kSpanKernelsNEON:
+		return depthSpanNEON<kDepthTestEnabled>;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+TextureSpanFunc getTextureSpanFunc(SpanKernels kernels) {
+	switch (kernels) {
+#ifdef SCUMMVM_SSE2
+	case kSpanKernelsSSE2:
+		return textureSpanSSE2<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>;
+#endif
+#ifdef SCUMMVM_NEON
+	case kSpanKernelsNEON:
+		return textureSpanNEON<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+} // end of namespace TinyGL
+
+#endif
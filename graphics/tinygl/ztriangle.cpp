@@ -29,39 +29,40 @@
 #include "graphics/tinygl/texelbuffer.h"
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
+#include "graphics/tinygl/zspan.h"
 
 namespace TinyGL {
 
-static const int NB_INTERP = 8;
+static const int NB_INTERP = TextureSpan::kBlockSize;
 
 template <bool kDepthWrite, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kDepthTestEnabled>
 void FrameBuffer::putPixelNoTexture(int fbOffset, uint *pz, byte *ps, int _a,
                                     int x, int y, uint &z, uint &r, uint &g, uint &b, uint &a,
                                     int &dzdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
                                     uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx) {
-	if (kEnableScissor && scissorPixel(x + _a, y)) {
-		return;
-	}
-	if (kStencilEnabled) {
-		bool stencilResult = stencilTest(ps[_a]);
-		if (!stencilResult) {
-			stencilOp(false, true, ps + _a);
-			return;
+	// Pixels out of the scissor rectangle still step along the row
+	if (!kEnableScissor || !scissorPixel(x + _a, y)) {
+		if (kStencilEnabled) {
+			bool stencilResult = stencilTest(ps[_a]);
+			if (!stencilResult) {
+				stencilOp(false, true, ps + _a);
+				return;
+			}
+		}
+		bool depthTestResult;
+		if (kDepthTestEnabled) {
+			depthTestResult = compareDepth(z, pz[_a]);
+		} else {
+			depthTestResult = true;
+		}
+		if (kStencilEnabled) {
+			stencilOp(true, depthTestResult, ps + _a);
+		}
+		if (depthTestResult) {
+			writePixel<kEnableAlphaTest, kEnableBlending, kDepthWrite, kFogMode>
+			          (fbOffset + _a, a >> (ZB_POINT_ALPHA_BITS - 8), r >> (ZB_POINT_RED_BITS - 8), g >> (ZB_POINT_GREEN_BITS - 8), b >> (ZB_POINT_BLUE_BITS - 8),
+			          z, fog, fog_r, fog_g, fog_b);
 		}
-	}
-	bool depthTestResult;
-	if (kDepthTestEnabled) {
-		depthTestResult = compareDepth(z, pz[_a]);
-	} else {
-		depthTestResult = true;
-	}
-	if (kStencilEnabled) {
-		stencilOp(true, depthTestResult, ps + _a);
-	}
-	if (depthTestResult) {
-		writePixel<kEnableAlphaTest, kEnableBlending, kDepthWrite, kFogMode>
-		          (fbOffset + _a, a >> (ZB_POINT_ALPHA_BITS - 8), r >> (ZB_POINT_RED_BITS - 8), g >> (ZB_POINT_GREEN_BITS - 8), b >> (ZB_POINT_BLUE_BITS - 8),
-		          z, fog, fog_r, fog_g, fog_b);
 	}
 	z += dzdx;
 	if (kFogMode) {
@@ -82,39 +83,39 @@ void FrameBuffer::putPixelTexture(int fbOffset, const TexelBuffer *texture,
                                   uint &r, uint &g, uint &b, uint &a,
                                   int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
                                   uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx) {
-	if (kEnableScissor && scissorPixel(x + _a, y)) {
-		return;
-	}
-	if (kStencilEnabled) {
-		bool stencilResult = stencilTest(ps[_a]);
-		if (!stencilResult) {
-			stencilOp(false, true, ps + _a);
-			return;
+	// Pixels out of the scissor rectangle still step along the row
+	if (!kEnableScissor || !scissorPixel(x + _a, y)) {
+		if (kStencilEnabled) {
+			bool stencilResult = stencilTest(ps[_a]);
+			if (!stencilResult) {
+				stencilOp(false, true, ps + _a);
+				return;
+			}
 		}
-	}
-	bool depthTestResult;
-	if (kDepthTestEnabled) {
-		depthTestResult = compareDepth(z, pz[_a]);
-	} else {
-		depthTestResult = true;
-	}
-	if (kStencilEnabled) {
-		stencilOp(true, depthTestResult, ps + _a);
-	}
-	if (depthTestResult) {
-		uint8 c_a, c_r, c_g, c_b;
-		texture->getARGBAt(wrap_s, wrap_t, s, t, c_a, c_r, c_g, c_b);
-		if (kLightsMode) {
-			uint l_a = (a >> (ZB_POINT_ALPHA_BITS - 8));
-			uint l_r = (r >> (ZB_POINT_RED_BITS - 8));
-			uint l_g = (g >> (ZB_POINT_GREEN_BITS - 8));
-			uint l_b = (b >> (ZB_POINT_BLUE_BITS - 8));
-			c_a = (c_a * l_a) >> (ZB_POINT_ALPHA_BITS - 8);
-			c_r = (c_r * l_r) >> (ZB_POINT_RED_BITS - 8);
-			c_g = (c_g * l_g) >> (ZB_POINT_GREEN_BITS - 8);
-			c_b = (c_b * l_b) >> (ZB_POINT_BLUE_BITS - 8);
+		bool depthTestResult;
+		if (kDepthTestEnabled) {
+			depthTestResult = compareDepth(z, pz[_a]);
+		} else {
+			depthTestResult = true;
+		}
+		if (kStencilEnabled) {
+			stencilOp(true, depthTestResult, ps + _a);
+		}
+		if (depthTestResult) {
+			uint8 c_a, c_r, c_g, c_b;
+			texture->getARGBAt(wrap_s, wrap_t, s, t, c_a, c_r, c_g, c_b);
+			if (kLightsMode) {
+				uint l_a = (a >> (ZB_POINT_ALPHA_BITS - 8));
+				uint l_r = (r >> (ZB_POINT_RED_BITS - 8));
+				uint l_g = (g >> (ZB_POINT_GREEN_BITS - 8));
+				uint l_b = (b >> (ZB_POINT_BLUE_BITS - 8));
+				c_a = (c_a * l_a) >> (ZB_POINT_ALPHA_BITS - 8);
+				c_r = (c_r * l_r) >> (ZB_POINT_RED_BITS - 8);
+				c_g = (c_g * l_g) >> (ZB_POINT_GREEN_BITS - 8);
+				c_b = (c_b * l_b) >> (ZB_POINT_BLUE_BITS - 8);
+			}
+			writePixel<kEnableAlphaTest, kEnableBlending, kDepthWrite, kFogMode>(fbOffset + _a, c_a, c_r, c_g, c_b, z, fog, fog_r, fog_g, fog_b);
 		}
-		writePixel<kEnableAlphaTest, kEnableBlending, kDepthWrite, kFogMode>(fbOffset + _a, c_a, c_r, c_g, c_b, z, fog, fog_r, fog_g, fog_b);
 	}
 	z += dzdx;
 	s += dsdx;
@@ -132,31 +133,64 @@ void FrameBuffer::putPixelTexture(int fbOffset, const TexelBuffer *texture,
 
 template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool kDepthTestEnabled>
 void FrameBuffer::putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx) {
-	if (kEnableScissor && scissorPixel(x + _a, y)) {
-		return;
-	}
-	if (kStencilEnabled) {
-		bool stencilResult = stencilTest(ps[_a]);
-		if (!stencilResult) {
-			stencilOp(false, true, ps + _a);
-			return;
+	// Pixels out of the scissor rectangle still step along the row
+	if (!kEnableScissor || !scissorPixel(x + _a, y)) {
+		if (kStencilEnabled) {
+			bool stencilResult = stencilTest(ps[_a]);
+			if (!stencilResult) {
+				stencilOp(false, true, ps + _a);
+				return;
+			}
+		}
+		bool depthTestResult;
+		if (kDepthTestEnabled) {
+			depthTestResult = compareDepth(z, pz[_a]);
+		} else {
+			depthTestResult = true;
+		}
+		if (kStencilEnabled) {
+			stencilOp(true, depthTestResult, ps + _a);
+		}
+		if (kDepthWrite && depthTestResult) {
+			pz[_a] = z;
 		}
-	}
-	bool depthTestResult;
-	if (kDepthTestEnabled) {
-		depthTestResult = compareDepth(z, pz[_a]);
-	} else {
-		depthTestResult = true;
-	}
-	if (kStencilEnabled) {
-		stencilOp(true, depthTestResult, ps + _a);
-	}
-	if (kDepthWrite && depthTestResult) {
-		pz[_a] = z;
 	}
 	z += dzdx;
 }
 
+void FrameBuffer::getSpanState(SpanState &state) const {
+	// The relations of the stored depth to the new one which pass compareDepth()
+	state.depthLess = !_depthTestEnabled || _depthFunc == TGL_LESS || _depthFunc == TGL_LEQUAL ||
+	                  _depthFunc == TGL_NOTEQUAL || _depthFunc == TGL_ALWAYS;
+	state.depthEqual = !_depthTestEnabled || _depthFunc == TGL_EQUAL || _depthFunc == TGL_LEQUAL ||
+	                   _depthFunc == TGL_GEQUAL || _depthFunc == TGL_ALWAYS;
+	state.depthGreater = !_depthTestEnabled || _depthFunc == TGL_GREATER || _depthFunc == TGL_GEQUAL ||
+	                     _depthFunc == TGL_NOTEQUAL || _depthFunc == TGL_ALWAYS;
+	// Likewise for the source alpha against the reference value, which may
+	// be out of the range of a byte
+	bool alphaLess = !_alphaTestEnabled || _alphaTestFunc == TGL_LESS || _alphaTestFunc == TGL_LEQUAL ||
+	                 _alphaTestFunc == TGL_NOTEQUAL || _alphaTestFunc == TGL_ALWAYS;
+	bool alphaEqual = !_alphaTestEnabled || _alphaTestFunc == TGL_EQUAL || _alphaTestFunc == TGL_LEQUAL ||
+	                  _alphaTestFunc == TGL_GEQUAL || _alphaTestFunc == TGL_ALWAYS;
+	bool alphaGreater = !_alphaTestEnabled || _alphaTestFunc == TGL_GREATER || _alphaTestFunc == TGL_GEQUAL ||
+	                    _alphaTestFunc == TGL_NOTEQUAL || _alphaTestFunc == TGL_ALWAYS;
+	if (_alphaTestRefVal < 0)
+		alphaLess = alphaEqual = alphaGreater;
+	else if (_alphaTestRefVal > 255)
+		alphaEqual = alphaGreater = alphaLess;
+	state.alphaLess = alphaLess;
+	state.alphaEqual = alphaEqual;
+	state.alphaGreater = alphaGreater;
+	state.alphaRef = CLIP(_alphaTestRefVal, 0, 255);
+	state.aShift = _pbufFormat.aShift;
+	state.rShift = _pbufFormat.rShift;
+	state.gShift = _pbufFormat.gShift;
+	state.bShift = _pbufFormat.bShift;
+	state.alphaMask = _pbufFormat.aBits() ? 0xFF : 0;
+	state.srcFactor = _sourceBlendingFactor;
+	state.dstFactor = _destinationBlendingFactor;
+}
+
 template <bool kInterpRGB, bool kInterpZ, bool kInterpST, bool kInterpSTZ, bool kSmoothMode,
           bool kDepthWrite, bool kFogMode, bool kAlphaTestEnabled, bool kEnableScissor,
           bool kBlendingEnabled, bool kStencilEnabled, bool kDepthTestEnabled>
@@ -302,6 +336,25 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		polyOffset = -m * _offsetFactor + -_offsetUnits * (1 << 6);
 	}
 
+	// SIMD kernels draw whole rows, if they support the state
+	ShadeSpanFunc shadeSpanFunc = nullptr;
+	DepthSpanFunc depthSpanFunc = nullptr;
+	TextureSpanFunc textureSpanFunc = nullptr;
+	SpanState spanState;
+	if (kInterpZ && !kStencilEnabled && _spanKernels != kSpanKernelsNone) {
+		if (!kInterpRGB) {
+			if (kDepthWrite)
+				depthSpanFunc = getDepthSpanFunc<kDepthTestEnabled>(_spanKernels);
+		} else if (!kFogMode && (!kBlendingEnabled || _destinationBlendingFactor != TGL_SRC_ALPHA_SATURATE)) {
+			if (kInterpST || kInterpSTZ)
+				textureSpanFunc = getTextureSpanFunc<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(_spanKernels);
+			else if (!kAlphaTestEnabled)
+				shadeSpanFunc = getShadeSpanFunc<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(_spanKernels);
+		}
+		if (shadeSpanFunc || depthSpanFunc || textureSpanFunc)
+			getSpanState(spanState);
+	}
+
 	// screen coordinates
 
 	int pp1 = _pbufWidth * p0->y;
@@ -423,129 +476,182 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
-			int x = x1;
-			if (!kInterpRGB) {
-				int n;
-				uint *pz;
-				byte *ps = nullptr;
-				uint z;
-				n = (x2 >> 16) - x1;
-				if (kInterpZ) {
-					pz = pz1 + x1;
-					z = z1;
-				}
-				if (kStencilEnabled) {
-					ps = ps1 + x1;
-				}
-				while (n >= 3) {
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 2, x, y, z, dzdx);
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 3, x, y, z, dzdx);
+			// Rows out of the scissor rectangle only step along the edges
+			if (kEnableScissor && y >= _clipRectangle.bottom)
+				return;
+			if (!kEnableScissor || y >= _clipRectangle.top) {
+				int x = x1;
+				if (!kInterpRGB) {
+					int n;
+					uint *pz;
+					byte *ps = nullptr;
+					uint z;
+					n = (x2 >> 16) - x1;
 					if (kInterpZ) {
-						pz += 4;
+						pz = pz1 + x1;
+						z = z1;
 					}
 					if (kStencilEnabled) {
-						ps += 4;
+						ps = ps1 + x1;
 					}
-					n -= 4;
-					x += 4;
-				}
-				while (n >= 0) {
-					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
-					if (kInterpZ) {
-						pz += 1;
+					if (depthSpanFunc && n >= 0) {
+						Span span = { nullptr, pz, n + 1, z, 0, 0, 0, 0, dzdx, 0, 0, 0, 0 };
+						if (!kEnableScissor || span.clip(x, _clipRectangle.left, _clipRectangle.right, false))
+							depthSpanFunc(span, spanState);
+						n = -1;
 					}
-					if (kStencilEnabled) {
-						ps += 1;
+					while (n >= 3) {
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 2, x, y, z, dzdx);
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 3, x, y, z, dzdx);
+						if (kInterpZ) {
+							pz += 4;
+						}
+						if (kStencilEnabled) {
+							ps += 4;
+						}
+						n -= 4;
+						x += 4;
+					}
+					while (n >= 0) {
+						putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
+						if (kInterpZ) {
+							pz += 1;
+						}
+						if (kStencilEnabled) {
+							ps += 1;
+						}
+						n -= 1;
+						x += 1;
+					}
+				} else if (!(kInterpST || kInterpSTZ)) {
+					uint *pz;
+					byte *ps = nullptr;
+					int pp;
+					uint z, r, g, b, a, fog;
+					int n = (x2 >> 16) - x1;
+					pp = pp1 + x1;
+					r = r1;
+					g = g1;
+					b = b1;
+					a = a1;
+					if (kFogMode) {
+						fog = f1;
 					}
-					n -= 1;
-					x += 1;
-				}
-			} else if (!(kInterpST || kInterpSTZ)) {
-				uint *pz;
-				byte *ps = nullptr;
-				int pp;
-				uint z, r, g, b, a, fog;
-				int n = (x2 >> 16) - x1;
-				pp = pp1 + x1;
-				r = r1;
-				g = g1;
-				b = b1;
-				a = a1;
-				if (kFogMode) {
-					fog = f1;
-				}
-				if (kInterpZ) {
-					pz = pz1 + x1;
-					z = z1;
-				}
-				if (kStencilEnabled) {
-					ps = ps1 + x1;
-				}
-				while (n >= 3) {
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					pp += 4;
 					if (kInterpZ) {
-						pz += 4;
+						pz = pz1 + x1;
+						z = z1;
 					}
 					if (kStencilEnabled) {
-						ps += 4;
+						ps = ps1 + x1;
+					}
+					if (shadeSpanFunc && n >= 0) {
+						Span span = { (uint32 *)_pbuf + pp, pz, n + 1, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx };
+						if (!kEnableScissor || span.clip(x, _clipRectangle.left, _clipRectangle.right, kSmoothMode))
+							shadeSpanFunc(span, spanState);
+						n = -1;
+					}
+					while (n >= 3) {
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						pp += 4;
+						if (kInterpZ) {
+							pz += 4;
+						}
+						if (kStencilEnabled) {
+							ps += 4;
+						}
+						n -= 4;
+						x += 4;
+					}
+					while (n >= 0) {
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						pp += 1;
+						if (kInterpZ) {
+							pz += 1;
+						}
+						if (kStencilEnabled) {
+							ps += 1;
+						}
+						n -= 1;
+						x += 1;
+					}
+				} else if (kInterpST || kInterpSTZ) {
+					uint *pz;
+					byte *ps = nullptr;
+					int s, t;
+					uint z, r, g, b, a, fog;
+					int n, pp;
+					float sz, tz, fz, zinv;
+					int dsdx, dtdx;
+
+					n = (x2 >> 16) - x1;
+					fz = (float)z1;
+					zinv = (float)(1.0 / fz);
+
+					pp = pp1 + x1;
+					if (kFogMode) {
+						fog = f1;
 					}
-					n -= 4;
-					x += 4;
-				}
-				while (n >= 0) {
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					pp += 1;
 					if (kInterpZ) {
-						pz += 1;
+						pz = pz1 + x1;
+						z = z1;
 					}
 					if (kStencilEnabled) {
-						ps += 1;
+						ps = ps1 + x1;
 					}
-					n -= 1;
-					x += 1;
-				}
-			} else if (kInterpST || kInterpSTZ) {
-				uint *pz;
-				byte *ps = nullptr;
-				int s, t;
-				uint z, r, g, b, a, fog;
-				int n, pp;
-				float sz, tz, fz, zinv;
-				int dsdx, dtdx;
-
-				n = (x2 >> 16) - x1;
-				fz = (float)z1;
-				zinv = (float)(1.0 / fz);
-
-				pp = pp1 + x1;
-				if (kFogMode) {
-					fog = f1;
-				}
-				if (kInterpZ) {
-					pz = pz1 + x1;
-					z = z1;
-				}
-				if (kStencilEnabled) {
-					ps = ps1 + x1;
-				}
-				sz = sz1;
-				tz = tz1;
-				r = r1;
-				g = g1;
-				b = b1;
-				a = a1;
-				while (n >= (NB_INTERP - 1)) {
+					sz = sz1;
+					tz = tz1;
+					r = r1;
+					g = g1;
+					b = b1;
+					a = a1;
+					if (textureSpanFunc && n >= 0) {
+						TextureSpan span = {
+							{ (uint32 *)_pbuf + pp, pz, n + 1, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx },
+							0, texture, _wrapS, _wrapT, sz, tz, fz, zinv, dszdx, dtzdx, fdzdx, ndszdx, ndtzdx, fndzdx
+						};
+						if (!kEnableScissor || span.clip(x, _clipRectangle.left, _clipRectangle.right))
+							textureSpanFunc(span, spanState);
+						n = -1;
+					}
+					while (n >= (NB_INTERP - 1)) {
+						{
+							float ss, tt;
+							ss = sz * zinv;
+							tt = tz * zinv;
+							s = (int)ss;
+							t = (int)tt;
+							dsdx = (int)((dszdx - ss * fdzdx) * zinv);
+							dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+							fz += fndzdx;
+							zinv = (float)(1.0 / fz);
+						}
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+							               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						}
+						pp += NB_INTERP;
+						if (kInterpZ) {
+							pz += NB_INTERP;
+						}
+						if (kStencilEnabled) {
+							ps += NB_INTERP;
+						}
+						sz += ndszdx;
+						tz += ndtzdx;
+						n -= NB_INTERP;
+						x += NB_INTERP;
+					}
+
 					{
 						float ss, tt;
 						ss = sz * zinv;
@@ -554,48 +660,21 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						t = (int)tt;
 						dsdx = (int)((dszdx - ss * fdzdx) * zinv);
 						dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
-						fz += fndzdx;
-						zinv = (float)(1.0 / fz);
-					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					}
-					pp += NB_INTERP;
-					if (kInterpZ) {
-						pz += NB_INTERP;
-					}
-					if (kStencilEnabled) {
-						ps += NB_INTERP;
 					}
-					sz += ndszdx;
-					tz += ndtzdx;
-					n -= NB_INTERP;
-					x += NB_INTERP;
-				}
-
-				{
-					float ss, tt;
-					ss = sz * zinv;
-					tt = tz * zinv;
-					s = (int)ss;
-					t = (int)tt;
-					dsdx = (int)((dszdx - ss * fdzdx) * zinv);
-					dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
-				}
 
-				while (n >= 0) {
-					putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-					               (pp, texture, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					pp += 1;
-					if (kInterpZ) {
-						pz += 1;
-					}
-					if (kStencilEnabled) {
-						ps += 1;
+					while (n >= 0) {
+						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+						               (pp, texture, _wrapS, _wrapT, pz, ps, 0, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						pp += 1;
+						if (kInterpZ) {
+							pz += 1;
+						}
+						if (kStencilEnabled) {
+							ps += 1;
+						}
+						n -= 1;
+						x += 1;
 					}
-					n -= 1;
-					x += 1;
 				}
 			}
 
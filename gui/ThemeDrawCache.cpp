@@ -0,0 +1,182 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gui/ThemeDrawCache.h"
+
+#include "graphics/managed_surface.h"
+
+namespace GUI {
+
+namespace {
+
+void copyRect(Graphics::Surface &dst, const Graphics::ManagedSurface &src, const Common::Rect &r) {
+	if (dst.w != r.width() || dst.h != r.height() || dst.format != src.format) {
+		dst.free();
+		dst.create(r.width(), r.height(), src.format);
+	}
+
+	dst.copyRectToSurface(src.getBasePtr(r.left, r.top), src.pitch, 0, 0, r.width(), r.height());
+}
+
+bool equalsRect(const Graphics::Surface &surf, const Graphics::ManagedSurface &dst, const Common::Rect &r) {
+	const uint rowBytes = r.width() * dst.format.bytesPerPixel;
+	for (int y = 0; y < r.height(); ++y) {
+		if (memcmp(surf.getBasePtr(0, y), dst.getBasePtr(r.left, r.top + y), rowBytes) != 0)
+			return false;
+	}
+	return true;
+}
+
+} // End of anonymous namespace
+
+ThemeDrawCache::Key::Key(int dd, uint32 dyn, const Common::Rect &area, const Common::Rect &drawnArea)
+	: drawData(dd), dynamic(dyn), width(area.width()), height(area.height()), drawn(drawnArea) {
+	drawn.translate(-area.left, -area.top);
+}
+
+uint ThemeDrawCache::KeyHash::operator()(const Key &key) const {
+	uint hash = key.drawData;
+	hash = hash * 31 + key.dynamic;
+	hash = hash * 31 + (uint16)key.width;
+	hash = hash * 31 + (uint16)key.height;
+	hash = hash * 31 + (uint16)key.drawn.left;
+	hash = hash * 31 + (uint16)key.drawn.top;
+	hash = hash * 31 + (uint16)key.drawn.right;
+	hash = hash * 31 + (uint16)key.drawn.bottom;
+	return hash;
+}
+
+bool ThemeDrawCache::KeyEqual::operator()(const Key &a, const Key &b) const {
+	return a.drawData == b.drawData && a.dynamic == b.dynamic && a.width == b.width
+	    && a.height == b.height && a.drawn == b.drawn;
+}
+
+uint ThemeDrawCache::Entry::getBytes() const {
+	return before.h * before.pitch + after.h * after.pitch;
+}
+
+ThemeDrawCache::ThemeDrawCache(uint budget) : _budget(budget) {
+}
+
+ThemeDrawCache::~ThemeDrawCache() {
+	clear();
+	_before.free();
+}
+
+void ThemeDrawCache::reset(uint budget) {
+	clear();
+	_budget = budget;
+}
+
+void ThemeDrawCache::clear() {
+	for (EntryList::iterator i = _lru.begin(); i != _lru.end(); ++i) {
+		(*i)->before.free();
+		(*i)->after.free();
+		delete *i;
+	}
+
+	_lru.clear();
+	_entries.clear();
+	_stats.entries = 0;
+	_stats.bytes = 0;
+}
+
+bool ThemeDrawCache::draw(const Key &key, Graphics::ManagedSurface &dst, const Common::Rect &r) {
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end()) {
+		++_stats.misses;
+		return false;
+	}
+
+	Entry *entry = *i->_value;
+	if (entry->before.format != dst.format || !equalsRect(entry->before, dst, r)) {
+		++_stats.misses;
+		return false;
+	}
+
+	dst.copyRectToSurface(entry->after, r.left, r.top, Common::Rect(entry->after.w, entry->after.h));
+
+	// Move the entry to the front
+	_lru.erase(i->_value);
+	_lru.push_front(entry);
+	i->_value = _lru.begin();
+
+	++_stats.hits;
+	return true;
+}
+
+bool ThemeDrawCache::isCacheable(const Graphics::ManagedSurface &dst, const Common::Rect &r) const {
+	// A few entries have to fit, or they would only push each other out
+	const uint bytes = 2 * r.width() * r.height() * dst.format.bytesPerPixel;
+	return !r.isEmpty() && bytes <= _budget / 4;
+}
+
+void ThemeDrawCache::saveBefore(const Graphics::ManagedSurface &dst, const Common::Rect &r) {
+	copyRect(_before, dst, r);
+}
+
+void ThemeDrawCache::store(const Key &key, const Graphics::ManagedSurface &dst, const Common::Rect &r) {
+	assert(_before.w == r.width() && _before.h == r.height());
+
+	Entry *entry;
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		// Drawn on different pixels than last time
+		entry = *i->_value;
+		_lru.erase(i->_value);
+		_stats.bytes -= entry->getBytes();
+	} else {
+		entry = new Entry();
+		entry->key = key;
+		++_stats.entries;
+	}
+
+	// The pixels kept by saveBefore() become the entry's, and the ones it
+	// had are reused for the next saveBefore().
+	Graphics::Surface before = entry->before;
+	entry->before = _before;
+	_before = before;
+	copyRect(entry->after, dst, r);
+
+	const uint bytes = entry->getBytes();
+	evict(bytes);
+
+	_lru.push_front(entry);
+	_entries[key] = _lru.begin();
+	_stats.bytes += bytes;
+}
+
+void ThemeDrawCache::evict(uint bytes) {
+	while (!_lru.empty() && _stats.bytes + bytes > _budget) {
+		Entry *entry = _lru.back();
+		_lru.pop_back();
+		_entries.erase(entry->key);
+
+		_stats.bytes -= entry->getBytes();
+		--_stats.entries;
+
+		entry->before.free();
+		entry->after.free();
+		delete entry;
+	}
+}
+
+} // End of namespace GUI
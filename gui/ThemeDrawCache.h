@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_THEME_DRAW_CACHE_H
+#define GUI_THEME_DRAW_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/rect.h"
+
+#include "graphics/surface.h"
+
+namespace Graphics {
+class ManagedSurface;
+}
+
+namespace GUI {
+
+/**
+ * Keeps the pixels which drawing a DrawData produced, so drawing it again
+ * in the same size is only a copy.
+ *
+ * Draw steps blend with what is below them, so an entry keeps the pixels
+ * from before the steps were drawn too, and is only used when they match
+ * the pixels which are about to be drawn on. The steps only depend on the
+ * size of the area they are drawn in, so a widget moving around, like the
+ * items of a scrolled grid, still finds its entry.
+ *
+ * The least recently used entries are dropped when the cache grows over
+ * its memory budget.
+ */
+class ThemeDrawCache {
+public:
+	struct Key {
+		Key() : drawData(0), dynamic(0) {}
+		Key(int dd, uint32 dyn, const Common::Rect &area, const Common::Rect &drawnArea);
+
+		int drawData;
+		uint32 dynamic;
+		int16 width, height;   ///< Size of the area the steps are drawn in
+		Common::Rect drawn;    ///< Area the steps draw to, relative to that area
+	};
+
+	struct Stats {
+		Stats() : hits(0), misses(0), entries(0), bytes(0) {}
+
+		uint hits;
+		uint misses;
+		uint entries;
+		uint bytes;
+	};
+
+	explicit ThemeDrawCache(uint budget = 0);
+	~ThemeDrawCache();
+
+	/** Drop all entries and change the memory budget. */
+	void reset(uint budget);
+
+	/** Drop all entries. */
+	void clear();
+
+	/**
+	 * Draw the cached pixels of a DrawData.
+	 *
+	 * @param key  The DrawData and where it is drawn.
+	 * @param dst  The surface to draw on.
+	 * @param r    Where on @p dst the steps draw to.
+	 * @return Whether the pixels were drawn, which is only the case when
+	 *         @p dst already holds the pixels the entry was drawn on.
+	 */
+	bool draw(const Key &key, Graphics::ManagedSurface &dst, const Common::Rect &r);
+
+	/**
+	 * Return whether drawing in @p r can be cached at all.
+	 */
+	bool isCacheable(const Graphics::ManagedSurface &dst, const Common::Rect &r) const;
+
+	/**
+	 * Keep the pixels of @p r before the steps are drawn, for store().
+	 */
+	void saveBefore(const Graphics::ManagedSurface &dst, const Common::Rect &r);
+
+	/**
+	 * Keep the pixels the steps drew in @p r, which must be the rect
+	 * passed to the last saveBefore().
+	 */
+	void store(const Key &key, const Graphics::ManagedSurface &dst, const Common::Rect &r);
+
+	const Stats &getStats() const { return _stats; }
+
+private:
+	struct Entry {
+		Key key;
+		Graphics::Surface before;
+		Graphics::Surface after;
+
+		uint getBytes() const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct KeyEqual {
+		bool operator()(const Key &a, const Key &b) const;
+	};
+
+	typedef Common::List<Entry *> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash, KeyEqual> EntryMap;
+
+	void evict(uint bytes);
+
+	uint _budget;
+	EntryList _lru;        ///< Most recently used first
+	EntryMap _entries;
+	Graphics::Surface _before;
+	Stats _stats;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -248,6 +248,7 @@ ThemeEngine::~ThemeEngine() {
 	_vectorRenderer = nullptr;
 	_screen.free();
 	_backBuffer.free();
+	_frameTimesSurface.free();
 
 	unloadTheme();
 	unloadExtraFont();
@@ -315,6 +316,9 @@ void ThemeEngine::setBaseResolution(int w, int h, float s) {
 
 	_parser->setBaseResolution(w, h, s);
 	_themeEval->setScaleFactor(s);
+
+	// The DrawData are drawn in another size now
+	_drawCache.clear();
 }
 
 /**********************************************************
@@ -465,6 +469,11 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
 
+	// The renderer may draw differently, and the cache may keep as much as
+	// two screens, up to kDrawCacheMaxBudget.
+	_drawCache.reset(MIN<uint>(kDrawCacheMaxBudget, 2 * _screen.pitch * _screen.h));
+	_frameTimesArea = Common::Rect();
+
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
 	// list. Clearing it avoids invalid overlay writes when the backend
@@ -758,6 +767,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
  *********************************************************/
 void ThemeEngine::loadTheme(const Common::String &themeId) {
 	unloadTheme();
+	_drawCache.clear();
 
 	debug(6, "Loading theme %s", themeId.c_str());
 
@@ -947,9 +957,24 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		Graphics::ManagedSurface &dst = *_vectorRenderer->getActiveSurface();
+		Common::Rect drawnArea = extendedRect;
+		drawnArea.clip(dst.w, dst.h);
+
+		const ThemeDrawCache::Key key(type, dynamic, area, drawnArea);
+		const bool cacheable = _drawCache.isCacheable(dst, drawnArea);
+
+		if (!cacheable || !_drawCache.draw(key, dst, drawnArea)) {
+			if (cacheable)
+				_drawCache.saveBefore(dst, drawnArea);
+
+			Common::List<Graphics::DrawStep>::const_iterator step;
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+			}
+
+			if (cacheable)
+				_drawCache.store(key, dst, drawnArea);
 		}
 
 		addDirtyRect(extendedRect);
@@ -1548,6 +1573,33 @@ void ThemeEngine::updateDirtyScreen() {
 	_dirtyScreen.clear();
 }
 
+void ThemeEngine::drawFrameTimes(const Common::U32String &text) {
+	if (!_initOk)
+		return;
+
+	// Uncover what the last text was shown on
+	if (!_frameTimesArea.isEmpty()) {
+		_system->copyRectToOverlay(_screen.getBasePtr(_frameTimesArea.left, _frameTimesArea.top), _screen.pitch,
+		                           _frameTimesArea.left, _frameTimesArea.top, _frameTimesArea.width(), _frameTimesArea.height());
+		_frameTimesArea = Common::Rect();
+	}
+
+	if (text.empty() || !_font)
+		return;
+
+	const int width = MIN<int>(_font->getStringWidth(text) + 4, _screen.w);
+	const int height = MIN<int>(_font->getFontHeight() + 2, _screen.h);
+	_frameTimesArea = Common::Rect(width, height);
+
+	if (_frameTimesSurface.w != width || _frameTimesSurface.h != height || _frameTimesSurface.format != _overlayFormat)
+		_frameTimesSurface.create(width, height, _overlayFormat);
+
+	_frameTimesSurface.fillRect(_frameTimesArea, _overlayFormat.RGBToColor(0, 0, 0));
+	_font->drawString(&_frameTimesSurface, text, 2, 1, width - 4, _overlayFormat.RGBToColor(255, 255, 255));
+
+	_system->copyRectToOverlay(_frameTimesSurface.getPixels(), _frameTimesSurface.pitch, 0, 0, width, height);
+}
+
 void ThemeEngine::applyScreenShading(ShadingStyle style) {
 	if (style != kShadingNone) {
 		_vectorRenderer->applyScreenShading(style);
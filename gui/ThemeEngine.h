@@ -35,6 +35,7 @@
 #include "graphics/font.h"
 #include "graphics/pixelformat.h"
 
+#include "gui/ThemeDrawCache.h"
 
 #define SCUMMVM_THEME_VERSION_STR "SCUMMVM_STX0.9.11"
 
@@ -337,6 +338,9 @@ public:
 	/** Constant value to expand dirty rectangles, to make sure they are fully copied */
 	static const int kDirtyRectangleThreshold = 1;
 
+	/** Most memory the pixels of rendered DrawData may take */
+	static const uint kDrawCacheMaxBudget = 32 * 1024 * 1024;
+
 	struct Renderer {
 		const char *name;
 		const char *shortname;
@@ -405,6 +409,21 @@ public:
 	 */
 	void updateScreen();
 
+	/** Return whether anything was drawn since the screen was last updated. */
+	bool hasDirtyScreen() const { return !_dirtyScreen.empty(); }
+
+	/**
+	 * Show a line of text in the corner of the overlay, above everything
+	 * the GUI draws. The text is not drawn on the screen surface, so the
+	 * GUI does not need to redraw anything when it changes.
+	 *
+	 * @param text The text to show, or an empty string to hide it.
+	 */
+	void drawFrameTimes(const Common::U32String &text);
+
+	/** Return how well the rendered DrawData are reused. */
+	const ThemeDrawCache::Stats &getDrawCacheStats() const { return _drawCache.getStats(); }
+
 	/**
 	 * Copy the entire backbuffer surface to the screen surface
 	 */
@@ -801,6 +820,13 @@ protected:
 	/** List of all the dirty screens that must be blitted to the overlay. */
 	Common::List<Common::Rect> _dirtyScreen;
 
+	/** Pixels drawn by DrawData draw steps, to draw them again quickly. */
+	ThemeDrawCache _drawCache;
+
+	/** Where the frame times were last shown on the overlay. */
+	Common::Rect _frameTimesArea;
+	Graphics::ManagedSurface _frameTimesSurface;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
@@ -73,6 +73,8 @@ GuiManager::GuiManager() : CommandSender(nullptr), _redrawStatus(kRedrawDisabled
 
 	_displayTopDialogOnly = false;
 
+	_frameTimes.enabled = ConfMan.getBool("gui_show_frame_times");
+
 	// Clear the cursor
 	memset(_cursor, 0xFF, sizeof(_cursor));
 
@@ -381,6 +383,8 @@ void GuiManager::redraw() {
 	if (_dialogStack.empty())
 		return;
 
+	const uint32 start = _system->getMillis(true);
+
 	// Reset any custom RTL paddings set by stacked dialogs when we go back to the top
 	if (useRTL() && _dialogStack.size() == 1) {
 		setDialogPaddings(0, 0);
@@ -392,8 +396,44 @@ void GuiManager::redraw() {
 		redrawInternal();
 	}
 
+	const bool drew = _theme->hasDirtyScreen();
 	_theme->updateScreen();
 	_redrawStatus = kRedrawDisabled;
+
+	if (_frameTimes.enabled)
+		updateFrameTimes(_system->getMillis(true) - start, drew);
+}
+
+void GuiManager::updateFrameTimes(uint32 millis, bool drew) {
+	if (drew) {
+		++_frameTimes.frames;
+		_frameTimes.total += millis;
+		_frameTimes.slowest = MAX(_frameTimes.slowest, millis);
+	}
+
+	const uint32 now = _system->getMillis(true);
+	bool textChanged = false;
+	if (now - _frameTimes.start >= 1000) {
+		const ThemeDrawCache::Stats &stats = _theme->getDrawCacheStats();
+		const uint hits = stats.hits - _frameTimes.cacheHits;
+		const uint lookups = hits + stats.misses - _frameTimes.cacheMisses;
+
+		_frameTimes.text = Common::U32String(Common::String::format("%u frames drawn, %.1f ms average, %u ms slowest, %u%% cached (%u KB)",
+			_frameTimes.frames, _frameTimes.frames ? (double)_frameTimes.total / _frameTimes.frames : 0.0, _frameTimes.slowest,
+			lookups ? hits * 100 / lookups : 0, stats.bytes / 1024));
+		textChanged = true;
+
+		_frameTimes.start = now;
+		_frameTimes.frames = 0;
+		_frameTimes.total = 0;
+		_frameTimes.slowest = 0;
+		_frameTimes.cacheHits = stats.hits;
+		_frameTimes.cacheMisses = stats.misses;
+	}
+
+	// Updating the screen may have drawn over the text
+	if (drew || textChanged)
+		_theme->drawFrameTimes(_frameTimes.text);
 }
 
 Dialog *GuiManager::getTopDialog() const {
@@ -198,6 +198,18 @@ protected:
 	int		_cursorAnimateTimer;
 	byte	_cursor[2048];
 
+	// Statistics of the time spent drawing, shown when gui_show_frame_times is set
+	struct FrameTimes {
+		FrameTimes() : enabled(false), start(0), frames(0), total(0), slowest(0), cacheHits(0), cacheMisses(0) {}
+		bool enabled;
+		uint32 start;       // When the statistics were last shown
+		uint frames;        // Frames which drew anything since then
+		uint32 total;       // Time spent drawing them
+		uint32 slowest;
+		uint cacheHits, cacheMisses;
+		Common::U32String text;
+	} _frameTimes;
+
 	// delayed deletion of GuiObject
 	struct GuiObjectTrashItem {
 		GuiObject* object;
@@ -217,6 +229,7 @@ protected:
 	void redraw();
 	void redrawInternalTopDialogOnly();
 	void redrawInternal();
+	void updateFrameTimes(uint32 millis, bool drew);
 
 	void setupCursor();
 	void animateCursor();
@@ -1567,6 +1567,9 @@ void LauncherGrid::build() {
 
 	// Add list with game titles
 	_grid = new GridWidget(this, "LauncherGrid.IconArea");
+	// The grid picks up the thumbnails loaded in the background on ticks,
+	// even while another widget has the focus
+	setTickleWidget(_grid);
 	// Populate the list
 	updateListing();
 
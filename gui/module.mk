@@ -25,6 +25,7 @@ MODULE_OBJS := \
 	shaderbrowser-dialog.o \
 	textviewer.o \
 	themebrowser.o \
+	ThemeDrawCache.o \
 	ThemeEngine.o \
 	ThemeEval.o \
 	ThemeLayout.o \
@@ -38,6 +39,7 @@ MODULE_OBJS := \
 	widgets/editable.o \
 	widgets/edittext.o \
 	widgets/grid.o \
+	widgets/gridthumbnails.o \
 	widgets/groupedlist.o \
 	widgets/list.o \
 	widgets/popup.o \
@@ -206,6 +206,7 @@ void OptionsDialog::init() {
 	_shaderButton = nullptr;
 	_shaderClearButton = nullptr;
 	_vsyncCheckbox = nullptr;
+	_scalerThreadsCheckbox = nullptr;
 	_rendererTypePopUpDesc = nullptr;
 	_rendererTypePopUp = nullptr;
 	_antiAliasPopUpDesc = nullptr;
@@ -381,6 +382,12 @@ void OptionsDialog::build() {
 			if (ConfMan.isKeyTemporary("vsync"))
 				_vsyncCheckbox->setOverride(true);
 		}
+
+		if (g_system->hasFeature(OSystem::kFeatureScalerThreads)) {
+			_scalerThreadsCheckbox->setState(ConfMan.getBool("scaler_threads", _domain));
+			if (ConfMan.isKeyTemporary("scaler_threads"))
+				_scalerThreadsCheckbox->setOverride(true);
+		}
 	}
 
 	if (_stretchPopUp) {
@@ -625,6 +632,13 @@ void OptionsDialog::apply() {
 					_vsyncCheckbox->setOverride(false);
 				}
 			}
+			if (g_system->hasFeature(OSystem::kFeatureScalerThreads)) {
+				if (ConfMan.getBool("scaler_threads", _domain) != _scalerThreadsCheckbox->getState()) {
+					graphicsModeChanged = true;
+					ConfMan.setBool("scaler_threads", _scalerThreadsCheckbox->getState(), _domain);
+					_scalerThreadsCheckbox->setOverride(false);
+				}
+			}
 
 			if (g_system->hasFeature(OSystem::kFeatureAspectRatioCorrection)) {
 				ConfMan.setBool("aspect_ratio", _aspectCheckbox->getState(), _domain);
@@ -752,6 +766,7 @@ void OptionsDialog::apply() {
 			ConfMan.removeKey("renderer", _domain);
 			ConfMan.removeKey("antialiasing", _domain);
 			ConfMan.removeKey("vsync", _domain);
+			ConfMan.removeKey("scaler_threads", _domain);
 		}
 	}
 
@@ -794,6 +809,8 @@ void OptionsDialog::apply() {
 			g_system->setFeatureState(OSystem::kFeatureFilteringMode, ConfMan.getBool("filtering", _domain));
 		if (ConfMan.hasKey("vsync"))
 			g_system->setFeatureState(OSystem::kFeatureVSync, ConfMan.getBool("vsync", _domain));
+		if (ConfMan.hasKey("scaler_threads"))
+			g_system->setFeatureState(OSystem::kFeatureScalerThreads, ConfMan.getBool("scaler_threads", _domain));
 
 		OSystem::TransactionError gfxError = g_system->endGFXTransaction();
 
@@ -1301,6 +1318,9 @@ void OptionsDialog::setGraphicSettingsState(bool enabled) {
 	if (g_system->hasFeature(OSystem::kFeatureVSync))
 		_vsyncCheckbox->setEnabled(enabled);
 
+	if (g_system->hasFeature(OSystem::kFeatureScalerThreads))
+		_scalerThreadsCheckbox->setEnabled(enabled);
+
 }
 
 void OptionsDialog::setAudioSettingsState(bool enabled) {
@@ -1664,6 +1684,9 @@ void OptionsDialog::addGraphicControls(GuiObject *boss, const Common::String &pr
 	if (g_system->hasFeature(OSystem::kFeatureVSync))
 		_vsyncCheckbox = new CheckboxWidget(boss, prefix + "grVSyncCheckbox", _("V-Sync"), _("Wait for the vertical sync to refresh the screen in order to prevent tearing artifacts"));
 
+	if (g_system->hasFeature(OSystem::kFeatureScalerThreads))
+		_scalerThreadsCheckbox = new CheckboxWidget(boss, prefix + "grScalerThreadsCheckbox", _("Multithreaded scaling"), _("Spread the work of the graphics scaler over all CPU cores"));
+
 	Common::Array<Graphics::RendererTypeDescription> rt = Graphics::Renderer::listTypes();
 	if (!rt.empty()) {
 		if (g_system->getOverlayWidth() > 320)
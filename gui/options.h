@@ -158,6 +158,7 @@ private:
 	CheckboxWidget *_filteringCheckbox;
 	CheckboxWidget *_aspectCheckbox;
 	CheckboxWidget *_vsyncCheckbox;
+	CheckboxWidget *_scalerThreadsCheckbox;
 	StaticTextWidget *_rendererTypePopUpDesc;
 	PopUpWidget *_rendererTypePopUp;
 	StaticTextWidget *_antiAliasPopUpDesc;
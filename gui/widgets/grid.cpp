@@ -53,6 +53,17 @@ void GridItemWidget::updateThumb() {
 		_thumbGfx.copyFrom(*gfx);
 }
 
+void GridItemWidget::updateLoadedThumb() {
+	// Only items still showing their placeholder can have gained a thumbnail
+	if (!_activeEntry || _activeEntry->isHeader || !_thumbGfx.empty() || !isVisible())
+		return;
+
+	if (_grid->filenameToSurface(_activeEntry->thumbPath)) {
+		updateThumb();
+		markAsDirty();
+	}
+}
+
 void GridItemWidget::update() {
 	if (_activeEntry) {
 		updateThumb();
@@ -391,6 +402,9 @@ Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int re
 GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	: ContainerWidget(boss, name), CommandSender(boss) {
 
+	// Thumbnails loaded in the background are picked up on ticks
+	setFlags(WIDGET_WANT_TICKLE);
+
 	_thumbnailHeight = 0;
 	_thumbnailWidth = 0;
 	_flagIconHeight = 0;
@@ -439,7 +453,6 @@ GridWidget::~GridWidget() {
 	unloadSurfaces(_platformIcons);
 	unloadSurfaces(_languageIcons);
 	unloadSurfaces(_extraIcons);
-	unloadSurfaces(_loadedSurfaces);
 	delete _disabledIconOverlay;
 	_gridItems.clear();
 	_dataEntryList.clear();
@@ -459,7 +472,11 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
 	if (name.empty())
 		return nullptr;
-	return _loadedSurfaces[name];
+
+	Common::StringMap::const_iterator i = _thumbnailPaths.find(name);
+	if (i == _thumbnailPaths.end() || i->_value.empty())
+		return nullptr;
+	return _thumbnailLoader.getTile(i->_value);
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode) {
@@ -682,42 +699,51 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 }
 
 void GridWidget::reloadThumbnails() {
-	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
-	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
-	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
-		GridItemInfo *entry = *iter;
-		if (entry->thumbPath.empty())
-			continue;
+	// Also load the thumbnails of a screen above and below, so that they are
+	// usually there by the time they are scrolled into view
+	const int numVisible = _lastVisibleItem - _firstVisibleItem + 1;
+	const int first = MAX(_firstVisibleItem - numVisible, 0);
+	const int last = MIN(_lastVisibleItem + numVisible, (int)_sortedEntryList.size() - 1);
+
+	// Visible thumbnails are requested first
+	for (uint i = 0; i < _visibleEntryList.size(); ++i) {
+		const Common::String &path = findThumbnailPath(*_visibleEntryList[i]);
+		if (!path.empty())
+			_thumbnailLoader.getTile(path);
+	}
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					_loadedSurfaces[entry->thumbPath] = new Graphics::ManagedSurface(*scSurf);
-				}
-			}
+	for (int i = first; i <= last; ++i) {
+		if (i >= _firstVisibleItem && i <= _lastVisibleItem)
+			continue;
+		const Common::String &path = findThumbnailPath(*_sortedEntryList[i]);
+		if (!path.empty())
+			_thumbnailLoader.getTile(path);
+	}
+}
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+const Common::String &GridWidget::findThumbnailPath(const GridItemInfo &entry) {
+	if (entry.thumbPath.empty())
+		return entry.thumbPath;
 
-				if (path != entry->thumbPath) {
-					_loadedSurfaces[path] = new Graphics::ManagedSurface(*scSurf);
-				}
+	Common::StringMap::const_iterator i = _thumbnailPaths.find(entry.thumbPath);
+	if (i != _thumbnailPaths.end())
+		return i->_value;
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
-			}
-		}
+	// Fall back to the icon of the engine
+	Common::String path;
+	g_gui.lockIconsSet();
+	if (g_gui.getIconsSet().hasFile(entry.thumbPath)) {
+		path = entry.thumbPath;
+	} else {
+		const Common::String enginePath = Common::String::format("icons/%s.png", entry.engineid.c_str());
+		if (g_gui.getIconsSet().hasFile(enginePath))
+			path = enginePath;
+		else
+			debug(5, "GridWidget: Cannot read file '%s'", entry.thumbPath.c_str());
 	}
+	g_gui.unlockIconsSet();
+
+	return _thumbnailPaths[entry.thumbPath] = path;
 }
 
 void GridWidget::loadFlagIcons() {
@@ -896,6 +922,14 @@ void GridWidget::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 	}
 }
 
+void GridWidget::handleTickle() {
+	if (!_thumbnailLoader.update())
+		return;
+
+	for (Common::Array<GridItemWidget *>::iterator i = _gridItems.begin(); i != _gridItems.end(); ++i)
+		(*i)->updateLoadedThumb();
+}
+
 void GridWidget::calcInnerHeight() {
 	int row = 0;
 	int col = 0;
@@ -1010,7 +1044,7 @@ void GridWidget::reflowLayout() {
 		unloadSurfaces(_extraIcons);
 		unloadSurfaces(_platformIcons);
 		unloadSurfaces(_languageIcons);
-		unloadSurfaces(_loadedSurfaces);
+		_thumbnailLoader.setTileSize(MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0), MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0));
 		if (_disabledIconOverlay)
 			_disabledIconOverlay->free();
 		reloadThumbnails();
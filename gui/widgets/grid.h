@@ -23,6 +23,7 @@
 #define GUI_WIDGETS_GRID_H
 
 #include "gui/dialog.h"
+#include "gui/widgets/gridthumbnails.h"
 #include "gui/widgets/scrollbar.h"
 #include "common/str.h"
 
@@ -102,8 +103,9 @@ protected:
 	Common::HashMap<int, const Graphics::ManagedSurface *> _languageIcons;
 	Common::HashMap<int, const Graphics::ManagedSurface *> _extraIcons;
 	Graphics::ManagedSurface *_disabledIconOverlay;
-	// Images are mapped by filename -> surface.
-	Common::HashMap<Common::String, const Graphics::ManagedSurface *> _loadedSurfaces;
+	// Thumbnails are mapped by filename -> icon file, empty when there is none.
+	Common::StringMap _thumbnailPaths;
+	GridThumbnailLoader _thumbnailLoader;
 
 	Common::Array<GridItemInfo>			_dataEntryList;
 	Common::Array<GridItemInfo>			_headerEntryList;
@@ -194,6 +196,7 @@ public:
 	void saveClosedGroups(const Common::U32String &groupName);
 
 	void reloadThumbnails();
+	const Common::String &findThumbnailPath(const GridItemInfo &entry);
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -213,6 +216,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
@@ -240,6 +244,7 @@ public:
 	void move(int x, int y);
 	void update();
 	void updateThumb();
+	void updateLoadedThumb();
 	void setActiveEntry(GridItemInfo &entry);
 
 	void drawWidget() override;
@@ -0,0 +1,314 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "common/file.h"
+#include "common/memstream.h"
+#include "common/system.h"
+
+#include "graphics/managed_surface.h"
+
+#include "image/png.h"
+
+#include "gui/gui-manager.h"
+#include "gui/widget.h"
+#include "gui/widgets/gridthumbnails.h"
+
+namespace GUI {
+
+/** Bump this whenever the way tiles are scaled or stored changes. */
+static const uint32 kTileCacheVersion = 1;
+
+GridThumbnailLoader::GridThumbnailLoader()
+	: _width(0), _height(0), _generation(0), _useCounter(0), _hasCacheDir(false) {
+}
+
+GridThumbnailLoader::~GridThumbnailLoader() {
+	JobMan.wait(_jobs);
+	update();
+	clear();
+}
+
+void GridThumbnailLoader::setTileSize(int width, int height) {
+	if (width == _width && height == _height)
+		return;
+
+	clear();
+	_width = width;
+	_height = height;
+
+	// Pending requests are for the old size, so they are dropped when they
+	// finish
+	++_generation;
+	_pending.clear();
+
+	_hasCacheDir = false;
+	const Common::String cachePath = g_system->getDefaultCachePath();
+	if (cachePath.empty() || width <= 0 || height <= 0)
+		return;
+
+	Common::FSNode dir = Common::FSNode(cachePath).getChild("grid-thumbnails");
+	if (!dir.isDirectory() && !dir.createDirectory())
+		return;
+
+	_cacheDir = dir.getChild(Common::String::format("%dx%d", width, height));
+	if (!_cacheDir.isDirectory() && !_cacheDir.createDirectory())
+		return;
+
+	_hasCacheDir = true;
+}
+
+const Graphics::ManagedSurface *GridThumbnailLoader::getTile(const Common::String &path) {
+	TileMap::iterator i = _tiles.find(path);
+	if (i != _tiles.end()) {
+		i->_value.lastUse = ++_useCounter;
+		return i->_value.surface;
+	}
+
+	if (_width > 0 && _height > 0 && !_pending.contains(path))
+		startLoading(path);
+	return nullptr;
+}
+
+bool GridThumbnailLoader::update() {
+	Common::Array<Request *> finished;
+	{
+		Common::StackLock lock(_finishedMutex);
+		if (_finished.empty())
+			return false;
+		SWAP(finished, _finished);
+	}
+
+	for (uint i = 0; i < finished.size(); ++i) {
+		Request *request = finished[i];
+
+		if (request->generation == _generation) {
+			_pending.erase(request->path);
+
+			// Icons which could not be loaded get an empty tile, so that they
+			// are not tried again
+			Tile &tile = _tiles[request->path];
+			tile.surface = request->tile;
+			tile.lastUse = ++_useCounter;
+
+			if (request->tile && request->store && _hasCacheDir)
+				writeCachedTile(*request);
+		} else if (request->tile) {
+			request->tile->free();
+			delete request->tile;
+		}
+
+		delete request;
+	}
+
+	if (_tiles.size() > kMaxTiles)
+		evictTiles();
+
+	return true;
+}
+
+void GridThumbnailLoader::clear() {
+	for (TileMap::iterator i = _tiles.begin(); i != _tiles.end(); ++i) {
+		if (i->_value.surface) {
+			i->_value.surface->free();
+			delete i->_value.surface;
+		}
+	}
+	_tiles.clear();
+}
+
+void GridThumbnailLoader::startLoading(const Common::String &path) {
+	Common::SeekableReadStream *icon = nullptr;
+	g_gui.lockIconsSet();
+	if (g_gui.getIconsSet().hasFile(path))
+		icon = g_gui.getIconsSet().createReadStreamForMember(path);
+	g_gui.unlockIconsSet();
+
+	if (!icon) {
+		_tiles[path] = Tile();
+		return;
+	}
+
+	Request *request = new Request();
+	request->path = path;
+	request->generation = _generation;
+	request->width = _width;
+	request->height = _height;
+	request->icon = icon;
+	request->cached = nullptr;
+	request->tile = nullptr;
+	request->checksum = 0;
+	request->size = 0;
+	request->store = false;
+
+	if (_hasCacheDir) {
+		Common::FSNode node = getCacheFile(path);
+		if (node.exists()) {
+			Common::File *file = new Common::File();
+			if (file->open(node))
+				request->cached = file;
+			else
+				delete file;
+		}
+	}
+
+	_pending[path] = true;
+	JobMan.schedule([this, request]() { run(request); }, &_jobs);
+}
+
+void GridThumbnailLoader::run(Request *request) {
+	const uint32 size = request->icon->size();
+	byte *data = (byte *)malloc(size);
+	if (data && request->icon->read(data, size) == size) {
+		request->size = size;
+		request->checksum = _crc.crcFast(data, size);
+
+		if (!request->cached || !readCachedTile(*request)) {
+#ifdef USE_PNG
+			Common::MemoryReadStream stream(data, size);
+			Image::PNGDecoder decoder;
+			if (decoder.loadStream(stream) && decoder.getSurface() && decoder.getSurface()->format.bytesPerPixel != 1) {
+				Graphics::ManagedSurface *surf = new Graphics::ManagedSurface(decoder.getSurface());
+				const Graphics::ManagedSurface *scaled = scaleGfx(surf, request->width, request->height, true);
+				if (scaled != surf) {
+					surf->free();
+					delete surf;
+				}
+				request->tile = const_cast<Graphics::ManagedSurface *>(scaled);
+				request->store = true;
+			}
+#endif
+		}
+	}
+	free(data);
+
+	delete request->icon;
+	delete request->cached;
+	request->icon = nullptr;
+	request->cached = nullptr;
+
+	Common::StackLock lock(_finishedMutex);
+	_finished.push_back(request);
+}
+
+bool GridThumbnailLoader::readCachedTile(Request &request) const {
+	Common::SeekableReadStream &in = *request.cached;
+
+	if (in.readUint32BE() != MKTAG('G', 'T', 'H', 'B') || in.readUint32LE() != kTileCacheVersion)
+		return false;
+	if (in.readUint32LE() != request.checksum || in.readUint32LE() != request.size)
+		return false;
+
+	const int w = in.readUint16LE();
+	const int h = in.readUint16LE();
+	Graphics::PixelFormat format;
+	format.bytesPerPixel = in.readByte();
+	format.rLoss = in.readByte();
+	format.gLoss = in.readByte();
+	format.bLoss = in.readByte();
+	format.aLoss = in.readByte();
+	format.rShift = in.readByte();
+	format.gShift = in.readByte();
+	format.bShift = in.readByte();
+	format.aShift = in.readByte();
+
+	if (in.eos() || in.err() || w <= 0 || h <= 0 || w > request.width || h > request.height)
+		return false;
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	Graphics::ManagedSurface *tile = new Graphics::ManagedSurface(w, h, format);
+	const uint rowBytes = w * format.bytesPerPixel;
+	for (int y = 0; y < h; ++y) {
+		if (in.read(tile->getBasePtr(0, y), rowBytes) != rowBytes) {
+			tile->free();
+			delete tile;
+			return false;
+		}
+	}
+
+	request.tile = tile;
+	return true;
+}
+
+void GridThumbnailLoader::writeCachedTile(const Request &request) const {
+	Common::DumpFile file;
+	if (!file.open(getCacheFile(request.path)))
+		return;
+
+	const Graphics::ManagedSurface &tile = *request.tile;
+	const Graphics::PixelFormat &format = tile.format;
+
+	file.writeUint32BE(MKTAG('G', 'T', 'H', 'B'));
+	file.writeUint32LE(kTileCacheVersion);
+	file.writeUint32LE(request.checksum);
+	file.writeUint32LE(request.size);
+	file.writeUint16LE(tile.w);
+	file.writeUint16LE(tile.h);
+	file.writeByte(format.bytesPerPixel);
+	file.writeByte(format.rLoss);
+	file.writeByte(format.gLoss);
+	file.writeByte(format.bLoss);
+	file.writeByte(format.aLoss);
+	file.writeByte(format.rShift);
+	file.writeByte(format.gShift);
+	file.writeByte(format.bShift);
+	file.writeByte(format.aShift);
+
+	const uint rowBytes = tile.w * format.bytesPerPixel;
+	for (int y = 0; y < tile.h; ++y)
+		file.write(tile.getBasePtr(0, y), rowBytes);
+
+	if (!file.flush() || file.err())
+		warning("GridThumbnailLoader: Could not write the cached tile of '%s'", request.path.c_str());
+}
+
+Common::FSNode GridThumbnailLoader::getCacheFile(const Common::String &path) const {
+	Common::String name = path;
+	for (uint i = 0; i < name.size(); ++i) {
+		if (name[i] == '/' || name[i] == '\\' || name[i] == ':')
+			name.setChar('_', i);
+	}
+	return _cacheDir.getChild(name + ".tile");
+}
+
+void GridThumbnailLoader::evictTiles() {
+	// Drop the least recently used quarter at once, so this does not have
+	// to run for every new tile
+	Common::Array<uint> uses;
+	uses.reserve(_tiles.size());
+	for (TileMap::const_iterator i = _tiles.begin(); i != _tiles.end(); ++i)
+		uses.push_back(i->_value.lastUse);
+	Common::sort(uses.begin(), uses.end());
+	const uint threshold = uses[uses.size() / 4];
+
+	for (TileMap::iterator i = _tiles.begin(); i != _tiles.end(); ++i) {
+		if (i->_value.lastUse < threshold) {
+			if (i->_value.surface) {
+				i->_value.surface->free();
+				delete i->_value.surface;
+			}
+			_tiles.erase(i);
+		}
+	}
+}
+
+} // End of namespace GUI
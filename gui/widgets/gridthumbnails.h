@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_WIDGETS_GRIDTHUMBNAILS_H
+#define GUI_WIDGETS_GRIDTHUMBNAILS_H
+
+#include "common/array.h"
+#include "common/crc.h"
+#include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/jobs.h"
+#include "common/mutex.h"
+#include "common/str.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Graphics {
+class ManagedSurface;
+}
+
+namespace GUI {
+
+/**
+ * Loads the icons of the grid view, scaled down to fit in its tiles.
+ *
+ * Icons are decoded and scaled by the job system, so scrolling through a
+ * large library does not stall the GUI while the icons of the new rows are
+ * loaded. Scaled tiles are kept in the cache directory of the backend, in
+ * a directory for each tile size, and only have to be loaded from there
+ * the next time. An entry is only used while the icon it was made from has
+ * the same checksum.
+ *
+ * Files are only ever opened on the GUI thread. The jobs read from the
+ * streams they are handed, and the tiles they produce are picked up by
+ * update().
+ */
+class GridThumbnailLoader {
+public:
+	GridThumbnailLoader();
+	/** Waits for the icons still being loaded. */
+	~GridThumbnailLoader();
+
+	/**
+	 * Set the size the tiles are scaled to fit in. Changing it drops all
+	 * the tiles loaded so far.
+	 */
+	void setTileSize(int width, int height);
+
+	/**
+	 * Return the tile of an icon from the icons set.
+	 *
+	 * @return The tile, or nullptr if the icon could not be loaded or is not
+	 *         loaded yet. In the latter case, loading starts in the
+	 *         background, and update() reports when it is done.
+	 */
+	const Graphics::ManagedSurface *getTile(const Common::String &path);
+
+	/**
+	 * Take over the tiles which were loaded in the background since the
+	 * last call.
+	 *
+	 * @return Whether any tile was finished.
+	 */
+	bool update();
+
+	/** Drop all the tiles. */
+	void clear();
+
+private:
+	struct Request {
+		Common::String path;
+		uint generation;
+		int width, height;
+		Common::SeekableReadStream *icon;    ///< The icon file
+		Common::SeekableReadStream *cached;  ///< The cached tile, if any
+		Graphics::ManagedSurface *tile;      ///< The result
+		uint32 checksum, size;               ///< Of the icon file
+		bool store;                          ///< Whether the tile has to be cached
+	};
+
+	struct Tile {
+		Tile() : surface(nullptr), lastUse(0) {}
+
+		Graphics::ManagedSurface *surface;
+		uint lastUse;
+	};
+
+	typedef Common::HashMap<Common::String, Tile> TileMap;
+
+	/** The most tiles kept in memory; more are dropped, least recently used first. */
+	static const uint kMaxTiles = 512;
+
+	void startLoading(const Common::String &path);
+	void run(Request *request);
+	bool readCachedTile(Request &request) const;
+	void writeCachedTile(const Request &request) const;
+	Common::FSNode getCacheFile(const Common::String &path) const;
+	void evictTiles();
+
+	int _width, _height;
+	/** Incremented when the tile size changes, to drop the tiles of pending requests. */
+	uint _generation;
+	uint _useCounter;
+
+	TileMap _tiles;
+	Common::HashMap<Common::String, bool> _pending;
+
+	bool _hasCacheDir;
+	Common::FSNode _cacheDir;
+
+	const Common::CRC32 _crc;
+
+	Common::JobGroup _jobs;
+	Common::Mutex _finishedMutex;
+	Common::Array<Request *> _finished;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -0,0 +1,88 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+
+#include "helper.h"
+#include "../null_osystem.h"
+
+class MixerTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_settings_before_mix() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixerImpl(22050);
+		mixerImpl.setReady(true);
+		Audio::Mixer &mixer = mixerImpl;
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, true, false), 42);
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT(mixer.isSoundIDActive(42));
+		TS_ASSERT_EQUALS(mixer.getSoundID(handle), 42);
+		TS_ASSERT(mixer.hasActiveChannelOfType(Audio::Mixer::kSFXSoundType));
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 22050U);
+
+		// Queued changes are visible right away, and survive the mix
+		mixer.setChannelVolume(handle, 100);
+		mixer.setChannelBalance(handle, -20);
+		mixer.setChannelRate(handle, 11025);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -20);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 11025U);
+
+		byte buffer[512 * 4];
+		mixerImpl.mixCallback(buffer, sizeof(buffer));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -20);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 11025U);
+
+		mixer.resetChannelRate(handle);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 22050U);
+
+		// Rates do not lose any bits
+		mixer.setChannelRate(handle, 176400);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 176400U);
+		mixerImpl.mixCallback(buffer, sizeof(buffer));
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 176400U);
+
+		mixer.stopHandle(handle);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.isSoundIDActive(42));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+		TS_ASSERT_EQUALS(mixer.getChannelRate(handle), 0U);
+		TS_ASSERT_EQUALS(mixer.getElapsedTime(handle).totalNumberOfFrames(), 0);
+#endif
+	}
+
+	void test_command_queue_overflow() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixerImpl(22050);
+		mixerImpl.setReady(true);
+		Audio::Mixer &mixer = mixerImpl;
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, true, false));
+
+		// Without a mixer callback draining the queue, the changes must
+		// still be applied once it fills up
+		for (int i = 0; i < 1000; ++i)
+			mixer.setChannelVolume(handle, i & 0xFF);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 999 & 0xFF);
+
+		byte buffer[512 * 4];
+		mixerImpl.mixCallback(buffer, sizeof(buffer));
+
+		// Pausing takes effect with the next mix, after which the position
+		// must not advance anymore
+		mixer.pauseHandle(handle, true);
+		mixerImpl.mixCallback(buffer, sizeof(buffer));
+		const Audio::Timestamp paused = mixer.getElapsedTime(handle);
+		mixerImpl.mixCallback(buffer, sizeof(buffer));
+		TS_ASSERT_EQUALS(mixer.getElapsedTime(handle).totalNumberOfFrames(), paused.totalNumberOfFrames());
+#endif
+	}
+};
@@ -0,0 +1,95 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/rate_intern.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class RateMixTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kMaxFrames = 67
+	};
+
+	uint32 _seed;
+
+	int16 nextSample() {
+		_seed = _seed * 1103515245 + 12345;
+		// Favour the extremes, so that the saturation is exercised as well
+		switch ((_seed >> 8) & 7) {
+		case 0:
+			return 32767;
+		case 1:
+			return -32768;
+		default:
+			return (int16)(_seed >> 16);
+		}
+	}
+
+	template<bool inStereo, bool outStereo, bool reverseStereo>
+	void compareWithScalar(Audio::RateMixFunc mix) {
+		static const Audio::st_volume_t volumes[] = { 0, 1, 127, 128, 255, 256 };
+
+		int16 in[kMaxFrames * 2];
+		int16 expected[kMaxFrames * 2];
+		int16 actual[kMaxFrames * 2];
+
+		_seed = 1;
+		for (uint numFrames = 0; numFrames <= kMaxFrames; ++numFrames) {
+			for (uint l = 0; l < ARRAYSIZE(volumes); ++l) {
+				for (uint r = 0; r < ARRAYSIZE(volumes); ++r) {
+					for (uint i = 0; i < ARRAYSIZE(in); ++i)
+						in[i] = nextSample();
+					for (uint i = 0; i < ARRAYSIZE(expected); ++i)
+						expected[i] = actual[i] = nextSample();
+
+					Audio::mixFrames<inStereo, outStereo, reverseStereo>(expected, in, numFrames, volumes[l], volumes[r]);
+					mix(actual, in, numFrames, volumes[l], volumes[r]);
+
+					TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+				}
+			}
+		}
+	}
+
+	template<bool inStereo, bool outStereo, bool reverseStereo>
+	void compareKernels() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			compareWithScalar<inStereo, outStereo, reverseStereo>(Audio::mixFramesSSE2<inStereo, outStereo, reverseStereo>);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+			compareWithScalar<inStereo, outStereo, reverseStereo>(Audio::mixFramesAVX2<inStereo, outStereo, reverseStereo>);
+#endif
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			compareWithScalar<inStereo, outStereo, reverseStereo>(Audio::mixFramesNEON<inStereo, outStereo, reverseStereo>);
+#endif
+#endif
+	}
+
+public:
+	void test_mix_stereo_to_stereo() {
+		compareKernels<true, true, false>();
+	}
+
+	void test_mix_stereo_to_stereo_reversed() {
+		compareKernels<true, true, true>();
+	}
+
+	void test_mix_stereo_to_mono() {
+		compareKernels<true, false, false>();
+	}
+
+	void test_mix_mono_to_stereo() {
+		compareKernels<false, true, false>();
+	}
+
+	void test_mix_mono_to_mono() {
+		compareKernels<false, false, false>();
+	}
+};
@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/compression/gzio.h"
+#include "common/compression/zlib.h"
+
+#include "../null_osystem.h"
+
+class GzioTestSuite : public CxxTest::TestSuite {
+	enum {
+		kSize = 3 * 1024 * 1024 + 123,
+		kChunk = 100
+	};
+
+	byte *_data;
+	byte *_gzip;
+	uint32 _gzipSize;
+
+	void fillData() {
+		// Some repetition, so that the data is split into many blocks
+		uint32 seed = 1;
+		for (uint i = 0; i < kSize; ++i) {
+			seed = seed * 1103515245 + 12345;
+			_data[i] = (i & 0x400) ? 'a' + ((seed >> 16) & 7) : 'a' + (i % 13);
+		}
+	}
+
+	void compress() {
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(out);
+		gzip->write(_data, kSize);
+		gzip->finalize();
+		_gzip = out->getData();
+		_gzipSize = out->size();
+		delete gzip;
+	}
+
+	void checkSeeks(Common::SeekableReadStream *stream) {
+		static const uint32 offsets[] = { kSize - kChunk, 5, 2 * 1024 * 1024 + 7, 1024 * 1024 - 3, 3 * 1024 * 1024 - 5000, 70000 };
+		byte buf[kChunk];
+
+		for (uint i = 0; i < ARRAYSIZE(offsets); ++i) {
+			TS_ASSERT(stream->seek(offsets[i]));
+			TS_ASSERT_EQUALS(stream->read(buf, kChunk), (uint32)kChunk);
+			TS_ASSERT_EQUALS(memcmp(buf, _data + offsets[i], kChunk), 0);
+		}
+	}
+
+public:
+	void setUp() {
+		_data = new byte[kSize];
+		_gzip = nullptr;
+		fillData();
+	}
+
+	void tearDown() {
+		delete[] _data;
+		free(_gzip);
+	}
+
+	void test_gzio_index() {
+#ifdef USE_ZLIB
+		compress();
+
+		// Skip the 10 bytes of the gzip header, and the 8 bytes of the trailer
+		Common::SharedPtr<Common::GzioIndex> index(new Common::GzioIndex());
+		Common::SeekableReadStream *stream = Common::GzioReadStream::openDeflate(
+			new Common::MemoryReadStream(_gzip + 10, _gzipSize - 18), kSize, DisposeAfterUse::YES, index);
+		checkSeeks(stream);
+		TS_ASSERT_LESS_THAN_EQUALS(2u, index->size());
+		delete stream;
+
+		// Another stream over the same data starts from the index
+		stream = Common::GzioReadStream::openDeflate(
+			new Common::MemoryReadStream(_gzip + 10, _gzipSize - 18), kSize, DisposeAfterUse::YES, index);
+		checkSeeks(stream);
+		delete stream;
+#endif
+	}
+
+	void test_gzip_seek() {
+#ifdef USE_ZLIB
+		compress();
+
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(_gzip, _gzipSize));
+		TS_ASSERT_EQUALS(stream->size(), kSize);
+		checkSeeks(stream);
+
+		// Back to the start, which goes through the gzip header again
+		byte buf[kChunk];
+		TS_ASSERT(stream->seek(0));
+		TS_ASSERT_EQUALS(stream->read(buf, kChunk), (uint32)kChunk);
+		TS_ASSERT_EQUALS(memcmp(buf, _data, kChunk), 0);
+		delete stream;
+#endif
+	}
+
+	void test_chunked_gzip() {
+#if defined(USE_ZLIB) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::MemoryWriteStreamDynamic *out = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapChunkedCompressedWriteStream(out);
+		Common::SeekableWriteStream *seekable = dynamic_cast<Common::SeekableWriteStream *>(gzip);
+		TS_ASSERT(seekable != nullptr);
+
+		// Write a placeholder first, and fill it in at the end, like some
+		// engines do with the size of their data.
+		gzip->write("XXXX", 4);
+		gzip->write(_data + 4, kSize - 4);
+		TS_ASSERT_EQUALS(seekable->size(), kSize);
+		TS_ASSERT(seekable->seek(0));
+		gzip->write(_data, 4);
+		gzip->finalize();
+		TS_ASSERT(!gzip->err());
+		_gzip = out->getData();
+		_gzipSize = out->size();
+		delete gzip;
+
+		Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+			new Common::MemoryReadStream(_gzip, _gzipSize));
+		TS_ASSERT_EQUALS(stream->size(), kSize);
+		checkSeeks(stream);
+
+		byte buf[kChunk];
+		TS_ASSERT(stream->seek(-kChunk / 2, SEEK_END));
+		TS_ASSERT_EQUALS(stream->read(buf, kChunk), (uint32)kChunk / 2);
+		TS_ASSERT(stream->eos());
+		TS_ASSERT_EQUALS(memcmp(buf, _data + kSize - kChunk / 2, kChunk / 2), 0);
+		delete stream;
+
+		// Without the tag, it is read as a plain gzip stream, as by older
+		// versions.
+		_gzip[_gzipSize - 8] = 0;
+		stream = Common::wrapCompressedReadStream(new Common::MemoryReadStream(_gzip, _gzipSize));
+		TS_ASSERT_EQUALS(stream->size(), kSize);
+		checkSeeks(stream);
+		TS_ASSERT(stream->seek(0));
+		TS_ASSERT_EQUALS(stream->read(buf, kChunk), (uint32)kChunk);
+		TS_ASSERT_EQUALS(memcmp(buf, _data, kChunk), 0);
+		delete stream;
+#endif
+	}
+};
@@ -0,0 +1,144 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/jobs.h"
+#include "common/thread.h"
+
+#include "../null_osystem.h"
+
+class JobsTestSuite : public CxxTest::TestSuite {
+	enum {
+		kNumGroups = 8,
+		kJobsPerGroup = 1000
+	};
+
+	/** Schedule jobs which each wait for jobs of their own. */
+	static void scheduleNested(Common::JobGroup &group, Common::Atomic<int> &count) {
+		for (int i = 0; i < 100; ++i) {
+			JobMan.schedule([&count]() {
+				Common::JobGroup inner;
+				for (int j = 0; j < 10; ++j)
+					JobMan.schedule([&count]() { count.fetchAdd(1); }, &inner);
+				JobMan.wait(inner);
+				TS_ASSERT(inner.isDone());
+			}, &group);
+		}
+	}
+
+	static void foreignThread(void *param) {
+		Common::Atomic<int> &count = *(Common::Atomic<int> *)param;
+		Common::JobGroup group;
+		scheduleNested(group, count);
+		JobMan.wait(group);
+	}
+
+public:
+	void test_parallel_for() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		int visited[1000] = {};
+		JobMan.parallelFor(0, 1000, [&](int i) { ++visited[i]; });
+		for (int i = 0; i < 1000; ++i)
+			TS_ASSERT_EQUALS(visited[i], 1);
+
+		// Empty and reversed ranges do nothing
+		JobMan.parallelFor(5, 5, [&](int i) { ++visited[i]; });
+		JobMan.parallelFor(5, 0, [&](int i) { ++visited[i]; });
+		TS_ASSERT_EQUALS(visited[0], 1);
+		TS_ASSERT_EQUALS(visited[5], 1);
+#endif
+	}
+
+	void test_groups() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::JobGroup group;
+		TS_ASSERT(group.isDone());
+
+		// Jobs scheduling more jobs into the same group
+		Common::Atomic<int> count;
+		for (int i = 0; i < 10; ++i) {
+			JobMan.schedule([&]() {
+				count.fetchAdd(1);
+				JobMan.schedule([&]() { count.fetchAdd(10); }, &group);
+			}, &group);
+		}
+		JobMan.wait(group);
+		TS_ASSERT(group.isDone());
+		TS_ASSERT_EQUALS(count.load(), 110);
+
+		// Groups can be reused
+		JobMan.schedule([&]() { count.store(0); }, &group);
+		JobMan.wait(group);
+		TS_ASSERT_EQUALS(count.load(), 0);
+#endif
+	}
+
+	void test_futures() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Future<int> futures[16];
+		for (int i = 0; i < 16; ++i)
+			futures[i] = JobMan.async([i]() { return i * i; });
+
+		for (int i = 0; i < 16; ++i) {
+			TS_ASSERT(futures[i].isValid());
+			TS_ASSERT_EQUALS(futures[i].get(), i * i);
+			TS_ASSERT(futures[i].isReady());
+		}
+
+		Common::Future<int> empty;
+		TS_ASSERT(!empty.isValid());
+#endif
+	}
+
+	void test_concurrency() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// The null backend runs several workers wherever it has threads
+		if (g_system->hasFeature(OSystem::kFeatureThreads))
+			TS_ASSERT(JobMan.getThreadCount() > 1);
+
+		// Many small jobs in several groups, waited for in turn
+		Common::JobGroup groups[kNumGroups];
+		Common::Atomic<int> counts[kNumGroups];
+		for (int i = 0; i < kJobsPerGroup; ++i) {
+			for (int j = 0; j < kNumGroups; ++j) {
+				Common::Atomic<int> &count = counts[j];
+				JobMan.schedule([&count]() { count.fetchAdd(1); }, &groups[j]);
+			}
+		}
+		for (int j = 0; j < kNumGroups; ++j) {
+			JobMan.wait(groups[j]);
+			TS_ASSERT_EQUALS(counts[j].load(), kJobsPerGroup);
+		}
+
+		// Jobs waiting for nested groups, scheduled both by the main thread
+		// and by a thread which is not one of the workers
+		Common::Atomic<int> count;
+		Common::Atomic<int> foreignCount;
+		Common::ThreadInternal *thread = g_system->createThread(foreignThread, &foreignCount);
+		scheduleNested(groups[0], count);
+		JobMan.wait(groups[0]);
+		TS_ASSERT_EQUALS(count.load(), 1000);
+
+		if (thread) {
+			thread->join();
+			delete thread;
+			TS_ASSERT_EQUALS(foreignCount.load(), 1000);
+		}
+
+		// Futures resolved out of order
+		Common::Future<int> futures[64];
+		for (int i = 0; i < 64; ++i)
+			futures[i] = JobMan.async([i]() { return i + 1; });
+		int sum = 0;
+		for (int i = 63; i >= 0; --i)
+			sum += futures[i].get();
+		TS_ASSERT_EQUALS(sum, 64 * 65 / 2);
+#endif
+	}
+};
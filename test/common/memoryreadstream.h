@@ -104,4 +104,35 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_shared_sub_stream() {
+		byte *contents = new byte[8];
+		for (int i = 0; i < 8; ++i)
+			contents[i] = i + 1;
+		Common::SharedPtr<byte> block(contents, Common::ArrayDeleter<byte>());
+
+		Common::SharedMemoryReadStream *ms = new Common::SharedMemoryReadStream(block, 1, 6);
+		TS_ASSERT_EQUALS(ms->getRawData(), contents + 1);
+		ms->skip(2);
+
+		// The sub stream shares the memory, and outlives its parent
+		Common::SeekableReadStream *sub = ms->readStream(3);
+		TS_ASSERT_EQUALS(ms->pos(), 5);
+		TS_ASSERT(!ms->eos());
+		TS_ASSERT_EQUALS(sub->getRawData(), contents + 3);
+		delete ms;
+		block.reset();
+
+		TS_ASSERT_EQUALS(sub->size(), 3);
+		TS_ASSERT_EQUALS(sub->readByte(), 4);
+		sub->seek(2, SEEK_SET);
+		TS_ASSERT_EQUALS(sub->readByte(), 6);
+
+		// Reading past the end gives a short stream, and sets eos
+		Common::SeekableReadStream *tail = sub->readStream(2);
+		TS_ASSERT_EQUALS(tail->size(), 0);
+		TS_ASSERT(sub->eos());
+		delete tail;
+		delete sub;
+	}
 };
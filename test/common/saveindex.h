@@ -0,0 +1,182 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/saveindex.h"
+
+#include "../null_osystem.h"
+
+class SaveIndexTestSuite : public CxxTest::TestSuite {
+	static Common::SaveIndex::Entry makeEntry(uint32 fileSize, int64 modificationTime, const char *description) {
+		Common::SaveIndex::Entry entry;
+		entry.fileSize = fileSize;
+		entry.modificationTime = modificationTime;
+		entry.description = description;
+		entry.date = 0x1A0A07E8;
+		entry.time = 0x0C22;
+		entry.playTime = 123456;
+		entry.isAutosave = false;
+		return entry;
+	}
+
+	static Common::Array<byte> makeThumbnail(uint32 size, byte seed) {
+		Common::Array<byte> thumbnail(size);
+		for (uint32 i = 0; i < size; ++i)
+			thumbnail[i] = (byte)(seed + i * 7);
+		return thumbnail;
+	}
+
+	static Common::Array<byte> writeIndex(Common::SaveIndex &index) {
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		TS_ASSERT(index.write(out));
+
+		Common::Array<byte> data(out.size());
+		if (out.size())
+			memcpy(data.data(), out.getData(), out.size());
+		return data;
+	}
+
+	static bool loadIndex(Common::SaveIndex &index, const Common::Array<byte> &data) {
+		Common::MemoryReadStream in(data.data(), data.size());
+		return index.load(in);
+	}
+
+	static bool hasThumbnail(const Common::SaveIndex &index, const Common::String &filename, const Common::Array<byte> &expected) {
+		Common::ScopedPtr<Common::SeekableReadStream> in(index.readThumbnail(filename));
+		if (!in || in->size() != (int64)expected.size())
+			return false;
+
+		Common::Array<byte> data(expected.size());
+		return in->read(data.data(), data.size()) == data.size() && data == expected;
+	}
+
+public:
+	void test_round_trip() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Common::Array<byte> thumbnail1 = makeThumbnail(100, 1);
+		const Common::Array<byte> thumbnail2 = makeThumbnail(33, 5);
+
+		Common::SaveIndex written(nullptr, "target");
+		Common::SaveIndex::Entry autosave = makeEntry(2000, 1700000001, "Autosave");
+		autosave.isAutosave = true;
+		written.set("target.000", autosave, Common::Array<byte>());
+		written.set("target.001", makeEntry(1000, 1700000000, "First"), thumbnail1);
+		written.set("target.002", makeEntry(3000, -5, "Second"), thumbnail2);
+		TS_ASSERT(written.isModified());
+		const Common::Array<byte> data = writeIndex(written);
+
+		Common::SaveIndex index(nullptr, "target");
+		TS_ASSERT(loadIndex(index, data));
+		TS_ASSERT(!index.isModified());
+
+		const Common::SaveIndex::Entry *entry = index.find("target.001", 1000, 1700000000);
+		TS_ASSERT(entry);
+		if (entry) {
+			TS_ASSERT_EQUALS(entry->description, "First");
+			TS_ASSERT_EQUALS(entry->date, 0x1A0A07E8u);
+			TS_ASSERT_EQUALS(entry->time, 0x0C22);
+			TS_ASSERT_EQUALS(entry->playTime, 123456u);
+			TS_ASSERT(!entry->isAutosave);
+		}
+
+		entry = index.find("target.000", 2000, 1700000001);
+		TS_ASSERT(entry && entry->isAutosave);
+		TS_ASSERT(index.find("target.002", 3000, -5));
+		TS_ASSERT(!index.find("target.003", 1000, 1700000000));
+
+		TS_ASSERT(hasThumbnail(index, "target.001", thumbnail1));
+		TS_ASSERT(hasThumbnail(index, "target.002", thumbnail2));
+		TS_ASSERT(!index.readThumbnail("target.000"));
+
+		// Writing the loaded index again gives the same file
+		TS_ASSERT(writeIndex(index) == data);
+#endif
+	}
+
+	void test_stale_entries() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::SaveIndex index(nullptr, "target");
+		index.set("target.001", makeEntry(1000, 1700000000, "First"), Common::Array<byte>());
+
+		TS_ASSERT(index.find("target.001", 1000, 1700000000));
+		// A savefile replaced by one of the same size is caught by its
+		// modification time, and the other way around
+		TS_ASSERT(!index.find("target.001", 1000, 1700000005));
+		TS_ASSERT(!index.find("target.001", 1004, 1700000000));
+		TS_ASSERT(!index.find("target.001", 1004, 1700000005));
+
+		// Replacing the entry trusts the new savefile only
+		index.set("target.001", makeEntry(1004, 1700000005, "First again"), Common::Array<byte>());
+		TS_ASSERT(!index.find("target.001", 1000, 1700000000));
+		const Common::SaveIndex::Entry *entry = index.find("target.001", 1004, 1700000005);
+		TS_ASSERT(entry && entry->description == "First again");
+#endif
+	}
+
+	void test_remove() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::SaveIndex index(nullptr, "target");
+		index.set("target.001", makeEntry(1000, 1700000000, "First"), makeThumbnail(16, 3));
+		index.set("target.002", makeEntry(3000, 1700000002, "Second"), Common::Array<byte>());
+		TS_ASSERT(loadIndex(index, writeIndex(index)));
+
+		TS_ASSERT(index.remove("target.001"));
+		TS_ASSERT(index.isModified());
+		TS_ASSERT(!index.remove("target.001"));
+		TS_ASSERT(!index.find("target.001", 1000, 1700000000));
+		TS_ASSERT(!index.readThumbnail("target.001"));
+
+		Common::SaveIndex reloaded(nullptr, "target");
+		TS_ASSERT(loadIndex(reloaded, writeIndex(index)));
+		TS_ASSERT(!reloaded.find("target.001", 1000, 1700000000));
+		TS_ASSERT(reloaded.find("target.002", 3000, 1700000002));
+#endif
+	}
+
+	void test_corrupt_index() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::SaveIndex written(nullptr, "target");
+		written.set("target.001", makeEntry(1000, 1700000000, "First"), Common::Array<byte>());
+		written.set("target.002", makeEntry(3000, 1700000002, "Second"), makeThumbnail(40, 9));
+		const Common::Array<byte> valid = writeIndex(written);
+
+		Common::SaveIndex index(nullptr, "target");
+		TS_ASSERT(loadIndex(index, valid));
+
+		// Cut inside the thumbnails, then inside the table of entries. A
+		// failed load leaves nothing from the previous one behind.
+		Common::Array<byte> data = valid;
+		data.resize(valid.size() - 10);
+		TS_ASSERT(!loadIndex(index, data));
+		TS_ASSERT(!index.find("target.001", 1000, 1700000000));
+
+		data.resize(valid.size() - 50);
+		TS_ASSERT(!loadIndex(index, data));
+		TS_ASSERT(!index.find("target.001", 1000, 1700000000));
+		TS_ASSERT(!index.find("target.002", 3000, 1700000002));
+
+		// Not an index file at all
+		data = valid;
+		data[0] ^= 0xFF;
+		TS_ASSERT(!loadIndex(index, data));
+
+		// Written by another version
+		data = valid;
+		data[4] = 0xFF;
+		TS_ASSERT(!loadIndex(index, data));
+
+		// Empty file
+		data.clear();
+		TS_ASSERT(!loadIndex(index, data));
+		TS_ASSERT(!index.find("target.001", 1000, 1700000000));
+#endif
+	}
+};
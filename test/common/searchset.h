@@ -0,0 +1,122 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+/**
+ * Archive with one byte files, which counts how often it is asked for them.
+ */
+class TestArchive : public Common::Archive {
+public:
+	TestArchive(byte id, bool listable) : _id(id), _listable(listable), _lookups(0) {}
+
+	void addFile(const char *name) { _files.push_back(Common::Path(name)); }
+	int getLookups() const { return _lookups; }
+
+	bool hasFile(const Common::Path &path) const override {
+		++_lookups;
+		for (uint i = 0; i < _files.size(); ++i) {
+			if (Common::Path::IgnoreCaseAndMac_EqualsTo()(_files[i], path))
+				return true;
+		}
+		return false;
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		for (uint i = 0; i < _files.size(); ++i)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_files[i].toString(), this)));
+		return _files.size();
+	}
+
+	bool listMemberPaths(Common::Array<Common::Path> &list) const override {
+		if (!_listable)
+			return false;
+
+		list.push_back(_files);
+		return true;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return Common::ArchiveMemberPtr();
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path.toString(), this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		return new Common::MemoryReadStream(&_id, 1);
+	}
+
+private:
+	byte _id;
+	bool _listable;
+	mutable int _lookups;
+	Common::Array<Common::Path> _files;
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+	static int readId(const Common::SearchSet &set, const char *name) {
+		Common::SeekableReadStream *stream = set.createReadStreamForMember(Common::Path(name));
+		if (!stream)
+			return -1;
+
+		const int id = stream->readByte();
+		delete stream;
+		return id;
+	}
+
+public:
+	void test_priority() {
+		Common::SearchSet set;
+		TestArchive *high = new TestArchive(1, true);
+		TestArchive *plain = new TestArchive(2, false);
+		TestArchive *low = new TestArchive(3, true);
+		high->addFile("a");
+		plain->addFile("a");
+		plain->addFile("b");
+		low->addFile("a");
+		low->addFile("B");
+		low->addFile("c");
+		set.add("high", high, 2);
+		set.add("plain", plain, 1);
+		set.add("low", low, 0);
+
+		TS_ASSERT_EQUALS(readId(set, "A"), 1);
+		TS_ASSERT_EQUALS(readId(set, "b"), 2);
+		TS_ASSERT_EQUALS(readId(set, "C"), 3);
+		TS_ASSERT_EQUALS(readId(set, "d"), -1);
+		TS_ASSERT(set.hasFile(Common::Path("c")));
+		TS_ASSERT(!set.hasFile(Common::Path("d")));
+
+		// The archive which can't list its files is still asked first
+		set.setPriority("plain", 3);
+		TS_ASSERT_EQUALS(readId(set, "a"), 2);
+		TS_ASSERT_EQUALS(readId(set, "c"), 3);
+
+		set.remove("plain");
+		TS_ASSERT_EQUALS(readId(set, "b"), 3);
+	}
+
+	void test_skip_archives() {
+		Common::SearchSet set;
+		TestArchive *first = new TestArchive(1, true);
+		TestArchive *second = new TestArchive(2, true);
+		first->addFile("a");
+		second->addFile("b");
+		set.add("first", first, 1);
+		set.add("second", second, 0);
+
+		TS_ASSERT_EQUALS(readId(set, "b"), 2);
+		TS_ASSERT(!set.hasFile(Common::Path("c")));
+		TS_ASSERT_EQUALS(first->getLookups(), 0);
+		TS_ASSERT_EQUALS(second->getLookups(), 1);
+
+		// Archives added later are found too
+		TestArchive *third = new TestArchive(3, true);
+		third->addFile("c");
+		set.add("third", third, 2);
+		TS_ASSERT_EQUALS(readId(set, "c"), 3);
+		TS_ASSERT_EQUALS(readId(set, "a"), 1);
+	}
+};
@@ -0,0 +1,219 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/blit.h"
+#include "graphics/blit-intern.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class BlitTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kMaxWidth = 37,
+		kHeight = 3,
+		kPitchPadding = 8
+	};
+
+	uint32 _seed;
+
+	byte nextByte() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	static uint32 readPixel(const byte *src, uint bytesPerPixel) {
+		return bytesPerPixel == 2 ? *(const uint16 *)src : *(const uint32 *)src;
+	}
+
+	static void writePixel(byte *dst, uint bytesPerPixel, uint32 color) {
+		if (bytesPerPixel == 2)
+			*(uint16 *)dst = color;
+		else
+			*(uint32 *)dst = color;
+	}
+
+	/** Convert pixel by pixel, the way the generic code does. */
+	static void referenceBlit(byte *dst, const byte *src, uint dstPitch, uint srcPitch, uint w, uint h,
+							  const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt,
+							  bool hasKey, uint32 key) {
+		for (uint y = 0; y < h; ++y) {
+			for (uint x = 0; x < w; ++x) {
+				const uint32 color = readPixel(src + y * srcPitch + x * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel);
+				if (hasKey && color == key)
+					continue;
+
+				byte a, r, g, b;
+				srcFmt.colorToARGB(color, a, r, g, b);
+				writePixel(dst + y * dstPitch + x * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel, dstFmt.ARGBToColor(a, r, g, b));
+			}
+		}
+	}
+
+	void compareFormats(const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		static const uint kSrcPitch = (kMaxWidth + kPitchPadding) * 4;
+		static const uint kDstPitch = (kMaxWidth + kPitchPadding) * 4;
+		byte src[kSrcPitch * kHeight];
+		byte expected[kDstPitch * kHeight];
+		byte actual[kDstPitch * kHeight];
+
+		for (uint w = 0; w <= kMaxWidth; ++w) {
+			for (int hasKey = 0; hasKey < 2; ++hasKey) {
+				for (uint i = 0; i < sizeof(src); ++i)
+					src[i] = nextByte();
+				for (uint i = 0; i < sizeof(expected); ++i)
+					expected[i] = actual[i] = nextByte();
+
+				// Make sure some pixels match the key
+				const uint32 key = readPixel(src, srcFmt.bytesPerPixel);
+				writePixel(src + 5 * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel, key);
+
+				referenceBlit(expected, src, kDstPitch, kSrcPitch, w, kHeight, dstFmt, srcFmt, hasKey, key);
+				if (hasKey)
+					Graphics::crossKeyBlit(actual, src, kDstPitch, kSrcPitch, w, kHeight, dstFmt, srcFmt, key);
+				else
+					Graphics::crossBlit(actual, src, kDstPitch, kSrcPitch, w, kHeight, dstFmt, srcFmt);
+
+				TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+			}
+		}
+	}
+
+	template<typename SrcColor, typename DstColor, bool hasKey>
+	void compareRowKernel(Graphics::CrossBlitRowFunc convertRow, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		Graphics::PixelConversion conv;
+		TS_ASSERT(conv.init(dstFmt, srcFmt));
+
+		byte src[kMaxWidth * sizeof(SrcColor)];
+		byte expected[kMaxWidth * sizeof(DstColor)];
+		byte actual[kMaxWidth * sizeof(DstColor)];
+
+		for (uint w = 0; w <= kMaxWidth; ++w) {
+			for (uint i = 0; i < sizeof(src); ++i)
+				src[i] = nextByte();
+			for (uint i = 0; i < sizeof(expected); ++i)
+				expected[i] = actual[i] = nextByte();
+			const uint32 key = *(const SrcColor *)src;
+
+			Graphics::crossBlitRow<SrcColor, DstColor, hasKey>(expected, src, w, conv, key);
+			convertRow(actual, src, w, conv, key);
+			TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+		}
+	}
+
+	template<typename SrcColor, typename DstColor, bool hasKey>
+	void compareRowKernels(const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			compareRowKernel<SrcColor, DstColor, hasKey>(Graphics::crossBlitRowSSE2<SrcColor, DstColor, hasKey>, dstFmt, srcFmt);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+			compareRowKernel<SrcColor, DstColor, hasKey>(Graphics::crossBlitRowAVX2<SrcColor, DstColor, hasKey>, dstFmt, srcFmt);
+#endif
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			compareRowKernel<SrcColor, DstColor, hasKey>(Graphics::crossBlitRowNEON<SrcColor, DstColor, hasKey>, dstFmt, srcFmt);
+#endif
+#endif
+	}
+
+public:
+	void test_row_kernels() {
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb4444(2, 4, 4, 4, 4, 8, 4, 0, 12);
+		const Graphics::PixelFormat rgba8888(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const Graphics::PixelFormat abgr8888(4, 8, 8, 8, 8, 0, 8, 16, 24);
+
+		_seed = 4;
+		compareRowKernels<uint16, uint16, false>(argb4444, rgb565);
+		compareRowKernels<uint16, uint16, true>(rgb565, argb4444);
+		compareRowKernels<uint16, uint32, false>(rgba8888, rgb565);
+		compareRowKernels<uint16, uint32, true>(abgr8888, argb4444);
+		compareRowKernels<uint32, uint16, false>(rgb565, rgba8888);
+		compareRowKernels<uint32, uint16, true>(argb4444, abgr8888);
+		compareRowKernels<uint32, uint32, false>(abgr8888, rgba8888);
+		compareRowKernels<uint32, uint32, true>(rgba8888, abgr8888);
+	}
+
+	void test_cross_blit() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 8, 4, 0, 12),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		_seed = 1;
+		for (uint i = 0; i < ARRAYSIZE(formats); ++i) {
+			for (uint j = 0; j < ARRAYSIZE(formats); ++j) {
+				if (i != j)
+					compareFormats(formats[i], formats[j]);
+			}
+		}
+	}
+
+	void test_cross_blit_in_place() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+		const Graphics::PixelFormat srcFmt(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat dstFmt(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const uint w = 29, h = 4;
+
+		uint16 src[w * h];
+		uint32 buffer[w * h];
+		_seed = 2;
+		for (uint i = 0; i < ARRAYSIZE(src); ++i)
+			src[i] = nextByte() | (nextByte() << 8);
+		memcpy(buffer, src, sizeof(src));
+
+		Graphics::crossBlit((byte *)buffer, (const byte *)buffer, w * 4, w * 2, w, h, dstFmt, srcFmt);
+
+		for (uint i = 0; i < ARRAYSIZE(src); ++i) {
+			byte a, r, g, b;
+			srcFmt.colorToARGB(src[i], a, r, g, b);
+			TS_ASSERT_EQUALS(buffer[i], dstFmt.ARGBToColor(a, r, g, b));
+		}
+	}
+
+	void test_cross_blit_map() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+#endif
+		const uint w = 27, h = 3;
+		uint32 map[256];
+		byte src[w * h];
+		uint32 buffer[w * h];
+
+		_seed = 3;
+		for (uint i = 0; i < ARRAYSIZE(map); ++i)
+			map[i] = nextByte() | (nextByte() << 8) | (nextByte() << 16) | (nextByte() << 24);
+		for (uint i = 0; i < ARRAYSIZE(src); ++i)
+			src[i] = nextByte();
+
+		// In place, to 32 bpp
+		memcpy(buffer, src, sizeof(src));
+		Graphics::crossBlitMap((byte *)buffer, (const byte *)buffer, w * 4, w, w, h, 4, map);
+		for (uint i = 0; i < ARRAYSIZE(src); ++i)
+			TS_ASSERT_EQUALS(buffer[i], map[src[i]]);
+
+		// With a key, to 16 bpp
+		uint16 dst16[w * h];
+		for (uint i = 0; i < ARRAYSIZE(dst16); ++i)
+			dst16[i] = 0x1234;
+		const byte key = src[3];
+		Graphics::crossKeyBlitMap((byte *)dst16, src, w * 2, w, w, h, 2, map, key);
+		for (uint i = 0; i < ARRAYSIZE(src); ++i)
+			TS_ASSERT_EQUALS(dst16[i], src[i] == key ? 0x1234 : (uint16)map[src[i]]);
+	}
+};
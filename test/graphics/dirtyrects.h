@@ -0,0 +1,73 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/dirtyrects.h"
+
+class DirtyRectListTestSuite : public CxxTest::TestSuite {
+public:
+	void test_merge_adjacent() {
+		Graphics::DirtyRectList list(10);
+
+		list.add(Common::Rect(0, 0, 10, 10));
+		list.add(Common::Rect(10, 0, 20, 10));
+		TS_ASSERT_EQUALS(list.size(), 1u);
+		TS_ASSERT_EQUALS(list[0], Common::Rect(0, 0, 20, 10));
+
+		list.add(Common::Rect(5, 5, 15, 8));
+		TS_ASSERT_EQUALS(list.size(), 1u);
+		TS_ASSERT_EQUALS(list.getArea(), 200u);
+		TS_ASSERT_EQUALS(list.getAddedArea(), 230u);
+	}
+
+	void test_keep_apart() {
+		Graphics::DirtyRectList list(10);
+
+		// A cursor and a HUD in opposite corners
+		list.add(Common::Rect(0, 0, 16, 16));
+		list.add(Common::Rect(600, 440, 640, 480));
+		TS_ASSERT_EQUALS(list.size(), 2u);
+		TS_ASSERT_EQUALS(list.getArea(), 16u * 16 + 40 * 40);
+
+		// A rect between them which joins them all would cost more
+		list.add(Common::Rect(300, 200, 310, 210));
+		TS_ASSERT_EQUALS(list.size(), 3u);
+
+		list.clear();
+		TS_ASSERT(list.empty());
+		TS_ASSERT_EQUALS(list.getAddedArea(), 0u);
+	}
+
+	void test_halo() {
+		// Close rects are cheaper to scale together when the scaler reads
+		// a wide border around each of them.
+		Graphics::DirtyRectList list(10, 0, 0);
+		list.add(Common::Rect(0, 0, 10, 10));
+		list.add(Common::Rect(12, 0, 22, 10));
+		TS_ASSERT_EQUALS(list.size(), 2u);
+
+		Graphics::DirtyRectList haloList(10, 4, 0);
+		haloList.add(Common::Rect(0, 0, 10, 10));
+		haloList.add(Common::Rect(12, 0, 22, 10));
+		TS_ASSERT_EQUALS(haloList.size(), 1u);
+		TS_ASSERT_EQUALS(haloList[0], Common::Rect(0, 0, 22, 10));
+	}
+
+	void test_full() {
+		Graphics::DirtyRectList list(4, 0, 0);
+
+		// Sprites spread over the screen, more than the list can hold
+		for (int i = 0; i < 16; ++i) {
+			const int x = (i % 4) * 160;
+			const int y = (i / 4) * 120;
+			const Common::Rect &merged = list.add(Common::Rect(x, y, x + 8, y + 8));
+			TS_ASSERT(merged.contains(Common::Rect(x, y, x + 8, y + 8)));
+			TS_ASSERT_LESS_THAN_EQUALS(list.size(), 4u);
+		}
+
+		// The sprites of a column end up together, which is far less than
+		// the whole screen
+		TS_ASSERT_EQUALS(list.size(), 4u);
+		TS_ASSERT_EQUALS(list.getArea(), 4u * 8 * 368);
+		for (uint i = 0; i < list.size(); ++i)
+			TS_ASSERT_EQUALS(list[i].width(), 8);
+	}
+};
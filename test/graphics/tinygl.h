@@ -0,0 +1,387 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#ifdef USE_TINYGL
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/zspan.h"
+#endif
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class TinyGLTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kWidth = 96,
+		kHeight = 72,
+		kTextureSize = 8,
+		kMaxSpan = 37
+	};
+
+	uint32 _seed;
+
+	float nextFloat(float min, float max) {
+		_seed = _seed * 1103515245 + 12345;
+		return min + (max - min) * ((_seed >> 16) & 0x7FFF) / 32767.0f;
+	}
+
+	uint32 nextUint() {
+		_seed = _seed * 1103515245 + 12345;
+		const uint32 hi = _seed >> 16;
+		_seed = _seed * 1103515245 + 12345;
+		return (hi << 16) | (_seed >> 16);
+	}
+
+#ifdef USE_TINYGL
+	void randomVertex() {
+		tglColor4f(nextFloat(0, 1), nextFloat(0, 1), nextFloat(0, 1), nextFloat(0.3f, 1));
+		tglTexCoord2f(nextFloat(0, 2), nextFloat(0, 2));
+		tglVertex3f(nextFloat(-1.3f, 1.3f), nextFloat(-1.3f, 1.3f), nextFloat(-1, 1));
+	}
+
+	/**
+	 * Draw a bit of everything: clears, shaded, blended and textured
+	 * primitives of all kinds crossing many tiles, and a blit in between.
+	 */
+	void drawScene(const Graphics::PixelFormat &format) {
+		_seed = 1;
+
+		byte texels[kTextureSize * kTextureSize * 4];
+		for (uint i = 0; i < sizeof(texels); ++i)
+			texels[i] = (byte)(nextFloat(0, 255));
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, TGL_NEAREST);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAG_FILTER, TGL_NEAREST);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, kTextureSize, kTextureSize, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texels);
+
+		Graphics::Surface sprite;
+		sprite.create(20, 30, format);
+		for (int y = 0; y < sprite.h; ++y) {
+			for (int x = 0; x < sprite.w; ++x)
+				sprite.setPixel(x, y, format.RGBToColor(x * 12, y * 8, 200));
+		}
+		TinyGL::BlitImage *image = tglGenBlitImage();
+		tglUploadBlitImage(image, sprite, 0, false);
+		sprite.free();
+
+		tglClearColor(0.1f, 0.2f, 0.3f, 1.0f);
+		tglClearDepth(1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglEnable(TGL_DEPTH_TEST);
+
+		static const TGLenum modes[] = {
+			TGL_TRIANGLES, TGL_TRIANGLE_STRIP, TGL_TRIANGLE_FAN, TGL_QUADS, TGL_POLYGON, TGL_LINES, TGL_LINE_LOOP
+		};
+		for (uint i = 0; i < ARRAYSIZE(modes); ++i) {
+			tglShadeModel(i & 1 ? TGL_FLAT : TGL_SMOOTH);
+			if (i & 2) {
+				tglEnable(TGL_BLEND);
+				tglBlendFunc(TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA);
+			} else {
+				tglDisable(TGL_BLEND);
+			}
+			if (i == 3 || i == 4)
+				tglEnable(TGL_TEXTURE_2D);
+			else
+				tglDisable(TGL_TEXTURE_2D);
+
+			// Enough vertices for whole primitives only
+			const int count = (modes[i] == TGL_TRIANGLES || modes[i] == TGL_TRIANGLE_FAN) ? 9 : 8;
+			tglBegin(modes[i]);
+			for (int v = 0; v < count; ++v)
+				randomVertex();
+			tglEnd();
+
+			if (i == 2)
+				tglBlit(image, 40, 20);
+		}
+
+		// Clearing the depth buffer only, then drawing over everything
+		tglClear(TGL_DEPTH_BUFFER_BIT);
+		tglDisable(TGL_BLEND);
+		tglBegin(TGL_TRIANGLES);
+		for (int v = 0; v < 12; ++v)
+			randomVertex();
+		tglEnd();
+
+		tglDeleteBlitImage(image);
+		tglDeleteTextures(1, &texture);
+	}
+
+	Graphics::Surface *render(bool dirtyRects, int threads) {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, format, 256, true, dirtyRects);
+		TinyGL::setRenderThreads(threads);
+
+		drawScene(format);
+		TinyGL::presentBuffer();
+
+		Graphics::Surface *surface = TinyGL::copyFromFrameBuffer(format);
+		TinyGL::destroyContext(context);
+		return surface;
+	}
+
+	/**
+	 * Draw random spans with a kernel and with the reference code, over
+	 * depths which are partly equal to the ones of the spans.
+	 */
+	template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+	void compareShadeSpan(TinyGL::ShadeSpanFunc shade, const TinyGL::SpanState &state) {
+		uint32 expectedPixels[kMaxSpan], actualPixels[kMaxSpan];
+		uint expectedDepths[kMaxSpan], actualDepths[kMaxSpan];
+
+		for (int count = 0; count <= kMaxSpan; ++count) {
+			TinyGL::Span span;
+			span.count = count;
+			span.z = (1 << 24) + nextUint() % 0xFC000000;
+			span.dzdx = (int)(nextUint() % 0x20000) - 0x10000;
+			span.r = nextUint() & 0xFFFFFF;
+			span.g = nextUint() & 0xFFFFFF;
+			span.b = nextUint() & 0xFFFFFF;
+			span.a = nextUint() & 0xFFFFFF;
+			span.drdx = (int)(nextUint() % 0x2000) - 0x1000;
+			span.dgdx = (int)(nextUint() % 0x2000) - 0x1000;
+			span.dbdx = (int)(nextUint() % 0x2000) - 0x1000;
+			span.dadx = (int)(nextUint() % 0x2000) - 0x1000;
+
+			for (int i = 0; i < kMaxSpan; ++i) {
+				const uint z = span.z + i * span.dzdx;
+				expectedPixels[i] = actualPixels[i] = nextUint();
+				expectedDepths[i] = actualDepths[i] = z + (int)(nextUint() % 3) - 1;
+			}
+
+			span.pixels = expectedPixels;
+			span.depths = expectedDepths;
+			TinyGL::shadeSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(span, state);
+			span.pixels = actualPixels;
+			span.depths = actualDepths;
+			shade(span, state);
+
+			TS_ASSERT_EQUALS(memcmp(expectedPixels, actualPixels, sizeof(expectedPixels)), 0);
+			TS_ASSERT_EQUALS(memcmp(expectedDepths, actualDepths, sizeof(expectedDepths)), 0);
+		}
+	}
+
+	/**
+	 * Likewise for textured spans, with perspective correct texture
+	 * coordinates, some pixels skipped at the start and all wrap modes.
+	 */
+	template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+	void compareTextureSpan(TinyGL::TextureSpanFunc texture, const TinyGL::SpanState &state, const TinyGL::TexelBuffer *texels) {
+		static const uint wrapModes[] = { TGL_REPEAT, TGL_CLAMP_TO_EDGE, TGL_MIRRORED_REPEAT };
+		uint32 expectedPixels[kMaxSpan], actualPixels[kMaxSpan];
+		uint expectedDepths[kMaxSpan], actualDepths[kMaxSpan];
+
+		for (int count = 0; count <= kMaxSpan; ++count) {
+			TinyGL::TextureSpan span;
+			TinyGL::Span &row = span.span;
+			row.count = count;
+			row.z = (1 << 24) + nextUint() % 0xFC000000;
+			row.dzdx = (int)(nextUint() % 0x20000) - 0x10000;
+			row.r = nextUint() & 0xFFFFFF;
+			row.g = nextUint() & 0xFFFFFF;
+			row.b = nextUint() & 0xFFFFFF;
+			row.a = nextUint() & 0xFFFFFF;
+			row.drdx = (int)(nextUint() % 0x2000) - 0x1000;
+			row.dgdx = (int)(nextUint() % 0x2000) - 0x1000;
+			row.dbdx = (int)(nextUint() % 0x2000) - 0x1000;
+			row.dadx = (int)(nextUint() % 0x2000) - 0x1000;
+
+			span.skip = count ? nextUint() % (count + 1) : 0;
+			span.texture = texels;
+			span.wrapS = wrapModes[nextUint() % ARRAYSIZE(wrapModes)];
+			span.wrapT = wrapModes[nextUint() % ARRAYSIZE(wrapModes)];
+			span.fz = (float)row.z;
+			span.zinv = (float)(1.0 / span.fz);
+			span.fdzdx = (float)row.dzdx;
+			span.sz = nextFloat(-0x100000, 0x100000) * span.fz;
+			span.tz = nextFloat(-0x100000, 0x100000) * span.fz;
+			span.dszdx = nextFloat(-0x4000, 0x4000) * span.fz;
+			span.dtzdx = nextFloat(-0x4000, 0x4000) * span.fz;
+			span.ndszdx = TinyGL::TextureSpan::kBlockSize * span.dszdx;
+			span.ndtzdx = TinyGL::TextureSpan::kBlockSize * span.dtzdx;
+			span.fndzdx = TinyGL::TextureSpan::kBlockSize * span.fdzdx;
+
+			for (int i = 0; i < kMaxSpan; ++i) {
+				const uint z = row.z + i * row.dzdx;
+				expectedPixels[i] = actualPixels[i] = nextUint();
+				expectedDepths[i] = actualDepths[i] = z + (int)(nextUint() % 3) - 1;
+			}
+
+			row.pixels = expectedPixels;
+			row.depths = expectedDepths;
+			TinyGL::textureSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(span, state);
+			row.pixels = actualPixels;
+			row.depths = actualDepths;
+			texture(span, state);
+
+			TS_ASSERT_EQUALS(memcmp(expectedPixels, actualPixels, sizeof(expectedPixels)), 0);
+			TS_ASSERT_EQUALS(memcmp(expectedDepths, actualDepths, sizeof(expectedDepths)), 0);
+		}
+	}
+
+	template <bool kDepthTestEnabled>
+	void compareDepthSpan(TinyGL::DepthSpanFunc depth, const TinyGL::SpanState &state) {
+		uint expected[kMaxSpan], actual[kMaxSpan];
+
+		for (int count = 0; count <= kMaxSpan; ++count) {
+			TinyGL::Span span;
+			span.pixels = nullptr;
+			span.count = count;
+			span.z = nextUint();
+			span.dzdx = (int)(nextUint() % 0x20000) - 0x10000;
+			for (int i = 0; i < kMaxSpan; ++i)
+				expected[i] = actual[i] = span.z + i * span.dzdx + (int)(nextUint() % 3) - 1;
+
+			span.depths = expected;
+			TinyGL::depthSpan<kDepthTestEnabled>(span, state);
+			span.depths = actual;
+			depth(span, state);
+			TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+		}
+	}
+
+	template <bool kSmoothMode, bool kBlendingEnabled, bool kDepthWrite, bool kDepthTestEnabled>
+	void compareSpanKernels(const TinyGL::SpanState &state) {
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+			compareShadeSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(
+				TinyGL::shadeSpanSSE2<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>, state);
+			for (uint i = 0; i < ARRAYSIZE(_texels); ++i)
+				compareTextureSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(
+					TinyGL::textureSpanSSE2<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>, state, _texels[i]);
+		}
+#endif
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+			compareShadeSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(
+				TinyGL::shadeSpanNEON<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>, state);
+			for (uint i = 0; i < ARRAYSIZE(_texels); ++i)
+				compareTextureSpan<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>(
+					TinyGL::textureSpanNEON<kSmoothMode, kBlendingEnabled, kDepthWrite, kDepthTestEnabled>, state, _texels[i]);
+		}
+#endif
+	}
+
+	template <bool kSmoothMode, bool kBlendingEnabled>
+	void compareSpanKernels(const TinyGL::SpanState &state) {
+		compareSpanKernels<kSmoothMode, kBlendingEnabled, false, false>(state);
+		compareSpanKernels<kSmoothMode, kBlendingEnabled, false, true>(state);
+		compareSpanKernels<kSmoothMode, kBlendingEnabled, true, false>(state);
+		compareSpanKernels<kSmoothMode, kBlendingEnabled, true, true>(state);
+	}
+
+	/** Nearest and bilinear textures for the textured span kernels. */
+	TinyGL::TexelBuffer *_texels[2];
+
+	template <bool kDepthTestEnabled>
+	void compareDepthSpanKernels(const TinyGL::SpanState &state) {
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			compareDepthSpan<kDepthTestEnabled>(TinyGL::depthSpanSSE2<kDepthTestEnabled>, state);
+#endif
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			compareDepthSpan<kDepthTestEnabled>(TinyGL::depthSpanNEON<kDepthTestEnabled>, state);
+#endif
+	}
+#endif
+
+public:
+	void test_tiles() {
+#if defined(USE_TINYGL) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		for (int dirtyRects = 0; dirtyRects < 2; ++dirtyRects) {
+			Graphics::Surface *expected = render(dirtyRects, 1);
+			// More threads than tiles of some draw calls
+			for (int threads = 2; threads <= 7; threads += 5) {
+				Graphics::Surface *actual = render(dirtyRects, threads);
+				TS_ASSERT_EQUALS(memcmp(expected->getPixels(), actual->getPixels(), expected->pitch * kHeight), 0);
+				actual->free();
+				delete actual;
+			}
+			expected->free();
+			delete expected;
+		}
+#endif
+	}
+
+	void test_span_kernels() {
+#if defined(USE_TINYGL) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+		static const int factors[][2] = {
+			{ TGL_SRC_ALPHA, TGL_ONE_MINUS_SRC_ALPHA },
+			{ TGL_ONE, TGL_ONE },
+			{ TGL_DST_COLOR, TGL_ZERO },
+			{ TGL_ZERO, TGL_DST_COLOR },
+			{ TGL_ONE_MINUS_DST_COLOR, TGL_ONE_MINUS_DST_ALPHA },
+			{ TGL_DST_ALPHA, TGL_ONE_MINUS_DST_COLOR },
+			{ TGL_ONE_MINUS_DST_ALPHA, TGL_DST_ALPHA },
+			{ TGL_SRC_ALPHA_SATURATE, TGL_SRC_ALPHA }
+		};
+
+		_seed = 2;
+		const Graphics::PixelFormat texelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		byte texels[kTextureSize * kTextureSize * 4];
+		for (uint i = 0; i < sizeof(texels); ++i)
+			texels[i] = (byte)nextUint();
+		_texels[0] = TinyGL::createNearestTexelBuffer(texels, texelFormat, TGL_RGBA, TGL_UNSIGNED_BYTE, kTextureSize, kTextureSize, kTextureSize);
+		_texels[1] = TinyGL::createBilinearTexelBuffer(texels, texelFormat, TGL_RGBA, TGL_UNSIGNED_BYTE, kTextureSize, kTextureSize, kTextureSize);
+
+		for (uint i = 0; i < ARRAYSIZE(formats); ++i) {
+			TinyGL::SpanState state;
+			state.alphaLess = state.alphaEqual = state.alphaGreater = true;
+			state.alphaRef = 0;
+			state.aShift = formats[i].aShift;
+			state.rShift = formats[i].rShift;
+			state.gShift = formats[i].gShift;
+			state.bShift = formats[i].bShift;
+			state.alphaMask = formats[i].aBits() ? 0xFF : 0;
+
+			// Every depth function
+			for (int depthFunc = 0; depthFunc < 8; ++depthFunc) {
+				state.depthLess = depthFunc & 1;
+				state.depthEqual = depthFunc & 2;
+				state.depthGreater = depthFunc & 4;
+
+				for (uint j = 0; j < ARRAYSIZE(factors); ++j) {
+					state.srcFactor = factors[j][0];
+					state.dstFactor = factors[j][1];
+					compareSpanKernels<false, true>(state);
+					compareSpanKernels<true, true>(state);
+				}
+				compareSpanKernels<false, false>(state);
+				compareSpanKernels<true, false>(state);
+				compareDepthSpanKernels<false>(state);
+				compareDepthSpanKernels<true>(state);
+			}
+
+			// Every alpha function, which only textured spans support
+			state.depthLess = state.depthEqual = true;
+			state.depthGreater = false;
+			state.srcFactor = TGL_SRC_ALPHA;
+			state.dstFactor = TGL_ONE_MINUS_SRC_ALPHA;
+			for (int alphaFunc = 0; alphaFunc < 8; ++alphaFunc) {
+				state.alphaLess = alphaFunc & 1;
+				state.alphaEqual = alphaFunc & 2;
+				state.alphaGreater = alphaFunc & 4;
+				state.alphaRef = nextUint() & 0xFF;
+				compareSpanKernels<true, true>(state);
+				compareSpanKernels<false, false>(state);
+			}
+		}
+
+		delete _texels[0];
+		delete _texels[1];
+#endif
+	}
+};
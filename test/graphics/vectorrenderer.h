@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/VectorRendererSpec-intern.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class VectorRendererTestSuite : public CxxTest::TestSuite
+{
+private:
+	enum {
+		kMaxCount = 41,
+		kPadding = 4
+	};
+
+	uint32 _seed;
+
+	uint32 nextPixel() {
+		_seed = _seed * 1103515245 + 12345;
+		const uint32 low = _seed >> 16;
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed & 0xFFFF0000) | low;
+	}
+
+	/**
+	 * Run a kernel on spans of every length up to kMaxCount, starting at
+	 * every position of a vector, and check that it writes exactly what
+	 * the reference implementation does.
+	 */
+	template<typename PixelType, typename Kernel, typename Reference>
+	void compareSpans(Kernel kernel, Reference reference) {
+		PixelType expected[kMaxCount + 2 * kPadding];
+		PixelType actual[kMaxCount + 2 * kPadding];
+
+		for (uint count = 0; count <= kMaxCount; ++count) {
+			for (uint offset = 0; offset < kPadding; ++offset) {
+				for (uint i = 0; i < ARRAYSIZE(expected); ++i)
+					expected[i] = actual[i] = (PixelType)nextPixel();
+
+				reference(expected + offset, count);
+				kernel(actual + offset, count);
+				TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+			}
+		}
+	}
+
+	template<typename PixelType>
+	void compareFill(typename Graphics::SpanFillFunc<PixelType>::Type spanFill) {
+		// Solid and two color fills
+		for (int solid = 0; solid < 2; ++solid) {
+			const PixelType first = (PixelType)nextPixel();
+			const PixelType second = solid ? first : (PixelType)nextPixel();
+			compareSpans<PixelType>(
+				[&](PixelType *dst, uint count) { spanFill(dst, count, first, second); },
+				[&](PixelType *dst, uint count) { Graphics::spanFill<PixelType>(dst, count, first, second); });
+		}
+	}
+
+	template<typename PixelType>
+	void compareBlend(typename Graphics::SpanBlendFunc<PixelType>::Type spanBlend, const Graphics::PixelFormat &format) {
+		Graphics::SpanBlendFormat blendFormat;
+		TS_ASSERT(blendFormat.init(format));
+
+		const uint alphas[] = { 0, 1, 64, 127, 128, 200, 254, 255 };
+		for (uint i = 0; i < ARRAYSIZE(alphas); ++i) {
+			const uint alpha = alphas[i];
+			const PixelType color = (PixelType)nextPixel();
+			compareSpans<PixelType>(
+				[&](PixelType *dst, uint count) { spanBlend(dst, count, color, alpha, blendFormat); },
+				[&](PixelType *dst, uint count) { Graphics::spanBlend<PixelType>(dst, count, color, alpha, blendFormat); });
+		}
+	}
+
+	template<typename PixelType>
+	void compareKernels(typename Graphics::SpanFillFunc<PixelType>::Type spanFill,
+						typename Graphics::SpanBlendFunc<PixelType>::Type spanBlend,
+						const Graphics::PixelFormat *formats, uint numFormats) {
+		compareFill<PixelType>(spanFill);
+		for (uint i = 0; i < numFormats; ++i)
+			compareBlend<PixelType>(spanBlend, formats[i]);
+	}
+
+public:
+	void test_span_kernels_16() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 8, 4, 0, 12),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0)
+		};
+
+		_seed = 1;
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			compareKernels<uint16>(Graphics::spanFillSSE2, Graphics::spanBlendSSE2, formats, ARRAYSIZE(formats));
+#endif
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			compareKernels<uint16>(Graphics::spanFillNEON, Graphics::spanBlendNEON, formats, ARRAYSIZE(formats));
+#endif
+#endif
+	}
+
+	void test_span_kernels_32() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		_seed = 2;
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			compareKernels<uint32>(Graphics::spanFillSSE2, Graphics::spanBlendSSE2, formats, ARRAYSIZE(formats));
+#endif
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			compareKernels<uint32>(Graphics::spanFillNEON, Graphics::spanBlendNEON, formats, ARRAYSIZE(formats));
+#endif
+#endif
+	}
+
+	void test_span_blend_format() {
+		Graphics::SpanBlendFormat blendFormat;
+		// 32 bpp formats need whole byte channels
+		TS_ASSERT(blendFormat.init(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)));
+		TS_ASSERT(!blendFormat.init(Graphics::PixelFormat(4, 8, 8, 8, 8, 20, 12, 4, 0)));
+		TS_ASSERT(!blendFormat.init(Graphics::PixelFormat(4, 5, 6, 5, 0, 11, 5, 0, 0)));
+		TS_ASSERT(blendFormat.init(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0)));
+		TS_ASSERT(!blendFormat.init(Graphics::PixelFormat::createFormatCLUT8()));
+	}
+};
@@ -75,6 +75,9 @@ public:
 protected:
 	Common::QuickTimeParser::SampleDesc *readSampleDesc(Common::QuickTimeParser::Track *track, uint32 format, uint32 descSize);
 
+	// Audio is buffered from the same stream after every frame
+	bool canDecodeAhead() const { return false; }
+
 private:
 	void init();
 
@@ -24,14 +24,107 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h" // for kMaxChannelVolume
 
+#include "common/atomic.h"
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/jobs.h"
+#include "common/rect.h"
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+/**
+ * Stands in for the video track in _tracks while frames are decoded ahead.
+ *
+ * The wrapped track is ahead of playback, so this reports the state of the
+ * track as it was when the frame handed out last was decoded.
+ */
+class VideoDecoder::FrameAheadTrack : public VideoTrack {
+public:
+	FrameAheadTrack(VideoDecoder *decoder, VideoTrack *track, uint count);
+	~FrameAheadTrack() override;
+
+	VideoTrack *getTrack() const { return _track; }
+	uint getFramesAhead() const { return _count; }
+
+	/** Return whether some frames were decoded but not handed out yet. */
+	bool hasFramesAhead() const { return _ready.load() != 0; }
+
+	/** Wait for the job decoding ahead to finish its current frame. */
+	void stopDecoding();
+
+	/** Drop the frames decoded ahead, after the wrapped track moved. */
+	void flush();
+
+	bool endOfTrack() const override { return _live ? _track->endOfTrack() : _endOfTrack; }
+	bool isRewindable() const override { return _track->isRewindable(); }
+	bool rewind() override;
+	bool isSeekable() const override { return _track->isSeekable(); }
+	bool seek(const Audio::Timestamp &time) override;
+	Audio::Timestamp getDuration() const override { return _track->getDuration(); }
+
+	uint16 getWidth() const override { return _track->getWidth(); }
+	uint16 getHeight() const override { return _track->getHeight(); }
+	Graphics::PixelFormat getPixelFormat() const override { return _track->getPixelFormat(); }
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format) override { return _track->setOutputPixelFormat(format); }
+	int getCurFrame() const override { return _live ? _track->getCurFrame() : _curFrame; }
+	int getFrameCount() const override { return _track->getFrameCount(); }
+	uint32 getNextFrameStartTime() const override { return _live ? _track->getNextFrameStartTime() : _nextFrameStartTime; }
+	const Graphics::Surface *decodeNextFrame() override;
+	const byte *getPalette() const override { return _palette; }
+	bool hasDirtyPalette() const override { return _dirtyPalette; }
+	Audio::Timestamp getFrameTime(uint frame) const override { return _track->getFrameTime(frame); }
+	bool canDither() const override { return _track->canDither(); }
+	void setDither(const byte *palette) override { _track->setDither(palette); }
+
+protected:
+	void pauseIntern(bool shouldPause) override;
+
+private:
+	struct Frame {
+		Graphics::Surface surface;
+		bool valid;
+		int curFrame;
+		uint32 nextFrameStartTime;
+		bool endOfTrack;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+	};
+
+	/** Decode frames until the ring is full. Runs as a job. */
+	void decodeAhead();
+	/** Decode one frame into the ring. */
+	void decodeFrame();
+	void startDecoding();
+
+	VideoDecoder *_decoder;
+	VideoTrack *_track;
+	uint _count;
+
+	// The frame handed out last, followed by up to _count decoded frames
+	Frame *_frames;
+	uint _shown;
+	uint _next;
+	Common::Atomic<uint32> _ready;
+	Common::Atomic<uint32> _stop;
+	Common::JobGroup _group;
+
+	// Whether nothing was decoded ahead since the last flush, in which case
+	// the wrapped track has the state to report. Subclasses may move it
+	// by themselves after seeking.
+	bool _live;
+
+	// State of the track after decoding the frame handed out last
+	int _curFrame;
+	uint32 _nextFrameStartTime;
+	bool _endOfTrack;
+	bool _dirtyPalette;
+	byte _palette[256 * 3];
+};
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -46,6 +139,7 @@ VideoDecoder::VideoDecoder() {
 	_endTime = 0;
 	_endTimeSet = false;
 	_nextVideoTrack = 0;
+	_frameAheadTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
@@ -55,6 +149,8 @@ void VideoDecoder::close() {
 	if (isPlaying())
 		stop();
 
+	stopFramesAhead(false);
+
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		delete *it;
 
@@ -206,7 +302,9 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
-	readNextPacket();
+	// When decoding ahead, the packets are read along with the frames
+	if (!_frameAheadTrack)
+		readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
 	// any frame available for us to display.
@@ -231,6 +329,10 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// Frames are only decoded ahead going forward
+	if (reverse)
+		stopFramesAhead(true);
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -341,6 +443,9 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	if (_frameAheadTrack)
+		_frameAheadTrack->stopDecoding();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -375,12 +480,20 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	if (_frameAheadTrack)
+		_frameAheadTrack->stopDecoding();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
 
 	// Do the actual seeking
-	if (!seekIntern(time))
+	bool result = seekIntern(time);
+
+	if (_frameAheadTrack)
+		_frameAheadTrack->flush();
+
+	if (!result)
 		return false;
 
 	// Seek any external track too
@@ -562,6 +675,69 @@ bool VideoDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
 	return result;
 }
 
+bool VideoDecoder::setFramesAhead(uint count) {
+	if (count == getFramesAhead())
+		return true;
+
+	stopFramesAhead(true);
+
+	if (!count)
+		return true;
+
+	// When jobs run serially, this would only add copies
+	if (JobMan.getThreadCount() < 2 || !canDecodeAhead())
+		return false;
+
+	uint index = 0;
+	VideoTrack *track = 0;
+
+	for (uint i = 0; i < _tracks.size(); i++) {
+		if (_tracks[i]->getTrackType() == Track::kTrackTypeVideo) {
+			if (track)
+				return false;
+
+			track = (VideoTrack *)_tracks[i];
+			index = i;
+		}
+	}
+
+	if (!track || track->isReversed())
+		return false;
+
+	_frameAheadTrack = new FrameAheadTrack(this, track, count);
+	_tracks[index] = _frameAheadTrack;
+	findNextVideoTrack();
+	return true;
+}
+
+uint VideoDecoder::getFramesAhead() const {
+	return _frameAheadTrack ? _frameAheadTrack->getFramesAhead() : 0;
+}
+
+void VideoDecoder::stopFramesAhead(bool keepFrame) {
+	if (!_frameAheadTrack)
+		return;
+
+	FrameAheadTrack *frameAheadTrack = _frameAheadTrack;
+	_frameAheadTrack = 0;
+
+	frameAheadTrack->stopDecoding();
+	bool skipped = frameAheadTrack->hasFramesAhead();
+	int curFrame = frameAheadTrack->getCurFrame();
+
+	for (uint i = 0; i < _tracks.size(); i++)
+		if (_tracks[i] == frameAheadTrack)
+			_tracks[i] = frameAheadTrack->getTrack();
+
+	delete frameAheadTrack;
+	findNextVideoTrack();
+
+	// The track went past the frame handed out last, so go back to the
+	// frame after it
+	if (keepFrame && skipped && isSeekable())
+		seekToFrame(curFrame + 1);
+}
+
 VideoDecoder::Track::Track() {
 	_paused = false;
 }
@@ -631,6 +807,140 @@ Audio::Timestamp VideoDecoder::FixedRateVideoTrack::getDuration() const {
 	return getFrameTime(getFrameCount());
 }
 
+VideoDecoder::FrameAheadTrack::FrameAheadTrack(VideoDecoder *decoder, VideoTrack *track, uint count) :
+		_decoder(decoder), _track(track), _count(count), _shown(0), _next(1), _ready(0), _stop(0),
+		_live(true), _curFrame(-1), _nextFrameStartTime(0), _endOfTrack(false), _dirtyPalette(false) {
+	memset(_palette, 0, sizeof(_palette));
+
+	// Allocate the surfaces now, so that decoding does not have to
+	_frames = new Frame[_count + 1];
+	for (uint i = 0; i <= _count; i++) {
+		if (track->getWidth() && track->getHeight())
+			_frames[i].surface.create(track->getWidth(), track->getHeight(), track->getPixelFormat());
+		_frames[i].valid = false;
+	}
+
+	if (track->isPaused())
+		pause(true);
+}
+
+VideoDecoder::FrameAheadTrack::~FrameAheadTrack() {
+	stopDecoding();
+
+	for (uint i = 0; i <= _count; i++)
+		_frames[i].surface.free();
+	delete[] _frames;
+}
+
+void VideoDecoder::FrameAheadTrack::stopDecoding() {
+	_stop.store(1);
+	JobMan.wait(_group);
+	_stop.store(0);
+}
+
+void VideoDecoder::FrameAheadTrack::flush() {
+	stopDecoding();
+
+	_ready.store(0);
+	_next = (_shown + 1) % (_count + 1);
+	_live = true;
+	_dirtyPalette = false;
+}
+
+bool VideoDecoder::FrameAheadTrack::rewind() {
+	stopDecoding();
+	bool result = _track->rewind();
+	flush();
+	return result;
+}
+
+bool VideoDecoder::FrameAheadTrack::seek(const Audio::Timestamp &time) {
+	stopDecoding();
+	bool result = _track->seek(time);
+	flush();
+	return result;
+}
+
+void VideoDecoder::FrameAheadTrack::pauseIntern(bool shouldPause) {
+	stopDecoding();
+	_track->pause(shouldPause);
+}
+
+const Graphics::Surface *VideoDecoder::FrameAheadTrack::decodeNextFrame() {
+	if (!_ready.load()) {
+		// Caught up with the job, if it is still running: let it finish
+		// the frame it is on
+		stopDecoding();
+
+		if (!_ready.load()) {
+			if (_track->endOfTrack())
+				return 0;
+
+			decodeFrame();
+		}
+	}
+
+	_shown = (_shown + 1) % (_count + 1);
+	const Frame &frame = _frames[_shown];
+
+	_live = false;
+	_curFrame = frame.curFrame;
+	_nextFrameStartTime = frame.nextFrameStartTime;
+	_endOfTrack = frame.endOfTrack;
+	_dirtyPalette = frame.dirtyPalette;
+	if (_dirtyPalette)
+		memcpy(_palette, frame.palette, sizeof(_palette));
+
+	// Only now can the job reuse the frame handed out before
+	_ready.fetchSub(1);
+	startDecoding();
+
+	return frame.valid ? &frame.surface : 0;
+}
+
+void VideoDecoder::FrameAheadTrack::startDecoding() {
+	// The track can only be looked at once the job is done
+	if (!_group.isDone() || _ready.load() >= _count || _track->endOfTrack())
+		return;
+
+	JobMan.schedule([this]() { decodeAhead(); }, &_group);
+}
+
+void VideoDecoder::FrameAheadTrack::decodeAhead() {
+	while (!_stop.load() && _ready.load() < _count && !_track->endOfTrack())
+		decodeFrame();
+}
+
+void VideoDecoder::FrameAheadTrack::decodeFrame() {
+	_decoder->readNextPacket();
+	const Graphics::Surface *surface = _track->decodeNextFrame();
+
+	Frame &frame = _frames[_next];
+	frame.valid = surface != 0;
+	if (surface) {
+		if (frame.surface.w != surface->w || frame.surface.h != surface->h || frame.surface.format != surface->format)
+			frame.surface.create(surface->w, surface->h, surface->format);
+
+		if (surface->w && surface->h)
+			frame.surface.copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame.curFrame = _track->getCurFrame();
+	frame.nextFrameStartTime = _track->getNextFrameStartTime();
+	frame.endOfTrack = _track->endOfTrack();
+	frame.dirtyPalette = _track->hasDirtyPalette();
+	if (frame.dirtyPalette) {
+		const byte *palette = _track->getPalette();
+		if (palette)
+			memcpy(frame.palette, palette, sizeof(frame.palette));
+		else
+			memset(frame.palette, 0, sizeof(frame.palette));
+	}
+
+	_next = (_next + 1) % (_count + 1);
+	_ready.fetchAdd(1);
+}
+
 VideoDecoder::AudioTrack::AudioTrack(Audio::Mixer::SoundType soundType) :
 		_volume(Audio::Mixer::kMaxChannelVolume),
 		_soundType(soundType),
@@ -785,6 +1095,10 @@ bool VideoDecoder::StreamFileAudioTrack::loadFromFile(const Common::String &base
 }
 
 void VideoDecoder::addTrack(Track *track, bool isExternal) {
+	// Frames are only decoded ahead for a single video track
+	if (track->getTrackType() == Track::kTrackTypeVideo)
+		stopFramesAhead(true);
+
 	_tracks.push_back(track);
 
 	if (isExternal)
@@ -1026,6 +1340,9 @@ bool VideoDecoder::hasAudio() const {
 }
 
 void VideoDecoder::eraseTrack(Track *track) {
+	if (_frameAheadTrack && _frameAheadTrack->getTrack() == track)
+		stopFramesAhead(false);
+
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
 			_externalTracks.remove_at(idx);
@@ -395,6 +395,35 @@ public:
 	 */
 	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
+	/**
+	 * Decode frames ahead of playback on the job system.
+	 *
+	 * Up to @p count frames are decoded ahead into a ring of surfaces, so
+	 * that decodeNextFrame() usually only has to hand out the next one.
+	 * This is off by default, and can only be used when the video has a
+	 * single video track which plays forward. Seeking and rewinding drop
+	 * the frames decoded ahead, and so does turning this off, setting a
+	 * reverse rate or adding a video track, in which case the video is
+	 * seeked back to the current frame if it can be.
+	 *
+	 * Since readNextPacket() and the decodeNextFrame() function of the video
+	 * track then run on another thread, this is only supported when
+	 * canDecodeAhead() returns true. Functions of subclasses that query the
+	 * video track directly, like dirty rectangles, see the last frame
+	 * decoded instead of the last frame returned.
+	 *
+	 * @param count The number of frames to decode ahead, 0 to turn it off
+	 * @return true on success, false otherwise
+	 */
+	bool setFramesAhead(uint count);
+
+	/**
+	 * Get the number of frames decoded ahead of playback.
+	 *
+	 * @see setFramesAhead()
+	 */
+	uint getFramesAhead() const;
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -958,7 +987,20 @@ protected:
 	 */
 	virtual AudioTrack *getAudioTrack(int index) { return 0; }
 
+	/**
+	 * Can readNextPacket() and the video track run on another thread?
+	 *
+	 * A subclass has to return false if its own functions access the data
+	 * used for decoding, for example by reading from the same stream to
+	 * buffer audio.
+	 *
+	 * @see setFramesAhead()
+	 */
+	virtual bool canDecodeAhead() const { return true; }
+
 private:
+	class FrameAheadTrack;
+
 	// Tracks owned by this VideoDecoder
 	TrackList _tracks;
 	TrackList _internalTracks;
@@ -971,6 +1013,10 @@ private:
 	Common::Rational _playbackRate;
 	VideoTrack *_nextVideoTrack;
 
+	// Wraps the video track in _tracks while decoding frames ahead
+	FrameAheadTrack *_frameAheadTrack;
+	void stopFramesAhead(bool keepFrame);
+
 	// Palette settings from individual tracks
 	mutable bool _dirtyPalette;
 	const byte *_palette;